@@ -0,0 +1,180 @@
+/**
+ * Implementation of the HdrHistogram class.
+ */
+
+#include "HdrHistogram.h"
+#include <algorithm>
+#include <cmath>
+
+/**
+ * Constructor for an empty histogram.
+ *
+ * Param: inHighest - the highest value to tell apart; larger values are
+ *                    counted as this one.
+ * Param: significantDigits - the decimal digits each value is kept to,
+ *                            from 1 to 5.
+ */
+HdrHistogram::HdrHistogram(unsigned long long inHighest,
+                           int significantDigits)
+    : highest(std::max(inHighest, 2ULL))
+{
+    // Enough sub-buckets that neighbouring values of the top half of a
+    // bucket differ by at most one unit of the last significant digit.
+    unsigned long long largestSingleUnit =
+        2 * (unsigned long long) std::pow(10.0, significantDigits);
+    int subBucketCountMagnitude = 0;
+    while ((1ULL << subBucketCountMagnitude) < largestSingleUnit)
+    {
+        subBucketCountMagnitude++;
+    }
+    subBucketHalfCountMagnitude = std::max(subBucketCountMagnitude, 1) - 1;
+    subBucketHalfCount = 1ULL << subBucketHalfCountMagnitude;
+    subBucketMask = 2 * subBucketHalfCount - 1;
+
+    // Each bucket covers twice the range of the one before it.
+    int bucketCount = 1;
+    unsigned long long smallestUntrackable = 2 * subBucketHalfCount;
+    while (smallestUntrackable <= highest)
+    {
+        bucketCount++;
+        if (smallestUntrackable > (~0ULL >> 1))
+        {
+            break;
+        }
+        smallestUntrackable <<= 1;
+    }
+    counts.resize((bucketCount + 1) * subBucketHalfCount);
+    reset();
+}
+
+/**
+ * Returns the position in counts of the sub-bucket holding a value.
+ */
+int HdrHistogram::indexOf(unsigned long long value)
+{
+    int bucket = 64 - __builtin_clzll(value | subBucketMask) -
+                 (subBucketHalfCountMagnitude + 1);
+    unsigned long long subBucket = value >> bucket;
+    return ((bucket + 1) << subBucketHalfCountMagnitude) +
+           (int) (subBucket - subBucketHalfCount);
+}
+
+/**
+ * Returns the highest value counted in a sub-bucket.
+ */
+unsigned long long HdrHistogram::highestEquivalent(int index)
+{
+    int bucket = (index >> subBucketHalfCountMagnitude) - 1;
+    unsigned long long subBucket = (index & (subBucketHalfCount - 1)) +
+                                   subBucketHalfCount;
+    if (bucket < 0)
+    {
+        subBucket -= subBucketHalfCount;
+        bucket = 0;
+    }
+    return (subBucket << bucket) + (1ULL << bucket) - 1;
+}
+
+/**
+ * Counts a value.
+ *
+ * Param: value - the value; values above the highest trackable one are
+ *                counted as that.
+ */
+void HdrHistogram::record(unsigned long long value)
+{
+    value = std::min(value, highest);
+    counts[indexOf(value)]++;
+    totalCount++;
+    minValue = std::min(minValue, value);
+    maxValue = std::max(maxValue, value);
+    sum += value;
+}
+
+/**
+ * Adds the counts of another histogram of the same range and precision.
+ */
+void HdrHistogram::add(HdrHistogram& other)
+{
+    for (size_t i = 0; i < counts.size() && i < other.counts.size(); i++)
+    {
+        counts[i] += other.counts[i];
+    }
+    totalCount += other.totalCount;
+    minValue = std::min(minValue, other.minValue);
+    maxValue = std::max(maxValue, other.maxValue);
+    sum += other.sum;
+}
+
+/**
+ * Forgets every value counted.
+ */
+void HdrHistogram::reset()
+{
+    std::fill(counts.begin(), counts.end(), 0);
+    totalCount = 0;
+    minValue = ~0ULL;
+    maxValue = 0;
+    sum = 0;
+}
+
+/**
+ * Returns the number of values counted.
+ */
+unsigned long long HdrHistogram::getCount()
+{
+    return totalCount;
+}
+
+/**
+ * Returns the smallest value counted, exactly, or 0 if there is none.
+ */
+unsigned long long HdrHistogram::getMin()
+{
+    return totalCount ? minValue : 0;
+}
+
+/**
+ * Returns the largest value counted, exactly, or 0 if there is none.
+ */
+unsigned long long HdrHistogram::getMax()
+{
+    return maxValue;
+}
+
+/**
+ * Returns the mean of the values counted, or 0 if there is none.
+ */
+double HdrHistogram::getMean()
+{
+    return totalCount ? sum / totalCount : 0;
+}
+
+/**
+ * Returns the value below or at which a percentage of the values counted
+ * lie, to the precision of the histogram, but never more than the largest
+ * value counted.
+ *
+ * Param: percentile - the percentage, such as 99.9.
+ * Return: The value, or 0 if there is none.
+ */
+unsigned long long HdrHistogram::valueAtPercentile(double percentile)
+{
+    if (totalCount == 0)
+    {
+        return 0;
+    }
+    unsigned long long target = (unsigned long long) std::ceil(
+        std::min(percentile, 100.0) / 100 * totalCount);
+    target = std::max(target, 1ULL);
+    unsigned long long seen = 0;
+    for (size_t i = 0; i < counts.size(); i++)
+    {
+        seen += counts[i];
+        if (seen >= target)
+        {
+            return std::min(highestEquivalent(i), maxValue);
+        }
+    }
+    return maxValue;
+}
@@ -0,0 +1,50 @@
+/**
+ * This class is a high dynamic range histogram of latencies, after Gil
+ * Tene's HdrHistogram: it counts values from 1 up to a highest trackable
+ * value to a fixed number of significant decimal digits, in memory that
+ * only grows with the logarithm of the range, so a load test can record
+ * every request and still report exact enough tail percentiles (p99.9)
+ * without keeping the samples.
+ *
+ * Values are kept in buckets, one per power of two, each split in linear
+ * sub-buckets; a value is only ever reported as the highest value of its
+ * sub-bucket, which is within the chosen precision of it. Recording is not
+ * thread safe: give each thread a histogram and add() them together.
+ */
+
+#ifndef HDRHISTOGRAM_H
+#define HDRHISTOGRAM_H
+
+#include <vector>
+
+class HdrHistogram {
+    private:
+        unsigned long long highest;
+        /** The sub-buckets of a bucket are 2^(subBucketHalfCountMagnitude
+         * + 1); the first bucket uses them all, later ones the top half. */
+        int subBucketHalfCountMagnitude;
+        unsigned long long subBucketHalfCount;
+        unsigned long long subBucketMask;
+        std::vector<unsigned long long> counts;
+        unsigned long long totalCount;
+        unsigned long long minValue;
+        unsigned long long maxValue;
+        /** The sum of every value recorded, for the mean. */
+        double sum;
+
+        int indexOf(unsigned long long value);
+        unsigned long long highestEquivalent(int index);
+
+    public:
+        HdrHistogram(unsigned long long inHighest, int significantDigits);
+        void record(unsigned long long value);
+        void add(HdrHistogram& other);
+        void reset();
+        unsigned long long getCount();
+        unsigned long long getMin();
+        unsigned long long getMax();
+        double getMean();
+        unsigned long long valueAtPercentile(double percentile);
+};
+
+#endif
@@ -0,0 +1,186 @@
+/**
+ * Implementation of the PerfCounters class.
+ */
+
+#include "PerfCounters.h"
+#include <cerrno>
+#include <cstring>
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+const char* PerfCounters::NAMES[NUM_EVENTS] = {"cycles", "instructions",
+                                               "l1dMisses", "llcMisses",
+                                               "branchMisses"};
+
+/** The perf type and config of each event, in the order of NAMES. */
+static const unsigned int TYPES[PerfCounters::NUM_EVENTS] = {
+    PERF_TYPE_HARDWARE, PERF_TYPE_HARDWARE, PERF_TYPE_HW_CACHE,
+    PERF_TYPE_HW_CACHE, PERF_TYPE_HARDWARE};
+static const unsigned long long CONFIGS[PerfCounters::NUM_EVENTS] = {
+    PERF_COUNT_HW_CPU_CYCLES, PERF_COUNT_HW_INSTRUCTIONS,
+    PERF_COUNT_HW_CACHE_L1D | (PERF_COUNT_HW_CACHE_OP_READ << 8) |
+        (PERF_COUNT_HW_CACHE_RESULT_MISS << 16),
+    PERF_COUNT_HW_CACHE_LL | (PERF_COUNT_HW_CACHE_OP_READ << 8) |
+        (PERF_COUNT_HW_CACHE_RESULT_MISS << 16),
+    PERF_COUNT_HW_BRANCH_MISSES};
+
+/**
+ * Opens one event of the calling thread, disabled, counting user space
+ * only.
+ *
+ * Param: event - the event, an index into NAMES.
+ * Param: group - the file of the group leader, or -1 to lead a new group.
+ * Return: The file, or -1 with errno set.
+ */
+static int openEvent(int event, int group)
+{
+    struct perf_event_attr attr;
+    memset(&attr, 0, sizeof(attr));
+    attr.size = sizeof(attr);
+    attr.type = TYPES[event];
+    attr.config = CONFIGS[event];
+    attr.disabled = (group == -1);
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+    attr.read_format = PERF_FORMAT_GROUP | PERF_FORMAT_TOTAL_TIME_ENABLED |
+                       PERF_FORMAT_TOTAL_TIME_RUNNING;
+    return syscall(__NR_perf_event_open, &attr, 0, -1, group, 0);
+}
+
+/**
+ * Constructor for the counters of the calling thread. Every event that can
+ * be opened is, stopped and at 0; the first one opened leads the group.
+ */
+PerfCounters::PerfCounters() : leader(-1), numOpen(0)
+{
+    for (int e = 0; e < NUM_EVENTS; e++)
+    {
+        fds[e] = openEvent(e, leader);
+        slots[e] = -1;
+        if (fds[e] >= 0)
+        {
+            slots[e] = numOpen++;
+            if (leader == -1)
+            {
+                leader = fds[e];
+            }
+        }
+        else if (error.empty())
+        {
+            error = std::string(NAMES[e]) + ": " + strerror(errno);
+        }
+    }
+    if (leader == -1 && error.empty())
+    {
+        error = "no events";
+    }
+}
+
+/**
+ * Destructor for the counters, which closes their files.
+ */
+PerfCounters::~PerfCounters()
+{
+    for (int e = 0; e < NUM_EVENTS; e++)
+    {
+        if (fds[e] >= 0)
+        {
+            close(fds[e]);
+        }
+    }
+}
+
+/**
+ * Returns true if at least one event could be opened.
+ */
+bool PerfCounters::isAvailable()
+{
+    return leader != -1;
+}
+
+/**
+ * Returns true if an event could be opened.
+ *
+ * Param: event - the event, an index into NAMES.
+ */
+bool PerfCounters::hasEvent(int event)
+{
+    return fds[event] >= 0;
+}
+
+/**
+ * Returns why the first event that could not be opened failed, or "" if
+ * every event was opened.
+ */
+std::string& PerfCounters::getError()
+{
+    return error;
+}
+
+/**
+ * Sets every count back to 0.
+ */
+void PerfCounters::reset()
+{
+    if (leader != -1)
+    {
+        ioctl(leader, PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+    }
+}
+
+/**
+ * Starts, or resumes, counting.
+ */
+void PerfCounters::start()
+{
+    if (leader != -1)
+    {
+        ioctl(leader, PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+    }
+}
+
+/**
+ * Stops counting, keeping the counts.
+ */
+void PerfCounters::stop()
+{
+    if (leader != -1)
+    {
+        ioctl(leader, PERF_EVENT_IOC_DISABLE, PERF_IOC_FLAG_GROUP);
+    }
+}
+
+/**
+ * Reads the counts since the last reset(). When the kernel had to share
+ * the hardware between more events than it has counters, the group only
+ * counted part of the time, and the counts are scaled up to the whole.
+ *
+ * Param: counts - receives a count per event, or -1 for events that are
+ *                 not open.
+ * Return: True if the counts were read.
+ */
+bool PerfCounters::read(double* counts)
+{
+    for (int e = 0; e < NUM_EVENTS; e++)
+    {
+        counts[e] = -1;
+    }
+    // nr, time enabled, time running, then a value per event.
+    unsigned long long buffer[3 + NUM_EVENTS];
+    if (leader == -1 || ::read(leader, buffer, sizeof(buffer)) <
+                        (ssize_t) ((3 + numOpen) * sizeof(buffer[0])))
+    {
+        return false;
+    }
+    double scale = buffer[2] > 0 ? (double) buffer[1] / buffer[2] : 0;
+    for (int e = 0; e < NUM_EVENTS; e++)
+    {
+        if (slots[e] >= 0)
+        {
+            counts[e] = buffer[3 + slots[e]] * scale;
+        }
+    }
+    return true;
+}
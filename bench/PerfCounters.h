@@ -0,0 +1,52 @@
+/**
+ * This class reads the hardware performance counters of the calling thread
+ * through perf_event_open: cycles, instructions, L1 data cache read misses,
+ * last level cache read misses and branch misses. The counters are opened
+ * as one group, so they count over exactly the same stretches of code, and
+ * only while they are enabled, so they can sum many short stretches such as
+ * every pivot of a solve. Only user space is counted, which is allowed at
+ * the default perf_event_paranoid level.
+ *
+ * Containers and virtual machines often hide some or all of the counters.
+ * Those that cannot be opened are skipped, hasEvent() tells which are
+ * left, and if none are, isAvailable() is false and getError() says why;
+ * start() and stop() then do nothing.
+ */
+
+#ifndef PERFCOUNTERS_H
+#define PERFCOUNTERS_H
+
+#include <string>
+
+class PerfCounters {
+    public:
+        static const int NUM_EVENTS = 5;
+        /** The name of each event, in the order counts are returned. */
+        static const char* NAMES[NUM_EVENTS];
+
+    private:
+        /** The file of each event, or -1; the first open one leads. */
+        int fds[NUM_EVENTS];
+        int leader;
+        /** The position of each open event in a read of the group. */
+        int slots[NUM_EVENTS];
+        int numOpen;
+        std::string error;
+
+        // Don't implement these, the files cannot be shared.
+        PerfCounters(PerfCounters const &copy);
+        PerfCounters &operator=(PerfCounters const &copy);
+
+    public:
+        PerfCounters();
+        ~PerfCounters();
+        bool isAvailable();
+        bool hasEvent(int event);
+        std::string& getError();
+        void reset();
+        void start();
+        void stop();
+        bool read(double* counts);
+};
+
+#endif
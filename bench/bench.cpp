@@ -0,0 +1,776 @@
+// Benchmarks the solver on generated HetNet scenes and prints the timings
+// as JSON or CSV. Every configuration is solved through both entry points
+// of the web front-end, repeated runs times after warmup runs:
+//
+//   scene - as cppSolveScene: the scene string is parsed into a model, the
+//           problem is built numerically and solved from the slack basis.
+//           With --crash, the simplex method is instead crashed from the 
+//           water-filling allocation (reported as Phase I) before Phase II.
+//   lp    - as cppMain: the same problem written as a problem string, with
+//           a floor on z at half of the water-filling z, which makes the
+//           slack basis infeasible and so exercises Phase I.
+//
+// For every stage (parse, build, phase1, phase2 and total) the minimum,
+// median, 90th and 99th percentiles, maximum and mean are reported, in
+// seconds. Run with --help for the options; without --devices the default
+// suite of sizes is run.
+//
+// With --counters, the hardware counters of PerfCounters are also read, 
+// once around each whole run and once around every pivot alone, and 
+// reported with the same statistics as the counts of a run per nonzero of
+// the constraint matrix ("cyclesPerNonZero"), the counts of the pivots per
+// pivot ("cyclesPerPivot"), and the instructions per cycle of a run 
+// ("ipc"). Switching the counters on and off around every pivot costs a
+// few microseconds, which the times then include. The pivots are counted
+// through a PivotHook, so this program must be compiled with -DPIVOT_HOOKS,
+// as "make bench" does. Counters that cannot be
+// read, as is usual in containers, are left out.
+//
+// With --map-dir, every table is kept in a memory-mapped file in that
+// directory instead of on the heap (see Simplex::setMappedStorage()), to
+// measure what solving out of core costs.
+//
+// With --scalar float, double or long-double, the scene's problem is also
+// solved from the slack basis by the BasicSimplex of that scalar type, with
+// Dantzig pricing and the Harris ratio test, and reported as the workload
+// "simplex float" and so on, without hardware counters.
+
+#include "BasicSimplex.h"
+#include "PerfCounters.h"
+#include "Simplex.h"
+#include "Solver.h"
+#include "SceneGenerator.h"
+#include "WaterFilling.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#ifndef PIVOT_HOOKS
+#error "bench.cpp counts pivots through PivotHook: compile with -DPIVOT_HOOKS"
+#endif
+
+/** The stages timed on every run, in output order. */
+static const int NUM_STAGES = 5;
+static const char* STAGES[NUM_STAGES] = {"parse", "build", "phase1",
+                                         "phase2", "total"};
+
+/** The sizes of the default suite: devices then access points. */
+static const int NUM_SUITE = 3;
+static const int SUITE[NUM_SUITE][2] = {{25, 4}, {100, 10}, {250, 20}};
+
+/** The settings of a benchmark. */
+struct Options
+{
+    int devices;
+    int accessPoints;
+    double minRadius;
+    double maxRadius;
+    double overlap;
+    double alpha;
+    double beta;
+    unsigned int seed;
+    int runs;
+    int warmup;
+    bool csv;
+    bool counters;
+    bool crash;
+    std::string workload;
+    std::string out;
+    std::string mapDir;
+    std::string scalar;
+};
+
+/** The timings of every run of one workload on one scene. */
+struct Result
+{
+    std::string workload;
+    int devices;
+    int accessPoints;
+    int pairs;
+    int nonZeros;
+    double objective;
+    int errorCode;
+    unsigned long long iterations;
+    std::vector<double> samples[NUM_STAGES];
+    std::vector<double> perNonZero[PerfCounters::NUM_EVENTS];
+    std::vector<double> perPivot[PerfCounters::NUM_EVENTS];
+    std::vector<double> ipc;
+};
+
+/** A named list of samples, one per run. */
+typedef std::pair<std::string, std::vector<double> > Series;
+
+/**
+ * Counts the pivots of a Simplex and runs the pivot counters only while it
+ * pivots.
+ */
+class PivotCounter : public PivotHook
+{
+    private:
+        PerfCounters* counters;
+        unsigned long long pivots;
+
+    public:
+        PivotCounter(PerfCounters* inCounters)
+            : counters(inCounters), pivots(0)
+        {
+        }
+
+        void beforePivot()
+        {
+            if (counters)
+            {
+                counters->start();
+            }
+        }
+
+        void afterPivot()
+        {
+            if (counters)
+            {
+                counters->stop();
+            }
+            pivots++;
+        }
+
+        unsigned long long getPivots()
+        {
+            return pivots;
+        }
+};
+
+/**
+ * Returns a percentile of sorted samples by the nearest rank method, so
+ * that every value reported was measured.
+ */
+static double percentile(const std::vector<double>& sorted, double p)
+{
+    int rank = (int) std::ceil(p / 100 * sorted.size());
+    return sorted[std::max(rank, 1) - 1];
+}
+
+/**
+ * Returns the median of sorted samples.
+ */
+static double median(const std::vector<double>& sorted)
+{
+    size_t n = sorted.size();
+    return n % 2 ? sorted[n / 2] : (sorted[n / 2 - 1] + sorted[n / 2]) / 2;
+}
+
+/**
+ * Returns the mean of samples.
+ */
+static double mean(const std::vector<double>& samples)
+{
+    double sum = 0;
+    for (size_t i = 0; i < samples.size(); i++)
+    {
+        sum += samples[i];
+    }
+    return sum / samples.size();
+}
+
+/**
+ * Writes the problem of a scene in the string form read by cppMain, with
+ * the extra row -z <= -floor. The rows are those of HetNetModel::buildLP(),
+ * written densely.
+ */
+static std::string problemString(HetNetModel& model, double floor)
+{
+    SparseLP lp;
+    model.buildLP(&lp);
+    int numVars = lp.getNumVars();
+    std::vector<double> row(numVars);
+    std::ostringstream problem;
+    problem.precision(17);
+    for (int j = 0; j < numVars; j++)
+    {
+        problem << (j ? " " : "") << lp.getObjective(j);
+    }
+    problem << ";";
+    for (int r = 0; r < lp.getNumRows(); r++)
+    {
+        std::fill(row.begin(), row.end(), 0);
+        for (int k = lp.getRowStart(r); k < lp.getRowEnd(r); k++)
+        {
+            row[lp.getColIndex(k)] = lp.getValue(k);
+        }
+        for (int j = 0; j < numVars; j++)
+        {
+            problem << row[j] << " ";
+        }
+        problem << lp.getRhs(r) << ",";
+    }
+    for (int j = 0; j < numVars; j++)
+    {
+        problem << (j == model.getZColumn() ? -1 : 0) << " ";
+    }
+    problem << -floor << ",;;";
+    return problem.str();
+}
+
+/**
+ * Records the counters of a run, if they are being read: the counts of the
+ * whole run per nonzero and the counts of its pivots per pivot.
+ */
+static void recordCounters(Result& result, PerfCounters* runCounters,
+                           PerfCounters* pivotCounters,
+                           unsigned long long pivots)
+{
+    if (!runCounters)
+    {
+        return;
+    }
+    double run[PerfCounters::NUM_EVENTS];
+    double pivot[PerfCounters::NUM_EVENTS];
+    runCounters->read(run);
+    pivotCounters->read(pivot);
+    for (int e = 0; e < PerfCounters::NUM_EVENTS; e++)
+    {
+        if (run[e] >= 0)
+        {
+            result.perNonZero[e].push_back(run[e] / result.nonZeros);
+        }
+        if (pivot[e] >= 0)
+        {
+            result.perPivot[e].push_back(pivots ? pivot[e] / pivots : 0);
+        }
+    }
+    if (run[0] > 0 && run[1] >= 0)
+    {
+        result.ipc.push_back(run[1] / run[0]);
+    }
+}
+
+/**
+ * Starts the counters of a run, if they are being read.
+ */
+static void startCounters(PerfCounters* runCounters,
+                          PerfCounters* pivotCounters)
+{
+    if (runCounters)
+    {
+        pivotCounters->reset();
+        runCounters->reset();
+        runCounters->start();
+    }
+}
+
+/**
+ * Solves a scene string the way cppSolveScene does, timing each stage. With
+ * crash, the simplex method starts from a basis crashed from the water 
+ * filling, as after cppSetCrashStart("1"), and the water filling and crash
+ * are reported as Phase I.
+ */
+static void runScene(std::string& scene, Result& result, bool record,
+                     bool crash, PerfCounters* runCounters,
+                     PerfCounters* pivotCounters)
+{
+    startCounters(runCounters, pivotCounters);
+    std::chrono::steady_clock::time_point start =
+        std::chrono::steady_clock::now();
+    HetNetModel model(scene);
+    double parse = secondsSince(start);
+
+    std::chrono::steady_clock::time_point stage =
+        std::chrono::steady_clock::now();
+    SparseLP lp;
+    model.buildLP(&lp);
+    Simplex simplex(&lp);
+    PivotCounter pivotCounter(pivotCounters);
+    simplex.setPivotHook(&pivotCounter);
+    double build = secondsSince(stage);
+
+    double filled = 0;
+    LPSolution* sol;
+    if (crash)
+    {
+        stage = std::chrono::steady_clock::now();
+        WaterFilling filling(&model);
+        LPSolution* heuristic = filling.solve();
+        filled = secondsSince(stage);
+        sol = simplex.solveFrom(heuristic->getOptimalValues());
+        delete heuristic;
+    }
+    else
+    {
+        sol = simplex.solve();
+    }
+    double total = secondsSince(start);
+    if (runCounters)
+    {
+        runCounters->stop();
+    }
+
+    if (record)
+    {
+        SolveStats& stats = sol->getStats();
+        double times[NUM_STAGES] = {parse, build,
+                                    filled + stats.getPhaseOneTime(),
+                                    stats.getPhaseTwoTime(), total};
+        for (int s = 0; s < NUM_STAGES; s++)
+        {
+            result.samples[s].push_back(times[s]);
+        }
+        result.pairs = model.getNumPairs();
+        result.objective = sol->getZValue();
+        result.errorCode = sol->getErrorCode();
+        result.iterations = simplex.getIterations();
+        recordCounters(result, runCounters, pivotCounters,
+                       pivotCounter.getPivots());
+    }
+    delete sol;
+}
+
+/**
+ * Solves a problem string the way cppMain does, timing each stage.
+ */
+static void runProblem(std::string& problem, Result& result, bool record,
+                       PerfCounters* runCounters, PerfCounters* pivotCounters)
+{
+    startCounters(runCounters, pivotCounters);
+    std::chrono::steady_clock::time_point start =
+        std::chrono::steady_clock::now();
+    LinearProgram* lp = Solver::getInstance().parse(problem);
+    double parse = secondsSince(start);
+
+    std::chrono::steady_clock::time_point stage =
+        std::chrono::steady_clock::now();
+    Simplex simplex(lp);
+    PivotCounter pivotCounter(pivotCounters);
+    simplex.setPivotHook(&pivotCounter);
+    double build = secondsSince(stage);
+
+    LPSolution* sol = simplex.solve();
+    double total = secondsSince(start);
+    if (runCounters)
+    {
+        runCounters->stop();
+    }
+
+    if (record)
+    {
+        SolveStats& stats = sol->getStats();
+        double times[NUM_STAGES] = {parse, build, stats.getPhaseOneTime(),
+                                    stats.getPhaseTwoTime(), total};
+        for (int s = 0; s < NUM_STAGES; s++)
+        {
+            result.samples[s].push_back(times[s]);
+        }
+        result.objective = sol->getZValue();
+        result.errorCode = sol->getErrorCode();
+        result.iterations = simplex.getIterations();
+        recordCounters(result, runCounters, pivotCounters,
+                       pivotCounter.getPivots());
+    }
+    delete sol;
+    delete lp;
+}
+
+/**
+ * Solves a scene's problem from the slack basis with the BasicSimplex of a
+ * scalar type, timing each stage.
+ */
+static void runScalar(SparseLP& lp, int scalar, Result& result, bool record)
+{
+    std::chrono::steady_clock::time_point start =
+        std::chrono::steady_clock::now();
+    Solve* simplex = SimplexVariant::create(&lp, scalar,
+                                            SimplexVariant::DANTZIG,
+                                            SimplexVariant::HARRIS, 0);
+    double build = secondsSince(start);
+    LPSolution* sol = simplex->solve();
+    double total = secondsSince(start);
+
+    if (record)
+    {
+        SolveStats& stats = sol->getStats();
+        double times[NUM_STAGES] = {0, build, stats.getPhaseOneTime(),
+                                    stats.getPhaseTwoTime(), total};
+        for (int s = 0; s < NUM_STAGES; s++)
+        {
+            result.samples[s].push_back(times[s]);
+        }
+        result.objective = sol->getZValue();
+        result.errorCode = sol->getErrorCode();
+        result.iterations = stats.getPhaseOneIterations() +
+                            stats.getPhaseTwoIterations();
+    }
+    delete sol;
+    delete simplex;
+}
+
+/**
+ * Generates the scene of a configuration and benchmarks the chosen
+ * workloads on it.
+ *
+ * Param: runCounters - the counters read around each run, or 0.
+ * Param: pivotCounters - the counters read around each pivot, or 0.
+ */
+static void benchmark(Options& options, std::vector<Result>& results,
+                      PerfCounters* runCounters, PerfCounters* pivotCounters)
+{
+    SceneGenerator generator(options.seed);
+    generator.setNumDevices(options.devices);
+    generator.setNumAccessPoints(options.accessPoints);
+    generator.setRadii(options.minRadius, options.maxRadius);
+    generator.setOverlap(options.overlap);
+    generator.setWeights(options.alpha, options.beta);
+    std::string scene = generator.generate();
+
+    Result result;
+    result.devices = options.devices;
+    result.accessPoints = options.accessPoints;
+    HetNetModel model(scene);
+    result.pairs = model.getNumPairs();
+    SparseLP lp;
+    model.buildLP(&lp);
+    result.nonZeros = lp.getNumNonZeros();
+
+    if (options.workload != "lp")
+    {
+        Result sceneResult = result;
+        sceneResult.workload = "scene";
+        for (int run = 0; run < options.warmup + options.runs; run++)
+        {
+            runScene(scene, sceneResult, run >= options.warmup,
+                     options.crash, runCounters, pivotCounters);
+        }
+        results.push_back(sceneResult);
+    }
+    if (options.workload != "scene")
+    {
+        WaterFilling filling(&model);
+        LPSolution* heuristic = filling.solve();
+        std::string problem = problemString(model,
+                                            heuristic->getOptimalValues()
+                                                [model.getZColumn()] / 2);
+        delete heuristic;
+
+        // The floor on z adds one nonzero.
+        Result problemResult = result;
+        problemResult.workload = "lp";
+        problemResult.nonZeros++;
+        for (int run = 0; run < options.warmup + options.runs; run++)
+        {
+            runProblem(problem, problemResult, run >= options.warmup,
+                       runCounters, pivotCounters);
+        }
+        results.push_back(problemResult);
+    }
+    if (!options.scalar.empty())
+    {
+        int scalar = SimplexVariant::DOUBLE;
+        if (options.scalar == "float")
+        {
+            scalar = SimplexVariant::FLOAT;
+        }
+        else if (options.scalar == "long-double")
+        {
+            scalar = SimplexVariant::LONG_DOUBLE;
+        }
+        Result scalarResult = result;
+        scalarResult.workload = "simplex " + options.scalar;
+        for (int run = 0; run < options.warmup + options.runs; run++)
+        {
+            runScalar(lp, scalar, scalarResult, run >= options.warmup);
+        }
+        results.push_back(scalarResult);
+    }
+}
+
+/**
+ * Returns every series of samples of a result: the stages, then whichever
+ * counters were read.
+ */
+static std::vector<Series> seriesOf(Result& result)
+{
+    std::vector<Series> series;
+    for (int s = 0; s < NUM_STAGES; s++)
+    {
+        series.push_back(Series(STAGES[s], result.samples[s]));
+    }
+    for (int e = 0; e < PerfCounters::NUM_EVENTS; e++)
+    {
+        std::string name = PerfCounters::NAMES[e];
+        if (!result.perNonZero[e].empty())
+        {
+            series.push_back(Series(name + "PerNonZero",
+                                    result.perNonZero[e]));
+        }
+        if (!result.perPivot[e].empty())
+        {
+            series.push_back(Series(name + "PerPivot", result.perPivot[e]));
+        }
+    }
+    if (!result.ipc.empty())
+    {
+        series.push_back(Series("ipc", result.ipc));
+    }
+    return series;
+}
+
+/**
+ * Writes the results as one JSON object.
+ */
+static void writeJson(std::ostream& out, Options& options,
+                      std::vector<Result>& results)
+{
+    out.precision(9);
+    out << "{\n  \"seed\": " << options.seed << ",\n  \"runs\": "
+        << options.runs << ",\n  \"warmup\": " << options.warmup
+        << ",\n  \"overlap\": " << options.overlap << ",\n  \"radii\": ["
+        << options.minRadius << ", " << options.maxRadius
+        << "],\n  \"weights\": [" << options.alpha << ", " << options.beta
+        << "],\n  \"mapped\": " << (options.mapDir.empty() ? "false" : "true")
+        << ",\n  \"results\": [";
+    for (size_t i = 0; i < results.size(); i++)
+    {
+        Result& result = results[i];
+        out << (i ? "," : "") << "\n    {\"workload\": \"" << result.workload
+            << "\", \"devices\": " << result.devices
+            << ", \"accessPoints\": " << result.accessPoints
+            << ", \"pairs\": " << result.pairs
+            << ", \"nonZeros\": " << result.nonZeros
+            << ", \"errorCode\": " << result.errorCode
+            << ", \"objective\": " << result.objective
+            << ", \"iterations\": " << result.iterations;
+        std::vector<Series> series = seriesOf(result);
+        for (size_t s = 0; s < series.size(); s++)
+        {
+            std::vector<double> sorted = series[s].second;
+            std::sort(sorted.begin(), sorted.end());
+            out << ",\n     \"" << series[s].first << "\": {\"min\": "
+                << sorted[0]
+                << ", \"median\": " << median(sorted)
+                << ", \"p90\": " << percentile(sorted, 90)
+                << ", \"p99\": " << percentile(sorted, 99)
+                << ", \"max\": " << sorted.back()
+                << ", \"mean\": " << mean(sorted) << "}";
+        }
+        out << "}";
+    }
+    out << "\n  ]\n}" << std::endl;
+}
+
+/**
+ * Writes the results as CSV, one line per workload, scene and stage or
+ * counter.
+ */
+static void writeCsv(std::ostream& out, std::vector<Result>& results)
+{
+    out.precision(9);
+    out << "workload,devices,accessPoints,pairs,nonZeros,errorCode,"
+        << "objective,iterations,stage,min,median,p90,p99,max,mean"
+        << std::endl;
+    for (size_t i = 0; i < results.size(); i++)
+    {
+        Result& result = results[i];
+        std::vector<Series> series = seriesOf(result);
+        for (size_t s = 0; s < series.size(); s++)
+        {
+            std::vector<double> sorted = series[s].second;
+            std::sort(sorted.begin(), sorted.end());
+            out << result.workload << "," << result.devices << ","
+                << result.accessPoints << "," << result.pairs << ","
+                << result.nonZeros << "," << result.errorCode << ","
+                << result.objective << "," << result.iterations << ","
+                << series[s].first << ","
+                << sorted[0] << "," << median(sorted) << ","
+                << percentile(sorted, 90) << "," << percentile(sorted, 99)
+                << "," << sorted.back() << "," << mean(sorted) << std::endl;
+        }
+    }
+}
+
+static void usage()
+{
+    std::cerr << "usage: bench [--devices N --aps N] [--min-radius R] "
+              << "[--max-radius R]\n             [--overlap D] [--alpha A] "
+              << "[--beta B] [--seed S] [--runs N]\n             [--warmup N] "
+              << "[--workload scene|lp|both] [--format json|csv]\n"
+              << "             [--out FILE] [--counters] [--map-dir DIR]\n"
+              << "             [--scalar float|double|long-double] [--crash]"
+              << std::endl;
+}
+
+int main(int argc, char** argv)
+{
+    Options options;
+    options.devices = 0;
+    options.accessPoints = 0;
+    options.minRadius = 60;
+    options.maxRadius = 260;
+    options.overlap = 2;
+    options.alpha = 0.5;
+    options.beta = 0.5;
+    options.seed = 1;
+    options.runs = 5;
+    options.warmup = 1;
+    options.csv = false;
+    options.counters = false;
+    options.crash = false;
+    options.workload = "both";
+
+    for (int i = 1; i < argc; i++)
+    {
+        std::string flag = argv[i];
+        if (flag == "--counters")
+        {
+            options.counters = true;
+            continue;
+        }
+        if (flag == "--crash")
+        {
+            options.crash = true;
+            continue;
+        }
+        if (flag == "--help" || i + 1 == argc)
+        {
+            usage();
+            return flag == "--help" ? 0 : 1;
+        }
+        std::string value = argv[++i];
+        if (flag == "--devices")
+        {
+            options.devices = atoi(value.c_str());
+        }
+        else if (flag == "--aps")
+        {
+            options.accessPoints = atoi(value.c_str());
+        }
+        else if (flag == "--min-radius")
+        {
+            options.minRadius = atof(value.c_str());
+        }
+        else if (flag == "--max-radius")
+        {
+            options.maxRadius = atof(value.c_str());
+        }
+        else if (flag == "--overlap")
+        {
+            options.overlap = atof(value.c_str());
+        }
+        else if (flag == "--alpha")
+        {
+            options.alpha = atof(value.c_str());
+        }
+        else if (flag == "--beta")
+        {
+            options.beta = atof(value.c_str());
+        }
+        else if (flag == "--seed")
+        {
+            options.seed = strtoul(value.c_str(), 0, 10);
+        }
+        else if (flag == "--runs")
+        {
+            options.runs = atoi(value.c_str());
+        }
+        else if (flag == "--warmup")
+        {
+            options.warmup = atoi(value.c_str());
+        }
+        else if (flag == "--workload")
+        {
+            options.workload = value;
+        }
+        else if (flag == "--format")
+        {
+            options.csv = value == "csv";
+        }
+        else if (flag == "--out")
+        {
+            options.out = value;
+        }
+        else if (flag == "--map-dir")
+        {
+            options.mapDir = value;
+        }
+        else if (flag == "--scalar")
+        {
+            options.scalar = value;
+        }
+        else
+        {
+            usage();
+            return 1;
+        }
+    }
+    if (options.runs < 1 || (options.devices > 0) !=
+                            (options.accessPoints > 0) ||
+        (!options.scalar.empty() && options.scalar != "float" &&
+         options.scalar != "double" && options.scalar != "long-double"))
+    {
+        usage();
+        return 1;
+    }
+
+    if (!options.mapDir.empty())
+    {
+        Simplex::setMappedStorage(options.mapDir, 0,
+                                  MappedTable::DEFAULT_PANEL_BYTES);
+    }
+
+    PerfCounters* runCounters = 0;
+    PerfCounters* pivotCounters = 0;
+    if (options.counters)
+    {
+        runCounters = new PerfCounters();
+        pivotCounters = new PerfCounters();
+        if (!runCounters->isAvailable() || !pivotCounters->isAvailable())
+        {
+            std::cerr << "hardware counters unavailable ("
+                      << runCounters->getError() << "), reporting times only"
+                      << std::endl;
+            delete runCounters;
+            delete pivotCounters;
+            runCounters = 0;
+            pivotCounters = 0;
+        }
+    }
+
+    std::vector<Result> results;
+    if (options.devices > 0)
+    {
+        benchmark(options, results, runCounters, pivotCounters);
+    }
+    else
+    {
+        for (int i = 0; i < NUM_SUITE; i++)
+        {
+            options.devices = SUITE[i][0];
+            options.accessPoints = SUITE[i][1];
+            benchmark(options, results, runCounters, pivotCounters);
+            std::cerr << "done " << options.devices << " devices, "
+                      << options.accessPoints << " access points"
+                      << std::endl;
+        }
+    }
+
+    std::ofstream file;
+    if (!options.out.empty())
+    {
+        file.open(options.out.c_str());
+    }
+    std::ostream& out = options.out.empty() ? std::cout : file;
+    if (options.csv)
+    {
+        writeCsv(out, results);
+    }
+    else
+    {
+        writeJson(out, options, results);
+    }
+    delete runCounters;
+    delete pivotCounters;
+    return 0;
+}
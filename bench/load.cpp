@@ -0,0 +1,534 @@
+// Drives the solver library with many requests at once, for capacity
+// planning, and reports the throughput and the latency percentiles. The
+// requests are generated HetNet scenes, solved as cppSolveScene solves
+// them, or the problems of a capture log (see CaptureLog), solved as they
+// were recorded. Two kinds of load can be applied:
+//
+//   open   - requests arrive at a target rate (--qps), evenly spaced or as
+//            a Poisson process, and are served by --threads workers. The
+//            latency of a request counts from when it was due to arrive,
+//            so when the workers fall behind, the time requests wait for
+//            one is part of it, as it would be for the users.
+//   closed - --threads clients each send a request, wait for the answer,
+//            and send the next, so the rate is whatever the solver keeps
+//            up with.
+//
+// After --warmup seconds, requests are measured for --duration seconds.
+// Latencies are counted in an HdrHistogram to 3 significant digits, and
+// reported with the time the workers spent solving (service), in seconds:
+// minimum, median, 90th, 99th and 99.9th percentiles, maximum and mean.
+// "cores" is the average number of workers busy solving, which at the peak
+// rate is the number of cores a node needs to keep up. For example:
+//
+//   make load LOAD_ARGS="--mode open --qps 200 --threads 8 --devices 100"
+
+#include "CaptureLog.h"
+#include "HdrHistogram.h"
+#include "SceneGenerator.h"
+#include "Solver.h"
+#include "utils.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+/** The highest latency told apart, in nanoseconds: an hour. */
+static const unsigned long long HIGHEST_NANOSECONDS = 3600000000000ULL;
+static const int SIGNIFICANT_DIGITS = 3;
+
+/** The percentiles reported, and their names. */
+static const int NUM_PERCENTILES = 4;
+static const double PERCENTILES[NUM_PERCENTILES] = {50, 90, 99, 99.9};
+static const char* PERCENTILE_NAMES[NUM_PERCENTILES] = {"p50", "p90", "p99",
+                                                        "p999"};
+
+/** The settings of a load test. */
+struct Options
+{
+    bool open;
+    double qps;
+    bool poisson;
+    int threads;
+    double warmup;
+    double duration;
+    std::string log;
+    int devices;
+    int accessPoints;
+    double overlap;
+    unsigned int seed;
+    int scenes;
+    bool csv;
+    std::string out;
+};
+
+/** What one worker measured. */
+struct Worker
+{
+    HdrHistogram latency;
+    HdrHistogram service;
+    unsigned long long completed;
+    unsigned long long failed;
+    double busy;
+
+    Worker() : latency(HIGHEST_NANOSECONDS, SIGNIFICANT_DIGITS),
+               service(HIGHEST_NANOSECONDS, SIGNIFICANT_DIGITS),
+               completed(0), failed(0), busy(0)
+    {
+    }
+};
+
+/** The state the workers share. */
+struct Load
+{
+    Options* options;
+    std::vector<CaptureRecord>* requests;
+    /** When each request of an open loop is due, in seconds from start. */
+    std::vector<double> arrivals;
+    std::chrono::steady_clock::time_point start;
+    /** The number of the next request to send. */
+    std::atomic<unsigned long long> next;
+};
+
+/**
+ * Returns the nanoseconds from one time to a later one.
+ */
+static unsigned long long nanoseconds(
+    std::chrono::steady_clock::time_point from,
+    std::chrono::steady_clock::time_point to)
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(to - from)
+        .count();
+}
+
+/**
+ * Returns true if every request was recorded under the settings of the 
+ * first (see Solver::applySettings()).
+ */
+static bool sameSettings(std::vector<CaptureRecord>& requests)
+{
+    CaptureRecord& first = requests[0];
+    for (size_t i = 1; i < requests.size(); i++)
+    {
+        CaptureRecord& request = requests[i];
+        if (request.timeLimit != first.timeLimit ||
+            request.maxIterations != first.maxIterations ||
+            request.gapTolerance != first.gapTolerance ||
+            request.memoryLimit != first.memoryLimit ||
+            request.queueTimeout != first.queueTimeout ||
+            request.crashStart != first.crashStart ||
+            request.scalar != first.scalar ||
+            request.pricing != first.pricing ||
+            request.ratioTest != first.ratioTest)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * Solves a request as the entry point that received it did, parsing
+ * included, under the settings applied for the load (see sameSettings()).
+ *
+ * Return: True if it was solved.
+ */
+static bool solve(CaptureRecord& request)
+{
+    if (request.kind == CaptureLog::PATH)
+    {
+        HetNetModel model(request.problem);
+        BetaPath* path = Solver::getInstance().solvePath(&model);
+        bool solved = path->getErrorCode() == LPSolution::SOLVED;
+        delete path;
+        return solved;
+    }
+    LPSolution* sol;
+    if (request.kind == CaptureLog::SCENE)
+    {
+        HetNetModel model(request.problem);
+        sol = Solver::getInstance().solve(&model);
+    }
+    else
+    {
+        sol = Solver::getInstance().solve(request.problem);
+    }
+    bool solved = sol->getErrorCode() == LPSolution::SOLVED;
+    delete sol;
+    return solved;
+}
+
+/**
+ * Serves the requests of an open loop as they fall due, until none are
+ * left.
+ */
+static void serveOpen(Load* load, Worker* worker)
+{
+    std::vector<CaptureRecord>& requests = *load->requests;
+    while (true)
+    {
+        unsigned long long i = load->next.fetch_add(1);
+        if (i >= load->arrivals.size())
+        {
+            return;
+        }
+        std::chrono::steady_clock::time_point due = load->start +
+            std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+                std::chrono::duration<double>(load->arrivals[i]));
+        std::this_thread::sleep_until(due);
+        std::chrono::steady_clock::time_point begin =
+            std::chrono::steady_clock::now();
+        bool solved = solve(requests[i % requests.size()]);
+        std::chrono::steady_clock::time_point end =
+            std::chrono::steady_clock::now();
+        if (load->arrivals[i] >= load->options->warmup)
+        {
+            worker->latency.record(nanoseconds(due, end));
+            worker->service.record(nanoseconds(begin, end));
+            worker->busy += nanoseconds(begin, end) / 1e9;
+            worker->completed++;
+            worker->failed += solved ? 0 : 1;
+        }
+    }
+}
+
+/**
+ * Sends requests one after the other, as a client of a closed loop, until
+ * the test is over.
+ */
+static void serveClosed(Load* load, Worker* worker)
+{
+    std::vector<CaptureRecord>& requests = *load->requests;
+    double end = load->options->warmup + load->options->duration;
+    while (true)
+    {
+        std::chrono::steady_clock::time_point begin =
+            std::chrono::steady_clock::now();
+        double sent = nanoseconds(load->start, begin) / 1e9;
+        if (sent >= end)
+        {
+            return;
+        }
+        unsigned long long i = load->next.fetch_add(1);
+        bool solved = solve(requests[i % requests.size()]);
+        std::chrono::steady_clock::time_point done =
+            std::chrono::steady_clock::now();
+        if (sent >= load->options->warmup)
+        {
+            worker->latency.record(nanoseconds(begin, done));
+            worker->service.record(nanoseconds(begin, done));
+            worker->busy += nanoseconds(begin, done) / 1e9;
+            worker->completed++;
+            worker->failed += solved ? 0 : 1;
+        }
+    }
+}
+
+/**
+ * Returns the times at which the requests of an open loop are due, in
+ * seconds from the start, over the warmup and the measured duration.
+ */
+static std::vector<double> arrivalsOf(Options& options)
+{
+    std::vector<double> arrivals;
+    std::mt19937 engine(options.seed);
+    double end = options.warmup + options.duration;
+    double time = 0;
+    while (time < end)
+    {
+        arrivals.push_back(time);
+        if (options.poisson)
+        {
+            // Exponential gaps, from the engine's raw output so a seed
+            // gives the same arrivals everywhere.
+            double u = (engine() + 1.0) / 4294967297.0;
+            time -= std::log(u) / options.qps;
+        }
+        else
+        {
+            time = arrivals.size() / options.qps;
+        }
+    }
+    return arrivals;
+}
+
+/**
+ * Writes a histogram of nanoseconds as a JSON object of seconds.
+ */
+static void writeHistogram(std::ostream& out, HdrHistogram& histogram)
+{
+    out << "{\"min\": " << histogram.getMin() / 1e9;
+    for (int p = 0; p < NUM_PERCENTILES; p++)
+    {
+        out << ", \"" << PERCENTILE_NAMES[p] << "\": "
+            << histogram.valueAtPercentile(PERCENTILES[p]) / 1e9;
+    }
+    out << ", \"max\": " << histogram.getMax() / 1e9
+        << ", \"mean\": " << histogram.getMean() / 1e9 << "}";
+}
+
+/**
+ * Writes the results as one JSON object.
+ */
+static void writeJson(std::ostream& out, Options& options, Worker& total,
+                      double elapsed, size_t numRequests)
+{
+    out.precision(9);
+    out << "{\n  \"mode\": \"" << (options.open ? "open" : "closed")
+        << "\",\n  \"threads\": " << options.threads;
+    if (options.open)
+    {
+        out << ",\n  \"targetQps\": " << options.qps
+            << ",\n  \"arrivals\": \""
+            << (options.poisson ? "poisson" : "uniform") << "\"";
+    }
+    out << ",\n  \"workload\": \""
+        << (options.log.empty() ? "scene" : options.log)
+        << "\",\n  \"distinctRequests\": " << numRequests
+        << ",\n  \"warmup\": " << options.warmup
+        << ",\n  \"duration\": " << options.duration
+        << ",\n  \"elapsed\": " << elapsed
+        << ",\n  \"completed\": " << total.completed
+        << ",\n  \"failed\": " << total.failed
+        << ",\n  \"throughput\": " << total.completed / elapsed
+        << ",\n  \"cores\": " << total.busy / elapsed
+        << ",\n  \"latency\": ";
+    writeHistogram(out, total.latency);
+    out << ",\n  \"service\": ";
+    writeHistogram(out, total.service);
+    out << "\n}" << std::endl;
+}
+
+/**
+ * Writes the results as CSV, one line per histogram.
+ */
+static void writeCsv(std::ostream& out, Options& options, Worker& total,
+                     double elapsed)
+{
+    out.precision(9);
+    out << "mode,threads,targetQps,completed,failed,throughput,cores,"
+        << "metric,min";
+    for (int p = 0; p < NUM_PERCENTILES; p++)
+    {
+        out << "," << PERCENTILE_NAMES[p];
+    }
+    out << ",max,mean" << std::endl;
+    HdrHistogram* histograms[2] = {&total.latency, &total.service};
+    const char* names[2] = {"latency", "service"};
+    for (int h = 0; h < 2; h++)
+    {
+        out << (options.open ? "open" : "closed") << "," << options.threads
+            << "," << (options.open ? options.qps : 0) << ","
+            << total.completed << "," << total.failed << ","
+            << total.completed / elapsed << "," << total.busy / elapsed
+            << "," << names[h] << "," << histograms[h]->getMin() / 1e9;
+        for (int p = 0; p < NUM_PERCENTILES; p++)
+        {
+            out << "," << histograms[h]->valueAtPercentile(PERCENTILES[p]) /
+                          1e9;
+        }
+        out << "," << histograms[h]->getMax() / 1e9 << ","
+            << histograms[h]->getMean() / 1e9 << std::endl;
+    }
+}
+
+static void usage()
+{
+    std::cerr << "usage: load [--mode open|closed] [--qps Q] "
+              << "[--arrivals uniform|poisson]\n            [--threads N] "
+              << "[--warmup S] [--duration S] [--log FILE]\n            "
+              << "[--devices N --aps N] [--overlap D] [--seed S] "
+              << "[--scenes N]\n            [--format json|csv] "
+              << "[--out FILE]" << std::endl;
+}
+
+int main(int argc, char** argv)
+{
+    Options options;
+    options.open = true;
+    options.qps = 100;
+    options.poisson = false;
+    options.threads = std::max(1U, std::thread::hardware_concurrency());
+    options.warmup = 1;
+    options.duration = 10;
+    options.devices = 100;
+    options.accessPoints = 10;
+    options.overlap = 2;
+    options.seed = 1;
+    options.scenes = 16;
+    options.csv = false;
+
+    for (int i = 1; i < argc; i++)
+    {
+        std::string flag = argv[i];
+        if (flag == "--help" || i + 1 == argc)
+        {
+            usage();
+            return flag == "--help" ? 0 : 1;
+        }
+        std::string value = argv[++i];
+        if (flag == "--mode")
+        {
+            options.open = value != "closed";
+        }
+        else if (flag == "--qps")
+        {
+            options.qps = atof(value.c_str());
+        }
+        else if (flag == "--arrivals")
+        {
+            options.poisson = value == "poisson";
+        }
+        else if (flag == "--threads")
+        {
+            options.threads = atoi(value.c_str());
+        }
+        else if (flag == "--warmup")
+        {
+            options.warmup = atof(value.c_str());
+        }
+        else if (flag == "--duration")
+        {
+            options.duration = atof(value.c_str());
+        }
+        else if (flag == "--log")
+        {
+            options.log = value;
+        }
+        else if (flag == "--devices")
+        {
+            options.devices = atoi(value.c_str());
+        }
+        else if (flag == "--aps")
+        {
+            options.accessPoints = atoi(value.c_str());
+        }
+        else if (flag == "--overlap")
+        {
+            options.overlap = atof(value.c_str());
+        }
+        else if (flag == "--seed")
+        {
+            options.seed = strtoul(value.c_str(), 0, 10);
+        }
+        else if (flag == "--scenes")
+        {
+            options.scenes = atoi(value.c_str());
+        }
+        else if (flag == "--format")
+        {
+            options.csv = value == "csv";
+        }
+        else if (flag == "--out")
+        {
+            options.out = value;
+        }
+        else
+        {
+            usage();
+            return 1;
+        }
+    }
+    if (options.threads < 1 || options.duration <= 0 || options.qps <= 0 ||
+        options.scenes < 1)
+    {
+        usage();
+        return 1;
+    }
+
+    // The requests are all made beforehand, so that making them is not
+    // part of the load.
+    std::vector<CaptureRecord> requests;
+    if (!options.log.empty())
+    {
+        std::string error;
+        if (!CaptureLog::read(options.log, requests, error))
+        {
+            std::cerr << error << std::endl;
+        }
+        if (requests.empty())
+        {
+            return 1;
+        }
+        // The settings are shared by every thread and cannot change under
+        // a running solve, so those of the first request apply to all.
+        Solver::getInstance().applySettings(requests[0]);
+        if (!sameSettings(requests))
+        {
+            std::cerr << "requests were recorded under other settings; "
+                      << "all run under those of the first" << std::endl;
+        }
+    }
+    else
+    {
+        SceneGenerator generator(options.seed);
+        generator.setNumDevices(options.devices);
+        generator.setNumAccessPoints(options.accessPoints);
+        generator.setOverlap(options.overlap);
+        for (int i = 0; i < options.scenes; i++)
+        {
+            CaptureRecord request;
+            request.kind = CaptureLog::SCENE;
+            request.problem = generator.generate();
+            requests.push_back(request);
+        }
+    }
+
+    Load load;
+    load.options = &options;
+    load.requests = &requests;
+    if (options.open)
+    {
+        load.arrivals = arrivalsOf(options);
+    }
+    load.next = 0;
+    std::vector<Worker*> workers;
+    std::vector<std::thread> threads;
+    load.start = std::chrono::steady_clock::now();
+    for (int t = 0; t < options.threads; t++)
+    {
+        workers.push_back(new Worker());
+        threads.push_back(std::thread(options.open ? serveOpen : serveClosed,
+                                      &load, workers.back()));
+    }
+    for (int t = 0; t < options.threads; t++)
+    {
+        threads[t].join();
+    }
+    // An open loop that fell behind takes longer than it was meant to.
+    double elapsed = std::max(options.duration,
+                              secondsSince(load.start) - options.warmup);
+
+    Worker total;
+    for (int t = 0; t < options.threads; t++)
+    {
+        total.latency.add(workers[t]->latency);
+        total.service.add(workers[t]->service);
+        total.completed += workers[t]->completed;
+        total.failed += workers[t]->failed;
+        total.busy += workers[t]->busy;
+        delete workers[t];
+    }
+
+    std::ofstream file;
+    if (!options.out.empty())
+    {
+        file.open(options.out.c_str());
+    }
+    std::ostream& out = options.out.empty() ? std::cout : file;
+    if (options.csv)
+    {
+        writeCsv(out, options, total, elapsed);
+    }
+    else
+    {
+        writeJson(out, options, total, elapsed, requests.size());
+    }
+    return 0;
+}
@@ -0,0 +1,338 @@
+// Replays a log recorded by cppStartCapture (see CaptureLog) through this
+// build: every recorded problem is solved again, under the settings it was
+// recorded with (limits, gap tolerance, memory limit, crash start and 
+// simplex variant), runs times after warmup runs, and its median time is 
+// set against the recorded one. An answer whose hash or engine differs 
+// from the recorded one is a mismatch; logs too old to name the engine 
+// are matched by hash alone. For example:
+//
+//   make replay REPLAY_ARGS="--log /var/log/solver.cap --runs 5"
+//
+// The report, as JSON or CSV, has a line per problem with both times, the
+// difference and ratio, and both error codes and engines; the JSON also 
+// sums up the ratios over the log (median, 90th and 99th percentiles). The
+// exit status is 1 if any answer did not match or the log could not be 
+// read to the end. Answers that ran out of time are compared too, but 
+// since they depend on the speed of the machine, a mismatch there says 
+// little.
+
+#include "CaptureLog.h"
+#include "Solver.h"
+#include "utils.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+
+/** The settings of a replay. */
+struct Options
+{
+    std::string log;
+    int runs;
+    int warmup;
+    int limit;
+    bool csv;
+    std::string out;
+};
+
+/** The replay of one recorded problem. */
+struct Replayed
+{
+    CaptureRecord* record;
+    double seconds;
+    int errorCode;
+    std::string engine;
+    bool match;
+};
+
+/**
+ * Returns a percentile of sorted samples by the nearest rank method, as
+ * the benchmark reports them.
+ */
+static double percentile(const std::vector<double>& sorted, double p)
+{
+    int rank = (int) std::ceil(p / 100 * sorted.size());
+    return sorted[std::max(rank, 1) - 1];
+}
+
+/**
+ * Solves a recorded problem once, as the entry point that received it
+ * did, parsing included.
+ *
+ * Param: record - the recorded problem.
+ * Param: seconds - set to the time the solve took.
+ * Param: errorCode - set to the error code of the answer.
+ * Param: engine - set to the engine that answered.
+ * Return: The hash of the answer (see CaptureLog::hashSolution() and
+ *         CaptureLog::hashPath()).
+ */
+static unsigned long long solve(CaptureRecord& record, double& seconds,
+                                int& errorCode, std::string& engine)
+{
+    Solver& solver = Solver::getInstance();
+    solver.applySettings(record);
+    std::chrono::steady_clock::time_point start =
+        std::chrono::steady_clock::now();
+    if (record.kind == CaptureLog::PATH)
+    {
+        HetNetModel model(record.problem);
+        BetaPath* path = solver.solvePath(&model);
+        seconds = secondsSince(start);
+        errorCode = path->getErrorCode();
+        engine = path->getStats().getEngine();
+        unsigned long long hash = CaptureLog::hashPath(path);
+        delete path;
+        return hash;
+    }
+    LPSolution* sol;
+    if (record.kind == CaptureLog::SCENE)
+    {
+        HetNetModel model(record.problem);
+        sol = solver.solve(&model);
+    }
+    else
+    {
+        sol = solver.solve(record.problem);
+    }
+    seconds = secondsSince(start);
+    errorCode = sol->getErrorCode();
+    engine = sol->getStats().getEngine();
+    unsigned long long hash = CaptureLog::hashSolution(sol);
+    delete sol;
+    return hash;
+}
+
+/**
+ * Replays a recorded problem: warmup solves, then runs timed ones, of
+ * which the median time is kept. The answer of the first timed run is
+ * compared with the recorded one.
+ */
+static Replayed replay(Options& options, CaptureRecord& record)
+{
+    Replayed replayed;
+    replayed.record = &record;
+    double seconds;
+    int errorCode;
+    std::string engine;
+    for (int i = 0; i < options.warmup; i++)
+    {
+        solve(record, seconds, errorCode, engine);
+    }
+    std::vector<double> times;
+    for (int i = 0; i < options.runs; i++)
+    {
+        unsigned long long hash = solve(record, seconds, errorCode, engine);
+        times.push_back(seconds);
+        if (i == 0)
+        {
+            replayed.errorCode = errorCode;
+            replayed.engine = engine;
+            replayed.match = errorCode == record.errorCode &&
+                             hash == record.resultHash &&
+                             (record.engine.empty() ||
+                              engine == record.engine);
+        }
+    }
+    std::sort(times.begin(), times.end());
+    size_t n = times.size();
+    replayed.seconds = n % 2 ? times[n / 2] :
+                               (times[n / 2 - 1] + times[n / 2]) / 2;
+    return replayed;
+}
+
+/**
+ * Returns the name of the kind of a recorded request.
+ */
+static const char* kindName(CaptureRecord& record)
+{
+    if (record.kind == CaptureLog::PATH)
+    {
+        return "path";
+    }
+    return record.kind == CaptureLog::SCENE ? "scene" : "problem";
+}
+
+/**
+ * Writes the replays as one JSON object.
+ */
+static void writeJson(std::ostream& out, Options& options,
+                      std::vector<Replayed>& replays)
+{
+    std::vector<double> ratios;
+    double recordedTotal = 0;
+    double replayTotal = 0;
+    int mismatches = 0;
+    for (size_t i = 0; i < replays.size(); i++)
+    {
+        Replayed& replayed = replays[i];
+        if (replayed.record->seconds > 0)
+        {
+            ratios.push_back(replayed.seconds / replayed.record->seconds);
+        }
+        recordedTotal += replayed.record->seconds;
+        replayTotal += replayed.seconds;
+        mismatches += replayed.match ? 0 : 1;
+    }
+    std::sort(ratios.begin(), ratios.end());
+
+    out.precision(9);
+    out << "{\n  \"log\": \"" << options.log << "\",\n  \"runs\": "
+        << options.runs << ",\n  \"warmup\": " << options.warmup
+        << ",\n  \"problems\": " << replays.size()
+        << ",\n  \"mismatches\": " << mismatches
+        << ",\n  \"recordedSeconds\": " << recordedTotal
+        << ",\n  \"replaySeconds\": " << replayTotal;
+    if (!ratios.empty())
+    {
+        out << ",\n  \"ratio\": {\"min\": " << ratios[0]
+            << ", \"median\": " << percentile(ratios, 50)
+            << ", \"p90\": " << percentile(ratios, 90)
+            << ", \"p99\": " << percentile(ratios, 99)
+            << ", \"max\": " << ratios.back() << "}";
+    }
+    out << ",\n  \"replays\": [";
+    for (size_t i = 0; i < replays.size(); i++)
+    {
+        Replayed& replayed = replays[i];
+        CaptureRecord& record = *replayed.record;
+        out << (i ? "," : "") << "\n    {\"index\": " << i
+            << ", \"kind\": \"" << kindName(record)
+            << "\", \"bytes\": " << record.problem.size()
+            << ", \"timestamp\": " << record.timestamp
+            << ", \"recordedSeconds\": " << record.seconds
+            << ", \"replaySeconds\": " << replayed.seconds
+            << ", \"delta\": " << replayed.seconds - record.seconds
+            << ", \"recordedErrorCode\": " << record.errorCode
+            << ", \"errorCode\": " << replayed.errorCode
+            << ", \"recordedEngine\": \"" << record.engine
+            << "\", \"engine\": \"" << replayed.engine << "\""
+            << ", \"match\": " << (replayed.match ? "true" : "false") << "}";
+    }
+    out << "\n  ]\n}" << std::endl;
+}
+
+/**
+ * Writes the replays as CSV, one line per problem.
+ */
+static void writeCsv(std::ostream& out, std::vector<Replayed>& replays)
+{
+    out.precision(9);
+    out << "index,kind,bytes,timestamp,recordedSeconds,replaySeconds,delta,"
+        << "ratio,recordedErrorCode,errorCode,recordedEngine,engine,match"
+        << std::endl;
+    for (size_t i = 0; i < replays.size(); i++)
+    {
+        Replayed& replayed = replays[i];
+        CaptureRecord& record = *replayed.record;
+        out << i << "," << kindName(record) << ","
+            << record.problem.size() << "," << record.timestamp << ","
+            << record.seconds << "," << replayed.seconds << ","
+            << replayed.seconds - record.seconds << ","
+            << (record.seconds > 0 ? replayed.seconds / record.seconds : 0)
+            << "," << record.errorCode << "," << replayed.errorCode << ","
+            << record.engine << "," << replayed.engine << ","
+            << (replayed.match ? 1 : 0) << std::endl;
+    }
+}
+
+static void usage()
+{
+    std::cerr << "usage: replay --log FILE [--runs N] [--warmup N] "
+              << "[--limit N]\n              [--format json|csv] "
+              << "[--out FILE]" << std::endl;
+}
+
+int main(int argc, char** argv)
+{
+    Options options;
+    options.runs = 3;
+    options.warmup = 1;
+    options.limit = 0;
+    options.csv = false;
+
+    for (int i = 1; i < argc; i++)
+    {
+        std::string flag = argv[i];
+        if (flag == "--help" || i + 1 == argc)
+        {
+            usage();
+            return flag == "--help" ? 0 : 1;
+        }
+        std::string value = argv[++i];
+        if (flag == "--log")
+        {
+            options.log = value;
+        }
+        else if (flag == "--runs")
+        {
+            options.runs = atoi(value.c_str());
+        }
+        else if (flag == "--warmup")
+        {
+            options.warmup = atoi(value.c_str());
+        }
+        else if (flag == "--limit")
+        {
+            options.limit = atoi(value.c_str());
+        }
+        else if (flag == "--format")
+        {
+            options.csv = value == "csv";
+        }
+        else if (flag == "--out")
+        {
+            options.out = value;
+        }
+        else
+        {
+            usage();
+            return 1;
+        }
+    }
+    if (options.log.empty() || options.runs < 1)
+    {
+        usage();
+        return 1;
+    }
+
+    // A log cut short is still replayed up to where it stops.
+    std::vector<CaptureRecord> records;
+    std::string error;
+    bool complete = CaptureLog::read(options.log, records, error);
+    if (!complete)
+    {
+        std::cerr << error << std::endl;
+    }
+    if (options.limit > 0 && (size_t) options.limit < records.size())
+    {
+        records.resize(options.limit);
+    }
+
+    std::vector<Replayed> replays;
+    bool matched = true;
+    for (size_t i = 0; i < records.size(); i++)
+    {
+        replays.push_back(replay(options, records[i]));
+        matched = matched && replays.back().match;
+    }
+
+    std::ofstream file;
+    if (!options.out.empty())
+    {
+        file.open(options.out.c_str());
+    }
+    std::ostream& out = options.out.empty() ? std::cout : file;
+    if (options.csv)
+    {
+        writeCsv(out, replays);
+    }
+    else
+    {
+        writeJson(out, options, replays);
+    }
+    return (complete && matched) ? 0 : 1;
+}
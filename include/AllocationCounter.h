@@ -0,0 +1,33 @@
+/**
+ * This class counts the heap allocations made by the calling thread, and
+ * the bytes they asked for, since it was created or restarted. Solves use
+ * it to report the allocations of each stage in their SolveStats.
+ *
+ * Allocations are only counted by a library compiled with
+ * -DCOUNT_ALLOCATIONS (the ALLOCS variable of the makefile), which replaces
+ * the global operator new and delete with versions that count into
+ * thread local totals; the totals stay at 0 otherwise, and isCounting()
+ * tells which build is running. The counts are kept per thread, so solves
+ * running concurrently never contend on them and each only sees its own.
+ */
+
+#ifndef ALLOCATIONCOUNTER_H
+#define ALLOCATIONCOUNTER_H
+
+class AllocationCounter {
+    private:
+        /** The thread's totals when the counter was last restarted. */
+        unsigned long long startAllocations;
+        unsigned long long startBytes;
+
+    public:
+        AllocationCounter();
+        void restart();
+        unsigned long long getAllocations();
+        unsigned long long getBytes();
+        static bool isCounting();
+        static unsigned long long getThreadAllocations();
+        static unsigned long long getThreadBytes();
+};
+
+#endif
@@ -0,0 +1,97 @@
+/**
+ * This class is the two-phase simplex method of Simplex, compiled for a
+ * scalar type, a pricing rule and a ratio test chosen at compile time (see
+ * SimplexPolicies.h). float halves the memory and bandwidth of the table,
+ * which suits huge runs where an approximate answer is enough; long double
+ * keeps more digits through the pivots of ill-conditioned problems.
+ *
+ * It only solves: there is no warm start, sensitivity analysis, changing
+ * of the problem or out-of-core table, for which Simplex is still the
+ * engine. The answer is converted to double, as LPSolution holds it.
+ *
+ * The template is defined in BasicSimplex.cpp and instantiated there for
+ * float, double and long double with each pricing rule and ratio test, so
+ * only those combinations exist. SimplexVariant::create() picks one at run
+ * time, behind the Solve interface.
+ */
+
+#ifndef BASICSIMPLEX_H
+#define BASICSIMPLEX_H
+
+#include "Solve.h"
+#include "SimplexPolicies.h"
+#include "SolveBudget.h"
+#include "SparseLP.h"
+#include <vector>
+
+template <typename Scalar, typename Pricing, typename RatioTest>
+class BasicSimplex : public Solve
+{
+    private:
+        int numDecisionVars;
+        int numConstraints;
+        /** Rows with an artificial variable in Phase I. */
+        int numArtificial;
+        /** The constraint rows, then the objective row, then Phase I's
+         * objective row when there are artificial variables. */
+        int numRows;
+        /** Decision variables, slacks, artificial variables and the right
+         * hand side. */
+        int numCols;
+        /** The table, row by row, and a pointer to each row. */
+        std::vector<Scalar> cells;
+        std::vector<Scalar*> table;
+        /** The basic column of each constraint row. */
+        std::vector<int> basis;
+        /** Whether each column may enter the basis. */
+        bool* eligible;
+        /** The limits on the solve, or 0 for none. */
+        SolveBudget* budget;
+        unsigned long long iterations;
+        unsigned long long degeneratePivots;
+        /** Seconds the constructor spent building the table. */
+        double buildTime;
+
+        // Don't implement these, the table cannot be shared.
+        BasicSimplex(BasicSimplex const &copy);
+        BasicSimplex &operator=(BasicSimplex const &copy);
+
+        void pivot(int pivotRow, int pivotCol, int curRows);
+        int optimize(int objectiveRow);
+        void driveOutArtificials();
+
+    public:
+        /** Pivots allowed per row and column of the table before a solve
+         * gives up with LPSolution::EXCEEDED_MAX_ITERATIONS. */
+        static const int PIVOTS_PER_LINE = 50;
+
+        BasicSimplex(SparseLP* lp);
+        virtual ~BasicSimplex();
+        virtual LPSolution* solve();
+        void setBudget(SolveBudget* budget);
+        unsigned long long getIterations();
+};
+
+/**
+ * The instantiations of BasicSimplex, chosen at run time.
+ */
+class SimplexVariant
+{
+    public:
+        /** Scalar types. */
+        static const int FLOAT = 0;
+        static const int DOUBLE = 1;
+        static const int LONG_DOUBLE = 2;
+        /** Pricing rules. */
+        static const int DANTZIG = 0;
+        static const int BLAND = 1;
+        /** Ratio tests. */
+        static const int TEXTBOOK = 0;
+        static const int HARRIS = 1;
+
+        static Solve* create(SparseLP* lp, int scalar, int pricing,
+                             int ratioTest, SolveBudget* budget);
+        static unsigned long long predictPeakBytes(SparseLP* lp, int scalar);
+};
+
+#endif
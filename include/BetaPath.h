@@ -0,0 +1,70 @@
+/**
+ * This class computes the solution of a HetNet scene for every fairness 
+ * weight beta in [0, 1] at once, with the throughput weight alpha = 1 - 
+ * beta as the web front-end sets it. The objective is then
+ *
+ *   c(beta) = c0 + beta * d,   c0 = (1 for each r_ua, 0 for z),
+ *                              d = (-1 for each r_ua, S for z),
+ *
+ * which is linear in beta, so an optimal basis stays optimal over an 
+ * interval of beta. The parametric simplex method starts from the optimal
+ * basis at beta = 0, finds where it stops being optimal, pivots to the 
+ * next basis and repeats until beta = 1. The result is a list of intervals,
+ * each with its basis and solution, from which the solution at any beta 
+ * can be looked up without solving again.
+ */
+
+#ifndef BETAPATH_H
+#define BETAPATH_H
+
+#include <vector>
+#include "HetNetModel.h"
+#include "LPSolution.h"
+#include "SolveBudget.h"
+#include "SolveStats.h"
+
+class BetaPath {
+    private:
+        /** The scene. */
+        HetNetModel* model;
+        /** The interval [start[i], end[i]] of each basis. */
+        std::vector<double> start;
+        std::vector<double> end;
+        /** The basis and solution of each interval, in the model's order. */
+        std::vector<std::vector<int> > bases;
+        std::vector<std::vector<double> > values;
+        /** Aggregate throughput sum(r_ua) of each interval's solution. */
+        std::vector<double> throughput;
+        /** The error code of the last compute(). */
+        int errorCode;
+        /** The limits on compute(), or 0 for none. */
+        SolveBudget* budget;
+        /** Pivots taken by the last compute(), over all its solves. */
+        unsigned long long iterations;
+        /** How the last compute() went, over all its solves. */
+        SolveStats stats;
+
+        int walk();
+
+    public:
+        /** Upper limit on the number of intervals and tie-breaking pivots. */
+        static const int MAX_STEPS = 100000;
+
+        BetaPath(HetNetModel* model);
+        void setBudget(SolveBudget* budget);
+        int compute();
+        void reject();
+        int getErrorCode();
+        unsigned long long getIterations();
+        SolveStats& getStats();
+        int getNumIntervals();
+        double getStart(int interval);
+        double getEnd(int interval);
+        std::vector<int>& getBasis(int interval);
+        std::vector<double>& getValues(int interval);
+        double getObjectiveValue(int interval, double beta);
+        int findInterval(double beta);
+        LPSolution* getSolution(double beta);
+};
+
+#endif
@@ -0,0 +1,99 @@
+/**
+ * This class records the problems the server is asked to solve into an
+ * append-only log, so a later build can be benchmarked and checked against
+ * the real workload (see bench/replay.cpp). Each record holds when the
+ * problem arrived, what kind of request it was, the request string itself,
+ * every solver setting that can change its answer, the engine that 
+ * answered, how long it took and a hash of the answer (see 
+ * hashSolution()). Logs written before the memory limit, crash start, 
+ * engine choice and engine were recorded are still read, with those 
+ * settings at their defaults and no engine.
+ *
+ * Every record is a frame of its own: a small header with the lengths and
+ * a checksum, followed by the record compressed with zlib. A frame is
+ * written with a single write() to a file opened for appending, so several
+ * processes of the web server may share one log, and a log cut short by a
+ * crash only loses its last, partial frame. Numbers are stored little
+ * endian, whatever the machine.
+ *
+ * A log may be sampled: with a sample rate of n, sample() only picks every
+ * n-th problem, and only those are passed to write().
+ */
+
+#ifndef CAPTURELOG_H
+#define CAPTURELOG_H
+
+#include "BetaPath.h"
+#include "LPSolution.h"
+#include <atomic>
+#include <mutex>
+#include <string>
+#include <vector>
+
+/** One recorded problem. */
+struct CaptureRecord
+{
+    /** Nanoseconds since the epoch when the problem arrived. */
+    unsigned long long timestamp;
+    /** PROBLEM, SCENE or PATH of CaptureLog. */
+    int kind;
+    /** The request string, as the entry point received it. */
+    std::string problem;
+    /** The settings of the Solver at the time (see Solver::setTimeLimit(),
+     * setMaxIterations(), setGapTolerance(), setMemoryLimit(), 
+     * setCrashStart() and setScalar()). */
+    double timeLimit;
+    unsigned long long maxIterations;
+    double gapTolerance;
+    unsigned long long memoryLimit;
+    double queueTimeout;
+    bool crashStart;
+    int scalar;
+    int pricing;
+    int ratioTest;
+    /** The engine that answered, as SolveStats::getEngine() names it. */
+    std::string engine;
+    /** The error code of the answer, and hashSolution() of it. */
+    int errorCode;
+    unsigned long long resultHash;
+    /** Seconds the solve took, parsing included. */
+    double seconds;
+};
+
+class CaptureLog {
+    public:
+        /** A problem string, solved as cppMain solves it. */
+        static const int PROBLEM = 0;
+        /** A HetNet scene string, solved as cppSolveScene solves it. */
+        static const int SCENE = 1;
+        /** A HetNet scene string, solved over beta as cppSolveScenePath 
+         * solves it. */
+        static const int PATH = 2;
+
+    private:
+        int file;
+        unsigned int sampleEvery;
+        /** The problems offered to record() so far. */
+        std::atomic<unsigned long long> seen;
+        std::mutex lock;
+        std::string error;
+
+        // Don't implement these, the file cannot be shared.
+        CaptureLog(CaptureLog const &copy);
+        CaptureLog &operator=(CaptureLog const &copy);
+
+    public:
+        CaptureLog(std::string path, unsigned int inSampleEvery);
+        ~CaptureLog();
+        bool isOpen();
+        std::string& getError();
+        bool sample();
+        bool write(CaptureRecord& record);
+        static unsigned long long hashSolution(LPSolution* sol);
+        static unsigned long long hashPath(BetaPath* path);
+        static unsigned long long now();
+        static bool read(std::string path, std::vector<CaptureRecord>& records,
+                         std::string& error);
+};
+
+#endif
@@ -0,0 +1,105 @@
+/**
+ * This class solves a HetNet scene by splitting it into clusters: the 
+ * connected components of the graph whose nodes are the devices and access
+ * points and whose edges are the pairs in range. Clusters share no 
+ * constraints except through the fairness variable z, so for a fixed z each
+ * cluster is an independent, much smaller problem:
+ *
+ *   g_k(z) = maximize alpha * sum(r_ua) over the pairs of cluster k
+ *            subject to the capacity and bound rows of cluster k
+ *                       sum_a(r_ua) >= z    for every device of cluster k
+ *
+ * and the whole problem is to maximize F(z) = sum_k(g_k(z)) + beta * S * z,
+ * where S is the sum of r_ua,max. F is concave and piecewise linear, and the
+ * fairness rows' dual values give its slope. The exact mode searches for
+ * the maximum of F by intersecting tangents, which ends exactly at a 
+ * breakpoint. The approximate mode solves each cluster once with its own 
+ * z and its share of the fairness weight, then fixes z at the smallest of 
+ * them. Either way, the clusters of each step are solved concurrently, so 
+ * solve time follows the largest cluster rather than the whole scene.
+ */
+
+#ifndef CLUSTERDECOMPOSITION_H
+#define CLUSTERDECOMPOSITION_H
+
+#include <vector>
+#include "HetNetModel.h"
+#include "LPSolution.h"
+#include "Simplex.h"
+#include "SparseLP.h"
+
+class ClusterDecomposition {
+    private:
+        /**
+         * One connected component of the scene, with its own retained 
+         * table. Its columns are its pairs, in the model's order, followed
+         * by its copy of z; its last row is -z <= -(the fixed z).
+         */
+        class Cluster {
+            public:
+                std::vector<int> pairs;
+                std::vector<int> aps;
+                std::vector<int> devices;
+                SparseLP lp;
+                Simplex* simplex;
+                /** The row fixing z. */
+                int zRow;
+                /** The sum of r_ua,max over the cluster's pairs. */
+                double sumRuaMax;
+                /** Results of the last solve. */
+                int errorCode;
+                double value;
+                double dual;
+                std::vector<double> values;
+
+                Cluster() : simplex(0), zRow(0), sumRuaMax(0), errorCode(0),
+                            value(0), dual(0) {}
+                ~Cluster() { delete simplex; }
+        };
+
+        /** The scene being solved. */
+        HetNetModel* model;
+        /** The clusters, largest first. */
+        std::vector<Cluster*> clusters;
+        /** True if some device is not in range of any access point. */
+        bool uncoveredDevice;
+        /** The number of threads to solve clusters with. */
+        int numThreads;
+        /** The limits of the clusters' solves, or 0 for none. */
+        SolveBudget* budget;
+
+        // Don't implement these, the clusters cannot be shared.
+        ClusterDecomposition(ClusterDecomposition const &copy);
+        ClusterDecomposition &operator=(ClusterDecomposition const &copy);
+
+        void findClusters();
+        void buildCluster(Cluster* cluster);
+        bool forEachCluster(int task, double z);
+        static void runTask(std::vector<Cluster*>* clusters, int task, 
+                            double z, double alpha, double beta,
+                            SolveBudget* budget, int first, int stride);
+        bool evaluate(double z, double& value, double& slope);
+        LPSolution* assemble(double z, double value);
+        LPSolution* failure();
+
+        /** Tasks run on every cluster by forEachCluster(). */
+        static const int MAX_Z_TASK = 0;
+        static const int FIXED_Z_TASK = 1;
+        static const int OWN_Z_TASK = 2;
+
+    public:
+        /** Modes of solve(). */
+        static const int EXACT = 0;
+        static const int APPROXIMATE = 1;
+        /** Upper limit on the tangent steps of the exact mode. */
+        static const int MAX_MASTER_STEPS = 200;
+
+        ClusterDecomposition(HetNetModel* model);
+        ~ClusterDecomposition();
+        int getNumClusters();
+        int getClusterSize(int cluster);
+        void setBudget(SolveBudget* budget);
+        LPSolution* solve(int mode, int numThreads);
+};
+
+#endif
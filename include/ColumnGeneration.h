@@ -0,0 +1,64 @@
+/**
+ * This class solves a HetNet scene by column generation. In the optimal 
+ * solution of a large scene most pairs carry no traffic, yet the full 
+ * problem carries a column and a bound row for every one of them through
+ * every pivot. Instead, a restricted master problem starts out with only 
+ * the best pair of each device. After each solve, the dual values y_a of 
+ * the capacity rows and y_u of the fairness rows price every pair that is
+ * left out; its reduced cost is
+ *
+ *   alpha - y_a + y_u
+ *
+ * since its column has a 1 in its access point's capacity row, a -1 in its
+ * device's fairness row, and a bound row of its own that would start out
+ * slack. Pairs with a positive reduced cost are added to the master, which
+ * is reoptimized from its current basis, until no pair prices out. The 
+ * master's solution is then optimal for the whole scene.
+ */
+
+#ifndef COLUMNGENERATION_H
+#define COLUMNGENERATION_H
+
+#include <vector>
+#include "HetNetModel.h"
+#include "LPSolution.h"
+#include "Simplex.h"
+#include "SparseLP.h"
+
+class ColumnGeneration {
+    private:
+        /** The scene being solved. */
+        HetNetModel* model;
+        /** The restricted master problem and its table. */
+        SparseLP lp;
+        Simplex* simplex;
+        /** The limits of the master's solves, or 0 for none. */
+        SolveBudget* budget;
+        /** The master's decision variable of each pair, or -1. */
+        std::vector<int> pairVar;
+        /** The master's decision variable of z. */
+        int zVar;
+        /** The number of pricing rounds of the last solve. */
+        int numRounds;
+
+        // Don't implement these, the table cannot be shared.
+        ColumnGeneration(ColumnGeneration const &copy);
+        ColumnGeneration &operator=(ColumnGeneration const &copy);
+
+        void buildMaster();
+        int priceColumns();
+        LPSolution* toModelOrder(LPSolution* sol);
+
+    public:
+        /** Upper limit on the number of pricing rounds. */
+        static const int MAX_ROUNDS = 1000;
+
+        ColumnGeneration(HetNetModel* model);
+        ~ColumnGeneration();
+        void setBudget(SolveBudget* budget);
+        LPSolution* solve();
+        int getNumColumns();
+        int getNumRounds();
+};
+
+#endif
@@ -0,0 +1,44 @@
+/**
+ * This class is a uniform grid spatial index over the coverage circles of the
+ * access points in a scene. Every access point is stored in each cell that
+ * its coverage circle's bounding box overlaps, so the access points that may
+ * reach a device are found by looking at the single cell that contains it,
+ * instead of by measuring the distance to every access point.
+ */
+
+#ifndef COVERAGEGRID_H
+#define COVERAGEGRID_H
+
+#include <vector>
+
+class CoverageGrid {
+    private:
+        /** Lower left corner of the grid. */
+        double originX;
+        double originY;
+        /** Width and height of a cell. */
+        double cellSize;
+        /** Number of cells along each axis. */
+        int cellsX;
+        int cellsY;
+        /** Index of the first access point of each cell; has one extra entry. */
+        std::vector<int> cellStart;
+        /** Access points of every cell, in increasing order within a cell. */
+        std::vector<int> cellAps;
+
+        int clampX(double x);
+        int clampY(double y);
+
+    public:
+        /** Upper limit on the number of cells, relative to access points. */
+        static const int CELLS_PER_AP = 4;
+
+        CoverageGrid();
+        void build(const double* x, const double* y, const double* radius,
+                   int numAps);
+        int getCell(double x, double y);
+        const int* cellBegin(int cell);
+        const int* cellEnd(int cell);
+};
+
+#endif
@@ -0,0 +1,111 @@
+/**
+ * This class drives a dynamic model: a HetNet scene whose devices move over
+ * a timeframe. Each tick moves the devices and recomputes r_ua,max for just
+ * the devices that moved. The simplex table of the previous tick is kept, 
+ * and only the entries that the moves change are updated in it before it is
+ * reoptimized, instead of solving every tick from scratch. Independent ticks
+ * and independent scenarios can also be solved on several threads, and a 
+ * trace can be read from a file while it is being solved.
+ */
+
+#ifndef DYNAMICSIMULATION_H
+#define DYNAMICSIMULATION_H
+
+#include <vector>
+#include "HetNetModel.h"
+#include "LPSolution.h"
+#include "Simplex.h"
+#include "SparseLP.h"
+#include "Tick.h"
+#include "TickQueue.h"
+#include "TraceReader.h"
+
+class DynamicSimulation {
+    private:
+        /** The scene being simulated. */
+        HetNetModel* model;
+        /** Whether to reoptimize the previous table or solve from scratch. */
+        bool warmStart;
+        /** The table of the last solve, or 0 if there is none. */
+        Simplex* simplex;
+        /** The limits of each tick's solve, or 0 for none. */
+        SolveBudget* budget;
+        /** The bytes the table was admitted with by the Solver's memory
+         * limit (see Solver::acquireMemory()), or 0. */
+        unsigned long long heldBytes;
+        /** The problem the table was built from. */
+        SparseLP lp;
+
+        /*
+         * Every device-network pair that has ever been in range since the 
+         * table was built has a slot: a column of the table and its 
+         * r_ua <= r_ua,max row. The slots of pairs that left range have their
+         * bound set to 0, so they can be reused if the pair comes back.
+         */
+        std::vector<int> slotAp;
+        std::vector<int> slotVar;
+        std::vector<int> slotRow;
+        std::vector<double> slotRate;
+        /** The slots of each device. */
+        std::vector<std::vector<int> > deviceSlots;
+        /** The slot of each of the model's pairs after the last update. */
+        std::vector<int> pairSlot;
+        /** The decision variable of z. */
+        int zVar;
+        /** The fairness row of the first device; the others follow it. */
+        int firstFairnessRow;
+        /** The scene's size and throughput weight when the table was built. */
+        int builtAps;
+        int builtDevices;
+        double builtAlpha;
+        /** The number of tables built from scratch so far. */
+        int numRebuilds;
+
+        // Don't implement these, the table cannot be shared.
+        DynamicSimulation(DynamicSimulation const &copy);
+        DynamicSimulation &operator=(DynamicSimulation const &copy);
+
+        LPSolution* rebuild();
+        bool canUpdate();
+        void updateTable();
+        LPSolution* toModelOrder(LPSolution* sol);
+        static void runChunk(HetNetModel* model, std::vector<Tick>* ticks,
+                             int begin, int end,
+                             std::vector<LPSolution*>* results);
+        static void produceTicks(TraceReader* reader, TickQueue* queue);
+        static void solveScenarioRange(std::vector<HetNetModel*>* scenarios,
+                                       int begin, int end,
+                                       std::vector<LPSolution*>* results);
+
+    public:
+        /**
+         * Receives the solution of each tick of a trace read from a file. 
+         * The solution is freed when the callback returns.
+         */
+        typedef void (*TickCallback)(Tick& tick, LPSolution* sol, void* data);
+
+        /** 
+         * The table is rebuilt once it holds this many slots per pair in 
+         * range, so stale slots do not slow every pivot down.
+         */
+        static const int MAX_SLOTS_PER_PAIR = 2;
+
+        DynamicSimulation(HetNetModel* model);
+        ~DynamicSimulation();
+        void setWarmStart(bool warmStart);
+        void setBudget(SolveBudget* budget);
+        bool applyTick(Tick& tick);
+        LPSolution* solve();
+        LPSolution* step(Tick& tick);
+        int getNumRebuilds();
+        int runTrace(TraceReader* reader, TickCallback callback, void* data,
+                     int queueCapacity);
+        static int defaultThreads();
+        static std::vector<LPSolution*> run(HetNetModel* model,
+                                            std::vector<Tick>& ticks,
+                                            int numThreads);
+        static std::vector<LPSolution*> solveScenarios(
+                std::vector<HetNetModel*>& scenarios, int numThreads);
+};
+
+#endif
@@ -0,0 +1,56 @@
+/**
+ * This class solves a HetNet scene as a sequence of maximum flow problems
+ * instead of a linear program. The rates form a flow from a source through
+ * each device u, along each of its pairs (capacity r_ua,max) and each access
+ * point a (capacity r_a,max) to a sink. For a fixed z, the best throughput
+ * T(z) is the largest such flow that gives every device at least z, which
+ * MaxFlow finds in two stages: first with the source edges capped at z,
+ * which must all fill up for z to be feasible, and then, with that flow
+ * fixed, with the caps lifted.
+ *
+ * The objective alpha * T(z) + beta * sumRuaMax * z is concave in z, since
+ * T(z) is the value of a linear program whose right hand side depends
+ * linearly on z. The largest feasible z is found by bisection and the best
+ * z below it by golden section search, so the whole solve takes about a
+ * hundred maximum flows, each far cheaper than pivoting the full table.
+ *
+ * The answer is laid out like that of Simplex on the problem built by
+ * HetNetModel::buildLP(): one rate per pair followed by z. Its objective
+ * value matches up to SEARCH_TOLERANCE, though the rates may be another of
+ * several optimal assignments. The weights must not be negative.
+ */
+
+#ifndef HETNETFLOW_H
+#define HETNETFLOW_H
+
+#include <vector>
+#include "HetNetModel.h"
+#include "LPSolution.h"
+#include "Solve.h"
+
+class HetNetFlow : public Solve {
+    private:
+        /** The scene being solved. */
+        HetNetModel* model;
+        /** The number of maximum flows the last solve took. */
+        int numFlows;
+
+        // Don't implement these, the scene is shared by pointer.
+        HetNetFlow(HetNetFlow const &copy);
+        HetNetFlow &operator=(HetNetFlow const &copy);
+
+        double maxThroughput(double z, std::vector<double>& rates);
+
+    public:
+        /** Searches for z stop once its interval is narrower than this
+         * fraction of the largest feasible z. */
+        static constexpr double SEARCH_TOLERANCE = 1e-10;
+        /** Upper limit on the steps of each search. */
+        static const int MAX_STEPS = 200;
+
+        HetNetFlow(HetNetModel* model);
+        LPSolution* solve();
+        int getNumFlows();
+};
+
+#endif
@@ -0,0 +1,91 @@
+/**
+ * This class represents a Heterogeneous Network scene: a set of access points
+ * (networks) and a set of devices, along with the user's throughput and
+ * fairness weights. It computes the maximum achievable rate r_ua,max of every
+ * device-network pair using the free space model described in
+ * doc/MathematicalModel.tex and assembles the optimization problem directly
+ * as a SparseLP, so the web front-end only needs to send the scene itself.
+ *
+ * The generated problem has one column r_ua for every device-network pair
+ * that is in range, followed by the fairness variable z. Its rows are, in
+ * order: one capacity row per access point, one r_ua <= r_ua,max row per
+ * pair, and one z <= r_u row per device.
+ */
+
+#ifndef HETNETMODEL_H
+#define HETNETMODEL_H
+
+#include <string>
+#include <vector>
+#include "SparseLP.h"
+#include "LPSolution.h"
+#include "CoverageGrid.h"
+
+class HetNetModel {
+    private:
+        /** Access point (network) centers, radii and maximum rates. */
+        std::vector<double> apX;
+        std::vector<double> apY;
+        std::vector<double> apRadius;
+        std::vector<double> apMaxRate;
+        /** Device positions. */
+        std::vector<double> deviceX;
+        std::vector<double> deviceY;
+        /** Weight of aggregate throughput in the objective. */
+        double alpha;
+        /** Weight of fairness in the objective. */
+        double beta;
+
+        /** True when the pairs below must be recomputed for every device. */
+        bool pairsDirty;
+        /** Devices that moved since the pairs were last computed. */
+        std::vector<int> movedDevices;
+        std::vector<bool> deviceMoved;
+        /** The device and access point of each in-range pair, device-major. */
+        std::vector<int> pairDevice;
+        std::vector<int> pairAp;
+        /** r_ua,max of each pair. */
+        std::vector<double> pairRate;
+        /** Index of the first pair of each device; has numDevices + 1 entries. */
+        std::vector<int> devicePairStart;
+        /** Sum of r_ua,max over every pair. */
+        double sumRuaMax;
+        /** Spatial index over the coverage circles of the access points. */
+        CoverageGrid grid;
+
+        void computePairs();
+        void updatePairs();
+        void updateMovedDevices();
+        void addDevicePairs(int device);
+
+    public:
+        HetNetModel();
+        HetNetModel(std::string& scene);
+        int addAccessPoint(double x, double y, double radius, double maxRate);
+        int addDevice(double x, double y);
+        bool moveDevice(int device, double x, double y);
+        double getDeviceX(int device);
+        double getDeviceY(int device);
+        void setAlpha(double alpha);
+        void setBeta(double beta);
+        double getAlpha();
+        double getBeta();
+        int getNumAccessPoints();
+        double getAccessPointX(int ap);
+        double getAccessPointY(int ap);
+        double getAccessPointRadius(int ap);
+        double getAccessPointRate(int ap);
+        int getNumDevices();
+        int getNumPairs();
+        int getPairDevice(int pair);
+        int getPairAccessPoint(int pair);
+        double getPairRate(int pair);
+        double getSumRuaMax();
+        int getZColumn();
+        static double maxAchievableRate(double distance, double radius,
+                                        double maxRate);
+        void buildLP(SparseLP* lp);
+        std::vector<double> expandSolution(LPSolution* sol);
+};
+
+#endif
@@ -10,6 +10,7 @@
 #define LPSOLUTION_H
 
 #include <vector>
+#include "SolveStats.h"
 
 /**
  * This class will represent a linear program solution.
@@ -25,6 +26,21 @@ class LPSolution {
         double* optimalValues; // the optimal values for the decision variables
         int numOptimalValues; // the size of optimalValues
         double zValue; // optimal value of the objective equation
+        double gap; // relative distance from zValue to the dual bound
+        /*
+         * Sensitivity analysis, filled in by Simplex::computeSensitivity():
+         * the dual value and right hand side range of each constraint row,
+         * and the reduced cost and objective coefficient range of each 
+         * decision variable. Empty unless it was asked for.
+         */
+        std::vector<double> duals;
+        std::vector<double> rhsLower;
+        std::vector<double> rhsUpper;
+        std::vector<double> reducedCosts;
+        std::vector<double> costLower;
+        std::vector<double> costUpper;
+        /* How the solution was found, and how long it took. */
+        SolveStats stats;
     public:
         /* These constants represent appropriate error codes. Any but 0 indicate
          * an error. */
@@ -41,6 +57,14 @@ class LPSolution {
         static const int EXCEEDED_MAX_ITERATIONS = 300;
         /** The Linear Program is not feasible.*/
         static const int INFEASIBLE = 400;
+        /** The solve ran out of time or iterations, or was cancelled (see
+         * SolveBudget). The optimal values, if set, are the best feasible
+         * point found before it stopped. */
+        static const int TIMED_OUT = 500;
+        /** The solve was turned away because its tables would need more
+         * memory than the Solver allows (see Solver::setMemoryLimit()). 
+         * Nothing was solved. */
+        static const int REJECTED = 600;
 
         LPSolution();
         ~LPSolution();
@@ -52,6 +76,16 @@ class LPSolution {
         void setNumOptimalValues(int numOptimalValues);
         void setZValue(double zValue);
         double getZValue();
+        void setGap(double gap);
+        double getGap();
+        bool hasSensitivity();
+        std::vector<double>& getDuals();
+        std::vector<double>& getRhsLower();
+        std::vector<double>& getRhsUpper();
+        std::vector<double>& getReducedCosts();
+        std::vector<double>& getCostLower();
+        std::vector<double>& getCostUpper();
+        SolveStats& getStats();
 
 };
 
@@ -0,0 +1,59 @@
+/**
+ * This class holds a dense table in a memory-mapped temporary file instead
+ * of on the heap, so the simplex method can solve problems whose table is
+ * larger than memory (see Simplex::setMappedStorage()). The file is
+ * removed as soon as it is made, so nothing is left behind even if the
+ * process is killed, and space for the whole table is reserved on disk up
+ * front, so running out of it fails here rather than halfway through a
+ * solve.
+ *
+ * The rows lie one after another in the file and are reached through the
+ * same array of row pointers arrayInit2d() gives, so code that works on a
+ * table does not need to know where it is stored. The kernel pages the
+ * rows in as they are touched and may write them back and drop them under
+ * memory pressure, which is what lets the table outgrow memory. It is told
+ * the table is swept in order, and code that sweeps it, such as
+ * Simplex::pivot(), works through it in panels of rows and asks for the
+ * next panel before it starts on the current one (see willNeed()), so the
+ * disk reads ahead of the arithmetic.
+ */
+
+#ifndef MAPPEDTABLE_H
+#define MAPPEDTABLE_H
+
+#include <string>
+
+class MappedTable {
+    public:
+        /** The default bytes of a panel of rows. */
+        static const unsigned long long DEFAULT_PANEL_BYTES = 4 << 20;
+
+    private:
+        /** The mapping, or 0, and its length in bytes. */
+        void* data;
+        unsigned long long length;
+        /** A pointer to the start of each row inside the mapping. */
+        double** rows;
+        unsigned long long numRows;
+        unsigned long long numCols;
+        /** The rows of a panel. */
+        int panelRows;
+        std::string error;
+
+        // Don't implement these, the mapping cannot be shared.
+        MappedTable(MappedTable const &copy);
+        MappedTable &operator=(MappedTable const &copy);
+
+    public:
+        MappedTable(std::string directory, unsigned long long inNumRows,
+                    unsigned long long inNumCols,
+                    unsigned long long panelBytes);
+        ~MappedTable();
+        bool isOpen();
+        std::string& getError();
+        double** getRows();
+        int getPanelRows();
+        void willNeed(unsigned long long firstRow, unsigned long long count);
+};
+
+#endif
@@ -0,0 +1,50 @@
+/**
+ * This class finds a maximum flow through a network of capacitated edges
+ * with the FIFO push-relabel method. Nodes are numbered from 0; every edge
+ * added is stored with its reverse, so an edge and its residual partner are
+ * the indices e and e ^ 1.
+ *
+ * solve() starts from whatever flow the network already carries, so a flow
+ * can be grown in stages: solve, raise capacities or add edges, and solve
+ * again. fixFlow() keeps the flow on an edge from being pushed back, which
+ * turns the flow already on it into a lower bound for the later stages.
+ */
+
+#ifndef MAXFLOW_H
+#define MAXFLOW_H
+
+#include <vector>
+
+class MaxFlow {
+    private:
+        /** The head, capacity and residual capacity of every edge. */
+        std::vector<int> edgeTo;
+        std::vector<double> capacity;
+        std::vector<double> residual;
+        /** The edges leaving each node. */
+        std::vector<std::vector<int> > adjacent;
+        /** Flow into each node not yet passed on; the sink's is the flow. */
+        std::vector<double> excess;
+        /** The distance label of each node. */
+        std::vector<int> height;
+        /** The next edge each node will try to push along. */
+        std::vector<int> current;
+        /** Amounts of flow at or below this are treated as 0. */
+        double tolerance;
+
+        void globalRelabel(int source, int sink);
+        void push(int from, int edge, double amount);
+
+    public:
+        /** Amounts of flow below this fraction of the largest capacity are
+         * treated as 0. */
+        static constexpr double FLOW_TOLERANCE = 1e-12;
+
+        MaxFlow(int numNodes);
+        int addEdge(int from, int to, double capacity);
+        double getFlow(int edge);
+        void fixFlow(int edge);
+        double solve(int source, int sink);
+};
+
+#endif
@@ -0,0 +1,43 @@
+/**
+ * This class admits solves by the memory their tables are predicted to
+ * need (see Simplex::predictPeakBytes()), so the solves running at once in
+ * a process never hold more than a set number of bytes between them. A
+ * solve that does not fit right now waits, up to a timeout, for others to
+ * release their memory; one that would not fit even alone is turned away
+ * at once, so the caller can pick a leaner engine or reject it, instead of
+ * the process being killed for running out of memory halfway through.
+ *
+ * A gate with a capacity of 0 admits everything without waiting.
+ */
+
+#ifndef MEMORYGATE_H
+#define MEMORYGATE_H
+
+#include <condition_variable>
+#include <mutex>
+
+class MemoryGate {
+    private:
+        std::mutex lock;
+        /** Signalled whenever memory is released. */
+        std::condition_variable released;
+        /** The bytes admitted solves may hold at once, or 0 for no limit. */
+        unsigned long long capacity;
+        /** The bytes held by the solves admitted now. */
+        unsigned long long used;
+
+        // Don't implement these, a gate is shared by the solves it admits.
+        MemoryGate(MemoryGate const &copy);
+        MemoryGate &operator=(MemoryGate const &copy);
+
+    public:
+        MemoryGate();
+        void setCapacity(unsigned long long capacity);
+        unsigned long long getCapacity();
+        unsigned long long getUsed();
+        bool fits(unsigned long long bytes);
+        bool acquire(unsigned long long bytes, double timeout);
+        void release(unsigned long long bytes);
+};
+
+#endif
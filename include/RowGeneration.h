@@ -0,0 +1,69 @@
+/**
+ * This class solves a HetNet scene by generating the fairness rows 
+ * z <= r_u lazily. At the optimum only the devices with the lowest rates
+ * hold z down, so most fairness rows are slack, yet each one costs a row of
+ * the table in every pivot. Instead, the problem starts out with the 
+ * fairness row of the device that can get the least rate, which is enough
+ * to keep z bounded. After each solve, the rate of every device is checked
+ * against z in a single pass over the pairs. Rate is first shifted at each
+ * access point from devices above z to devices below it, which keeps the 
+ * objective value; the rows of the devices that still fall furthest short
+ * are added and the table is reoptimized with the dual
+ * simplex method, until no device falls short. That solution is optimal for the 
+ * whole scene.
+ */
+
+#ifndef ROWGENERATION_H
+#define ROWGENERATION_H
+
+#include <vector>
+#include "HetNetModel.h"
+#include "LPSolution.h"
+#include "Simplex.h"
+#include "SparseLP.h"
+
+class RowGeneration {
+    private:
+        /** The scene being solved. */
+        HetNetModel* model;
+        /** The problem with the active fairness rows, and its table. */
+        SparseLP lp;
+        Simplex* simplex;
+        /** The limits of the table's solves, or 0 for none. */
+        SolveBudget* budget;
+        /** The pairs of each access point. */
+        std::vector<std::vector<int> > apPairs;
+        /** Whether each device's fairness row is in the table. */
+        std::vector<bool> active;
+        /** The number of fairness rows in the table. */
+        int numActive;
+        /** The number of rounds of the last solve. */
+        int numRounds;
+
+        // Don't implement these, the table cannot be shared.
+        RowGeneration(RowGeneration const &copy);
+        RowGeneration &operator=(RowGeneration const &copy);
+
+        void buildProblem();
+        void sumRates(double* values, std::vector<double>& rate,
+                      std::vector<int>& deviceStart);
+        int addViolatedRows(LPSolution* sol);
+        void lowerZ(LPSolution* sol);
+        void repair(double* values, std::vector<double>& rate,
+                    std::vector<int>& deviceStart, double z);
+
+    public:
+        /** Upper limit on the number of rounds. */
+        static const int MAX_ROUNDS = 1000;
+        /** The fewest violated rows added in a round, if there are enough. */
+        static const int MIN_ROWS_PER_ROUND = 8;
+
+        RowGeneration(HetNetModel* model);
+        ~RowGeneration();
+        void setBudget(SolveBudget* budget);
+        LPSolution* solve();
+        int getNumActiveRows();
+        int getNumRounds();
+};
+
+#endif
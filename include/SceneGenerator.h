@@ -0,0 +1,55 @@
+/**
+ * This class generates random HetNet scenes of a chosen size, for
+ * benchmarks and tests. The scenes come from a seeded Mersenne Twister and
+ * its raw output is mapped to doubles here rather than by the standard
+ * distributions, whose algorithms are left to the library, so a seed gives
+ * the same scene on every platform and a benchmark can be rerun against a
+ * baseline.
+ *
+ * Access points are spread uniformly over a square, with radii and maximum
+ * rates drawn uniformly from their ranges. The side of the square follows
+ * from the overlap density: the average number of access points covering a
+ * point of it, ignoring its edges. Each device is placed uniformly in the
+ * coverage circle of an access point picked at random, so every device is
+ * in range of at least one network and z is not forced to 0.
+ */
+
+#ifndef SCENEGENERATOR_H
+#define SCENEGENERATOR_H
+
+#include <random>
+#include <string>
+
+class SceneGenerator {
+    private:
+        /** The source of every random number. */
+        std::mt19937 engine;
+        /** The size of the scenes. */
+        int numDevices;
+        int numAccessPoints;
+        /** The ranges that radii and r_a,max are drawn from. */
+        double minRadius;
+        double maxRadius;
+        double minRate;
+        double maxRate;
+        /** The average number of access points covering a point. */
+        double overlap;
+        /** The weights of throughput and fairness. */
+        double alpha;
+        double beta;
+
+        double uniform(double low, double high);
+
+    public:
+        SceneGenerator(unsigned int seed);
+        void setNumDevices(int numDevices);
+        void setNumAccessPoints(int numAccessPoints);
+        void setRadii(double minRadius, double maxRadius);
+        void setRates(double minRate, double maxRate);
+        void setOverlap(double overlap);
+        void setWeights(double alpha, double beta);
+        double getSide();
+        std::string generate();
+};
+
+#endif
@@ -12,6 +12,11 @@
 #define SIMPLEX_H
 #include "Solve.h"
 #include "utils.h"
+#include "SparseLP.h"
+#include "SimplexPolicies.h"
+#include "SolveBudget.h"
+#include "AllocationCounter.h"
+#include "MappedTable.h"
 #include "float.h"
 #include <cmath>
 #include <iostream>
@@ -22,6 +27,25 @@
 #include <string.h>
 #include <cstdio>
 #include <sstream>
+#include <vector>
+#include <algorithm>
+#include <chrono>
+
+#ifdef PIVOT_HOOKS
+/**
+ * Called around every pivot of a Simplex it is given to, so the bench can
+ * count pivots and read hardware counters around them alone. It only
+ * exists when the library is compiled with -DPIVOT_HOOKS, as the bench 
+ * target of the makefile does, so ordinary builds pay nothing for it.
+ */
+class PivotHook
+{
+    public:
+        virtual ~PivotHook() {}
+        virtual void beforePivot() = 0;
+        virtual void afterPivot() = 0;
+};
+#endif
 
 class Simplex : public Solve 
 {
@@ -40,26 +64,168 @@ class Simplex : public Solve
         int numRows;
         /** Number of columns. */ 
         int numCols;
+        /** Rows and columns allocated for the table, so it can grow. */
+        int rowCapacity;
+        int colCapacity;
+        /** The basic column of each constraint row of the table. */
+        std::vector<int> basis;
+        /** The original right hand side of each row. */
+        std::vector<double> rowRhs;
+        /** The original objective coefficient of each decision variable. */
+        std::vector<double> varCost;
+        /** The limits on the current solve, or 0 for none. */
+        SolveBudget* budget;
+        /** Pivots taken by the current solve, in every phase. */
+        unsigned long long iterations;
+        /** True if the current solve ran out of budget. */
+        bool timedOut;
+        /** Pivots of the current solve that did not move the solution. */
+        unsigned long long degeneratePivots;
+        /** Pivots and seconds the last solve spent finding a feasible 
+         * basis, and seconds spent optimizing from it. */
+        unsigned long long phaseOneIterations;
+        double phaseOneTime;
+        double phaseTwoTime;
+        /** Seconds the constructor spent building the table. */
+        double buildTime;
+        /** The most bytes the table and Phase I's table held at once. */
+        unsigned long long peakTableBytes;
+        /** Heap allocations, and their bytes, of the build and of each 
+         * phase of the last solve, indexed by SolveStats stage. */
+        unsigned long long allocations[SolveStats::NUM_STAGES];
+        unsigned long long allocatedBytes[SolveStats::NUM_STAGES];
+        /** Whether to use the Harris ratio test or the textbook one. */
+        bool harris;
+        /** Whether solve() perturbs the right hand sides. */
+        bool perturb;
+        /** Relative gap at which Phase II may stop, or 0 to solve exactly. */
+        double gapTolerance;
+        /** Whether Phase I's table is kept for the next solve. */
+        bool keepWorkspace;
+        /** Phase I's table while it is kept, or 0, and the rows and 
+         * columns allocated for it. */
+        double** relatedTable;
+        int relatedRowCapacity;
+        int relatedColCapacity;
+        /** The files the table and Phase I's table are mapped from, or 0
+         * when they are on the heap (see setMappedStorage()). */
+        MappedTable* mappedTable;
+        MappedTable* mappedRelatedTable;
+        /** Phase I's rows with an artificial variable, basis and solution,
+         * kept so that repeated solves reuse them. */
+        std::vector<int> artificialRows;
+        std::vector<int> relatedBasis;
+        LPSolution relatedSol;
+        /** 
+         * An upper bound on every column, decision variables then slacks,
+         * implied by the rows of the problem solve() started from. Empty 
+         * when there is none, or after the problem was modified.
+         */
+        std::vector<double> upperBound;
+
+#ifdef PIVOT_HOOKS
+        /** Called around every pivot, or 0. */
+        PivotHook* pivotHook;
+#endif
+
+        // Don't implement these, the table cannot be shared.
+        Simplex(Simplex const &copy);
+        Simplex &operator=(Simplex const &copy);
    protected: 
-        unsigned long long choose(int n, int k);
-        unsigned long long gcd(unsigned long long x, unsigned long long y);
         void tokenizeToMatrix(LinkedList<std::string>* list, int start);
         virtual void displayMatrix(double** matrix, int x, int y);
         void lpToTable (LinearProgram* lp);
-        void pivot(double** table, int pivotRow, int pivotCol, int numRows, int numCols);
+        void pivot(double** table, int pivotRow, int pivotCol, int numRows,
+                   int numCols);
         bool checkFeasibility ();
-        void optimize(double** table, LPSolution* sol, int curRows, int curCols, int); 
+        bool isEqualitySlack(int col);
+        void optimize(double** table, int* basis, LPSolution* sol, int curRows,
+                      int curCols, int constraintRows);
+        void initState();
+        void reserveTable(int rows, int cols);
+        void shiftColumnCost(int col, double delta);
+        int restoreFeasibility();
+        int dualSimplex();
         bool isTwoPhase();
+        bool budgetExhausted();
+        int ratioTest(double** table, int pivotCol, int curCols,
+                      int constraintRows);
+        void optimizePerturbed(LPSolution* sol);
+        void computeUpperBounds();
+        double computeGap();
+        void directionalCosts(const double* direction,
+                              std::vector<double>& costs);
+        int crash(const double* point);
+        void recordStats(LPSolution* sol);
+        void countAllocations(int stage, AllocationCounter& counter);
+        void fillTable(SparseLP* lp);
+        void reserveRelatedTable(int rows, int cols);
+        double** allocateTable(int rows, int cols, MappedTable** mapped);
+        void freeTable(double** rows, int numRows, MappedTable** mapped);
         
     public:
         /**
          * Attempt to prevent rounding error for zero. May need to be reduced
-         * in the future to improve precision.
+         * in the future to improve precision. It is the one BasicSimplex
+         * uses for double (see ScalarTraits).
+         */
+        static constexpr double ZERO_TOLERANCE = ScalarTraits<double>::zero();
+        /** Pivots allowed per row and column of the table in each phase
+         * before a solve gives up with 
+         * LPSolution::EXCEEDED_MAX_ITERATIONS. */
+        static const int PIVOTS_PER_LINE = 50;
+        /** 
+         * How far below 0 the Harris ratio test lets a basic variable go
+         * while it looks for a larger pivot, also taken from ScalarTraits.
          */
-        static constexpr double ZERO_TOLERANCE = 0.0001;
+        static constexpr double FEASIBILITY_TOLERANCE =
+            ScalarTraits<double>::feasibility();
+        /** Size of the right hand side perturbation, relative to the 
+         * largest right hand side. */
+        static constexpr double PERTURBATION = 1e-5;
+        /** Passes over the rows when deriving implied upper bounds. */
+        static const int BOUND_PASSES = 3;
         
         Simplex(LinearProgram* lp);
+        Simplex(SparseLP* lp);
+        virtual ~Simplex();
         virtual LPSolution* solve();
+        LPSolution* solveFrom(const double* point);
+        void solveInto(LPSolution* sol);
+        void load(SparseLP* lp);
+        void setKeepWorkspace(bool keep);
+        void setBudget(SolveBudget* budget);
+        unsigned long long getIterations();
+        unsigned long long getDegeneratePivots();
+        void setHarrisRatioTest(bool harris);
+        void setPerturbation(bool perturb);
+        void setGapTolerance(double gapTolerance);
+        std::vector<int> getBasis();
+        int getNumDecisionVars();
+        int getNumConstraints();
+        double getDual(int row);
+        double getReducedCost(int var);
+        void computeSensitivity(LPSolution* sol);
+        void changeRhs(int row, double rhs);
+        void changeObjective(int var, double cost);
+        int addColumns(int count, const double* costs, const int* colStart,
+                       const int* rowIndex, const double* values);
+        int addRow(int count, const int* vars, const double* values, double rhs);
+        LPSolution* reoptimize();
+        double getObjectiveRange(const double* direction);
+        bool pivotTowards(const double* direction);
+        static unsigned long long predictPeakBytes(int numConstraints,
+                                                   int numDecisionVars,
+                                                   int numArtificial);
+        static unsigned long long predictPeakBytes(LinearProgram* lp);
+        static unsigned long long predictPeakBytes(SparseLP* lp);
+        static void setMappedStorage(std::string directory,
+                                     unsigned long long minBytes,
+                                     unsigned long long panelBytes);
+        bool isTableMapped();
+#ifdef PIVOT_HOOKS
+        void setPivotHook(PivotHook* hook);
+#endif
 };
 
 #endif
@@ -0,0 +1,196 @@
+/**
+ * The scalar tolerances, pricing rules and ratio tests BasicSimplex is
+ * compiled with. Each policy is a class of static inline functions, so the
+ * loops of BasicSimplex that call them are compiled with the rule in
+ * place, with no virtual call or flag test per pivot.
+ *
+ * A pricing rule chooses the column that enters the basis from the
+ * objective row, where a positive entry means the objective grows if the
+ * column enters. A ratio test chooses the row that leaves the basis, so
+ * that the right hand sides stay nonnegative.
+ */
+
+#ifndef SIMPLEXPOLICIES_H
+#define SIMPLEXPOLICIES_H
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+/**
+ * The tolerances of a scalar type. Simplex takes its ZERO_TOLERANCE and
+ * FEASIBILITY_TOLERANCE from those of double, so both engines agree on 
+ * them; float has about 7 significant digits, so it needs looser ones, and
+ * long double can afford a tighter feasibility tolerance.
+ */
+template <typename Scalar>
+struct ScalarTraits;
+
+template <>
+struct ScalarTraits<float>
+{
+    static constexpr float zero() { return 1e-3f; }
+    static constexpr float feasibility() { return 1e-4f; }
+    static const char* name() { return "float"; }
+};
+
+template <>
+struct ScalarTraits<double>
+{
+    static constexpr double zero() { return 1e-4; }
+    static constexpr double feasibility() { return 1e-7; }
+    static const char* name() { return "double"; }
+};
+
+template <>
+struct ScalarTraits<long double>
+{
+    static constexpr long double zero() { return 1e-4L; }
+    static constexpr long double feasibility() { return 1e-10L; }
+    static const char* name() { return "long double"; }
+};
+
+/**
+ * Dantzig's rule, as Simplex uses: the column with the largest objective
+ * entry, which usually takes the fewest pivots.
+ */
+struct DantzigPricing
+{
+    static const char* name() { return "dantzig"; }
+
+    /**
+     * Param: objective - the objective row.
+     * Param: eligible - whether each column may enter.
+     * Param: numCols - the columns to choose from.
+     * Return: The column, or -1 if none has an entry above the tolerance.
+     */
+    template <typename Scalar>
+    static int choose(const Scalar* objective, const bool* eligible,
+                      int numCols)
+    {
+        int pivotCol = -1;
+        Scalar maxCoeff = ScalarTraits<Scalar>::zero();
+        for (int col = 0; col < numCols; col++)
+        {
+            if (objective[col] > maxCoeff && eligible[col])
+            {
+                maxCoeff = objective[col];
+                pivotCol = col;
+            }
+        }
+        return pivotCol;
+    }
+};
+
+/**
+ * Bland's rule: the first column with a positive objective entry. It
+ * takes more pivots than Dantzig's rule, but never cycles, so it finishes
+ * on degenerate problems where the other may not.
+ */
+struct BlandPricing
+{
+    static const char* name() { return "bland"; }
+
+    /**
+     * See DantzigPricing::choose().
+     */
+    template <typename Scalar>
+    static int choose(const Scalar* objective, const bool* eligible,
+                      int numCols)
+    {
+        for (int col = 0; col < numCols; col++)
+        {
+            if (objective[col] > ScalarTraits<Scalar>::zero() &&
+                eligible[col])
+            {
+                return col;
+            }
+        }
+        return -1;
+    }
+};
+
+/**
+ * The textbook ratio test: the first row with the smallest ratio of right
+ * hand side to pivot column entry.
+ */
+struct TextbookRatioTest
+{
+    static const char* name() { return "textbook"; }
+
+    /**
+     * Param: table - the table.
+     * Param: pivotCol - the entering column.
+     * Param: rhsCol - the right hand side column.
+     * Param: constraintRows - the rows to choose from.
+     * Return: The row, or -1 if the column has no positive entry, which
+     *         means the problem is unbounded.
+     */
+    template <typename Scalar>
+    static int choose(Scalar** table, int pivotCol, int rhsCol,
+                      int constraintRows)
+    {
+        int pivotRow = -1;
+        Scalar minRatio = std::numeric_limits<Scalar>::max();
+        for (int row = 0; row < constraintRows; row++)
+        {
+            if (table[row][pivotCol] > ScalarTraits<Scalar>::zero() &&
+                table[row][rhsCol] / table[row][pivotCol] < minRatio)
+            {
+                minRatio = table[row][rhsCol] / table[row][pivotCol];
+                pivotRow = row;
+            }
+        }
+        return pivotRow;
+    }
+};
+
+/**
+ * The Harris ratio test, as Simplex uses by default: among the rows whose
+ * ratio is within the feasibility tolerance of the smallest, the one with
+ * the largest pivot entry, which keeps the table better conditioned. The
+ * right hand side of the chosen row is clipped to 0 if the tolerance let
+ * it go below.
+ */
+struct HarrisRatioTest
+{
+    static const char* name() { return "harris"; }
+
+    /**
+     * See TextbookRatioTest::choose().
+     */
+    template <typename Scalar>
+    static int choose(Scalar** table, int pivotCol, int rhsCol,
+                      int constraintRows)
+    {
+        Scalar zero = ScalarTraits<Scalar>::zero();
+        Scalar maxStep = std::numeric_limits<Scalar>::max();
+        for (int row = 0; row < constraintRows; row++)
+        {
+            if (table[row][pivotCol] > zero)
+            {
+                maxStep = std::min(maxStep, (table[row][rhsCol] +
+                                   ScalarTraits<Scalar>::feasibility()) /
+                                   table[row][pivotCol]);
+            }
+        }
+        int pivotRow = -1;
+        Scalar maxPivot = zero;
+        for (int row = 0; row < constraintRows; row++)
+        {
+            if (table[row][pivotCol] > maxPivot &&
+                table[row][rhsCol] / table[row][pivotCol] <= maxStep)
+            {
+                maxPivot = table[row][pivotCol];
+                pivotRow = row;
+            }
+        }
+        if (pivotRow >= 0 && table[pivotRow][rhsCol] < 0)
+        {
+            table[pivotRow][rhsCol] = 0;
+        }
+        return pivotRow;
+    }
+};
+
+#endif
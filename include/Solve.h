@@ -16,6 +16,7 @@
 class Solve
 {
     public:
+        virtual ~Solve() {}
         /** This function is intended to be the entry method into our Solve 
          * type.
          */
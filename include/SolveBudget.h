@@ -0,0 +1,43 @@
+/**
+ * This class limits how much work a solve may do: a wall clock deadline, a
+ * cap on the number of pivots and a cancellation flag that another thread
+ * can raise. Simplex checks it once per pivot, which costs a clock read and
+ * two comparisons, far less than the pivot itself. A solve that runs out of
+ * budget stops with LPSolution::TIMED_OUT and the best feasible point it
+ * reached, instead of holding its thread until the problem is solved.
+ *
+ * A budget is only read while solving, apart from cancel(), so one budget
+ * may be shared by solves running on several threads.
+ */
+
+#ifndef SOLVEBUDGET_H
+#define SOLVEBUDGET_H
+
+#include <atomic>
+#include <chrono>
+
+class SolveBudget {
+    private:
+        /** When the solve must stop, if hasDeadline is true. */
+        std::chrono::steady_clock::time_point deadline;
+        bool hasDeadline;
+        /** The most pivots a solve may take, or 0 for no limit. */
+        unsigned long long maxIterations;
+        /** Raised by cancel(). */
+        std::atomic<bool> cancelled;
+
+        // Don't implement these, a budget is shared by pointer.
+        SolveBudget(SolveBudget const &copy);
+        SolveBudget &operator=(SolveBudget const &copy);
+
+    public:
+        SolveBudget();
+        void setTimeLimit(double seconds);
+        void setDeadline(std::chrono::steady_clock::time_point deadline);
+        void setMaxIterations(unsigned long long maxIterations);
+        void cancel();
+        bool isCancelled();
+        bool isExhausted(unsigned long long iterations);
+};
+
+#endif
@@ -0,0 +1,103 @@
+/**
+ * This class holds statistics about how a solution was found, so that a
+ * slow solve can be explained from the logs: the time spent parsing the
+ * problem, building the table and in each phase, the pivots of each phase
+ * and how many of them were degenerate, the most memory the tables held at
+ * once (and what the Solver predicted before admitting it), the shape of
+ * the table, which engine and rules ran and, once the interface has set 
+ * them, the error code and optimality gap of the answer. Collecting
+ * them takes a few clock reads per solve. Every LPSolution carries one;
+ * entries that do not apply to the engine that ran are left at 0. 
+ * Builds that count allocations (see AllocationCounter) also report the
+ * heap allocations and bytes of each stage.
+ */
+
+#ifndef SOLVESTATS_H
+#define SOLVESTATS_H
+
+#include <string>
+
+class SolveStats {
+    public:
+        /** The stages allocations are counted for. */
+        static const int PARSE = 0;
+        static const int BUILD = 1;
+        static const int PHASE_ONE = 2;
+        static const int PHASE_TWO = 3;
+        static const int NUM_STAGES = 4;
+
+    private:
+        /** Seconds spent turning the request into a problem. */
+        double parseTime;
+        /** Seconds spent building the linear program and its table. */
+        double buildTime;
+        /** Pivots and seconds spent finding a feasible basis. */
+        unsigned long long phaseOneIterations;
+        double phaseOneTime;
+        /** Pivots and seconds spent optimizing from it. */
+        unsigned long long phaseTwoIterations;
+        double phaseTwoTime;
+        /** Pivots that did not move the solution. */
+        unsigned long long degeneratePivots;
+        /** The most bytes the simplex tables held at once. */
+        unsigned long long peakTableBytes;
+        /** The peak the Solver predicted before admitting the solve. */
+        unsigned long long predictedTableBytes;
+        /** The constraint rows and variable columns of the problem. */
+        int numRows;
+        int numColumns;
+        /** Heap allocations, and the bytes they asked for, per stage. */
+        unsigned long long allocations[NUM_STAGES];
+        unsigned long long allocatedBytes[NUM_STAGES];
+        /** The engine, and the pricing and ratio test rules it used. */
+        std::string engine;
+        std::string pricing;
+        std::string ratioTest;
+        /** The error code of the solution and the gap it was proved to be
+         * within (see LPSolution::getGap()). */
+        int status;
+        double gap;
+
+    public:
+        SolveStats();
+        double getParseTime();
+        void setParseTime(double parseTime);
+        double getBuildTime();
+        void setBuildTime(double buildTime);
+        unsigned long long getPhaseOneIterations();
+        void setPhaseOneIterations(unsigned long long iterations);
+        double getPhaseOneTime();
+        void setPhaseOneTime(double phaseOneTime);
+        unsigned long long getPhaseTwoIterations();
+        void setPhaseTwoIterations(unsigned long long iterations);
+        double getPhaseTwoTime();
+        void setPhaseTwoTime(double phaseTwoTime);
+        unsigned long long getDegeneratePivots();
+        void setDegeneratePivots(unsigned long long degeneratePivots);
+        unsigned long long getPeakTableBytes();
+        void setPeakTableBytes(unsigned long long peakTableBytes);
+        unsigned long long getPredictedTableBytes();
+        void setPredictedTableBytes(unsigned long long predictedTableBytes);
+        int getNumRows();
+        int getNumColumns();
+        void setShape(int numRows, int numColumns);
+        unsigned long long getAllocations(int stage);
+        unsigned long long getAllocatedBytes(int stage);
+        void setAllocations(int stage, unsigned long long allocations,
+                            unsigned long long bytes);
+        void addAllocations(int stage, unsigned long long allocations,
+                            unsigned long long bytes);
+        std::string& getEngine();
+        void setEngine(std::string engine);
+        std::string& getPricing();
+        void setPricing(std::string pricing);
+        std::string& getRatioTest();
+        void setRatioTest(std::string ratioTest);
+        int getStatus();
+        double getGap();
+        void setResult(int status, double gap);
+        double getTotalTime();
+        std::string toJson();
+};
+
+#endif
@@ -14,15 +14,50 @@
 #ifndef SOLVER_H
 #define SOLVER_H
 #include "LinearProgram.h"
+#include "BetaPath.h"
 #include "LPSolution.h"
+#include "HetNetModel.h"
+#include "CaptureLog.h"
+#include "MemoryGate.h"
+#include "SolveBudget.h"
+#include <mutex>
 #include <sstream>
 #include <vector>
 
 class Solver {
     private:
+        /** Seconds allowed for each solve, or 0 for no limit. */
+        double timeLimit;
+        /** Pivots allowed for each solve, or 0 for no limit. */
+        unsigned long long maxIterations;
+        /** Relative optimality gap accepted by each solve, or 0. */
+        double gapTolerance;
+        /** The log incoming problems are recorded into, or 0. */
+        CaptureLog* captureLog;
+        /** Admits solves by the memory their tables are predicted to need. */
+        MemoryGate gate;
+        /** Seconds a solve may wait for memory before it is rejected. */
+        double queueTimeout;
+        /** Whether scenes start from a basis crashed from WaterFilling. */
+        bool crashStart;
+        /** The scalar type, pricing rule and ratio test of the BasicSimplex
+         * that solves problems (see SimplexVariant), or -1 for Simplex. */
+        int scalar;
+        int pricing;
+        int ratioTest;
+        /** The budgets of the solves running now, which cancel() raises. */
+        std::vector<SolveBudget*> running;
+        std::mutex runningMutex;
+
+        LPSolution* reject(unsigned long long predicted);
+        void startBudget(SolveBudget* budget);
+        void finishBudget(SolveBudget* budget);
+        void writeCapture(CaptureRecord& record);
 
         // Don't implement these, they prevent copies from being made.
-        Solver() {};
+        Solver() : timeLimit(0), maxIterations(0), gapTolerance(0),
+                   captureLog(0), queueTimeout(0), crashStart(false),
+                   scalar(-1), pricing(0), ratioTest(0) {};
         Solver(Solver const &copy);
         Solver &operator=(Solver const &copy);
 
@@ -38,7 +73,31 @@ public:
         static Solver solver;
         return solver;
     }
+    void setTimeLimit(double seconds);
+    void setMaxIterations(unsigned long long maxIterations);
+    bool setGapTolerance(double gapTolerance);
+    void setCaptureLog(CaptureLog* log);
+    void setMemoryLimit(unsigned long long bytes, double queueSeconds);
+    bool setCrashStart(bool crash);
+    bool setScalar(int scalar, int pricing, int ratioTest);
+    void cancel();
+    bool acquireMemory(unsigned long long bytes);
+    void releaseMemory(unsigned long long bytes);
+    void capture(int kind, std::string& problem, LPSolution* sol,
+                 unsigned long long arrival, double seconds);
+    void capture(int kind, std::string& problem, BetaPath* path,
+                 unsigned long long arrival, double seconds);
+    void applySettings(CaptureRecord& record);
+    LinearProgram* parse(std::string& problem);
     LPSolution* solve(std::string& problem);
+    LPSolution* solve(LinearProgram* lp);
+    LPSolution* solve(HetNetModel* model);
+    LPSolution* solveSensitivity(HetNetModel* model);
+    LPSolution* solveColumnGeneration(HetNetModel* model);
+    LPSolution* solveFlow(HetNetModel* model);
+    LPSolution* solveRowGeneration(HetNetModel* model);
+    LPSolution* solveClusters(HetNetModel* model, int mode, int numThreads);
+    BetaPath* solvePath(HetNetModel* model);
 
 };
 
@@ -0,0 +1,58 @@
+/**
+ * This class represents a Linear Program stored numerically in compressed
+ * sparse row form. Unlike LinearProgram, which holds each constraint as a
+ * string of coefficients, a SparseLP only stores the nonzero coefficients of
+ * each row, so it can be generated directly by a model builder without any
+ * string formatting or parsing.
+ */
+
+#ifndef SPARSELP_H
+#define SPARSELP_H
+
+#include <vector>
+
+class SparseLP {
+    private:
+        /** The number of decision variables (columns). */
+        int numVars;
+        /** Objective coefficients, one per decision variable (maximized). */
+        std::vector<double> objective;
+        /** Offset of the first entry of each row. */
+        std::vector<int> rowStart;
+        /** Column of each stored coefficient. */
+        std::vector<int> colIndex;
+        /** Value of each stored coefficient. */
+        std::vector<double> values;
+        /** Right hand side of each row. */
+        std::vector<double> rhs;
+        /** LEQ or EQ for each row. */
+        std::vector<int> rowType;
+        /** Number of rows of each type. */
+        int numLeqRows;
+        int numEqRows;
+
+    public:
+        /** Row types. */
+        static const int LEQ = 0;
+        static const int EQ = 1;
+
+        SparseLP();
+        void clear(int numVars);
+        void setObjective(int col, double value);
+        int addRow(int type, double rhs);
+        void addCoefficient(int col, double value);
+        int getNumVars();
+        int getNumRows();
+        int getNumLeqRows();
+        int getNumEqRows();
+        int getNumNonZeros();
+        double getObjective(int col);
+        int getRowType(int row);
+        double getRhs(int row);
+        int getRowStart(int row);
+        int getRowEnd(int row);
+        int getColIndex(int entry);
+        double getValue(int entry);
+};
+
+#endif
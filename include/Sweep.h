@@ -0,0 +1,77 @@
+/**
+ * This class solves a HetNet scene over a grid of parameters, for capacity
+ * planning: the throughput weight alpha, the fairness weight beta, a factor
+ * that scales the maximum rate r_a,max of a chosen set of access points and
+ * the device density, the fraction of the scene's devices that are present.
+ *
+ * Rather than solving every grid point from scratch, the points are put in
+ * a snake order, where each point differs from the one before it in a
+ * single parameter, and split into one chain per thread. Along a chain,
+ * weights only change objective coefficients and the scale only changes
+ * right hand sides, so each point reoptimizes the table of the one before
+ * it. Only a change of density, which changes the shape of the problem,
+ * builds a new table. Results are streamed to a SweepWriter as they are
+ * found, one row per grid point with the columns in COLUMN_NAMES.
+ */
+
+#ifndef SWEEP_H
+#define SWEEP_H
+
+#include <string>
+#include <vector>
+#include "HetNetModel.h"
+#include "SolveBudget.h"
+#include "SweepWriter.h"
+
+class Sweep {
+    private:
+        /** The scene at density 1 and scale 1. */
+        HetNetModel* scene;
+        /** The values of each parameter. */
+        std::vector<double> densities;
+        std::vector<double> scales;
+        std::vector<double> alphas;
+        std::vector<double> betas;
+        /** True for each access point whose rate is scaled. */
+        std::vector<bool> scaledAps;
+        /** The limits of each point's solve, or 0 for none. */
+        SolveBudget* budget;
+
+        static void setRange(std::vector<double>& values, double from,
+                             double to, int steps);
+        void runChain(int begin, int end, SweepWriter* writer, int* solved);
+        static void runChainThread(Sweep* sweep, int begin, int end,
+                                   SweepWriter* writer, int* solved);
+
+    public:
+        /** Number of columns of every result row. */
+        static const int NUM_COLUMNS = 11;
+        /**
+         * The columns of every result row: the grid point's index in the
+         * grid (density-major, then scale, alpha and beta), its parameters,
+         * the number of devices present, the error code, the objective
+         * value, the aggregate throughput sum(r_ua), the fairness z and
+         * whether the point was reoptimized from its neighbour's table.
+         */
+        static const char* const COLUMN_NAMES[NUM_COLUMNS];
+
+        Sweep(HetNetModel* scene);
+        void setDensities(double from, double to, int steps);
+        void setScales(double from, double to, int steps);
+        void setAlphas(double from, double to, int steps);
+        void setBetas(double from, double to, int steps);
+        void setScaledAccessPoints(const std::vector<int>& aps);
+        void setBudget(SolveBudget* budget);
+        int getNumPoints();
+        int getPoint(int order, int& density, int& scale, int& alpha,
+                     int& beta);
+        double getDensity(int density);
+        double getScale(int scale);
+        double getAlpha(int alpha);
+        double getBeta(int beta);
+        void buildScene(double density, double scale, HetNetModel* out);
+        int run(SweepWriter* writer, int numThreads);
+        int run(std::string path, int numThreads);
+};
+
+#endif
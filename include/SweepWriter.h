@@ -0,0 +1,66 @@
+/**
+ * This class writes the results of a parameter sweep to a columnar file.
+ * Rows are collected into blocks of BLOCK_ROWS rows, and each block is
+ * written one column after the other, so a reader that only needs a few
+ * columns (say throughput and fairness, for a Pareto front) can skip the
+ * rest of each block. Blocks are written as soon as they fill up, so the
+ * memory used does not depend on the size of the sweep.
+ *
+ * The file starts with the 8 byte MAGIC, a 32 bit column count and a
+ * COLUMN_NAME_SIZE byte, zero padded name for every column. Every block is a
+ * 32 bit row count followed by each column's values as doubles. Like binary
+ * traces, numbers are in the byte order of the machine that wrote them.
+ *
+ * Rows may be added from several threads at once.
+ */
+
+#ifndef SWEEPWRITER_H
+#define SWEEPWRITER_H
+
+#include <cstdio>
+#include <mutex>
+#include <string>
+#include <vector>
+
+class SweepWriter {
+    private:
+        /** The open file, or 0. */
+        FILE* file;
+        /** Number of columns of every row. */
+        int numColumns;
+        /** The rows of the current block, column-major. */
+        std::vector<std::vector<double> > block;
+        /** Number of rows in the current block. */
+        int blockRows;
+        /** Number of rows written or buffered since open(). */
+        long long numRows;
+        /** True if a write failed. */
+        bool error;
+        std::mutex lock;
+
+        void flush();
+
+        // Don't implement these, the file cannot be shared.
+        SweepWriter(SweepWriter const &copy);
+        SweepWriter &operator=(SweepWriter const &copy);
+
+    public:
+        /** Marks the start of a sweep file. */
+        static const char MAGIC[8];
+        /** Bytes stored for each column name. */
+        static const int COLUMN_NAME_SIZE = 16;
+        /** Number of rows per block. */
+        static const int BLOCK_ROWS = 1024;
+
+        SweepWriter();
+        ~SweepWriter();
+        bool open(std::string path, const std::vector<std::string>& names);
+        void addRow(const double* row);
+        bool close();
+        long long getNumRows();
+        bool hasError();
+        static bool read(std::string path, std::vector<std::string>& names,
+                         std::vector<std::vector<double> >& columns);
+};
+
+#endif
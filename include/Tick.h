@@ -0,0 +1,28 @@
+/**
+ * This class represents one time step of a dynamic simulation: the new
+ * positions of the devices that moved during the step. Devices that are not
+ * listed stay where they were.
+ */
+
+#ifndef TICK_H
+#define TICK_H
+
+#include <vector>
+
+class Tick {
+    public:
+        /** Time of the step, in the units of the trace it came from. */
+        double time;
+        /** The devices that moved and their new positions. */
+        std::vector<int> devices;
+        std::vector<double> x;
+        std::vector<double> y;
+
+        Tick();
+        Tick(double time);
+        void addMove(int device, double x, double y);
+        int getNumMoves();
+        void clear();
+};
+
+#endif
@@ -0,0 +1,38 @@
+/**
+ * This class is a bounded, blocking queue of Ticks shared by two threads: a 
+ * producer that reads a trace and a consumer that solves it. The producer 
+ * waits when the queue is full, so only a few ticks are ever held in memory
+ * however long the trace is.
+ */
+
+#ifndef TICKQUEUE_H
+#define TICKQUEUE_H
+
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include "Tick.h"
+
+class TickQueue {
+    private:
+        /** The ticks waiting to be consumed. */
+        std::deque<Tick> ticks;
+        /** The largest number of ticks held at once. */
+        size_t capacity;
+        /** True once the producer has no more ticks. */
+        bool closed;
+        std::mutex lock;
+        std::condition_variable notFull;
+        std::condition_variable notEmpty;
+
+    public:
+        /** Default number of ticks held at once. */
+        static const int DEFAULT_CAPACITY = 8;
+
+        TickQueue(int capacity);
+        void push(Tick& tick);
+        bool pop(Tick& tick);
+        void close();
+};
+
+#endif
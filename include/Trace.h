@@ -0,0 +1,109 @@
+/**
+ * Trace points for seeing where the time of a single slow solve goes: the
+ * phases of the simplex method, each pivot and the threads they ran on.
+ *
+ * A trace point is written as TRACE_SCOPE(name, ...) at the top of a
+ * block, with up to two named integer arguments, and records the block as
+ * one event when it is left. Unless the library is compiled with
+ * -DSOLVER_TRACE (the TRACE variable of the makefile) the macro expands to
+ * nothing, so ordinary builds pay nothing for it.
+ *
+ * Every thread records into a ring buffer of its own, holding its last
+ * TraceBuffer::CAPACITY events, so recording takes two clock reads, a copy
+ * and two atomic stores, with no locks and no allocation after the 
+ * thread's first event. Trace::toJson() gathers the buffers of every 
+ * thread into the Chrome trace event format, which chrome://tracing and
+ * Perfetto (ui.perfetto.dev) display as one timeline per thread.
+ */
+
+#ifndef TRACE_H
+#define TRACE_H
+
+#include <atomic>
+#include <string>
+#include <vector>
+
+/**
+ * One traced block: when it began and how long it took, in nanoseconds of
+ * the steady clock, with up to two named arguments. Names are string
+ * literals, so only their pointers are stored.
+ */
+struct TraceEvent {
+    const char* name;
+    const char* argNames[2];
+    long long args[2];
+    unsigned long long begin;
+    unsigned long long duration;
+    int thread;
+};
+
+class TraceBuffer {
+    public:
+        /** The number of events kept; older ones are overwritten. */
+        static constexpr unsigned long long CAPACITY = 1 << 15;
+
+    private:
+        TraceEvent* events;
+        /** The number of events ever recorded, published after each. */
+        std::atomic<unsigned long long> count;
+        /** The count as it will be once the event being recorded is. */
+        std::atomic<unsigned long long> reserved;
+        /** The count at the last clear(); older events are not reported. */
+        std::atomic<unsigned long long> cleared;
+        /** The thread that records into the buffer, or -1 if none does. */
+        int thread;
+
+        // Don't implement these, buffers are shared by pointer.
+        TraceBuffer(TraceBuffer const &copy);
+        TraceBuffer &operator=(TraceBuffer const &copy);
+
+    public:
+        TraceBuffer();
+        ~TraceBuffer();
+        int getThread();
+        void setThread(int thread);
+        void record(const TraceEvent& event);
+        void copyEvents(std::vector<TraceEvent>& out);
+        void clear();
+};
+
+class Trace {
+    public:
+        static unsigned long long now();
+        static TraceBuffer* getBuffer();
+        static std::vector<TraceEvent> getEvents();
+        static std::string toJson();
+        static bool writeJson(std::string path);
+        static void clear();
+};
+
+/**
+ * Records the block it is declared in as one event when it goes out of
+ * scope. Use it through TRACE_SCOPE, so it can be compiled out.
+ */
+class TraceScope {
+    private:
+        TraceEvent event;
+
+        // Don't implement these, a scope belongs to its block.
+        TraceScope(TraceScope const &copy);
+        TraceScope &operator=(TraceScope const &copy);
+
+    public:
+        TraceScope(const char* name, const char* argName0 = 0,
+                   long long arg0 = 0, const char* argName1 = 0,
+                   long long arg1 = 0);
+        ~TraceScope();
+};
+
+#define TRACE_CONCAT_(a, b) a##b
+#define TRACE_CONCAT(a, b) TRACE_CONCAT_(a, b)
+
+#ifdef SOLVER_TRACE
+    #define TRACE_SCOPE(...) \
+        TraceScope TRACE_CONCAT(traceScope, __LINE__)(__VA_ARGS__)
+#else
+    #define TRACE_SCOPE(...)
+#endif
+
+#endif
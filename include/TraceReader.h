@@ -0,0 +1,88 @@
+/**
+ * This class reads a mobility trace: a sequence of records giving a time, a
+ * device id and the device's new position, in nondecreasing time order. The
+ * records that share a time form one Tick of a dynamic simulation.
+ *
+ * Two formats are supported and told apart by the start of the file:
+ *
+ *   CSV:    one "time,device,x,y" record per line. A first line that does
+ *           not start with a number is taken as a header and skipped.
+ *   Binary: the 8 byte BINARY_MAGIC, followed by packed records of a double
+ *           time, a 32 bit device id and double x and y coordinates, in the
+ *           byte order of the machine that wrote them. 
+ *
+ * A record with a negative device id, or one at or above the number of 
+ * devices given to setNumDevices(), is malformed.
+ *
+ * The file is read through a fixed size buffer, one Tick at a time, so the 
+ * memory used does not depend on the length of the trace.
+ */
+
+#ifndef TRACEREADER_H
+#define TRACEREADER_H
+
+#include <cstdio>
+#include <string>
+#include <vector>
+#include "Tick.h"
+
+class TraceReader {
+    private:
+        /** The open trace, or 0. */
+        FILE* file;
+        /** True for the binary format, false for CSV. */
+        bool binary;
+        /** Bytes read from the file but not yet parsed are buffer[pos, end). */
+        std::vector<char> buffer;
+        size_t pos;
+        size_t end;
+        /** True once the whole file has been read into the buffer. */
+        bool endOfFile;
+        /** True if a malformed record was found. */
+        bool error;
+        /** The number of the line being parsed, for CSV error messages. */
+        int lineNumber;
+        /** Device ids must be below this, or 0 for no limit. */
+        int numDevices;
+        /** A record that was read but belongs to the next tick. */
+        bool havePending;
+        double pendingTime;
+        int pendingDevice;
+        double pendingX;
+        double pendingY;
+
+        bool fill(size_t needed);
+        bool readRecord(double& time, int& device, double& x, double& y);
+        bool readCsvRecord(double& time, int& device, double& x, double& y);
+        bool readBinaryRecord(double& time, int& device, double& x, 
+                              double& y);
+
+        // Don't implement these, the file cannot be shared.
+        TraceReader(TraceReader const &copy);
+        TraceReader &operator=(TraceReader const &copy);
+
+    public:
+        /** Marks the start of a binary trace. */
+        static const char BINARY_MAGIC[8];
+        /** Size of a binary record in bytes. */
+        static const int BINARY_RECORD_SIZE = 28;
+        /** Default size of the read buffer in bytes. */
+        static const int DEFAULT_BUFFER_SIZE = 1 << 16;
+
+        TraceReader();
+        TraceReader(int bufferSize);
+        ~TraceReader();
+        bool open(std::string path);
+        void close();
+        bool isBinary();
+        bool hasError();
+        int getLineNumber();
+        void setNumDevices(int numDevices);
+        bool readTick(Tick& tick);
+        static bool writeBinaryHeader(FILE* out);
+        static bool writeBinaryRecord(FILE* out, double time, int device,
+                                      double x, double y);
+        static bool convertToBinary(std::string csvPath, std::string binaryPath);
+};
+
+#endif
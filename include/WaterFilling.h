@@ -0,0 +1,101 @@
+/**
+ * This class finds a good feasible allocation of a HetNet scene quickly, by
+ * progressive filling instead of optimization. Every device starts on its
+ * best pair and all devices raise their rate together. When a pair reaches
+ * r_ua,max, its device moves on to its next best pair; when an access point
+ * reaches r_a,max, every device drawing from it moves on. A device with no
+ * pair left on an access point with room stops rising, so the devices that
+ * are hardest to serve fix z, while the others keep filling the capacity
+ * left. Whatever pair capacity the access points still have room for is
+ * then handed out on top.
+ *
+ * The events are kept in a priority queue, so the filling takes
+ * O((P + A) log(P + A)) time for P pairs and A access points, against the
+ * many pivots of the full table. The allocation is feasible but not always
+ * optimal: devices never move flow between access points to make room for
+ * each other.
+ *
+ * Solver::solve() hands the allocation to Simplex::solveFrom() as a crash
+ * basis, which needs a vertex of the problem to represent it exactly. So
+ * flow is finally moved around cycles of pairs strictly between 0 and
+ * r_ua,max, and between devices above z, until none are left (see 
+ * pushAround()). That keeps the throughput and z, and takes time 
+ * proportional to the number of such pairs for each move, still a small 
+ * part of a single pivot for large scenes.
+ */
+
+#ifndef WATERFILLING_H
+#define WATERFILLING_H
+
+#include <functional>
+#include <queue>
+#include <vector>
+#include "HetNetModel.h"
+#include "LPSolution.h"
+#include "Solve.h"
+
+class WaterFilling : public Solve {
+    private:
+        /** A pair or access point that fills up at a given level. */
+        struct Event
+        {
+            double level;
+            bool accessPoint;
+            /** The device whose pair fills, or the access point. */
+            int index;
+            /** Events from before the index last changed are stale. */
+            int version;
+
+            bool operator>(const Event& other) const
+            {
+                return level > other.level;
+            }
+        };
+
+        /** The scene being solved. */
+        HetNetModel* model;
+        /** Each device's pairs, best first, and the next one to try. */
+        std::vector<std::vector<int> > devicePairs;
+        std::vector<int> nextPair;
+        /** The pair each device draws from now, or -1, and since when. */
+        std::vector<int> currentPair;
+        std::vector<double> attachLevel;
+        std::vector<int> deviceVersion;
+        /** The devices drawing from each access point, the room it had at
+         * the level it was last updated, and whether it is full. */
+        std::vector<int> apDrawing;
+        std::vector<double> apRoom;
+        std::vector<double> apLevel;
+        std::vector<bool> apFull;
+        std::vector<int> apVersion;
+        /** The pairs that drew from each access point; some have left. */
+        std::vector<std::vector<int> > apPairs;
+        /** The rate of every pair. */
+        std::vector<double> rates;
+        /** The pairs that may still be strictly between 0 and r_ua,max,
+         * and those of each device and access point. */
+        std::vector<int> freeList;
+        std::vector<std::vector<int> > freePairs;
+        /** Rates closer than this fraction of r_ua,max to 0 or r_ua,max
+         * count as being there. */
+        static constexpr double RATE_TOLERANCE = 1e-9;
+        /** Pending events, lowest level first. */
+        std::priority_queue<Event, std::vector<Event>,
+                            std::greater<Event> > events;
+
+        // Don't implement these, the scene is shared by pointer.
+        WaterFilling(WaterFilling const &copy);
+        WaterFilling &operator=(WaterFilling const &copy);
+
+        void reset();
+        void updateAccessPoint(int ap, double level, int change);
+        void attach(int device, double level);
+        void detach(int device, double level);
+        bool pushAround(double z, std::vector<double>& received);
+
+    public:
+        WaterFilling(HetNetModel* model);
+        LPSolution* solve();
+};
+
+#endif
@@ -2,4 +2,18 @@
 #define INTERFACE_H
 #include <string>
 std::string cppMain(std::string problem);
+std::string cppSolveScene(std::string scene);
+std::string cppSolveScenePath(std::string scene);
+std::string cppSetTimeLimit(std::string seconds);
+std::string cppSetGapTolerance(std::string gap);
+std::string cppSetCrashStart(std::string crash);
+std::string cppSetScalar(std::string scalar, std::string pricing,
+                         std::string ratioTest);
+std::string cppSetMemoryLimit(std::string megabytes, std::string queueSeconds);
+std::string cppSolveSceneSensitivity(std::string scene);
+std::string cppLastSolveStats();
+std::string cppClearTrace();
+std::string cppWriteTrace(std::string path);
+std::string cppStartCapture(std::string path, std::string sampleEvery);
+std::string cppStopCapture();
 #endif
@@ -9,7 +9,11 @@
 #ifndef UTILS_H
 #define UTILS_H
 
+#include <chrono>
+
 double** arrayInit2d(unsigned long long x, unsigned long long y);
 void arrayDel2d(double** array, unsigned long long x);
+unsigned long long arrayBytes2d(unsigned long long x, unsigned long long y);
+double secondsSince(std::chrono::steady_clock::time_point start);
 
 #endif
@@ -0,0 +1,134 @@
+/**
+ * Implementation of the AllocationCounter class, and in counting builds of
+ * the global operator new and delete that feed it.
+ */
+
+#include "AllocationCounter.h"
+#include <cstdlib>
+#include <new>
+
+/** The allocations made by this thread, and the bytes they asked for. */
+static thread_local unsigned long long threadAllocations = 0;
+static thread_local unsigned long long threadBytes = 0;
+
+#ifdef COUNT_ALLOCATIONS
+
+/**
+ * Allocates memory for operator new, counting it.
+ *
+ * Return: The memory, or 0 if there is none.
+ */
+static void* countedMalloc(std::size_t size)
+{
+    threadAllocations++;
+    threadBytes += size;
+    return std::malloc(size ? size : 1);
+}
+
+void* operator new(std::size_t size)
+{
+    void* p = countedMalloc(size);
+    if (!p)
+    {
+        throw std::bad_alloc();
+    }
+    return p;
+}
+
+void* operator new[](std::size_t size)
+{
+    return operator new(size);
+}
+
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept
+{
+    return countedMalloc(size);
+}
+
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept
+{
+    return countedMalloc(size);
+}
+
+void operator delete(void* p) noexcept
+{
+    std::free(p);
+}
+
+void operator delete[](void* p) noexcept
+{
+    std::free(p);
+}
+
+void operator delete(void* p, const std::nothrow_t&) noexcept
+{
+    std::free(p);
+}
+
+void operator delete[](void* p, const std::nothrow_t&) noexcept
+{
+    std::free(p);
+}
+
+#endif
+
+/**
+ * Constructor for a counter that starts counting now.
+ */
+AllocationCounter::AllocationCounter()
+{
+    restart();
+}
+
+/**
+ * Starts counting again from now.
+ */
+void AllocationCounter::restart()
+{
+    startAllocations = threadAllocations;
+    startBytes = threadBytes;
+}
+
+/**
+ * Returns the allocations this thread made since the counter was started.
+ */
+unsigned long long AllocationCounter::getAllocations()
+{
+    return threadAllocations - startAllocations;
+}
+
+/**
+ * Returns the bytes this thread allocated since the counter was started.
+ */
+unsigned long long AllocationCounter::getBytes()
+{
+    return threadBytes - startBytes;
+}
+
+/**
+ * Returns true if this build counts allocations.
+ */
+bool AllocationCounter::isCounting()
+{
+#ifdef COUNT_ALLOCATIONS
+    return true;
+#else
+    return false;
+#endif
+}
+
+/**
+ * Returns the allocations the calling thread has made.
+ */
+unsigned long long AllocationCounter::getThreadAllocations()
+{
+    return threadAllocations;
+}
+
+/**
+ * Returns the bytes the calling thread has allocated.
+ */
+unsigned long long AllocationCounter::getThreadBytes()
+{
+    return threadBytes;
+}
@@ -0,0 +1,422 @@
+/**
+ * Implementation of the BasicSimplex template, and its instantiations.
+ */
+
+#include "BasicSimplex.h"
+#include "utils.h"
+#include "Trace.h"
+
+/**
+ * Constructor for BasicSimplex objects. The table is filled from a sparse
+ * Linear Program in the scalar type. A row with a negative right hand side
+ * is negated, so every right hand side starts nonnegative, and it and every
+ * = row get an artificial variable, which Phase I drives to 0.
+ *
+ * Param: lp - the Linear Program to solve.
+ */
+template <typename Scalar, typename Pricing, typename RatioTest>
+BasicSimplex<Scalar, Pricing, RatioTest>::BasicSimplex(SparseLP* lp)
+    : budget(0), iterations(0), degeneratePivots(0)
+{
+    TRACE_SCOPE("buildTable");
+    std::chrono::steady_clock::time_point start =
+        std::chrono::steady_clock::now();
+    numDecisionVars = lp->getNumVars();
+    numConstraints = lp->getNumRows();
+    numArtificial = 0;
+    for (int r = 0; r < numConstraints; r++)
+    {
+        if (lp->getRowType(r) == SparseLP::EQ || lp->getRhs(r) < 0)
+        {
+            numArtificial++;
+        }
+    }
+    numRows = numConstraints + (numArtificial > 0 ? 2 : 1);
+    numCols = numDecisionVars + numConstraints + numArtificial + 1;
+    cells.assign((size_t) numRows * numCols, 0);
+    table.resize(numRows);
+    for (int i = 0; i < numRows; i++)
+    {
+        table[i] = &cells[(size_t) i * numCols];
+    }
+    basis.resize(numConstraints);
+    eligible = new bool[numCols];
+    std::fill(eligible, eligible + numDecisionVars + numConstraints, true);
+    std::fill(eligible + numDecisionVars + numConstraints, eligible + numCols,
+              false);
+
+    int rhsCol = numCols - 1;
+    int artificialCol = numDecisionVars + numConstraints;
+    for (int r = 0; r < numConstraints; r++)
+    {
+        Scalar sign = lp->getRhs(r) < 0 ? -1 : 1;
+        for (int k = lp->getRowStart(r); k < lp->getRowEnd(r); k++)
+        {
+            table[r][lp->getColIndex(k)] = sign * (Scalar) lp->getValue(k);
+        }
+        table[r][numDecisionVars + r] = sign;
+        table[r][rhsCol] = sign * (Scalar) lp->getRhs(r);
+        if (lp->getRowType(r) == SparseLP::EQ || lp->getRhs(r) < 0)
+        {
+            // The slack of an = row must stay at 0.
+            eligible[numDecisionVars + r] = lp->getRowType(r) != SparseLP::EQ;
+            table[r][artificialCol] = 1;
+            basis[r] = artificialCol++;
+        }
+        else
+        {
+            basis[r] = numDecisionVars + r;
+        }
+    }
+    for (int j = 0; j < numDecisionVars; j++)
+    {
+        table[numConstraints][j] = lp->getObjective(j);
+    }
+
+    // Phase I maximizes minus the sum of the artificial variables; written
+    // in terms of the nonbasic columns, that is the sum of their rows.
+    if (numArtificial > 0)
+    {
+        Scalar* phaseOne = table[numConstraints + 1];
+        for (int r = 0; r < numConstraints; r++)
+        {
+            if (basis[r] >= numDecisionVars + numConstraints)
+            {
+                for (int j = 0; j < numDecisionVars + numConstraints; j++)
+                {
+                    phaseOne[j] += table[r][j];
+                }
+                phaseOne[rhsCol] += table[r][rhsCol];
+            }
+        }
+    }
+    buildTime = secondsSince(start);
+}
+
+/**
+ * Destructor for BasicSimplex objects.
+ */
+template <typename Scalar, typename Pricing, typename RatioTest>
+BasicSimplex<Scalar, Pricing, RatioTest>::~BasicSimplex()
+{
+    delete [] eligible;
+}
+
+/**
+ * Sets the limits on the solve, as Simplex::setBudget() does.
+ *
+ * Param: inBudget - the limits, or 0 for none. It still belongs to the
+ *                   caller.
+ */
+template <typename Scalar, typename Pricing, typename RatioTest>
+void BasicSimplex<Scalar, Pricing, RatioTest>::setBudget(SolveBudget* inBudget)
+{
+    budget = inBudget;
+}
+
+/**
+ * Returns the number of pivots taken by the last solve().
+ */
+template <typename Scalar, typename Pricing, typename RatioTest>
+unsigned long long BasicSimplex<Scalar, Pricing, RatioTest>::getIterations()
+{
+    return iterations;
+}
+
+/**
+ * Pivots the table, as Simplex::pivot() does.
+ *
+ * Param: pivotRow - the row of the leaving variable.
+ * Param: pivotCol - the column of the entering variable.
+ * Param: curRows - the rows to update: the constraint rows and the
+ *                  objective rows still in use.
+ */
+template <typename Scalar, typename Pricing, typename RatioTest>
+void BasicSimplex<Scalar, Pricing, RatioTest>::pivot(int pivotRow,
+                                                     int pivotCol,
+                                                     int curRows)
+{
+    TRACE_SCOPE("pivot", "row", pivotRow, "col", pivotCol);
+    Scalar* pivotRowData = table[pivotRow];
+    Scalar pivotNumber = pivotRowData[pivotCol];
+    for (int col = 0; col < numCols; col++)
+    {
+        if (pivotRowData[col] != 0) // so it doesn't produce -0
+        {
+            pivotRowData[col] = pivotRowData[col] / pivotNumber;
+        }
+    }
+
+    for (int row = 0; row < curRows; row++)
+    {
+        Scalar* rowData = table[row];
+        if (std::abs(rowData[pivotCol]) > ScalarTraits<Scalar>::zero() &&
+            row != pivotRow)
+        {
+            Scalar multiple = rowData[pivotCol];
+            for (int col = 0; col < numCols; col++)
+            {
+                rowData[col] -= multiple * pivotRowData[col];
+            }
+        }
+    }
+}
+
+/**
+ * Pivots until an objective row has no column worth entering, with the
+ * pricing rule and ratio test the class was compiled with.
+ *
+ * Param: objectiveRow - the row of the objective; it and the rows above it
+ *                       are updated by each pivot.
+ * Return: LPSolution::SOLVED, UNBOUNDED, TIMED_OUT if the budget ran out,
+ *         or EXCEEDED_MAX_ITERATIONS.
+ */
+template <typename Scalar, typename Pricing, typename RatioTest>
+int BasicSimplex<Scalar, Pricing, RatioTest>::optimize(int objectiveRow)
+{
+    TRACE_SCOPE("optimize", "rows", objectiveRow + 1, "cols", numCols);
+    int rhsCol = numCols - 1;
+    unsigned long long maxIterations = iterations +
+        (unsigned long long) PIVOTS_PER_LINE * (numRows + numCols);
+    while (true)
+    {
+        int pivotCol = Pricing::choose(table[objectiveRow], eligible,
+                                       rhsCol);
+        if (pivotCol < 0)
+        {
+            return LPSolution::SOLVED;
+        }
+        if (budget && budget->isExhausted(iterations))
+        {
+            return LPSolution::TIMED_OUT;
+        }
+        if (iterations >= maxIterations)
+        {
+            return LPSolution::EXCEEDED_MAX_ITERATIONS;
+        }
+        int pivotRow = RatioTest::choose(table.data(), pivotCol, rhsCol,
+                                         numConstraints);
+        if (pivotRow < 0)
+        {
+            return LPSolution::UNBOUNDED;
+        }
+        if (table[pivotRow][rhsCol] <= ScalarTraits<Scalar>::feasibility())
+        {
+            degeneratePivots++;
+        }
+        pivot(pivotRow, pivotCol, objectiveRow + 1);
+        basis[pivotRow] = pivotCol;
+        iterations++;
+    }
+}
+
+/**
+ * Pivots the artificial variables still basic, at 0, after Phase I out of
+ * the basis, each on the largest entry of its row among the other columns,
+ * as Simplex does. The right hand side is 0, so no other row moves. A row
+ * with no such entry is redundant and keeps its artificial variable, which
+ * no later pivot can change.
+ */
+template <typename Scalar, typename Pricing, typename RatioTest>
+void BasicSimplex<Scalar, Pricing, RatioTest>::driveOutArtificials()
+{
+    int firstArtificial = numDecisionVars + numConstraints;
+    for (int r = 0; r < numConstraints; r++)
+    {
+        if (basis[r] < firstArtificial)
+        {
+            continue;
+        }
+        int pivotCol = -1;
+        Scalar maxEntry = ScalarTraits<Scalar>::zero();
+        for (int j = 0; j < firstArtificial; j++)
+        {
+            if (eligible[j] && std::abs(table[r][j]) > maxEntry)
+            {
+                maxEntry = std::abs(table[r][j]);
+                pivotCol = j;
+            }
+        }
+        if (pivotCol >= 0)
+        {
+            pivot(r, pivotCol, numRows);
+            basis[r] = pivotCol;
+        }
+    }
+}
+
+/**
+ * Solves the Linear Program with the two-phase simplex method.
+ *
+ * Return: The solution, converted to double. It has optimal values when it
+ *         is SOLVED, or TIMED_OUT in Phase II with the best feasible point
+ *         found.
+ */
+template <typename Scalar, typename Pricing, typename RatioTest>
+LPSolution* BasicSimplex<Scalar, Pricing, RatioTest>::solve()
+{
+    TRACE_SCOPE("BasicSimplex::solve", "rows", numRows, "cols", numCols);
+    LPSolution* sol = new LPSolution();
+    int rhsCol = numCols - 1;
+    double phaseOneTime = 0;
+    double phaseTwoTime = 0;
+    std::chrono::steady_clock::time_point start =
+        std::chrono::steady_clock::now();
+    int errorCode = LPSolution::SOLVED;
+    if (numArtificial > 0)
+    {
+        errorCode = optimize(numConstraints + 1);
+        if (errorCode == LPSolution::SOLVED &&
+            std::abs(table[numConstraints + 1][rhsCol]) >=
+            ScalarTraits<Scalar>::zero())
+        {
+            errorCode = LPSolution::INFEASIBLE;
+        }
+        if (errorCode == LPSolution::SOLVED)
+        {
+            driveOutArtificials();
+        }
+    }
+    unsigned long long phaseOneIterations = iterations;
+    phaseOneTime = secondsSince(start);
+    // Without a feasible point there is nothing to report.
+    bool feasible = errorCode == LPSolution::SOLVED;
+    if (feasible)
+    {
+        start = std::chrono::steady_clock::now();
+        errorCode = optimize(numConstraints);
+        phaseTwoTime = secondsSince(start);
+    }
+    sol->setErrorCode(errorCode);
+
+    if (feasible && (errorCode == LPSolution::SOLVED ||
+                     errorCode == LPSolution::TIMED_OUT))
+    {
+        double* optimalValues = new double[numDecisionVars]();
+        for (int r = 0; r < numConstraints; r++)
+        {
+            if (basis[r] < numDecisionVars)
+            {
+                optimalValues[basis[r]] = (double) table[r][rhsCol];
+            }
+        }
+        sol->setOptimalValues(optimalValues);
+        sol->setNumOptimalValues(numDecisionVars);
+        Scalar z = -table[numConstraints][rhsCol];
+        sol->setZValue(std::abs(z) < ScalarTraits<Scalar>::zero() ? 0 :
+                                                               (double) z);
+    }
+
+    SolveStats& stats = sol->getStats();
+    stats.setEngine(std::string("simplex ") + ScalarTraits<Scalar>::name());
+    stats.setPricing(Pricing::name());
+    stats.setRatioTest(RatioTest::name());
+    stats.setShape(numConstraints, numDecisionVars + numConstraints);
+    stats.setBuildTime(buildTime);
+    stats.setPhaseOneIterations(phaseOneIterations);
+    stats.setPhaseOneTime(phaseOneTime);
+    stats.setPhaseTwoIterations(iterations - phaseOneIterations);
+    stats.setPhaseTwoTime(phaseTwoTime);
+    stats.setDegeneratePivots(degeneratePivots);
+    stats.setPeakTableBytes((unsigned long long) numRows *
+                            (sizeof(Scalar*) + numCols * sizeof(Scalar)));
+    return sol;
+}
+
+/**
+ * Makes a BasicSimplex of the given policies, with a budget.
+ */
+template <typename Scalar, typename Pricing, typename RatioTest>
+static Solve* make(SparseLP* lp, SolveBudget* budget)
+{
+    BasicSimplex<Scalar, Pricing, RatioTest>* simplex =
+        new BasicSimplex<Scalar, Pricing, RatioTest>(lp);
+    simplex->setBudget(budget);
+    return simplex;
+}
+
+/**
+ * Makes a BasicSimplex of a scalar type with the given pricing rule and
+ * ratio test.
+ */
+template <typename Scalar>
+static Solve* makeOf(SparseLP* lp, int pricing, int ratioTest,
+                     SolveBudget* budget)
+{
+    if (pricing == SimplexVariant::BLAND)
+    {
+        return ratioTest == SimplexVariant::TEXTBOOK ?
+            make<Scalar, BlandPricing, TextbookRatioTest>(lp, budget) :
+            make<Scalar, BlandPricing, HarrisRatioTest>(lp, budget);
+    }
+    return ratioTest == SimplexVariant::TEXTBOOK ?
+        make<Scalar, DantzigPricing, TextbookRatioTest>(lp, budget) :
+        make<Scalar, DantzigPricing, HarrisRatioTest>(lp, budget);
+}
+
+/**
+ * Makes the instantiation of BasicSimplex for a scalar type, pricing rule
+ * and ratio test chosen at run time. Delete it when done.
+ *
+ * Param: lp - the Linear Program to solve.
+ * Param: scalar - FLOAT, DOUBLE or LONG_DOUBLE.
+ * Param: pricing - DANTZIG or BLAND.
+ * Param: ratioTest - TEXTBOOK or HARRIS.
+ * Param: budget - the limits on the solve, or 0 for none.
+ * Return: The simplex method, ready to solve().
+ */
+Solve* SimplexVariant::create(SparseLP* lp, int scalar, int pricing,
+                              int ratioTest, SolveBudget* budget)
+{
+    if (scalar == FLOAT)
+    {
+        return makeOf<float>(lp, pricing, ratioTest, budget);
+    }
+    if (scalar == LONG_DOUBLE)
+    {
+        return makeOf<long double>(lp, pricing, ratioTest, budget);
+    }
+    return makeOf<double>(lp, pricing, ratioTest, budget);
+}
+
+/**
+ * Returns the bytes the table of create() will hold, as its solve reports
+ * them in SolveStats::getPeakTableBytes(), without building it: a row per
+ * constraint, the objective and Phase I's objective if a row needs an
+ * artificial variable, each with a column per variable, slack, artificial
+ * variable and the right hand side.
+ *
+ * Param: lp - the Linear Program.
+ * Param: scalar - FLOAT, DOUBLE or LONG_DOUBLE.
+ */
+unsigned long long SimplexVariant::predictPeakBytes(SparseLP* lp, int scalar)
+{
+    int numArtificial = 0;
+    for (int r = 0; r < lp->getNumRows(); r++)
+    {
+        if (lp->getRowType(r) == SparseLP::EQ || lp->getRhs(r) < 0)
+        {
+            numArtificial++;
+        }
+    }
+    unsigned long long rows = lp->getNumRows() + (numArtificial > 0 ? 2 : 1);
+    unsigned long long cols = lp->getNumVars() + lp->getNumRows() +
+                              numArtificial + 1;
+    size_t cell = scalar == FLOAT ? sizeof(float) :
+                  (scalar == LONG_DOUBLE ? sizeof(long double) :
+                                           sizeof(double));
+    return rows * (sizeof(void*) + cols * cell);
+}
+
+template class BasicSimplex<float, DantzigPricing, TextbookRatioTest>;
+template class BasicSimplex<float, DantzigPricing, HarrisRatioTest>;
+template class BasicSimplex<float, BlandPricing, TextbookRatioTest>;
+template class BasicSimplex<float, BlandPricing, HarrisRatioTest>;
+template class BasicSimplex<double, DantzigPricing, TextbookRatioTest>;
+template class BasicSimplex<double, DantzigPricing, HarrisRatioTest>;
+template class BasicSimplex<double, BlandPricing, TextbookRatioTest>;
+template class BasicSimplex<double, BlandPricing, HarrisRatioTest>;
+template class BasicSimplex<long double, DantzigPricing, TextbookRatioTest>;
+template class BasicSimplex<long double, DantzigPricing, HarrisRatioTest>;
+template class BasicSimplex<long double, BlandPricing, TextbookRatioTest>;
+template class BasicSimplex<long double, BlandPricing, HarrisRatioTest>;
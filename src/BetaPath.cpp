@@ -0,0 +1,302 @@
+/**
+ * Implementation of the BetaPath class.
+ */
+
+#include "BetaPath.h"
+#include "Simplex.h"
+#include "SparseLP.h"
+#include "utils.h"
+#include <algorithm>
+
+/**
+ * Constructor.
+ *
+ * Param: inModel - the scene. Its weights are ignored.
+ */
+BetaPath::BetaPath(HetNetModel* inModel) : model(inModel),
+                                           errorCode(LPSolution::DEFAULT),
+                                           budget(0), iterations(0)
+{
+}
+
+/**
+ * Sets the limits on compute(): its time limit and cancellation hold for
+ * the whole path, and its pivot limit for the pivots of every solve along
+ * it together.
+ *
+ * Param: inBudget - the limits, or 0 for none. It must outlive compute().
+ */
+void BetaPath::setBudget(SolveBudget* inBudget)
+{
+    budget = inBudget;
+}
+
+/**
+ * Computes the intervals of beta in [0, 1] and the optimal solution over
+ * each one.
+ *
+ * Return: LPSolution::SOLVED, LPSolution::TIMED_OUT if the budget ran out
+ *         first, in which case the intervals found so far are kept, or 
+ *         the error code of the first solve that failed.
+ */
+int BetaPath::compute()
+{
+    std::chrono::steady_clock::time_point begin =
+        std::chrono::steady_clock::now();
+    stats = SolveStats();
+    walk();
+
+    // Phase I is that of the solve at beta = 0; everything after it, the 
+    // steps along the path included, is Phase II.
+    stats.setEngine("beta path");
+    stats.setPhaseTwoIterations(iterations - stats.getPhaseOneIterations());
+    stats.setPhaseTwoTime(std::max(0.0, secondsSince(begin) - 
+                                        stats.getBuildTime() - 
+                                        stats.getPhaseOneTime()));
+    return errorCode;
+}
+
+/**
+ * Does the work of compute(), recording the statistics of the solve at 
+ * beta = 0 and adding those of every later one.
+ *
+ * Return: The error code, as compute().
+ */
+int BetaPath::walk()
+{
+    start.clear();
+    end.clear();
+    bases.clear();
+    values.clear();
+    throughput.clear();
+    iterations = 0;
+
+    // Build the problem at beta = 0, leaving the model's weights as they were.
+    double alpha = model->getAlpha();
+    double beta = model->getBeta();
+    model->setAlpha(1);
+    model->setBeta(0);
+    SparseLP lp;
+    model->buildLP(&lp);
+    model->setAlpha(alpha);
+    model->setBeta(beta);
+
+    int numPairs = model->getNumPairs();
+    std::vector<double> direction(numPairs + 1, -1);
+    direction[numPairs] = model->getSumRuaMax();
+
+    Simplex simplex(&lp);
+    simplex.setBudget(budget);
+    LPSolution* sol = simplex.solve();
+    iterations += simplex.getIterations();
+    stats = sol->getStats();
+    errorCode = sol->getErrorCode();
+    delete sol;
+    if (errorCode != LPSolution::SOLVED)
+    {
+        return errorCode;
+    }
+
+    double current = 0;
+    for (int step = 0; step < MAX_STEPS && current < 1; step++)
+    {
+        // Each solve only counts its own pivots against the budget.
+        if (budget && budget->isExhausted(iterations))
+        {
+            errorCode = LPSolution::TIMED_OUT;
+            return errorCode;
+        }
+        double range = simplex.getObjectiveRange(direction.data());
+        if (range == 0)
+        {
+            // The basis is only optimal at this beta; move to the adjacent
+            // one that is optimal just past it.
+            if (!simplex.pivotTowards(direction.data()))
+            {
+                errorCode = LPSolution::UNBOUNDED;
+                return errorCode;
+            }
+            iterations++;
+            continue;
+        }
+
+        sol = simplex.reoptimize();
+        iterations += simplex.getIterations();
+        SolveStats& solveStats = sol->getStats();
+        stats.setDegeneratePivots(stats.getDegeneratePivots() + 
+                                  solveStats.getDegeneratePivots());
+        stats.setPeakTableBytes(std::max(stats.getPeakTableBytes(),
+                                         solveStats.getPeakTableBytes()));
+        errorCode = sol->getErrorCode();
+        if (errorCode != LPSolution::SOLVED)
+        {
+            delete sol;
+            return errorCode;
+        }
+        double next = (range >= 1 - current) ? 1 : current + range;
+        start.push_back(current);
+        end.push_back(next);
+        bases.push_back(simplex.getBasis());
+        values.push_back(std::vector<double>(sol->getOptimalValues(),
+                                             sol->getOptimalValues() +
+                                             numPairs + 1));
+        double sum = 0;
+        for (int p = 0; p < numPairs; p++)
+        {
+            sum += values.back()[p];
+        }
+        throughput.push_back(sum);
+        delete sol;
+
+        current = next;
+        for (int j = 0; j <= numPairs && current < 1; j++)
+        {
+            simplex.changeObjective(j, (j < numPairs ? 1 : 0) + 
+                                       current * direction[j]);
+        }
+    }
+    if (current < 1)
+    {
+        errorCode = LPSolution::EXCEEDED_MAX_ITERATIONS;
+    }
+    return errorCode;
+}
+
+/**
+ * Forgets the intervals and marks the path as turned away without being
+ * computed, with LPSolution::REJECTED, as the Solver does when its table
+ * would not fit in memory.
+ */
+void BetaPath::reject()
+{
+    start.clear();
+    end.clear();
+    bases.clear();
+    values.clear();
+    throughput.clear();
+    iterations = 0;
+    stats = SolveStats();
+    stats.setEngine("rejected");
+    errorCode = LPSolution::REJECTED;
+}
+
+/**
+ * Returns the error code of the last compute().
+ */
+int BetaPath::getErrorCode()
+{
+    return errorCode;
+}
+
+/**
+ * Returns the pivots taken by the last compute(), over all its solves.
+ */
+unsigned long long BetaPath::getIterations()
+{
+    return iterations;
+}
+
+/**
+ * Returns the statistics of the last compute(): the shape and table memory
+ * of its problem, and the pivots and times of all its solves together.
+ */
+SolveStats& BetaPath::getStats()
+{
+    return stats;
+}
+
+/**
+ * Returns the number of intervals.
+ */
+int BetaPath::getNumIntervals()
+{
+    return start.size();
+}
+
+/**
+ * Returns the smallest beta of an interval.
+ */
+double BetaPath::getStart(int interval)
+{
+    return start[interval];
+}
+
+/**
+ * Returns the largest beta of an interval.
+ */
+double BetaPath::getEnd(int interval)
+{
+    return end[interval];
+}
+
+/**
+ * Returns the optimal basis over an interval, as Simplex::getBasis().
+ */
+std::vector<int>& BetaPath::getBasis(int interval)
+{
+    return bases[interval];
+}
+
+/**
+ * Returns the optimal solution over an interval, ordered as the model's 
+ * columns.
+ */
+std::vector<double>& BetaPath::getValues(int interval)
+{
+    return values[interval];
+}
+
+/**
+ * Returns the objective value at a beta within an interval, which is 
+ * (1 - beta) * sum(r_ua) + beta * S * z for the interval's solution.
+ */
+double BetaPath::getObjectiveValue(int interval, double beta)
+{
+    return (1 - beta) * throughput[interval] +
+           beta * model->getSumRuaMax() * values[interval].back();
+}
+
+/**
+ * Returns the interval containing a beta, or -1 if there is none.
+ */
+int BetaPath::findInterval(double beta)
+{
+    for (size_t i = 0; i < start.size(); i++)
+    {
+        if (beta <= end[i])
+        {
+            return (beta >= start[i]) ? i : -1;
+        }
+    }
+    return -1;
+}
+
+/**
+ * Returns the solution at a beta, as Solver::solve() would for the scene
+ * with that beta and alpha = 1 - beta, but without solving.
+ *
+ * Param: beta - the fairness weight.
+ * Return: The solution, which the caller frees.
+ */
+LPSolution* BetaPath::getSolution(double beta)
+{
+    LPSolution* sol = new LPSolution();
+    int interval = findInterval(beta);
+    if (interval == -1)
+    {
+        sol->setErrorCode(errorCode == LPSolution::SOLVED ? 
+                          LPSolution::DEFAULT : errorCode);
+        return sol;
+    }
+    int numValues = values[interval].size();
+    double* copy = new double[numValues];
+    for (int j = 0; j < numValues; j++)
+    {
+        copy[j] = values[interval][j];
+    }
+    sol->setErrorCode(LPSolution::SOLVED);
+    sol->setOptimalValues(copy);
+    sol->setNumOptimalValues(numValues);
+    sol->setZValue(getObjectiveValue(interval, beta));
+    return sol;
+}
@@ -0,0 +1,384 @@
+/**
+ * Implementation of the CaptureLog class.
+ */
+
+#include "CaptureLog.h"
+#include "Trace.h"
+#include <cerrno>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <fcntl.h>
+#include <fstream>
+#include <sstream>
+#include <unistd.h>
+#include <zlib.h>
+
+/** The first bytes of every frame. */
+static const char MAGIC[4] = {'L', 'P', 'C', '2'};
+/** The first bytes of the frames of logs written before the memory limit,
+ * crash start, engine choice and engine were recorded. */
+static const char OLD_MAGIC[4] = {'L', 'P', 'C', 'R'};
+/** The bytes of a frame header: the magic, the length of the record, the
+ * length of its compressed form and the CRC-32 of the record. */
+static const size_t HEADER_BYTES = 16;
+/** The bytes of a record before its engine and problem strings, and of an
+ * old record before its problem string. */
+static const size_t FIXED_BYTES = 96;
+static const size_t OLD_FIXED_BYTES = 60;
+/** Values closer to 0 than this hash as 0, so that -0 and round off in
+ * the last digits of a zero do not count as a different answer. */
+static const double HASH_ZERO = 1e-9;
+
+/**
+ * Appends an unsigned number of a number of bytes, little endian.
+ */
+static void putUint(std::string& out, unsigned long long value, int bytes)
+{
+    for (int i = 0; i < bytes; i++)
+    {
+        out += (char) ((value >> (8 * i)) & 0xff);
+    }
+}
+
+/**
+ * Appends a double by its bits, little endian.
+ */
+static void putDouble(std::string& out, double value)
+{
+    unsigned long long bits;
+    memcpy(&bits, &value, sizeof(bits));
+    putUint(out, bits, 8);
+}
+
+/**
+ * Reads an unsigned number of a number of bytes, little endian, moving
+ * past it.
+ */
+static unsigned long long getUint(const char*& in, int bytes)
+{
+    unsigned long long value = 0;
+    for (int i = 0; i < bytes; i++)
+    {
+        value |= (unsigned long long) (unsigned char) in[i] << (8 * i);
+    }
+    in += bytes;
+    return value;
+}
+
+/**
+ * Reads a double by its bits, little endian, moving past it.
+ */
+static double getDouble(const char*& in)
+{
+    unsigned long long bits = getUint(in, 8);
+    double value;
+    memcpy(&value, &bits, sizeof(value));
+    return value;
+}
+
+/**
+ * Constructor for a log that appends to a file, creating it if needed.
+ *
+ * Param: path - the file.
+ * Param: inSampleEvery - record one problem in this many; 0 or 1 records
+ *                        every problem.
+ */
+CaptureLog::CaptureLog(std::string path, unsigned int inSampleEvery)
+    : sampleEvery(inSampleEvery ? inSampleEvery : 1), seen(0)
+{
+    file = open(path.c_str(), O_WRONLY | O_APPEND | O_CREAT, 0644);
+    if (file < 0)
+    {
+        error = path + ": " + strerror(errno);
+    }
+}
+
+/**
+ * Destructor for logs, which closes the file.
+ */
+CaptureLog::~CaptureLog()
+{
+    if (file >= 0)
+    {
+        close(file);
+    }
+}
+
+/**
+ * Returns true if the file could be opened.
+ */
+bool CaptureLog::isOpen()
+{
+    return file >= 0;
+}
+
+/**
+ * Returns why the file could not be opened or the last write failed, or ""
+ * if nothing failed.
+ */
+std::string& CaptureLog::getError()
+{
+    return error;
+}
+
+/**
+ * Counts a problem and returns true if it is one of those to record. It
+ * may be called from any thread.
+ */
+bool CaptureLog::sample()
+{
+    return seen.fetch_add(1) % sampleEvery == 0;
+}
+
+/**
+ * Compresses a record and appends it to the log as one frame. It may be
+ * called from any thread.
+ *
+ * Param: record - the record.
+ * Return: True if the whole frame was written.
+ */
+bool CaptureLog::write(CaptureRecord& record)
+{
+    TRACE_SCOPE("CaptureLog::write", "bytes", record.problem.size());
+    if (file < 0)
+    {
+        return false;
+    }
+    std::string data;
+    data.reserve(FIXED_BYTES + record.engine.size() + record.problem.size());
+    putUint(data, record.timestamp, 8);
+    putUint(data, record.kind, 4);
+    putDouble(data, record.timeLimit);
+    putUint(data, record.maxIterations, 8);
+    putDouble(data, record.gapTolerance);
+    putUint(data, (unsigned int) record.errorCode, 4);
+    putUint(data, record.resultHash, 8);
+    putDouble(data, record.seconds);
+    putUint(data, record.memoryLimit, 8);
+    putDouble(data, record.queueTimeout);
+    putUint(data, record.crashStart ? 1 : 0, 4);
+    putUint(data, (unsigned int) record.scalar, 4);
+    putUint(data, (unsigned int) record.pricing, 4);
+    putUint(data, (unsigned int) record.ratioTest, 4);
+    putUint(data, record.engine.size(), 4);
+    data += record.engine;
+    putUint(data, record.problem.size(), 4);
+    data += record.problem;
+
+    uLongf packedBytes = compressBound(data.size());
+    std::string frame(HEADER_BYTES + packedBytes, '\0');
+    if (compress2((Bytef*) &frame[HEADER_BYTES], &packedBytes,
+                  (const Bytef*) data.data(), data.size(),
+                  Z_DEFAULT_COMPRESSION) != Z_OK)
+    {
+        return false;
+    }
+    frame.resize(HEADER_BYTES + packedBytes);
+    std::string header(MAGIC, sizeof(MAGIC));
+    putUint(header, data.size(), 4);
+    putUint(header, packedBytes, 4);
+    putUint(header, crc32(0, (const Bytef*) data.data(), data.size()), 4);
+    frame.replace(0, HEADER_BYTES, header);
+
+    // Appends from one process never interleave; the lock keeps the
+    // threads of this one from interleaving short writes.
+    std::lock_guard<std::mutex> guard(lock);
+    ssize_t written = ::write(file, frame.data(), frame.size());
+    if (written != (ssize_t) frame.size())
+    {
+        error = written < 0 ? strerror(errno) : "short write";
+        return false;
+    }
+    return true;
+}
+
+/**
+ * Adds text to an FNV-1a hash.
+ */
+static void hashText(unsigned long long& hash, const char* text)
+{
+    for (const char* c = text; *c; c++)
+    {
+        hash = (hash ^ (unsigned char) *c) * 1099511628211ULL;
+    }
+}
+
+/**
+ * Adds a value to a hash, rounded as hashSolution() rounds it.
+ */
+static void hashValue(unsigned long long& hash, double value)
+{
+    char text[32];
+    snprintf(text, sizeof(text), "%.9g;",
+             std::abs(value) < HASH_ZERO ? 0.0 : value);
+    hashText(hash, text);
+}
+
+/**
+ * Returns a hash of an answer: its error code and, if it has a point, its
+ * objective value and point, each rounded to 9 significant digits so that
+ * builds which only differ in the last bits of their arithmetic agree.
+ * This is FNV-1a over the rounded values written as text.
+ *
+ * Param: sol - the answer.
+ */
+unsigned long long CaptureLog::hashSolution(LPSolution* sol)
+{
+    unsigned long long hash = 14695981039346656037ULL;
+    char text[32];
+    snprintf(text, sizeof(text), "%d;", sol->getErrorCode());
+    hashText(hash, text);
+    hashValue(hash, sol->getZValue());
+    int numValues = sol->getOptimalValues() ? sol->getNumOptimalValues() : 0;
+    for (int i = 0; i < numValues; i++)
+    {
+        hashValue(hash, sol->getOptimalValues()[i]);
+    }
+    return hash;
+}
+
+/**
+ * Returns a hash of a path over beta, as hashSolution() hashes an answer:
+ * its error code, then the ends of each interval, the objective values
+ * there and the point over it.
+ *
+ * Param: path - the computed path.
+ */
+unsigned long long CaptureLog::hashPath(BetaPath* path)
+{
+    unsigned long long hash = 14695981039346656037ULL;
+    char text[32];
+    snprintf(text, sizeof(text), "%d;", path->getErrorCode());
+    hashText(hash, text);
+    for (int i = 0; i < path->getNumIntervals(); i++)
+    {
+        double start = path->getStart(i);
+        double end = path->getEnd(i);
+        hashValue(hash, start);
+        hashValue(hash, end);
+        hashValue(hash, path->getObjectiveValue(i, start));
+        hashValue(hash, path->getObjectiveValue(i, end));
+        LPSolution* sol = path->getSolution(start);
+        for (int j = 0; j < sol->getNumOptimalValues(); j++)
+        {
+            hashValue(hash, sol->getOptimalValues()[j]);
+        }
+        delete sol;
+    }
+    return hash;
+}
+
+/**
+ * Returns the current time in nanoseconds since the epoch, the time base
+ * of the timestamps of records.
+ */
+unsigned long long CaptureLog::now()
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count();
+}
+
+/**
+ * Reads every record of a log, oldest first. Reading stops at the first
+ * frame that is cut short or damaged; the records before it are kept.
+ *
+ * Param: path - the file.
+ * Param: records - the list to append the records to.
+ * Param: error - set to why reading stopped early.
+ * Return: True if the whole file was read.
+ */
+bool CaptureLog::read(std::string path, std::vector<CaptureRecord>& records,
+                      std::string& error)
+{
+    std::ifstream in(path.c_str(), std::ios::binary);
+    if (!in)
+    {
+        error = path + ": " + strerror(errno);
+        return false;
+    }
+    char header[HEADER_BYTES];
+    std::string packed;
+    std::string data;
+    for (int frame = 0; in.read(header, HEADER_BYTES); frame++)
+    {
+        std::ostringstream where;
+        where << path << ": record " << frame << " ";
+        const char* field = header + sizeof(MAGIC);
+        uLongf dataBytes = getUint(field, 4);
+        uLong packedBytes = getUint(field, 4);
+        unsigned long long crc = getUint(field, 4);
+        bool old = memcmp(header, OLD_MAGIC, sizeof(OLD_MAGIC)) == 0;
+        if (!old && memcmp(header, MAGIC, sizeof(MAGIC)) != 0)
+        {
+            error = where.str() + "is not a capture record";
+            return false;
+        }
+        packed.resize(packedBytes);
+        data.resize(dataBytes);
+        if (!in.read(&packed[0], packedBytes))
+        {
+            error = where.str() + "is cut short";
+            return false;
+        }
+        if (uncompress((Bytef*) &data[0], &dataBytes,
+                       (const Bytef*) packed.data(), packedBytes) != Z_OK ||
+            dataBytes != data.size() ||
+            dataBytes < (old ? OLD_FIXED_BYTES : FIXED_BYTES) ||
+            crc32(0, (const Bytef*) data.data(), dataBytes) != crc)
+        {
+            error = where.str() + "is damaged";
+            return false;
+        }
+
+        const char* next = data.data();
+        CaptureRecord record;
+        record.timestamp = getUint(next, 8);
+        record.kind = getUint(next, 4);
+        record.timeLimit = getDouble(next);
+        record.maxIterations = getUint(next, 8);
+        record.gapTolerance = getDouble(next);
+        record.errorCode = (int) getUint(next, 4);
+        record.resultHash = getUint(next, 8);
+        record.seconds = getDouble(next);
+        record.memoryLimit = 0;
+        record.queueTimeout = 0;
+        record.crashStart = false;
+        record.scalar = -1;
+        record.pricing = 0;
+        record.ratioTest = 0;
+        if (!old)
+        {
+            record.memoryLimit = getUint(next, 8);
+            record.queueTimeout = getDouble(next);
+            record.crashStart = getUint(next, 4) != 0;
+            record.scalar = (int) getUint(next, 4);
+            record.pricing = (int) getUint(next, 4);
+            record.ratioTest = (int) getUint(next, 4);
+            size_t engineBytes = getUint(next, 4);
+            // The problem's length follows the engine.
+            if (engineBytes + 4 > data.size() - (next - data.data()))
+            {
+                error = where.str() + "is damaged";
+                return false;
+            }
+            record.engine.assign(next, engineBytes);
+            next += engineBytes;
+        }
+        size_t problemBytes = getUint(next, 4);
+        if (problemBytes != data.size() - (next - data.data()))
+        {
+            error = where.str() + "is damaged";
+            return false;
+        }
+        record.problem.assign(next, problemBytes);
+        records.push_back(record);
+    }
+    if (in.gcount() != 0)
+    {
+        error = path + ": the last record is cut short";
+        return false;
+    }
+    return true;
+}
@@ -0,0 +1,513 @@
+/**
+ * Implementation of the ClusterDecomposition class.
+ */
+
+#include "ClusterDecomposition.h"
+#include <algorithm>
+#include <cmath>
+#include <thread>
+
+/**
+ * Returns the root of a node in a union-find forest, compressing the path.
+ */
+static int findRoot(std::vector<int>& parent, int node)
+{
+    while (parent[node] != node)
+    {
+        parent[node] = parent[parent[node]];
+        node = parent[node];
+    }
+    return node;
+}
+
+/**
+ * Orders clusters from the most pairs to the fewest.
+ */
+static bool largerCluster(const std::vector<int>* a, const std::vector<int>* b)
+{
+    return a->size() > b->size();
+}
+
+/**
+ * Constructor. Splits the scene into clusters right away.
+ *
+ * Param: inModel - the scene to solve.
+ */
+ClusterDecomposition::ClusterDecomposition(HetNetModel* inModel) : 
+    model(inModel), uncoveredDevice(false), numThreads(1), budget(0)
+{
+    findClusters();
+}
+
+/**
+ * Destructor; frees the clusters and their tables.
+ */
+ClusterDecomposition::~ClusterDecomposition()
+{
+    for (size_t k = 0; k < clusters.size(); k++)
+    {
+        delete clusters[k];
+    }
+}
+
+/**
+ * Sets the limits of later solves (see Simplex::setBudget()). Each cluster's
+ * solves may take the budget's pivots; its deadline and cancellation cover
+ * the whole solve. A cluster that runs out of budget makes the solve 
+ * return LPSolution::TIMED_OUT without values, since the other clusters' 
+ * points for the same z would be missing.
+ *
+ * Param: inBudget - the limits, or 0 for none. It must outlive the solves.
+ */
+void ClusterDecomposition::setBudget(SolveBudget* inBudget)
+{
+    budget = inBudget;
+}
+
+/**
+ * Returns the number of clusters.
+ */
+int ClusterDecomposition::getNumClusters()
+{
+    return clusters.size();
+}
+
+/**
+ * Returns the number of pairs in a cluster. Clusters are numbered from the
+ * largest to the smallest.
+ */
+int ClusterDecomposition::getClusterSize(int cluster)
+{
+    return clusters[cluster]->pairs.size();
+}
+
+/**
+ * Finds the connected components of the device-access point graph with a
+ * union-find forest over the devices, numbered from 0, and the access 
+ * points, numbered after them, and builds the problem of each one.
+ */
+void ClusterDecomposition::findClusters()
+{
+    int numPairs = model->getNumPairs();
+    int numDevices = model->getNumDevices();
+    int numAps = model->getNumAccessPoints();
+
+    std::vector<int> parent(numDevices + numAps);
+    for (size_t node = 0; node < parent.size(); node++)
+    {
+        parent[node] = node;
+    }
+    std::vector<bool> covered(numDevices, false);
+    for (int p = 0; p < numPairs; p++)
+    {
+        int device = model->getPairDevice(p);
+        int a = findRoot(parent, device);
+        int b = findRoot(parent, numDevices + model->getPairAccessPoint(p));
+        parent[a] = b;
+        covered[device] = true;
+    }
+    for (int u = 0; u < numDevices; u++)
+    {
+        uncoveredDevice = uncoveredDevice || !covered[u];
+    }
+
+    // Group the pairs by component; they stay in the model's order.
+    std::vector<int> component(numDevices + numAps, -1);
+    std::vector<std::vector<int>*> groups;
+    for (int p = 0; p < numPairs; p++)
+    {
+        int root = findRoot(parent, model->getPairDevice(p));
+        if (component[root] == -1)
+        {
+            component[root] = groups.size();
+            groups.push_back(new std::vector<int>());
+        }
+        groups[component[root]]->push_back(p);
+    }
+    std::stable_sort(groups.begin(), groups.end(), largerCluster);
+
+    for (size_t k = 0; k < groups.size(); k++)
+    {
+        Cluster* cluster = new Cluster();
+        cluster->pairs.swap(*groups[k]);
+        delete groups[k];
+        buildCluster(cluster);
+        clusters.push_back(cluster);
+    }
+}
+
+/**
+ * Builds the problem of a cluster, as HetNetModel::buildLP() does for the
+ * whole scene, plus a last row -z <= 0 that later fixes z. The pairs' 
+ * objective coefficients are alpha and z's is 0.
+ *
+ * Param: cluster - the cluster, with its pairs set.
+ */
+void ClusterDecomposition::buildCluster(Cluster* cluster)
+{
+    std::vector<int>& pairs = cluster->pairs;
+    int numPairs = pairs.size();
+    int zCol = numPairs;
+
+    // The pairs are device-major, so a device's pairs are consecutive.
+    std::vector<int> deviceStart;
+    std::vector<int> localAp(model->getNumAccessPoints(), -1);
+    std::vector<std::vector<int> > apPairs;
+    cluster->sumRuaMax = 0;
+    for (int i = 0; i < numPairs; i++)
+    {
+        int device = model->getPairDevice(pairs[i]);
+        int ap = model->getPairAccessPoint(pairs[i]);
+        if (cluster->devices.empty() || cluster->devices.back() != device)
+        {
+            cluster->devices.push_back(device);
+            deviceStart.push_back(i);
+        }
+        if (localAp[ap] == -1)
+        {
+            localAp[ap] = cluster->aps.size();
+            cluster->aps.push_back(ap);
+            apPairs.push_back(std::vector<int>());
+        }
+        apPairs[localAp[ap]].push_back(i);
+        cluster->sumRuaMax += model->getPairRate(pairs[i]);
+    }
+    deviceStart.push_back(numPairs);
+
+    SparseLP& lp = cluster->lp;
+    lp.clear(numPairs + 1);
+    for (int i = 0; i < numPairs; i++)
+    {
+        lp.setObjective(i, model->getAlpha());
+    }
+    lp.setObjective(zCol, 0);
+
+    for (size_t a = 0; a < cluster->aps.size(); a++)
+    {
+        lp.addRow(SparseLP::LEQ, model->getAccessPointRate(cluster->aps[a]));
+        for (size_t i = 0; i < apPairs[a].size(); i++)
+        {
+            lp.addCoefficient(apPairs[a][i], 1);
+        }
+    }
+    for (int i = 0; i < numPairs; i++)
+    {
+        lp.addRow(SparseLP::LEQ, model->getPairRate(pairs[i]));
+        lp.addCoefficient(i, 1);
+    }
+    for (size_t u = 0; u < cluster->devices.size(); u++)
+    {
+        lp.addRow(SparseLP::LEQ, 0);
+        for (int i = deviceStart[u]; i < deviceStart[u + 1]; i++)
+        {
+            lp.addCoefficient(i, -1);
+        }
+        lp.addCoefficient(zCol, 1);
+    }
+    cluster->zRow = lp.getNumRows();
+    lp.addRow(SparseLP::LEQ, 0);
+    lp.addCoefficient(zCol, -1);
+}
+
+/**
+ * Runs a task on every cluster, spreading the clusters over the threads. 
+ * Clusters are sorted from the largest, so dealing them out in turn keeps
+ * the threads about equally busy.
+ *
+ * Param: task - MAX_Z_TASK, FIXED_Z_TASK or OWN_Z_TASK.
+ * Param: z - the fixed value of z, for FIXED_Z_TASK.
+ * Return: True if every cluster was solved.
+ */
+bool ClusterDecomposition::forEachCluster(int task, double z)
+{
+    int threadCount = std::min<int>(numThreads, clusters.size());
+    double alpha = model->getAlpha();
+    double beta = model->getBeta();
+    std::vector<std::thread> threads;
+    for (int t = 1; t < threadCount; t++)
+    {
+        threads.push_back(std::thread(runTask, &clusters, task, z, alpha, 
+                                      beta, budget, t, threadCount));
+    }
+    runTask(&clusters, task, z, alpha, beta, budget, 0,
+            std::max(threadCount, 1));
+    for (size_t t = 0; t < threads.size(); t++)
+    {
+        threads[t].join();
+    }
+
+    bool solved = true;
+    for (size_t k = 0; k < clusters.size(); k++)
+    {
+        solved = solved && clusters[k]->errorCode == LPSolution::SOLVED;
+    }
+    return solved;
+}
+
+/**
+ * Runs a task on clusters first, first + stride, ... on the calling thread.
+ * The tasks are:
+ *
+ *   MAX_Z_TASK:   solve the cluster for the largest z it can give every one
+ *                 of its devices, then set the objective back to alpha for
+ *                 each pair and 0 for z.
+ *   OWN_Z_TASK:   solve the cluster with beta times its own share of S as 
+ *                 the objective coefficient of z, then set it back to 0.
+ *   FIXED_Z_TASK: reoptimize the cluster with z fixed, keeping its value
+ *                 and the dual value of the row fixing z.
+ *
+ * The first two create the cluster's table, which the third one reuses.
+ * Every table is given the budget, which the threads share.
+ */
+void ClusterDecomposition::runTask(std::vector<Cluster*>* clusters, int task,
+                                   double z, double alpha, double beta,
+                                   SolveBudget* budget, int first, int stride)
+{
+    for (size_t k = first; k < clusters->size(); k += stride)
+    {
+        Cluster* cluster = (*clusters)[k];
+        int numPairs = cluster->pairs.size();
+        LPSolution* sol;
+        if (task == FIXED_Z_TASK)
+        {
+            cluster->simplex->changeRhs(cluster->zRow, -z);
+            sol = cluster->simplex->reoptimize();
+            cluster->dual = cluster->simplex->getDual(cluster->zRow);
+        }
+        else
+        {
+            if (task == MAX_Z_TASK)
+            {
+                for (int i = 0; i < numPairs; i++)
+                {
+                    cluster->lp.setObjective(i, 0);
+                }
+                cluster->lp.setObjective(numPairs, 1);
+            }
+            else
+            {
+                cluster->lp.setObjective(numPairs, beta * cluster->sumRuaMax);
+            }
+            delete cluster->simplex;
+            cluster->simplex = new Simplex(&cluster->lp);
+            cluster->simplex->setBudget(budget);
+            sol = cluster->simplex->solve();
+            for (int i = 0; i < numPairs && task == MAX_Z_TASK; i++)
+            {
+                cluster->simplex->changeObjective(i, alpha);
+            }
+            cluster->simplex->changeObjective(numPairs, 0);
+        }
+
+        cluster->errorCode = sol->getErrorCode();
+        cluster->value = sol->getZValue();
+        cluster->values.assign(numPairs + 1, 0);
+        if (sol->getOptimalValues())
+        {
+            cluster->values.assign(sol->getOptimalValues(),
+                                   sol->getOptimalValues() + numPairs + 1);
+        }
+        delete sol;
+    }
+}
+
+/**
+ * Evaluates F at a fixed z by solving every cluster.
+ *
+ * Param: z - the value of z.
+ * Param: value - receives F(z).
+ * Param: slope - receives the slope of F at z: beta * S minus the dual 
+ *                values of the rows fixing z.
+ * Return: False if some cluster could not be solved.
+ */
+bool ClusterDecomposition::evaluate(double z, double& value, double& slope)
+{
+    if (!forEachCluster(FIXED_Z_TASK, z))
+    {
+        return false;
+    }
+    double zCost = model->getBeta() * model->getSumRuaMax();
+    value = zCost * z;
+    slope = zCost;
+    for (size_t k = 0; k < clusters.size(); k++)
+    {
+        value += clusters[k]->value;
+        slope -= clusters[k]->dual;
+    }
+    return true;
+}
+
+/**
+ * Returns a solution carrying the error code of the first cluster that 
+ * could not be solved.
+ */
+LPSolution* ClusterDecomposition::failure()
+{
+    LPSolution* sol = new LPSolution();
+    for (size_t k = 0; k < clusters.size(); k++)
+    {
+        if (clusters[k]->errorCode != LPSolution::SOLVED)
+        {
+            sol->setErrorCode(clusters[k]->errorCode);
+            break;
+        }
+    }
+    return sol;
+}
+
+/**
+ * Combines the clusters' last solutions into a solution of the scene, 
+ * ordered as the model's columns.
+ *
+ * Param: z - the value of z the clusters were last solved with.
+ * Param: value - the objective value of the scene.
+ * Return: The solution.
+ */
+LPSolution* ClusterDecomposition::assemble(double z, double value)
+{
+    int numPairs = model->getNumPairs();
+    double* values = new double[numPairs + 1]();
+    for (size_t k = 0; k < clusters.size(); k++)
+    {
+        Cluster* cluster = clusters[k];
+        for (size_t i = 0; i < cluster->pairs.size(); i++)
+        {
+            values[cluster->pairs[i]] = cluster->values[i];
+        }
+    }
+    values[numPairs] = z;
+
+    LPSolution* sol = new LPSolution();
+    sol->setErrorCode(LPSolution::SOLVED);
+    sol->setOptimalValues(values);
+    sol->setNumOptimalValues(numPairs + 1);
+    sol->setZValue(value);
+    return sol;
+}
+
+/**
+ * Solves the scene cluster by cluster. A scene with a single cluster is
+ * solved as a whole, since there is nothing to split.
+ *
+ * Param: mode - EXACT or APPROXIMATE.
+ * Param: inNumThreads - the number of threads, or 0 for one per core.
+ * Return: The solution, ordered as the model's columns.
+ */
+LPSolution* ClusterDecomposition::solve(int mode, int inNumThreads)
+{
+    if (clusters.size() <= 1)
+    {
+        SparseLP lp;
+        model->buildLP(&lp);
+        Simplex simplex(&lp);
+        simplex.setBudget(budget);
+        return simplex.solve();
+    }
+    numThreads = inNumThreads;
+    if (numThreads <= 0)
+    {
+        numThreads = std::thread::hardware_concurrency();
+        numThreads = (numThreads > 0) ? numThreads : 1;
+    }
+
+    double z = 0, value = 0, slope = 0;
+
+    if (mode == APPROXIMATE)
+    {
+        // Each cluster picks its own z; the smallest one is the largest 
+        // that every cluster can give.
+        if (!forEachCluster(OWN_Z_TASK, 0))
+        {
+            return failure();
+        }
+        z = clusters[0]->values.back();
+        for (size_t k = 1; k < clusters.size(); k++)
+        {
+            z = std::min(z, clusters[k]->values.back());
+        }
+        z = uncoveredDevice ? 0 : std::max(z, 0.0);
+        if (!evaluate(z, value, slope))
+        {
+            return failure();
+        }
+        return assemble(z, value);
+    }
+
+    // Every z in [0, zMax] is feasible for every cluster.
+    if (!forEachCluster(MAX_Z_TASK, 0))
+    {
+        return failure();
+    }
+    double zMax = 0;
+    if (!uncoveredDevice)
+    {
+        zMax = clusters[0]->value;
+        for (size_t k = 1; k < clusters.size(); k++)
+        {
+            zMax = std::min(zMax, clusters[k]->value);
+        }
+        zMax = std::max(zMax, 0.0);
+    }
+
+    double lo = 0, loValue, loSlope;
+    if (!evaluate(lo, loValue, loSlope))
+    {
+        return failure();
+    }
+    if (loSlope <= 0 || zMax == 0)
+    {
+        return assemble(lo, loValue);
+    }
+    double hi = zMax, hiValue, hiSlope;
+    if (!evaluate(hi, hiValue, hiSlope))
+    {
+        return failure();
+    }
+    if (hiSlope >= 0)
+    {
+        return assemble(hi, hiValue);
+    }
+
+    // The maximum is in (lo, hi). Step to where the tangents at lo and hi
+    // meet. If F reaches the tangents there, that point is the maximum; 
+    // otherwise its slope tells which end it replaces. F is piecewise 
+    // linear, so this finds the breakpoint at the maximum exactly.
+    for (int step = 0; step < MAX_MASTER_STEPS; step++)
+    {
+        z = (hiValue - loValue + loSlope * lo - hiSlope * hi) / 
+            (loSlope - hiSlope);
+        if (!(z > lo && z < hi))
+        {
+            z = (lo + hi) / 2;
+        }
+        double predicted = loValue + loSlope * (z - lo);
+        if (!evaluate(z, value, slope))
+        {
+            return failure();
+        }
+        if (value >= predicted - 1e-9 * (1 + std::abs(predicted)) || 
+            slope == 0)
+        {
+            return assemble(z, value);
+        }
+        if (slope > 0)
+        {
+            lo = z;
+            loValue = value;
+            loSlope = slope;
+        }
+        else
+        {
+            hi = z;
+            hiValue = value;
+            hiSlope = slope;
+        }
+    }
+
+    z = (loValue >= hiValue) ? lo : hi;
+    if (!evaluate(z, value, slope))
+    {
+        return failure();
+    }
+    return assemble(z, value);
+}
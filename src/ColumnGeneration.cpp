@@ -0,0 +1,274 @@
+/**
+ * Implementation of the ColumnGeneration class.
+ */
+
+#include "ColumnGeneration.h"
+
+/**
+ * Constructor.
+ *
+ * Param: inModel - the scene to solve.
+ */
+ColumnGeneration::ColumnGeneration(HetNetModel* inModel) : model(inModel),
+                                                           simplex(0),
+                                                           budget(0),
+                                                           zVar(0),
+                                                           numRounds(0)
+{
+}
+
+/**
+ * Destructor; frees the master's table.
+ */
+ColumnGeneration::~ColumnGeneration()
+{
+    delete simplex;
+}
+
+/**
+ * Sets the limits of later solves (see Simplex::setBudget()). The master's
+ * first solve and each reoptimization may take the budget's pivots; its 
+ * deadline and cancellation cover the whole solve.
+ *
+ * Param: inBudget - the limits, or 0 for none. It must outlive the solves.
+ */
+void ColumnGeneration::setBudget(SolveBudget* inBudget)
+{
+    budget = inBudget;
+}
+
+/**
+ * Returns the number of pairs in the master problem after the last solve.
+ */
+int ColumnGeneration::getNumColumns()
+{
+    int count = 0;
+    for (size_t p = 0; p < pairVar.size(); p++)
+    {
+        count += (pairVar[p] != -1);
+    }
+    return count;
+}
+
+/**
+ * Returns the number of pricing rounds of the last solve.
+ */
+int ColumnGeneration::getNumRounds()
+{
+    return numRounds;
+}
+
+/**
+ * Builds the first master problem. Its rows are one capacity row per 
+ * access point, then one fairness row per device, then the bound rows of
+ * the pairs in the master. It starts out with the pair of each device with
+ * the highest r_ua,max, so every device can get some rate and z can be
+ * positive from the start.
+ */
+void ColumnGeneration::buildMaster()
+{
+    int numPairs = model->getNumPairs();
+    int numAps = model->getNumAccessPoints();
+    int numDevices = model->getNumDevices();
+    double alpha = model->getAlpha();
+
+    std::vector<int> best(numDevices, -1);
+    for (int p = 0; p < numPairs; p++)
+    {
+        int u = model->getPairDevice(p);
+        if (best[u] == -1 || model->getPairRate(p) > model->getPairRate(best[u]))
+        {
+            best[u] = p;
+        }
+    }
+    std::vector<int> initial;
+    pairVar.assign(numPairs, -1);
+    for (int u = 0; u < numDevices; u++)
+    {
+        if (best[u] != -1)
+        {
+            pairVar[best[u]] = initial.size();
+            initial.push_back(best[u]);
+        }
+    }
+    int numColumns = initial.size();
+    zVar = numColumns;
+
+    lp.clear(numColumns + 1);
+    for (int i = 0; i < numColumns; i++)
+    {
+        lp.setObjective(i, alpha);
+    }
+    lp.setObjective(zVar, model->getBeta() * model->getSumRuaMax());
+
+    std::vector<std::vector<int> > apColumns(numAps);
+    for (int i = 0; i < numColumns; i++)
+    {
+        apColumns[model->getPairAccessPoint(initial[i])].push_back(i);
+    }
+    for (int a = 0; a < numAps; a++)
+    {
+        lp.addRow(SparseLP::LEQ, model->getAccessPointRate(a));
+        for (size_t k = 0; k < apColumns[a].size(); k++)
+        {
+            lp.addCoefficient(apColumns[a][k], 1);
+        }
+    }
+    for (int u = 0; u < numDevices; u++)
+    {
+        lp.addRow(SparseLP::LEQ, 0);
+        if (best[u] != -1)
+        {
+            lp.addCoefficient(pairVar[best[u]], -1);
+        }
+        lp.addCoefficient(zVar, 1);
+    }
+    for (int i = 0; i < numColumns; i++)
+    {
+        lp.addRow(SparseLP::LEQ, model->getPairRate(initial[i]));
+        lp.addCoefficient(i, 1);
+    }
+
+    delete simplex;
+    simplex = new Simplex(&lp);
+    simplex->setBudget(budget);
+}
+
+/**
+ * Prices the pairs that are not in the master and adds the ones with a 
+ * positive reduced cost, at most one per device (the one with the highest
+ * reduced cost), so the master grows a little at a time. Each new pair
+ * gets a column and a bound row.
+ *
+ * Return: The number of pairs added.
+ */
+int ColumnGeneration::priceColumns()
+{
+    int numPairs = model->getNumPairs();
+    int numAps = model->getNumAccessPoints();
+    int numDevices = model->getNumDevices();
+    double alpha = model->getAlpha();
+
+    std::vector<double> capacityDual(numAps);
+    for (int a = 0; a < numAps; a++)
+    {
+        capacityDual[a] = simplex->getDual(a);
+    }
+
+    std::vector<int> entering(numDevices, -1);
+    std::vector<double> bestCost(numDevices, Simplex::ZERO_TOLERANCE);
+    for (int p = 0; p < numPairs; p++)
+    {
+        if (pairVar[p] != -1)
+        {
+            continue;
+        }
+        int u = model->getPairDevice(p);
+        double reducedCost = alpha - capacityDual[model->getPairAccessPoint(p)]
+                             + simplex->getDual(numAps + u);
+        if (reducedCost > bestCost[u])
+        {
+            bestCost[u] = reducedCost;
+            entering[u] = p;
+        }
+    }
+
+    std::vector<int> added;
+    std::vector<double> costs;
+    std::vector<int> colStart;
+    std::vector<int> rowIndex;
+    std::vector<double> values;
+    for (int u = 0; u < numDevices; u++)
+    {
+        if (entering[u] != -1)
+        {
+            int p = entering[u];
+            added.push_back(p);
+            costs.push_back(alpha);
+            colStart.push_back(rowIndex.size());
+            rowIndex.push_back(model->getPairAccessPoint(p));
+            values.push_back(1);
+            rowIndex.push_back(numAps + u);
+            values.push_back(-1);
+        }
+    }
+    int count = added.size();
+    if (count == 0)
+    {
+        return 0;
+    }
+    colStart.push_back(rowIndex.size());
+
+    int firstVar = simplex->addColumns(count, costs.data(), colStart.data(),
+                                       rowIndex.data(), values.data());
+    for (int k = 0; k < count; k++)
+    {
+        int var = firstVar + k;
+        double one = 1;
+        pairVar[added[k]] = var;
+        simplex->addRow(1, &var, &one, model->getPairRate(added[k]));
+    }
+    return count;
+}
+
+/**
+ * Solves the scene by column generation. If the budget runs out, the 
+ * master's last feasible point is returned with LPSolution::TIMED_OUT; 
+ * the pairs left out of the master carry no rate, so it is feasible for
+ * the whole scene too.
+ *
+ * Return: The solution, ordered as the model's columns.
+ */
+LPSolution* ColumnGeneration::solve()
+{
+    buildMaster();
+    LPSolution* sol = simplex->solve();
+    numRounds = 0;
+    while (sol->getErrorCode() == LPSolution::SOLVED && priceColumns() > 0)
+    {
+        if (numRounds == MAX_ROUNDS)
+        {
+            // Pricing still found columns, so the master is not optimal.
+            sol->setErrorCode(LPSolution::EXCEEDED_MAX_ITERATIONS);
+            return toModelOrder(sol);
+        }
+        delete sol;
+        sol = simplex->reoptimize();
+        numRounds++;
+    }
+    if (sol->getErrorCode() != LPSolution::SOLVED &&
+        (sol->getErrorCode() != LPSolution::TIMED_OUT ||
+         sol->getNumOptimalValues() <= zVar))
+    {
+        return sol;
+    }
+    return toModelOrder(sol);
+}
+
+/**
+ * Reorders the values of a solution of the master as the model's columns: 
+ * one per pair in range, 0 for the pairs never added or added after the 
+ * solution was found, followed by z.
+ *
+ * Param: sol - a solution of the master.
+ * Return: sol, with its values replaced.
+ */
+LPSolution* ColumnGeneration::toModelOrder(LPSolution* sol)
+{
+    int numPairs = pairVar.size();
+    int numMasterValues = sol->getNumOptimalValues();
+    double* masterValues = sol->getOptimalValues();
+    double* values = new double[numPairs + 1]();
+    for (int p = 0; p < numPairs; p++)
+    {
+        if (pairVar[p] != -1 && pairVar[p] < numMasterValues)
+        {
+            values[p] = masterValues[pairVar[p]];
+        }
+    }
+    values[numPairs] = masterValues[zVar];
+    delete [] masterValues;
+    sol->setOptimalValues(values);
+    sol->setNumOptimalValues(numPairs + 1);
+    return sol;
+}
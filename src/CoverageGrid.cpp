@@ -0,0 +1,148 @@
+/**
+ * Implementation of the CoverageGrid spatial index.
+ */
+
+#include "CoverageGrid.h"
+#include <algorithm>
+#include <cmath>
+
+/**
+ * Constructor for an empty grid. Every lookup returns no access points until
+ * build() is called.
+ */
+CoverageGrid::CoverageGrid() : originX(0), originY(0), cellSize(1),
+                               cellsX(1), cellsY(1)
+{
+    cellStart.assign(2, 0);
+}
+
+/**
+ * Builds the grid over a set of coverage circles. The grid covers the
+ * bounding box of every circle. Cells are about as wide as the average
+ * radius, but never so small that there are more than CELLS_PER_AP cells per
+ * access point, which keeps the grid small for sparse scenes.
+ *
+ * Param: x - x coordinates of the access points.
+ * Param: y - y coordinates of the access points.
+ * Param: radius - ranges of the access points.
+ * Param: numAps - number of access points.
+ */
+void CoverageGrid::build(const double* x, const double* y,
+                         const double* radius, int numAps)
+{
+    cellStart.clear();
+    cellAps.clear();
+    if (numAps == 0)
+    {
+        cellsX = cellsY = 1;
+        cellStart.assign(2, 0);
+        return;
+    }
+
+    double minX = x[0] - radius[0], maxX = x[0] + radius[0];
+    double minY = y[0] - radius[0], maxY = y[0] + radius[0];
+    double sumRadius = 0;
+    for (int a = 0; a < numAps; a++)
+    {
+        minX = std::min(minX, x[a] - radius[a]);
+        maxX = std::max(maxX, x[a] + radius[a]);
+        minY = std::min(minY, y[a] - radius[a]);
+        maxY = std::max(maxY, y[a] + radius[a]);
+        sumRadius += radius[a];
+    }
+
+    double width = std::max(maxX - minX, 1e-9);
+    double height = std::max(maxY - minY, 1e-9);
+    cellSize = std::max(sumRadius / numAps,
+                        std::sqrt(width * height / (CELLS_PER_AP * numAps)));
+    cellSize = std::max(cellSize, 1e-9);
+    originX = minX;
+    originY = minY;
+    cellsX = std::max(1, (int) std::ceil(width / cellSize));
+    cellsY = std::max(1, (int) std::ceil(height / cellSize));
+
+    // Count the access points of each cell, then place them. Access points
+    // are visited in increasing order, so each cell's list stays sorted.
+    int numCells = cellsX * cellsY;
+    cellStart.assign(numCells + 1, 0);
+    for (int pass = 0; pass < 2; pass++)
+    {
+        if (pass == 1)
+        {
+            for (int c = 0; c < numCells; c++)
+            {
+                cellStart[c + 1] += cellStart[c];
+            }
+            cellAps.resize(cellStart[numCells]);
+        }
+        std::vector<int> fill(cellStart.begin(), cellStart.end() - 1);
+        for (int a = 0; a < numAps; a++)
+        {
+            int x0 = clampX(x[a] - radius[a]), x1 = clampX(x[a] + radius[a]);
+            int y0 = clampY(y[a] - radius[a]), y1 = clampY(y[a] + radius[a]);
+            for (int cy = y0; cy <= y1; cy++)
+            {
+                for (int cx = x0; cx <= x1; cx++)
+                {
+                    int cell = cy * cellsX + cx;
+                    if (pass == 0)
+                    {
+                        cellStart[cell + 1]++;
+                    }
+                    else
+                    {
+                        cellAps[fill[cell]++] = a;
+                    }
+                }
+            }
+        }
+    }
+}
+
+/**
+ * Returns the column of the cell containing x, clamped to the grid.
+ */
+int CoverageGrid::clampX(double x)
+{
+    int cx = (int) std::floor((x - originX) / cellSize);
+    return std::min(std::max(cx, 0), cellsX - 1);
+}
+
+/**
+ * Returns the row of the cell containing y, clamped to the grid.
+ */
+int CoverageGrid::clampY(double y)
+{
+    int cy = (int) std::floor((y - originY) / cellSize);
+    return std::min(std::max(cy, 0), cellsY - 1);
+}
+
+/**
+ * Returns the cell containing a point. Points outside of the grid are mapped
+ * to the nearest border cell; no coverage circle reaches them, so every
+ * candidate found there is rejected by the distance check.
+ *
+ * Param: x - x coordinate of the point.
+ * Param: y - y coordinate of the point.
+ * Return: The cell index.
+ */
+int CoverageGrid::getCell(double x, double y)
+{
+    return clampY(y) * cellsX + clampX(x);
+}
+
+/**
+ * Returns a pointer to the first candidate access point of a cell.
+ */
+const int* CoverageGrid::cellBegin(int cell)
+{
+    return cellAps.data() + cellStart[cell];
+}
+
+/**
+ * Returns a pointer one past the last candidate access point of a cell.
+ */
+const int* CoverageGrid::cellEnd(int cell)
+{
+    return cellAps.data() + cellStart[cell + 1];
+}
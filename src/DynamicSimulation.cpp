@@ -0,0 +1,516 @@
+/**
+ * Implementation of the DynamicSimulation class.
+ */
+
+#include "DynamicSimulation.h"
+#include "Solver.h"
+#include <thread>
+
+/**
+ * Constructor for a simulation of the given scene. The scene is updated in
+ * place as ticks are applied.
+ *
+ * Param: inModel - the scene to simulate.
+ */
+DynamicSimulation::DynamicSimulation(HetNetModel* inModel) : model(inModel),
+                                                             warmStart(true),
+                                                             simplex(0),
+                                                             budget(0),
+                                                             heldBytes(0),
+                                                             zVar(0),
+                                                             firstFairnessRow(0),
+                                                             builtAps(0),
+                                                             builtDevices(0),
+                                                             builtAlpha(0),
+                                                             numRebuilds(0)
+{
+}
+
+/**
+ * Destructor; frees the table of the last solve.
+ */
+DynamicSimulation::~DynamicSimulation()
+{
+    delete simplex;
+    Solver::getInstance().releaseMemory(heldBytes);
+}
+
+/**
+ * Enables or disables reoptimizing the previous table. Disabling it makes
+ * every tick a cold solve, which is mostly useful for comparisons.
+ */
+void DynamicSimulation::setWarmStart(bool inWarmStart)
+{
+    warmStart = inWarmStart;
+}
+
+/**
+ * Sets the limits of each later tick's solve (see Simplex::setBudget()).
+ * A tick that runs out of budget returns LPSolution::TIMED_OUT, with the
+ * best feasible point it reached if it has one; the table is kept for the
+ * next tick.
+ *
+ * Param: inBudget - the limits, or 0 for none. It must outlive the solves.
+ */
+void DynamicSimulation::setBudget(SolveBudget* inBudget)
+{
+    budget = inBudget;
+    if (simplex)
+    {
+        simplex->setBudget(budget);
+    }
+}
+
+/**
+ * Moves the devices of a tick without solving.
+ *
+ * Param: tick - the moves to apply.
+ * Return: False if a move names a device the scene does not have; such 
+ *         moves are skipped.
+ */
+bool DynamicSimulation::applyTick(Tick& tick)
+{
+    bool valid = true;
+    for (int i = 0; i < tick.getNumMoves(); i++)
+    {
+        valid = model->moveDevice(tick.devices[i], tick.x[i], tick.y[i]) &&
+                valid;
+    }
+    return valid;
+}
+
+/**
+ * Solves the scene in its current state. If the previous table can be 
+ * reused, the changes since the last solve are applied to it and it is 
+ * reoptimized: moves only change the bounds r_ua,max of the moved devices'
+ * pairs, which the dual simplex method repairs in a few pivots. Otherwise,
+ * or if reoptimizing fails other than by running out of budget, the 
+ * problem is built and solved from scratch.
+ *
+ * Return: The solution, ordered as the model's columns, or one with
+ *         LPSolution::REJECTED if a new table did not fit in the Solver's
+ *         memory limit.
+ */
+LPSolution* DynamicSimulation::solve()
+{
+    if (!canUpdate())
+    {
+        return rebuild();
+    }
+
+    updateTable();
+    LPSolution* sol = simplex->reoptimize();
+    if (sol->getErrorCode() == LPSolution::TIMED_OUT)
+    {
+        // Solving from scratch would only run out of budget again.
+        return sol->getOptimalValues() ? toModelOrder(sol) : sol;
+    }
+    if (sol->getErrorCode() != LPSolution::SOLVED)
+    {
+        delete sol;
+        return rebuild();
+    }
+    return toModelOrder(sol);
+}
+
+/**
+ * Returns true if the previous table can be updated to the current scene:
+ * there is one, no access points or devices were added since it was built,
+ * and it has not collected too many stale slots.
+ */
+bool DynamicSimulation::canUpdate()
+{
+    return warmStart && simplex &&
+           model->getNumAccessPoints() == builtAps &&
+           model->getNumDevices() == builtDevices &&
+           (int) slotVar.size() <= 
+               MAX_SLOTS_PER_PAIR * model->getNumPairs() + builtDevices;
+}
+
+/**
+ * Builds the problem for the current scene and solves it from scratch. The
+ * columns of the new table are the model's columns, so every pair gets the
+ * slot of the same index. The table is admitted by the Solver's memory 
+ * limit with its size when built; slots added by later ticks grow it 
+ * past that until the next rebuild.
+ *
+ * Return: The solution, or one with LPSolution::REJECTED if the table did
+ *         not fit.
+ */
+LPSolution* DynamicSimulation::rebuild()
+{
+    model->buildLP(&lp);
+    delete simplex;
+    simplex = 0;
+    Solver& solver = Solver::getInstance();
+    solver.releaseMemory(heldBytes);
+    heldBytes = Simplex::predictPeakBytes(&lp);
+    if (!solver.acquireMemory(heldBytes))
+    {
+        LPSolution* sol = new LPSolution();
+        sol->setErrorCode(LPSolution::REJECTED);
+        sol->getStats().setEngine("rejected");
+        sol->getStats().setPredictedTableBytes(heldBytes);
+        heldBytes = 0;
+        return sol;
+    }
+    simplex = new Simplex(&lp);
+    simplex->setBudget(budget);
+    numRebuilds++;
+
+    int numPairs = model->getNumPairs();
+    builtAps = model->getNumAccessPoints();
+    builtDevices = model->getNumDevices();
+    builtAlpha = model->getAlpha();
+    zVar = numPairs;
+    firstFairnessRow = builtAps + numPairs;
+
+    slotAp.resize(numPairs);
+    slotVar.resize(numPairs);
+    slotRow.resize(numPairs);
+    slotRate.resize(numPairs);
+    pairSlot.resize(numPairs);
+    deviceSlots.assign(builtDevices, std::vector<int>());
+    for (int p = 0; p < numPairs; p++)
+    {
+        slotAp[p] = model->getPairAccessPoint(p);
+        slotVar[p] = p;
+        slotRow[p] = builtAps + p;
+        slotRate[p] = model->getPairRate(p);
+        pairSlot[p] = p;
+        deviceSlots[model->getPairDevice(p)].push_back(p);
+    }
+    LPSolution* sol = simplex->solve();
+    sol->getStats().setPredictedTableBytes(heldBytes);
+    return sol;
+}
+
+/**
+ * Applies the changes to the scene since the last solve to the table: new
+ * bounds for the pairs whose r_ua,max changed, a bound of 0 for the pairs 
+ * that left range, a new slot for each pair that came into range, and the
+ * new objective coefficients.
+ */
+void DynamicSimulation::updateTable()
+{
+    int numPairs = model->getNumPairs();
+    std::vector<bool> inRange(slotVar.size(), false);
+    std::vector<int> newPairs;
+    pairSlot.resize(numPairs);
+
+    for (int p = 0; p < numPairs; p++)
+    {
+        int device = model->getPairDevice(p);
+        int ap = model->getPairAccessPoint(p);
+        std::vector<int>& slots = deviceSlots[device];
+        int slot = -1;
+        for (size_t i = 0; i < slots.size() && slot == -1; i++)
+        {
+            if (slotAp[slots[i]] == ap)
+            {
+                slot = slots[i];
+            }
+        }
+
+        pairSlot[p] = slot;
+        if (slot == -1)
+        {
+            newPairs.push_back(p);
+        }
+        else
+        {
+            inRange[slot] = true;
+            if (slotRate[slot] != model->getPairRate(p))
+            {
+                slotRate[slot] = model->getPairRate(p);
+                simplex->changeRhs(slotRow[slot], slotRate[slot]);
+            }
+        }
+    }
+
+    for (size_t slot = 0; slot < inRange.size(); slot++)
+    {
+        if (!inRange[slot] && slotRate[slot] != 0)
+        {
+            slotRate[slot] = 0;
+            simplex->changeRhs(slotRow[slot], 0);
+        }
+    }
+
+    // Each new pair's column has a 1 in its access point's capacity row and
+    // a -1 in its device's fairness row.
+    int count = newPairs.size();
+    if (count > 0)
+    {
+        std::vector<double> costs(count, model->getAlpha());
+        std::vector<int> colStart(count + 1);
+        std::vector<int> rowIndex(2 * count);
+        std::vector<double> values(2 * count);
+        for (int k = 0; k < count; k++)
+        {
+            int p = newPairs[k];
+            colStart[k] = 2 * k;
+            rowIndex[2 * k] = model->getPairAccessPoint(p);
+            values[2 * k] = 1;
+            rowIndex[2 * k + 1] = firstFairnessRow + model->getPairDevice(p);
+            values[2 * k + 1] = -1;
+        }
+        colStart[count] = 2 * count;
+        int firstVar = simplex->addColumns(count, costs.data(), 
+                                           colStart.data(), rowIndex.data(),
+                                           values.data());
+
+        for (int k = 0; k < count; k++)
+        {
+            int p = newPairs[k];
+            int slot = slotVar.size();
+            int var = firstVar + k;
+            double one = 1;
+            slotAp.push_back(model->getPairAccessPoint(p));
+            slotVar.push_back(var);
+            slotRate.push_back(model->getPairRate(p));
+            slotRow.push_back(simplex->addRow(1, &var, &one,
+                                              model->getPairRate(p)));
+            deviceSlots[model->getPairDevice(p)].push_back(slot);
+            pairSlot[p] = slot;
+        }
+    }
+
+    if (model->getAlpha() != builtAlpha)
+    {
+        for (size_t slot = 0; slot < slotVar.size(); slot++)
+        {
+            simplex->changeObjective(slotVar[slot], model->getAlpha());
+        }
+        builtAlpha = model->getAlpha();
+    }
+    simplex->changeObjective(zVar, model->getBeta() * model->getSumRuaMax());
+}
+
+/**
+ * Reorders the values of a solution of the updated table as the model's
+ * columns: one per pair in range, followed by z.
+ *
+ * Param: sol - a solution of the updated table.
+ * Return: sol, with its values replaced.
+ */
+LPSolution* DynamicSimulation::toModelOrder(LPSolution* sol)
+{
+    int numPairs = pairSlot.size();
+    double* tableValues = sol->getOptimalValues();
+    double* values = new double[numPairs + 1];
+    for (int p = 0; p < numPairs; p++)
+    {
+        values[p] = tableValues[slotVar[pairSlot[p]]];
+    }
+    values[numPairs] = tableValues[zVar];
+    delete [] tableValues;
+    sol->setOptimalValues(values);
+    sol->setNumOptimalValues(numPairs + 1);
+    return sol;
+}
+
+/**
+ * Advances the simulation by one tick and solves it.
+ *
+ * Param: tick - the moves to apply.
+ * Return: The solution of the scene after the tick.
+ */
+LPSolution* DynamicSimulation::step(Tick& tick)
+{
+    applyTick(tick);
+    return solve();
+}
+
+/**
+ * Returns the number of times the table was built and solved from scratch
+ * rather than reoptimized, the first solve included.
+ */
+int DynamicSimulation::getNumRebuilds()
+{
+    return numRebuilds;
+}
+
+/**
+ * Solves a trace as it is read from a file. A separate thread parses the
+ * trace into a bounded queue while this one solves the ticks, so parsing
+ * overlaps with solving and at most queueCapacity ticks are in memory at 
+ * once, however long the trace is.
+ *
+ * Param: reader - an open trace.
+ * Param: callback - called with the solution of each tick, in order.
+ * Param: data - passed to the callback.
+ * Param: queueCapacity - the number of ticks that may be read ahead, or 0
+ *                        for TickQueue::DEFAULT_CAPACITY.
+ * Return: The number of ticks solved. If the trace stopped at a malformed
+ *         record, such as one for a device the scene does not have, 
+ *         reader->hasError() is true afterwards.
+ */
+int DynamicSimulation::runTrace(TraceReader* reader, TickCallback callback,
+                                void* data, int queueCapacity)
+{
+    if (queueCapacity <= 0)
+    {
+        queueCapacity = TickQueue::DEFAULT_CAPACITY;
+    }
+    reader->setNumDevices(model->getNumDevices());
+    TickQueue queue(queueCapacity);
+    std::thread producer(produceTicks, reader, &queue);
+
+    int numTicks = 0;
+    Tick tick;
+    while (queue.pop(tick))
+    {
+        LPSolution* sol = step(tick);
+        callback(tick, sol, data);
+        delete sol;
+        numTicks++;
+    }
+    producer.join();
+    return numTicks;
+}
+
+/**
+ * Reads every tick of a trace into a queue, then closes the queue.
+ */
+void DynamicSimulation::produceTicks(TraceReader* reader, TickQueue* queue)
+{
+    Tick tick;
+    while (reader->readTick(tick))
+    {
+        queue->push(tick);
+    }
+    queue->close();
+}
+
+/**
+ * Returns the number of threads to use when none is given: one per core.
+ */
+int DynamicSimulation::defaultThreads()
+{
+    int cores = std::thread::hardware_concurrency();
+    return (cores > 0) ? cores : 1;
+}
+
+/**
+ * Solves a whole trace of ticks. The trace is split into numThreads
+ * contiguous chunks that are solved concurrently; within each chunk, ticks
+ * reoptimize the table of the previous tick. Device positions are absolute,
+ * so each chunk starts from a copy of the scene with every earlier move 
+ * applied, and the results do not depend on the number of threads.
+ *
+ * Param: model - the scene before the first tick. It is not modified.
+ * Param: ticks - the trace.
+ * Param: numThreads - number of threads to use, or 0 for one per core.
+ * Return: The solution after each tick, in order. The caller frees them.
+ */
+std::vector<LPSolution*> DynamicSimulation::run(HetNetModel* model,
+                                                std::vector<Tick>& ticks,
+                                                int numThreads)
+{
+    int numTicks = ticks.size();
+    std::vector<LPSolution*> results(numTicks, (LPSolution*) 0);
+    if (numThreads <= 0)
+    {
+        numThreads = defaultThreads();
+    }
+    if (numThreads > numTicks)
+    {
+        numThreads = numTicks;
+    }
+
+    std::vector<std::thread> threads;
+    for (int t = 1; t < numThreads; t++)
+    {
+        int begin = (long long) numTicks * t / numThreads;
+        int end = (long long) numTicks * (t + 1) / numThreads;
+        threads.push_back(std::thread(runChunk, model, &ticks, begin, end,
+                                      &results));
+    }
+    runChunk(model, &ticks, 0, (numThreads > 0) ? numTicks / numThreads : 0,
+             &results);
+    for (size_t t = 0; t < threads.size(); t++)
+    {
+        threads[t].join();
+    }
+    return results;
+}
+
+/**
+ * Solves ticks [begin, end) of a trace on the calling thread.
+ *
+ * Param: model - the scene before the first tick of the trace.
+ * Param: ticks - the trace.
+ * Param: begin - the first tick to solve.
+ * Param: end - one past the last tick to solve.
+ * Param: results - receives the solution of each tick.
+ */
+void DynamicSimulation::runChunk(HetNetModel* model, std::vector<Tick>* ticks,
+                                 int begin, int end,
+                                 std::vector<LPSolution*>* results)
+{
+    HetNetModel chunkModel(*model);
+    DynamicSimulation simulation(&chunkModel);
+    for (int i = 0; i < begin; i++)
+    {
+        simulation.applyTick((*ticks)[i]);
+    }
+    for (int i = begin; i < end; i++)
+    {
+        (*results)[i] = simulation.step((*ticks)[i]);
+    }
+}
+
+/**
+ * Solves independent scenes concurrently, such as the same scene under
+ * different weights. Each thread solves a contiguous range of scenes.
+ *
+ * Param: scenarios - the scenes to solve.
+ * Param: numThreads - number of threads to use, or 0 for one per core.
+ * Return: The solution of each scene, in order. The caller frees them.
+ */
+std::vector<LPSolution*> DynamicSimulation::solveScenarios(
+        std::vector<HetNetModel*>& scenarios, int numThreads)
+{
+    int numScenarios = scenarios.size();
+    std::vector<LPSolution*> results(numScenarios, (LPSolution*) 0);
+    if (numThreads <= 0)
+    {
+        numThreads = defaultThreads();
+    }
+    if (numThreads > numScenarios)
+    {
+        numThreads = numScenarios;
+    }
+
+    std::vector<std::thread> threads;
+    for (int t = 1; t < numThreads; t++)
+    {
+        int begin = (long long) numScenarios * t / numThreads;
+        int end = (long long) numScenarios * (t + 1) / numThreads;
+        threads.push_back(std::thread(solveScenarioRange, &scenarios, begin,
+                                      end, &results));
+    }
+    solveScenarioRange(&scenarios, 0,
+                       (numThreads > 0) ? numScenarios / numThreads : 0,
+                       &results);
+    for (size_t t = 0; t < threads.size(); t++)
+    {
+        threads[t].join();
+    }
+    return results;
+}
+
+/**
+ * Solves scenes [begin, end) on the calling thread.
+ */
+void DynamicSimulation::solveScenarioRange(std::vector<HetNetModel*>* scenarios,
+                                           int begin, int end,
+                                           std::vector<LPSolution*>* results)
+{
+    for (int i = begin; i < end; i++)
+    {
+        DynamicSimulation simulation((*scenarios)[i]);
+        (*results)[i] = simulation.solve();
+    }
+}
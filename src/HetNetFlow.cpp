@@ -0,0 +1,213 @@
+/**
+ * Implementation of the HetNetFlow class.
+ */
+
+#include "HetNetFlow.h"
+#include "MaxFlow.h"
+#include <algorithm>
+#include <cmath>
+
+/** The nodes of the flow network: the source and sink come first, then the
+ * devices, then the access points. */
+static const int SOURCE = 0;
+static const int SINK = 1;
+
+/**
+ * Constructor.
+ *
+ * Param: inModel - the scene to solve. It is not modified.
+ */
+HetNetFlow::HetNetFlow(HetNetModel* inModel) : model(inModel), numFlows(0)
+{
+}
+
+/**
+ * Finds the most throughput the scene can carry while every device gets at
+ * least z.
+ *
+ * Param: z - the rate every device must get.
+ * Param: rates - receives the rate of every pair.
+ * Return: The throughput, or -1 if some device cannot get z.
+ */
+double HetNetFlow::maxThroughput(double z, std::vector<double>& rates)
+{
+    int numDevices = model->getNumDevices();
+    int numAps = model->getNumAccessPoints();
+    int numPairs = model->getNumPairs();
+    numFlows++;
+
+    MaxFlow flow(2 + numDevices + numAps);
+    std::vector<int> pairEdge(numPairs);
+    std::vector<double> deviceRate(numDevices, 0);
+    for (int p = 0; p < numPairs; p++)
+    {
+        int device = model->getPairDevice(p);
+        pairEdge[p] = flow.addEdge(2 + device,
+                                   2 + numDevices + model->getPairAccessPoint(p),
+                                   model->getPairRate(p));
+        deviceRate[device] += model->getPairRate(p);
+    }
+    for (int a = 0; a < numAps; a++)
+    {
+        flow.addEdge(2 + numDevices + a, SINK, model->getAccessPointRate(a));
+    }
+
+    // Give every device z first, then whatever else fits on top.
+    std::vector<int> floorEdge(numDevices);
+    for (int u = 0; u < numDevices; u++)
+    {
+        floorEdge[u] = flow.addEdge(SOURCE, 2 + u, z);
+    }
+    flow.solve(SOURCE, SINK);
+    for (int u = 0; u < numDevices; u++)
+    {
+        if (flow.getFlow(floorEdge[u]) < z * (1 - SEARCH_TOLERANCE))
+        {
+            return -1;
+        }
+        flow.fixFlow(floorEdge[u]);
+        if (deviceRate[u] > z)
+        {
+            flow.addEdge(SOURCE, 2 + u, deviceRate[u] - z);
+        }
+    }
+    double throughput = flow.solve(SOURCE, SINK);
+
+    rates.resize(numPairs);
+    for (int p = 0; p < numPairs; p++)
+    {
+        rates[p] = flow.getFlow(pairEdge[p]);
+    }
+    return throughput;
+}
+
+/**
+ * Solves the scene.
+ *
+ * Return: The solution, ordered as the model's columns.
+ */
+LPSolution* HetNetFlow::solve()
+{
+    int numDevices = model->getNumDevices();
+    int numPairs = model->getNumPairs();
+    double alpha = model->getAlpha();
+    double zWeight = model->getBeta() * model->getSumRuaMax();
+    numFlows = 0;
+
+    // No device can get more than all of its pairs together.
+    std::vector<double> deviceRate(numDevices, 0);
+    for (int p = 0; p < numPairs; p++)
+    {
+        deviceRate[model->getPairDevice(p)] += model->getPairRate(p);
+    }
+    double zLow = 0;
+    double zHigh = numDevices > 0 ?
+                   *std::min_element(deviceRate.begin(), deviceRate.end()) : 0;
+
+    std::vector<double> rates;
+    if (maxThroughput(zHigh, rates) >= 0)
+    {
+        zLow = zHigh;
+    }
+    for (int step = 0; step < MAX_STEPS &&
+                       zHigh - zLow > SEARCH_TOLERANCE * zHigh; step++)
+    {
+        double z = (zLow + zHigh) / 2;
+        if (maxThroughput(z, rates) >= 0)
+        {
+            zLow = z;
+        }
+        else
+        {
+            zHigh = z;
+        }
+    }
+    double zMax = zLow;
+
+    // Golden section search for the best z in [0, zMax], keeping the best
+    // point seen, which includes both ends.
+    double ratio = (std::sqrt(5.0) - 1) / 2;
+    double low = 0, high = zMax;
+    double z[2] = {high - ratio * (high - low), low + ratio * (high - low)};
+    double value[2];
+    double ends[2] = {0, zMax};
+    std::vector<double> bestRates;
+    double best = -HUGE_VAL;
+    double bestZ = 0;
+    for (int i = 0; i < 4; i++)
+    {
+        double point = (i < 2) ? ends[i] : z[i - 2];
+        double throughput = maxThroughput(point, rates);
+        double objective = (throughput < 0) ? -HUGE_VAL :
+                           alpha * throughput + zWeight * point;
+        if (i >= 2)
+        {
+            value[i - 2] = objective;
+        }
+        if (throughput >= 0 && objective > best)
+        {
+            best = objective;
+            bestRates = rates;
+            bestZ = point;
+        }
+    }
+    for (int step = 0; step < MAX_STEPS &&
+                       high - low > SEARCH_TOLERANCE * zMax; step++)
+    {
+        int probe;
+        if (value[0] < value[1])
+        {
+            low = z[0];
+            z[0] = z[1];
+            value[0] = value[1];
+            z[1] = low + ratio * (high - low);
+            probe = 1;
+        }
+        else
+        {
+            high = z[1];
+            z[1] = z[0];
+            value[1] = value[0];
+            z[0] = high - ratio * (high - low);
+            probe = 0;
+        }
+        double throughput = maxThroughput(z[probe], rates);
+        value[probe] = (throughput < 0) ? -HUGE_VAL :
+                       alpha * throughput + zWeight * z[probe];
+        if (throughput >= 0 && value[probe] > best)
+        {
+            best = value[probe];
+            bestRates = rates;
+            bestZ = z[probe];
+        }
+    }
+
+    // Report the z the rates actually give, which is at least bestZ up to
+    // rounding.
+    std::vector<double> received(numDevices, 0);
+    double* values = new double[numPairs + 1]();
+    double total = 0;
+    for (int p = 0; p < numPairs; p++)
+    {
+        values[p] = bestRates.empty() ? 0 : bestRates[p];
+        received[model->getPairDevice(p)] += values[p];
+        total += values[p];
+    }
+    values[numPairs] = numDevices > 0 ?
+        *std::min_element(received.begin(), received.end()) : bestZ;
+
+    LPSolution* sol = new LPSolution();
+    sol->setErrorCode(LPSolution::SOLVED);
+    sol->setOptimalValues(values);
+    sol->setNumOptimalValues(numPairs + 1);
+    sol->setZValue(alpha * total + zWeight * values[numPairs]);
+    return sol;
+}
+
+/**
+ * Returns the number of maximum flows the last solve took.
+ */
+int HetNetFlow::getNumFlows()
+{
+    return numFlows;
+}
@@ -0,0 +1,543 @@
+/**
+ * Implementation of the HetNetModel class, which turns a Heterogeneous
+ * Network scene into a linear program. See doc/MathematicalModel.tex for
+ * the model being built.
+ */
+
+#include "HetNetModel.h"
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+
+/**
+ * Constructor for an empty scene with all of the weight on throughput.
+ */
+HetNetModel::HetNetModel() : alpha(1), beta(0), pairsDirty(true), sumRuaMax(0)
+{
+}
+
+/**
+ * Constructs a scene from its compact string form:
+ *
+ * "alpha beta;x y radius maxRate,...,;x y,...,;"
+ *
+ * The first field holds the weights, the second holds one entry per access
+ * point and the third holds one entry per device. Like the linear program
+ * format, every entry is followed by a comma and every field by a semicolon.
+ * The size of this string is linear in the size of the scene. Malformed
+ * input is not checked for.
+ *
+ * Param: scene - the scene in string form.
+ */
+HetNetModel::HetNetModel(std::string& scene) : alpha(1), beta(0),
+                                               pairsDirty(true), sumRuaMax(0)
+{
+    const char* probe = scene.c_str();
+    char* end;
+
+    alpha = strtod(probe, &end);
+    beta = strtod(end, &end);
+    probe = strchr(end, ';');
+    if (!probe)
+    {
+        return;
+    }
+    probe++;
+
+    // access points: x y radius maxRate,
+    while (*probe && *probe != ';')
+    {
+        double x = strtod(probe, &end);
+        double y = strtod(end, &end);
+        double radius = strtod(end, &end);
+        double maxRate = strtod(end, &end);
+        if (end == probe)
+        {
+            break;
+        }
+        addAccessPoint(x, y, radius, maxRate);
+        probe = end;
+        while (*probe == ',' || *probe == ' ')
+        {
+            probe++;
+        }
+    }
+    if (*probe == ';')
+    {
+        probe++;
+    }
+
+    // devices: x y,
+    while (*probe && *probe != ';')
+    {
+        double x = strtod(probe, &end);
+        double y = strtod(end, &end);
+        if (end == probe)
+        {
+            break;
+        }
+        addDevice(x, y);
+        probe = end;
+        while (*probe == ',' || *probe == ' ')
+        {
+            probe++;
+        }
+    }
+}
+
+/**
+ * Adds an access point to the scene.
+ *
+ * Param: x - x coordinate of the center.
+ * Param: y - y coordinate of the center.
+ * Param: radius - the range of the network.
+ * Param: maxRate - r_a,max, the rate a single device at the center receives.
+ * Return: The index of the new access point.
+ */
+int HetNetModel::addAccessPoint(double x, double y, double radius,
+                                double maxRate)
+{
+    apX.push_back(x);
+    apY.push_back(y);
+    apRadius.push_back(radius);
+    apMaxRate.push_back(maxRate);
+    pairsDirty = true;
+    return apX.size() - 1;
+}
+
+/**
+ * Adds a device to the scene.
+ *
+ * Param: x - x coordinate of the device.
+ * Param: y - y coordinate of the device.
+ * Return: The index of the new device.
+ */
+int HetNetModel::addDevice(double x, double y)
+{
+    deviceX.push_back(x);
+    deviceY.push_back(y);
+    deviceMoved.push_back(false);
+    pairsDirty = true;
+    return deviceX.size() - 1;
+}
+
+/**
+ * Moves a device. Only the pairs of the devices that moved are recomputed
+ * the next time the pairs are needed; the r_ua,max of every other pair is
+ * kept as is.
+ *
+ * Param: device - the device to move.
+ * Param: x - its new x coordinate.
+ * Param: y - its new y coordinate.
+ * Return: False, and nothing is moved, if there is no such device.
+ */
+bool HetNetModel::moveDevice(int device, double x, double y)
+{
+    if (device < 0 || device >= getNumDevices())
+    {
+        return false;
+    }
+    deviceX[device] = x;
+    deviceY[device] = y;
+    if (!deviceMoved[device])
+    {
+        deviceMoved[device] = true;
+        movedDevices.push_back(device);
+    }
+    return true;
+}
+
+/**
+ * Returns the x coordinate of a device.
+ */
+double HetNetModel::getDeviceX(int device)
+{
+    return deviceX[device];
+}
+
+/**
+ * Returns the y coordinate of a device.
+ */
+double HetNetModel::getDeviceY(int device)
+{
+    return deviceY[device];
+}
+
+/**
+ * Sets the weight of aggregate throughput.
+ */
+void HetNetModel::setAlpha(double inAlpha)
+{
+    alpha = inAlpha;
+}
+
+/**
+ * Sets the weight of fairness.
+ */
+void HetNetModel::setBeta(double inBeta)
+{
+    beta = inBeta;
+}
+
+/**
+ * Returns the weight of aggregate throughput.
+ */
+double HetNetModel::getAlpha()
+{
+    return alpha;
+}
+
+/**
+ * Returns the weight of fairness.
+ */
+double HetNetModel::getBeta()
+{
+    return beta;
+}
+
+/**
+ * Returns the number of access points in the scene.
+ */
+int HetNetModel::getNumAccessPoints()
+{
+    return apX.size();
+}
+
+/**
+ * Returns the x coordinate of an access point.
+ */
+double HetNetModel::getAccessPointX(int ap)
+{
+    return apX[ap];
+}
+
+/**
+ * Returns the y coordinate of an access point.
+ */
+double HetNetModel::getAccessPointY(int ap)
+{
+    return apY[ap];
+}
+
+/**
+ * Returns the range of an access point.
+ */
+double HetNetModel::getAccessPointRadius(int ap)
+{
+    return apRadius[ap];
+}
+
+/**
+ * Returns the maximum rate r_a,max of an access point.
+ */
+double HetNetModel::getAccessPointRate(int ap)
+{
+    return apMaxRate[ap];
+}
+
+/**
+ * Returns the number of devices in the scene.
+ */
+int HetNetModel::getNumDevices()
+{
+    return deviceX.size();
+}
+
+/**
+ * Returns the number of device-network pairs that are in range, which is the
+ * number of r_ua columns in the generated problem.
+ */
+int HetNetModel::getNumPairs()
+{
+    updatePairs();
+    return pairDevice.size();
+}
+
+/**
+ * Returns the device of the given pair.
+ */
+int HetNetModel::getPairDevice(int pair)
+{
+    updatePairs();
+    return pairDevice[pair];
+}
+
+/**
+ * Returns the access point of the given pair.
+ */
+int HetNetModel::getPairAccessPoint(int pair)
+{
+    updatePairs();
+    return pairAp[pair];
+}
+
+/**
+ * Returns r_ua,max of the given pair.
+ */
+double HetNetModel::getPairRate(int pair)
+{
+    updatePairs();
+    return pairRate[pair];
+}
+
+/**
+ * Returns the sum of r_ua,max over every pair.
+ */
+double HetNetModel::getSumRuaMax()
+{
+    updatePairs();
+    return sumRuaMax;
+}
+
+/**
+ * Returns the column of the fairness variable z, which follows the r_ua
+ * columns.
+ */
+int HetNetModel::getZColumn()
+{
+    return getNumPairs();
+}
+
+/**
+ * Free space model for the maximum achievable rate of a device:
+ * r_ua,max = r_a,max * (1 - d_ua / l_a)^2 when the device is in range,
+ * 0 otherwise.
+ *
+ * Param: distance - distance between the device and the access point.
+ * Param: radius - range of the access point.
+ * Param: maxRate - r_a,max of the access point.
+ * Return: r_ua,max.
+ */
+double HetNetModel::maxAchievableRate(double distance, double radius,
+                                      double maxRate)
+{
+    if (distance >= radius)
+    {
+        return 0;
+    }
+    double remaining = 1 - (distance / radius);
+    return maxRate * remaining * remaining;
+}
+
+/**
+ * Recomputes the pairs if the scene changed since they were last computed.
+ * When devices were only moved, just their pairs are recomputed.
+ */
+void HetNetModel::updatePairs()
+{
+    if (pairsDirty)
+    {
+        computePairs();
+        pairsDirty = false;
+    }
+    else if (!movedDevices.empty())
+    {
+        updateMovedDevices();
+    }
+    for (size_t i = 0; i < movedDevices.size(); i++)
+    {
+        deviceMoved[movedDevices[i]] = false;
+    }
+    movedDevices.clear();
+}
+
+/**
+ * Appends the pairs of one device, found through the coverage grid, in
+ * increasing access point order.
+ *
+ * Param: u - the device.
+ */
+void HetNetModel::addDevicePairs(int u)
+{
+    int cell = grid.getCell(deviceX[u], deviceY[u]);
+    for (const int* probe = grid.cellBegin(cell);
+         probe != grid.cellEnd(cell); probe++)
+    {
+        int a = *probe;
+        double dx = deviceX[u] - apX[a];
+        double dy = deviceY[u] - apY[a];
+        if (dx * dx + dy * dy >= apRadius[a] * apRadius[a])
+        {
+            continue;
+        }
+        double rate = maxAchievableRate(std::sqrt(dx * dx + dy * dy),
+                                        apRadius[a], apMaxRate[a]);
+        if (rate > 0)
+        {
+            pairDevice.push_back(u);
+            pairAp.push_back(a);
+            pairRate.push_back(rate);
+            sumRuaMax += rate;
+        }
+    }
+}
+
+/**
+ * Computes r_ua,max for every device-network pair that is in range, ordered
+ * by device and then by access point. The candidates for each device come
+ * from the coverage grid, so only the access points whose coverage overlaps
+ * the device's cell are measured rather than every access point.
+ */
+void HetNetModel::computePairs()
+{
+    int numDevices = deviceX.size();
+
+    grid.build(apX.data(), apY.data(), apRadius.data(), apX.size());
+    pairDevice.clear();
+    pairAp.clear();
+    pairRate.clear();
+    devicePairStart.assign(numDevices + 1, 0);
+    sumRuaMax = 0;
+
+    for (int u = 0; u < numDevices; u++)
+    {
+        devicePairStart[u] = pairDevice.size();
+        addDevicePairs(u);
+    }
+    devicePairStart[numDevices] = pairDevice.size();
+}
+
+/**
+ * Recomputes the pairs of the devices that moved. The pairs of every other
+ * device are copied over unchanged, without measuring any distances.
+ */
+void HetNetModel::updateMovedDevices()
+{
+    int numDevices = deviceX.size();
+    std::vector<int> oldDevice, oldAp;
+    std::vector<double> oldRate;
+    std::vector<int> oldStart;
+    oldDevice.swap(pairDevice);
+    oldAp.swap(pairAp);
+    oldRate.swap(pairRate);
+    oldStart.swap(devicePairStart);
+
+    pairDevice.reserve(oldDevice.size());
+    pairAp.reserve(oldAp.size());
+    pairRate.reserve(oldRate.size());
+    devicePairStart.resize(numDevices + 1);
+    sumRuaMax = 0;
+
+    for (int u = 0; u < numDevices; u++)
+    {
+        devicePairStart[u] = pairDevice.size();
+        if (deviceMoved[u])
+        {
+            addDevicePairs(u);
+        }
+        else
+        {
+            for (int p = oldStart[u]; p < oldStart[u + 1]; p++)
+            {
+                pairDevice.push_back(u);
+                pairAp.push_back(oldAp[p]);
+                pairRate.push_back(oldRate[p]);
+                sumRuaMax += oldRate[p];
+            }
+        }
+    }
+    devicePairStart[numDevices] = pairDevice.size();
+}
+
+/**
+ * Assembles the optimization problem for the scene. Rather than the share
+ * x_ua of r_ua,max, each pair's variable is the rate r_ua = x_ua * r_ua,max
+ * allocated to it, which gives the equivalent problem:
+ *
+ *   maximize alpha * sum(r_ua) + beta * sum(r_ua,max) * z
+ *   subject to sum_u(r_ua) <= r_a,max     for every access point
+ *              r_ua <= r_ua,max           for every pair
+ *              z - sum_a(r_ua) <= 0       for every device
+ *
+ * Written this way every coefficient in the rows is 1 or -1 and r_ua,max 
+ * only appears as a right hand side, so when devices move only right hand
+ * sides change. Only the pairs that are in range get a column, since 
+ * r_ua = 0 is forced for the others.
+ *
+ * Param: lp - the program to fill. Any previous contents are discarded.
+ */
+void HetNetModel::buildLP(SparseLP* lp)
+{
+    updatePairs();
+    int numPairs = pairDevice.size();
+    int numAps = apX.size();
+    int numDevices = deviceX.size();
+    int zCol = numPairs;
+
+    lp->clear(numPairs + 1);
+    for (int p = 0; p < numPairs; p++)
+    {
+        lp->setObjective(p, alpha);
+    }
+    lp->setObjective(zCol, beta * sumRuaMax);
+
+    // Group the pairs by access point for the capacity rows.
+    std::vector<int> apPairStart(numAps + 1, 0);
+    for (int p = 0; p < numPairs; p++)
+    {
+        apPairStart[pairAp[p] + 1]++;
+    }
+    for (int a = 0; a < numAps; a++)
+    {
+        apPairStart[a + 1] += apPairStart[a];
+    }
+    std::vector<int> apPairs(numPairs);
+    std::vector<int> fill(apPairStart.begin(), apPairStart.end() - 1);
+    for (int p = 0; p < numPairs; p++)
+    {
+        apPairs[fill[pairAp[p]]++] = p;
+    }
+
+    for (int a = 0; a < numAps; a++)
+    {
+        lp->addRow(SparseLP::LEQ, apMaxRate[a]);
+        for (int i = apPairStart[a]; i < apPairStart[a + 1]; i++)
+        {
+            lp->addCoefficient(apPairs[i], 1);
+        }
+    }
+
+    for (int p = 0; p < numPairs; p++)
+    {
+        lp->addRow(SparseLP::LEQ, pairRate[p]);
+        lp->addCoefficient(p, 1);
+    }
+
+    for (int u = 0; u < numDevices; u++)
+    {
+        lp->addRow(SparseLP::LEQ, 0);
+        for (int p = devicePairStart[u]; p < devicePairStart[u + 1]; p++)
+        {
+            lp->addCoefficient(p, -1);
+        }
+        lp->addCoefficient(zCol, 1);
+    }
+}
+
+/**
+ * Expands a solution of the problem built by buildLP() into the share x_ua
+ * of r_ua,max for every device and every access point (device-major, 0 for
+ * the pairs that are out of range), followed by z. This is the layout the
+ * web front-end expects.
+ *
+ * Param: sol - a solution of the problem built by buildLP().
+ * Return: The numDevices * numAccessPoints + 1 assignment values.
+ */
+std::vector<double> HetNetModel::expandSolution(LPSolution* sol)
+{
+    updatePairs();
+    int numPairs = pairDevice.size();
+    int numAps = apX.size();
+    std::vector<double> dense(deviceX.size() * numAps + 1, 0);
+    double* values = sol->getOptimalValues();
+
+    if (values && sol->getNumOptimalValues() == numPairs + 1)
+    {
+        for (int p = 0; p < numPairs; p++)
+        {
+            dense[pairDevice[p] * numAps + pairAp[p]] = values[p] / pairRate[p];
+        }
+        dense[dense.size() - 1] = values[numPairs];
+    }
+    return dense;
+}
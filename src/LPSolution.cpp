@@ -12,7 +12,7 @@
  * Constructor for LPSolution class.
  */
 LPSolution::LPSolution() : errorCode(DEFAULT), optimalValues(0), 
-                           numOptimalValues(0), zValue(0)
+                           numOptimalValues(0), zValue(0), gap(0)
 {
 }
 
@@ -102,3 +102,105 @@ double LPSolution::getZValue()
 {
     return zValue;
 }
+
+/**
+ * setGap method.
+ * This sets the certified relative optimality gap of the solution.
+ */
+void LPSolution::setGap(double inGap)
+{
+    gap = inGap;
+}
+
+/**
+ * getGap method.
+ * This returns the relative optimality gap: the optimal value is at most 
+ * zValue + gap * |bound|, where bound is the dual bound the solver proved.
+ * It is 0 for a solution solved to optimality, and may be infinite for a 
+ * solve that timed out without a bound.
+ */
+double LPSolution::getGap()
+{
+    return gap;
+}
+
+/**
+ * hasSensitivity method.
+ * Returns true if the sensitivity analysis below was computed.
+ */
+bool LPSolution::hasSensitivity()
+{
+    return !duals.empty() || !reducedCosts.empty();
+}
+
+/**
+ * getDuals method.
+ * The dual value (shadow price) of each constraint row: how much the 
+ * optimal value grows per unit increase of the row's right hand side, as
+ * long as it stays within [getRhsLower(), getRhsUpper()].
+ */
+std::vector<double>& LPSolution::getDuals()
+{
+    return duals;
+}
+
+/**
+ * getRhsLower method.
+ * The smallest right hand side of each row for which the optimal basis,
+ * and so the dual value, stays the same; -DBL_MAX if there is none.
+ */
+std::vector<double>& LPSolution::getRhsLower()
+{
+    return rhsLower;
+}
+
+/**
+ * getRhsUpper method.
+ * The largest right hand side of each row for which the optimal basis 
+ * stays the same; DBL_MAX if there is none.
+ */
+std::vector<double>& LPSolution::getRhsUpper()
+{
+    return rhsUpper;
+}
+
+/**
+ * getReducedCosts method.
+ * The reduced cost of each decision variable: how much the optimal value
+ * changes per unit the variable is forced up from 0. It is 0 for basic 
+ * variables and at most 0 for the others.
+ */
+std::vector<double>& LPSolution::getReducedCosts()
+{
+    return reducedCosts;
+}
+
+/**
+ * getCostLower method.
+ * The smallest objective coefficient of each decision variable for which 
+ * the optimal values stay the same; -DBL_MAX if there is none.
+ */
+std::vector<double>& LPSolution::getCostLower()
+{
+    return costLower;
+}
+
+/**
+ * getCostUpper method.
+ * The largest objective coefficient of each decision variable for which 
+ * the optimal values stay the same; DBL_MAX if there is none.
+ */
+std::vector<double>& LPSolution::getCostUpper()
+{
+    return costUpper;
+}
+
+/**
+ * getStats method.
+ * The statistics of the solve that found this solution: time spent in each
+ * stage, pivots, memory and the engine that ran (see SolveStats).
+ */
+SolveStats& LPSolution::getStats()
+{
+    return stats;
+}
@@ -0,0 +1,141 @@
+/**
+ * Implementation of the MappedTable class.
+ */
+
+#include "MappedTable.h"
+#include <algorithm>
+#include <cerrno>
+#include <cstdlib>
+#include <fcntl.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#include <vector>
+
+/**
+ * Constructor for a zeroed table in a new temporary file. Check isOpen()
+ * before using it.
+ *
+ * Param: directory - where to make the file. It should be on a disk, not
+ *                    on a file system kept in memory such as /dev/shm.
+ * Param: inNumRows - the rows of the table.
+ * Param: inNumCols - the columns of the table.
+ * Param: panelBytes - about how many bytes of rows to work on at a time.
+ */
+MappedTable::MappedTable(std::string directory, unsigned long long inNumRows,
+                         unsigned long long inNumCols,
+                         unsigned long long panelBytes)
+    : data(0), rows(0), numRows(inNumRows), numCols(inNumCols)
+{
+    unsigned long long rowBytes = std::max(numCols, 1ULL) * sizeof(double);
+    length = std::max(numRows, 1ULL) * rowBytes;
+    // The tables of the simplex method never have more rows than an int.
+    panelRows = (int) std::min(std::max(panelBytes / rowBytes, 1ULL),
+                               std::max(numRows, 1ULL));
+
+    std::string path = directory + "/simplexXXXXXX";
+    std::vector<char> name(path.begin(), path.end());
+    name.push_back('\0');
+    int file = mkstemp(name.data());
+    if (file < 0)
+    {
+        error = path + ": " + strerror(errno);
+        return;
+    }
+    unlink(name.data());
+    // Unlike ftruncate(), this fails now if the disk is too small, instead
+    // of with a bus error at the first row that does not fit.
+    int reserved = posix_fallocate(file, 0, length);
+    if (reserved != 0)
+    {
+        error = path + ": " + strerror(reserved);
+        close(file);
+        return;
+    }
+    void* mapping = mmap(0, length, PROT_READ | PROT_WRITE, MAP_SHARED, file,
+                         0);
+    close(file);
+    if (mapping == MAP_FAILED)
+    {
+        error = path + ": " + strerror(errno);
+        return;
+    }
+    data = mapping;
+    madvise(data, length, MADV_SEQUENTIAL);
+
+    rows = new double*[numRows];
+    for (unsigned long long i = 0; i < numRows; i++)
+    {
+        rows[i] = (double*) data + i * numCols;
+    }
+}
+
+/**
+ * Destructor for mapped tables, which unmaps the file and so frees its
+ * space on disk.
+ */
+MappedTable::~MappedTable()
+{
+    if (data)
+    {
+        munmap(data, length);
+    }
+    delete [] rows;
+}
+
+/**
+ * Returns true if the file could be made and mapped.
+ */
+bool MappedTable::isOpen()
+{
+    return data != 0;
+}
+
+/**
+ * Returns why the file could not be made or mapped, or "" if it was.
+ */
+std::string& MappedTable::getError()
+{
+    return error;
+}
+
+/**
+ * Returns the table, as an array of row pointers like arrayInit2d() gives.
+ * It belongs to the MappedTable; do not pass it to arrayDel2d().
+ */
+double** MappedTable::getRows()
+{
+    return rows;
+}
+
+/**
+ * Returns the rows of a panel: the most rows that fit in the panel bytes
+ * given to the constructor, but at least 1.
+ */
+int MappedTable::getPanelRows()
+{
+    return panelRows;
+}
+
+/**
+ * Tells the kernel some rows will be needed soon, so it starts reading
+ * them from disk while the caller works on others.
+ *
+ * Param: firstRow - the first of the rows.
+ * Param: count - the number of rows; those past the end are ignored.
+ */
+void MappedTable::willNeed(unsigned long long firstRow,
+                           unsigned long long count)
+{
+    if (firstRow >= numRows)
+    {
+        return;
+    }
+    count = std::min(count, numRows - firstRow);
+    // madvise() wants the start rounded down to a page.
+    unsigned long long pageSize = sysconf(_SC_PAGESIZE);
+    unsigned long long start = firstRow * numCols * sizeof(double);
+    unsigned long long end = start + count * numCols * sizeof(double);
+    start -= start % pageSize;
+    madvise((char*) data + start, end - start, MADV_WILLNEED);
+}
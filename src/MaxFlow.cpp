@@ -0,0 +1,200 @@
+/**
+ * Implementation of the MaxFlow class.
+ */
+
+#include "MaxFlow.h"
+#include <algorithm>
+#include <deque>
+
+/**
+ * Constructor for a network without edges or flow.
+ *
+ * Param: numNodes - the number of nodes.
+ */
+MaxFlow::MaxFlow(int numNodes) : adjacent(numNodes), excess(numNodes, 0),
+                                 height(numNodes, 0), current(numNodes, 0),
+                                 tolerance(0)
+{
+}
+
+/**
+ * Adds an edge and its reverse.
+ *
+ * Param: from - the tail of the edge.
+ * Param: to - the head of the edge.
+ * Param: inCapacity - the most flow the edge may carry.
+ * Return: The index of the edge. Its reverse is the index ^ 1.
+ */
+int MaxFlow::addEdge(int from, int to, double inCapacity)
+{
+    int edge = edgeTo.size();
+    edgeTo.push_back(to);
+    capacity.push_back(inCapacity);
+    residual.push_back(inCapacity);
+    adjacent[from].push_back(edge);
+    edgeTo.push_back(from);
+    capacity.push_back(0);
+    residual.push_back(0);
+    adjacent[to].push_back(edge + 1);
+    return edge;
+}
+
+/**
+ * Returns the flow an edge carries.
+ */
+double MaxFlow::getFlow(int edge)
+{
+    return capacity[edge] - residual[edge];
+}
+
+/**
+ * Keeps the flow an edge carries now for good: later solves may neither add
+ * to it nor push it back.
+ */
+void MaxFlow::fixFlow(int edge)
+{
+    capacity[edge] -= residual[edge];
+    residual[edge] = 0;
+    residual[edge ^ 1] = 0;
+}
+
+/**
+ * Moves flow along an edge with enough residual capacity.
+ */
+void MaxFlow::push(int from, int edge, double amount)
+{
+    residual[edge] -= amount;
+    residual[edge ^ 1] += amount;
+    excess[from] -= amount;
+    excess[edgeTo[edge]] += amount;
+}
+
+/**
+ * Sets every label to its exact distance in the residual network: to the
+ * sink for the nodes that can still reach it, and to the source, plus the
+ * number of nodes, for the ones whose excess can only go back. Nodes that
+ * can reach neither get twice the number of nodes.
+ */
+void MaxFlow::globalRelabel(int source, int sink)
+{
+    int numNodes = adjacent.size();
+    height.assign(numNodes, 2 * numNodes);
+    current.assign(numNodes, 0);
+    height[sink] = 0;
+    height[source] = numNodes;
+
+    int roots[2] = {sink, source};
+    for (int r = 0; r < 2; r++)
+    {
+        std::deque<int> queue(1, roots[r]);
+        while (!queue.empty())
+        {
+            int node = queue.front();
+            queue.pop_front();
+            for (size_t i = 0; i < adjacent[node].size(); i++)
+            {
+                int edge = adjacent[node][i];
+                int other = edgeTo[edge];
+                if (residual[edge ^ 1] > tolerance &&
+                    height[other] == 2 * numNodes)
+                {
+                    height[other] = height[node] + 1;
+                    queue.push_back(other);
+                }
+            }
+        }
+    }
+}
+
+/**
+ * Pushes as much flow as possible from the source to the sink, on top of
+ * the flow the network already carries. Active nodes are discharged in
+ * FIFO order, and every label is recomputed exactly after each round of as
+ * many relabels as there are nodes.
+ *
+ * Param: source - the node flow leaves from.
+ * Param: sink - the node flow arrives at.
+ * Return: The total flow into the sink.
+ */
+double MaxFlow::solve(int source, int sink)
+{
+    int numNodes = adjacent.size();
+    double largest = 0;
+    for (size_t e = 0; e < capacity.size(); e++)
+    {
+        largest = std::max(largest, capacity[e]);
+    }
+    tolerance = FLOW_TOLERANCE * largest;
+    globalRelabel(source, sink);
+
+    std::deque<int> active;
+    for (size_t i = 0; i < adjacent[source].size(); i++)
+    {
+        int edge = adjacent[source][i];
+        if (residual[edge] > tolerance)
+        {
+            push(source, edge, residual[edge]);
+        }
+    }
+    for (int node = 0; node < numNodes; node++)
+    {
+        if (node != source && node != sink && excess[node] > tolerance)
+        {
+            active.push_back(node);
+        }
+    }
+
+    int relabels = 0;
+    while (!active.empty())
+    {
+        int node = active.front();
+        active.pop_front();
+        while (excess[node] > tolerance)
+        {
+            if (current[node] == (int) adjacent[node].size())
+            {
+                int lowest = 2 * numNodes;
+                for (size_t i = 0; i < adjacent[node].size(); i++)
+                {
+                    int edge = adjacent[node][i];
+                    if (residual[edge] > tolerance)
+                    {
+                        lowest = std::min(lowest, height[edgeTo[edge]]);
+                    }
+                }
+                if (lowest >= 2 * numNodes)
+                {
+                    // Only rounding error is left, with nowhere to go.
+                    excess[node] = 0;
+                    break;
+                }
+                height[node] = lowest + 1;
+                current[node] = 0;
+                if (++relabels == numNodes)
+                {
+                    relabels = 0;
+                    globalRelabel(source, sink);
+                }
+                continue;
+            }
+
+            int edge = adjacent[node][current[node]];
+            int other = edgeTo[edge];
+            if (residual[edge] > tolerance &&
+                height[node] == height[other] + 1)
+            {
+                bool wasActive = excess[other] > tolerance;
+                push(node, edge, std::min(excess[node], residual[edge]));
+                if (!wasActive && other != source && other != sink)
+                {
+                    active.push_back(other);
+                }
+            }
+            else
+            {
+                current[node]++;
+            }
+        }
+    }
+    return excess[sink];
+}
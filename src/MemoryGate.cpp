@@ -0,0 +1,100 @@
+/**
+ * Implementation of the MemoryGate class.
+ */
+
+#include "MemoryGate.h"
+#include <chrono>
+
+/**
+ * Constructor for a gate without a limit.
+ */
+MemoryGate::MemoryGate() : capacity(0), used(0)
+{
+}
+
+/**
+ * Sets the bytes that admitted solves may hold at once. Solves admitted
+ * before keep their memory even if it no longer fits.
+ *
+ * Param: inCapacity - the bytes, or 0 for no limit.
+ */
+void MemoryGate::setCapacity(unsigned long long inCapacity)
+{
+    std::lock_guard<std::mutex> guard(lock);
+    capacity = inCapacity;
+    released.notify_all();
+}
+
+/**
+ * Returns the bytes that admitted solves may hold at once, or 0 if there
+ * is no limit.
+ */
+unsigned long long MemoryGate::getCapacity()
+{
+    std::lock_guard<std::mutex> guard(lock);
+    return capacity;
+}
+
+/**
+ * Returns the bytes held by the solves admitted now.
+ */
+unsigned long long MemoryGate::getUsed()
+{
+    std::lock_guard<std::mutex> guard(lock);
+    return used;
+}
+
+/**
+ * Returns true if a solve needing a number of bytes could ever be
+ * admitted, that is if it fits when no other solve is running.
+ */
+bool MemoryGate::fits(unsigned long long bytes)
+{
+    std::lock_guard<std::mutex> guard(lock);
+    return capacity == 0 || bytes <= capacity;
+}
+
+/**
+ * Admits a solve, waiting for others to release memory if it does not fit
+ * beside them. Every successful call must be matched by a release() of
+ * the same bytes once the solve has freed its tables.
+ *
+ * Param: bytes - the bytes the solve will hold.
+ * Param: timeout - the most seconds to wait, or 0 not to wait.
+ * Return: True if the solve was admitted; false if it would never fit or
+ *         did not fit before the timeout.
+ */
+bool MemoryGate::acquire(unsigned long long bytes, double timeout)
+{
+    std::unique_lock<std::mutex> guard(lock);
+    std::chrono::steady_clock::time_point deadline =
+        std::chrono::steady_clock::now() +
+        std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+            std::chrono::duration<double>(timeout));
+    while (capacity != 0 && used + bytes > capacity)
+    {
+        if (bytes > capacity ||
+            released.wait_until(guard, deadline) == std::cv_status::timeout)
+        {
+            if (capacity != 0 && used + bytes > capacity)
+            {
+                return false;
+            }
+        }
+    }
+    used += bytes;
+    return true;
+}
+
+/**
+ * Releases the memory of a solve admitted by acquire(), letting waiting
+ * solves in.
+ *
+ * Param: bytes - the bytes that were acquired.
+ */
+void MemoryGate::release(unsigned long long bytes)
+{
+    std::lock_guard<std::mutex> guard(lock);
+    used -= bytes;
+    released.notify_all();
+}
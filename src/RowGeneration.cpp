@@ -0,0 +1,320 @@
+/**
+ * Implementation of the RowGeneration class.
+ */
+
+#include "RowGeneration.h"
+#include <algorithm>
+
+// std::min() binds a reference to it, which needs a definition.
+const int RowGeneration::MIN_ROWS_PER_ROUND;
+
+/**
+ * Constructor.
+ *
+ * Param: inModel - the scene to solve.
+ */
+RowGeneration::RowGeneration(HetNetModel* inModel) : model(inModel),
+                                                     simplex(0),
+                                                     budget(0),
+                                                     numActive(0),
+                                                     numRounds(0)
+{
+}
+
+/**
+ * Destructor; frees the table.
+ */
+RowGeneration::~RowGeneration()
+{
+    delete simplex;
+}
+
+/**
+ * Sets the limits of later solves (see Simplex::setBudget()). The first 
+ * solve and each reoptimization may take the budget's pivots; its deadline
+ * and cancellation cover the whole solve.
+ *
+ * Param: inBudget - the limits, or 0 for none. It must outlive the solves.
+ */
+void RowGeneration::setBudget(SolveBudget* inBudget)
+{
+    budget = inBudget;
+}
+
+/**
+ * Returns the number of fairness rows in the table after the last solve.
+ */
+int RowGeneration::getNumActiveRows()
+{
+    return numActive;
+}
+
+/**
+ * Returns the number of rounds of the last solve.
+ */
+int RowGeneration::getNumRounds()
+{
+    return numRounds;
+}
+
+/**
+ * Builds the first problem: the model's columns, capacity rows and bound 
+ * rows, and the fairness row of the device with the smallest sum of 
+ * r_ua,max, which no device's rate can exceed.
+ */
+void RowGeneration::buildProblem()
+{
+    int numPairs = model->getNumPairs();
+    int numAps = model->getNumAccessPoints();
+    int numDevices = model->getNumDevices();
+    int zCol = numPairs;
+
+    lp.clear(numPairs + 1);
+    for (int p = 0; p < numPairs; p++)
+    {
+        lp.setObjective(p, model->getAlpha());
+    }
+    lp.setObjective(zCol, model->getBeta() * model->getSumRuaMax());
+
+    apPairs.assign(numAps, std::vector<int>());
+    std::vector<double> deviceRate(numDevices, 0);
+    for (int p = 0; p < numPairs; p++)
+    {
+        apPairs[model->getPairAccessPoint(p)].push_back(p);
+        deviceRate[model->getPairDevice(p)] += model->getPairRate(p);
+    }
+    for (int a = 0; a < numAps; a++)
+    {
+        lp.addRow(SparseLP::LEQ, model->getAccessPointRate(a));
+        for (size_t k = 0; k < apPairs[a].size(); k++)
+        {
+            lp.addCoefficient(apPairs[a][k], 1);
+        }
+    }
+    for (int p = 0; p < numPairs; p++)
+    {
+        lp.addRow(SparseLP::LEQ, model->getPairRate(p));
+        lp.addCoefficient(p, 1);
+    }
+
+    active.assign(numDevices, false);
+    numActive = 0;
+    int weakest = 0;
+    for (int u = 1; u < numDevices; u++)
+    {
+        if (deviceRate[u] < deviceRate[weakest])
+        {
+            weakest = u;
+        }
+    }
+    if (numDevices > 0)
+    {
+        lp.addRow(SparseLP::LEQ, 0);
+        for (int p = 0; p < numPairs; p++)
+        {
+            if (model->getPairDevice(p) == weakest)
+            {
+                lp.addCoefficient(p, -1);
+            }
+        }
+        lp.addCoefficient(zCol, 1);
+        active[weakest] = true;
+        numActive = 1;
+    }
+
+    delete simplex;
+    simplex = new Simplex(&lp);
+    simplex->setBudget(budget);
+}
+
+/**
+ * Sums the rate of every device in a solution in one pass over the pairs.
+ *
+ * Param: values - the solution's values.
+ * Param: rate - receives the rate of each device.
+ * Param: deviceStart - receives the first pair of each device, and one 
+ *                      past the last pair.
+ */
+void RowGeneration::sumRates(double* values, std::vector<double>& rate,
+                             std::vector<int>& deviceStart)
+{
+    int numPairs = model->getNumPairs();
+    int numDevices = model->getNumDevices();
+
+    // Pairs are device-major, so each device's pairs are consecutive.
+    rate.assign(numDevices, 0);
+    deviceStart.assign(numDevices + 1, 0);
+    for (int p = 0; p < numPairs; p++)
+    {
+        int u = model->getPairDevice(p);
+        rate[u] += values[p];
+        deviceStart[u + 1] = p + 1;
+    }
+    for (int u = 0; u < numDevices; u++)
+    {
+        deviceStart[u + 1] = std::max(deviceStart[u + 1], deviceStart[u]);
+    }
+}
+
+/**
+ * Finds the devices whose rate in a solution is below z and adds their 
+ * fairness rows to the table.
+ *
+ * Param: sol - the last solution.
+ * Return: The number of rows added.
+ */
+int RowGeneration::addViolatedRows(LPSolution* sol)
+{
+    int numPairs = model->getNumPairs();
+    int numDevices = model->getNumDevices();
+    double* values = sol->getOptimalValues();
+    double z = values[numPairs];
+
+    std::vector<double> rate;
+    std::vector<int> deviceStart;
+    sumRates(values, rate, deviceStart);
+    repair(values, rate, deviceStart, z);
+
+    // Add the most violated rows first, at most as many as are active, so
+    // the active set at most doubles each round.
+    std::vector<std::pair<double, int> > violated;
+    for (int u = 0; u < numDevices; u++)
+    {
+        if (!active[u] && z - rate[u] > Simplex::ZERO_TOLERANCE)
+        {
+            violated.push_back(std::make_pair(rate[u] - z, u));
+        }
+    }
+    int added = std::min<int>(violated.size(), std::max(numActive, 
+                                                        MIN_ROWS_PER_ROUND));
+    std::partial_sort(violated.begin(), violated.begin() + added, 
+                      violated.end());
+
+    std::vector<int> vars;
+    std::vector<double> coefficients;
+    for (int k = 0; k < added; k++)
+    {
+        int u = violated[k].second;
+        vars.clear();
+        coefficients.clear();
+        for (int p = deviceStart[u]; p < deviceStart[u + 1]; p++)
+        {
+            vars.push_back(p);
+            coefficients.push_back(-1);
+        }
+        vars.push_back(numPairs);
+        coefficients.push_back(1);
+        simplex->addRow(vars.size(), vars.data(), coefficients.data(), 0);
+        active[u] = true;
+    }
+    numActive += added;
+    return added;
+}
+
+/**
+ * Tries to fix the fairness rows a solution violates without changing its
+ * objective value. At an access point, rate can move from a device that has
+ * more than z to another device in range, as long as neither pair's bound
+ * is broken; the access point's total and the objective stay the same. If
+ * every device reaches z this way, the solution is feasible for the whole
+ * scene with the relaxation's objective value, so it is optimal without 
+ * adding any rows. Otherwise fewer rows need to be added.
+ *
+ * Param: values - the solution's values, changed in place.
+ * Param: rate - the rate of each device, kept up to date.
+ * Param: deviceStart - the first pair of each device.
+ * Param: z - the solution's z.
+ */
+void RowGeneration::repair(double* values, std::vector<double>& rate,
+                           std::vector<int>& deviceStart, double z)
+{
+    int numDevices = rate.size();
+    for (int u = 0; u < numDevices; u++)
+    {
+        double deficit = z - rate[u];
+        for (int p = deviceStart[u]; p < deviceStart[u + 1] && 
+                                     deficit > 0; p++)
+        {
+            double room = model->getPairRate(p) - values[p];
+            std::vector<int>& donors = apPairs[model->getPairAccessPoint(p)];
+            for (size_t k = 0; k < donors.size() && deficit > 0 && room > 0;
+                 k++)
+            {
+                int q = donors[k];
+                int v = model->getPairDevice(q);
+                double amount = std::min(std::min(deficit, room),
+                                         std::min(rate[v] - z, values[q]));
+                if (v == u || amount <= 0)
+                {
+                    continue;
+                }
+                values[q] -= amount;
+                values[p] += amount;
+                rate[v] -= amount;
+                rate[u] += amount;
+                deficit -= amount;
+                room -= amount;
+            }
+        }
+    }
+}
+
+/**
+ * Makes a point of the relaxation feasible for the whole scene: rate is 
+ * first shifted as in repair(), then z is lowered to the smallest rate of
+ * any device, which the rows left out of the table may call for. The 
+ * objective value is lowered with it.
+ *
+ * Param: sol - a feasible point of the table, changed in place.
+ */
+void RowGeneration::lowerZ(LPSolution* sol)
+{
+    int numPairs = model->getNumPairs();
+    double* values = sol->getOptimalValues();
+    double z = values[numPairs];
+
+    std::vector<double> rate;
+    std::vector<int> deviceStart;
+    sumRates(values, rate, deviceStart);
+    repair(values, rate, deviceStart, z);
+    for (size_t u = 0; u < rate.size(); u++)
+    {
+        z = std::min(z, rate[u]);
+    }
+    sol->setZValue(sol->getZValue() - (values[numPairs] - z) * 
+                   model->getBeta() * model->getSumRuaMax());
+    values[numPairs] = z;
+}
+
+/**
+ * Solves the scene, adding fairness rows until none is violated. If the 
+ * budget runs out, the last point is made feasible for the whole scene by
+ * lowerZ() and returned with LPSolution::TIMED_OUT.
+ *
+ * Return: The solution, ordered as the model's columns.
+ */
+LPSolution* RowGeneration::solve()
+{
+    buildProblem();
+    LPSolution* sol = simplex->solve();
+    numRounds = 0;
+    while (sol->getErrorCode() == LPSolution::SOLVED && 
+           addViolatedRows(sol) > 0)
+    {
+        if (numRounds == MAX_ROUNDS)
+        {
+            // Rows are still violated, so the solution is not feasible.
+            sol->setErrorCode(LPSolution::EXCEEDED_MAX_ITERATIONS);
+            break;
+        }
+        delete sol;
+        sol = simplex->reoptimize();
+        numRounds++;
+    }
+    if (sol->getErrorCode() == LPSolution::TIMED_OUT &&
+        sol->getNumOptimalValues() > model->getNumPairs())
+    {
+        lowerZ(sol);
+    }
+    return sol;
+}
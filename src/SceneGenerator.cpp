@@ -0,0 +1,142 @@
+/**
+ * Implementation of the SceneGenerator class.
+ */
+
+#include "SceneGenerator.h"
+#include <cmath>
+#include <sstream>
+#include <vector>
+
+/**
+ * Constructor for a generator of small scenes, with the ranges used by the
+ * web front-end and equal weights.
+ *
+ * Param: seed - the seed of the random numbers.
+ */
+SceneGenerator::SceneGenerator(unsigned int seed) : engine(seed),
+                                                    numDevices(50),
+                                                    numAccessPoints(5),
+                                                    minRadius(60),
+                                                    maxRadius(260),
+                                                    minRate(200),
+                                                    maxRate(1700),
+                                                    overlap(2),
+                                                    alpha(0.5), beta(0.5)
+{
+}
+
+/**
+ * Returns a number drawn uniformly from [low, high).
+ */
+double SceneGenerator::uniform(double low, double high)
+{
+    return low + (high - low) * (engine() / 4294967296.0);
+}
+
+/**
+ * Sets the number of devices of each scene.
+ */
+void SceneGenerator::setNumDevices(int inNumDevices)
+{
+    numDevices = inNumDevices;
+}
+
+/**
+ * Sets the number of access points of each scene.
+ */
+void SceneGenerator::setNumAccessPoints(int inNumAccessPoints)
+{
+    numAccessPoints = inNumAccessPoints;
+}
+
+/**
+ * Sets the range the coverage radius of each access point is drawn from.
+ */
+void SceneGenerator::setRadii(double inMinRadius, double inMaxRadius)
+{
+    minRadius = inMinRadius;
+    maxRadius = inMaxRadius;
+}
+
+/**
+ * Sets the range r_a,max of each access point is drawn from.
+ */
+void SceneGenerator::setRates(double inMinRate, double inMaxRate)
+{
+    minRate = inMinRate;
+    maxRate = inMaxRate;
+}
+
+/**
+ * Sets the average number of access points covering a point of the scene.
+ * Raising it packs the access points closer, which gives every device more
+ * pairs and the problem more columns.
+ *
+ * Param: inOverlap - the density, greater than 0.
+ */
+void SceneGenerator::setOverlap(double inOverlap)
+{
+    overlap = inOverlap;
+}
+
+/**
+ * Sets the weights of throughput and fairness of each scene.
+ */
+void SceneGenerator::setWeights(double inAlpha, double inBeta)
+{
+    alpha = inAlpha;
+    beta = inBeta;
+}
+
+/**
+ * Returns the side of the square the access points are spread over. The
+ * coverage circles have a total area of numAccessPoints * pi * E[r^2],
+ * where E[r^2] = (a^2 + ab + b^2) / 3 for r uniform on [a, b], which the
+ * square holds overlap times.
+ */
+double SceneGenerator::getSide()
+{
+    double meanSquare = (minRadius * minRadius + minRadius * maxRadius +
+                         maxRadius * maxRadius) / 3;
+    return std::sqrt(numAccessPoints * M_PI * meanSquare / overlap);
+}
+
+/**
+ * Generates the next scene, in the string form read by
+ * HetNetModel::HetNetModel(std::string&), so that parsing it can be timed
+ * too. Every value is written with enough digits to be read back exactly.
+ *
+ * Return: The scene.
+ */
+std::string SceneGenerator::generate()
+{
+    double side = getSide();
+    std::vector<double> apX(numAccessPoints);
+    std::vector<double> apY(numAccessPoints);
+    std::vector<double> apRadius(numAccessPoints);
+
+    std::ostringstream scene;
+    scene.precision(17);
+    scene << alpha << " " << beta << ";";
+    for (int a = 0; a < numAccessPoints; a++)
+    {
+        apX[a] = uniform(0, side);
+        apY[a] = uniform(0, side);
+        apRadius[a] = uniform(minRadius, maxRadius);
+        scene << apX[a] << " " << apY[a] << " " << apRadius[a] << " "
+              << uniform(minRate, maxRate) << ",";
+    }
+    scene << ";";
+    // Without access points there is nowhere to place the devices.
+    int count = numAccessPoints > 0 ? numDevices : 0;
+    for (int u = 0; u < count; u++)
+    {
+        int a = engine() % numAccessPoints;
+        double distance = apRadius[a] * std::sqrt(uniform(0, 1));
+        double angle = uniform(0, 2 * M_PI);
+        scene << apX[a] + distance * std::cos(angle) << " "
+              << apY[a] + distance * std::sin(angle) << ",";
+    }
+    scene << ";";
+    return scene.str();
+}
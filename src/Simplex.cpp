@@ -12,6 +12,19 @@
  */
 
 #include "Simplex.h"
+#include "Trace.h"
+
+// Definitions for the constants that are passed by reference.
+constexpr double Simplex::ZERO_TOLERANCE;
+constexpr double Simplex::FEASIBILITY_TOLERANCE;
+constexpr double Simplex::PERTURBATION;
+
+/** Where tables of at least mapMinBytes are mapped from files, or "" to
+ * keep every table on the heap (see Simplex::setMappedStorage()). */
+static std::string mapDirectory;
+static unsigned long long mapMinBytes = 0;
+static unsigned long long mapPanelBytes = MappedTable::DEFAULT_PANEL_BYTES;
+
 
 /**
  * Constructor for Simplex objects.
@@ -20,8 +33,25 @@
  *
  * Param: LP - the Linear Program to solve.
  */
-Simplex::Simplex(LinearProgram* lp)
+Simplex::Simplex(LinearProgram* lp) : budget(0), iterations(0),
+                                      timedOut(false), degeneratePivots(0),
+                                      phaseOneIterations(0),
+                                      phaseOneTime(0), phaseTwoTime(0),
+                                      harris(true), perturb(false),
+                                      gapTolerance(0), keepWorkspace(false),
+                                      relatedTable(0), relatedRowCapacity(0),
+                                      relatedColCapacity(0), mappedTable(0),
+                                      mappedRelatedTable(0)
 {
+    TRACE_SCOPE("buildTable");
+#ifdef PIVOT_HOOKS
+    pivotHook = 0;
+#endif
+    std::fill(allocations, allocations + SolveStats::NUM_STAGES, 0);
+    std::fill(allocatedBytes, allocatedBytes + SolveStats::NUM_STAGES, 0);
+    AllocationCounter counter;
+    std::chrono::steady_clock::time_point start = 
+        std::chrono::steady_clock::now();
     numLeqConstraints = lp->getLeqConstraints()->getSize();
     numEqConstraints = lp->getEqConstraints()->getSize();
     numConstraints = numLeqConstraints + numEqConstraints;
@@ -36,9 +66,15 @@ Simplex::Simplex(LinearProgram* lp)
 
     numRows = numConstraints + 1;
     numCols = numDecisionVars + numConstraints + 1;
-    table = arrayInit2d(numRows, numCols);
+    rowCapacity = numRows;
+    colCapacity = numCols;
+    table = allocateTable(numRows, numCols, &mappedTable);
     lpToTable (lp); // converts the LP into matrix format 
                     // for more efficient solving
+    initState();
+    buildTime = secondsSince(start);
+    countAllocations(SolveStats::BUILD, counter);
+    peakTableBytes = arrayBytes2d(rowCapacity, colCapacity);
 
     #ifdef SERVER_DEBUG
         std::cerr << "original matrix" << std::endl;
@@ -47,95 +83,147 @@ Simplex::Simplex(LinearProgram* lp)
 
 }
 
-#ifdef SERVER_DEBUG
 /**
- * Debug function for displaying a matrix. 
+ * Constructor for Simplex objects from a numeric, sparse Linear Program.
+ * The table is filled straight from the stored coefficients, so no string
+ * parsing takes place. As with the string form, the <= rows are placed
+ * before the = rows.
  *
- * Param: matrix - the matrix to print.
- * Param: x - the length of the matrix.
- * Param: y - the width of the matrix.
+ * Param: lp - the Linear Program to solve.
  */
-void Simplex::displayMatrix(double** matrix, int x, int y)
+Simplex::Simplex(SparseLP* lp) : budget(0), iterations(0), timedOut(false),
+                                  degeneratePivots(0), phaseOneIterations(0),
+                                  phaseOneTime(0), phaseTwoTime(0),
+                                  harris(true), perturb(false),
+                                  gapTolerance(0), keepWorkspace(false),
+                                  relatedTable(0), relatedRowCapacity(0),
+                                  relatedColCapacity(0), mappedTable(0),
+                                  mappedRelatedTable(0)
 {
-    for (int i = 0; i < x; i++)
-    {
-        for (int j = 0; j < y; j++)
-        {
-            fprintf(stderr, "%7.2f", matrix[i][j]);
-        }
-
-        fprintf(stderr, "\n");
-    }
+    TRACE_SCOPE("buildTable");
+#ifdef PIVOT_HOOKS
+    pivotHook = 0;
+#endif
+    std::fill(allocations, allocations + SolveStats::NUM_STAGES, 0);
+    std::fill(allocatedBytes, allocatedBytes + SolveStats::NUM_STAGES, 0);
+    AllocationCounter counter;
+    std::chrono::steady_clock::time_point start = 
+        std::chrono::steady_clock::now();
+    table = 0;
+    rowCapacity = 0;
+    colCapacity = 0;
+    fillTable(lp);
+    buildTime = secondsSince(start);
+    countAllocations(SolveStats::BUILD, counter);
+    peakTableBytes = arrayBytes2d(rowCapacity, colCapacity);
 
-    fprintf(stderr, "\n");
+    #ifdef SERVER_DEBUG
+        std::cerr << "original matrix" << std::endl;
+        displayMatrix(table, numRows, numCols);
+    #endif
 }
-#endif
 
 /**
- * Finds the greatest common denominator given two numbers.
- * Used in the choose method. This function was originally intended for use
- * by the choose function, which allows for extremely large integer values - 
- * thus unsigned long longs.
+ * Replaces the problem with another one, reusing the table and the rest of
+ * the state instead of building a new Simplex. When the new problem is no
+ * larger than the ones loaded before, nothing is allocated, so a Simplex 
+ * that is loaded and solved over and over with same-shaped problems (see 
+ * solveInto() and setKeepWorkspace()) stops allocating after the first.
+ * The budget and settings are kept; the implied bounds are not.
  *
- * Param: x - The first number to find the GCD between.
- * Param y - the second number to find the GCD between.
+ * Param: lp - the Linear Program to solve next.
+ */
+void Simplex::load(SparseLP* lp)
+{
+    TRACE_SCOPE("load");
+    AllocationCounter counter;
+    std::chrono::steady_clock::time_point start = 
+        std::chrono::steady_clock::now();
+    fillTable(lp);
+    upperBound.clear();
+    buildTime = secondsSince(start);
+    countAllocations(SolveStats::BUILD, counter);
+    peakTableBytes = std::max(peakTableBytes, 
+                              arrayBytes2d(rowCapacity, colCapacity));
+}
+
+/**
+ * Fills the table from a sparse Linear Program, the <= rows before the = 
+ * rows, and sets up the slack basis. The table is only allocated again if
+ * the problem does not fit; otherwise it is cleared.
  *
- * return: The GCD between x and y.
+ * Param: lp - the Linear Program.
  */
-unsigned long long Simplex::gcd(unsigned long long x, unsigned long long y)
+void Simplex::fillTable(SparseLP* lp)
 {
-    while (y != 0)
+    numLeqConstraints = lp->getNumLeqRows();
+    numEqConstraints = lp->getNumEqRows();
+    numConstraints = numLeqConstraints + numEqConstraints;
+    numDecisionVars = lp->getNumVars();
+
+    numRows = numConstraints + 1;
+    numCols = numDecisionVars + numConstraints + 1;
+    if (numRows > rowCapacity || numCols > colCapacity)
+    {
+        if (table)
+        {
+            freeTable(table, rowCapacity, &mappedTable);
+        }
+        rowCapacity = std::max(numRows, rowCapacity);
+        colCapacity = std::max(numCols, colCapacity);
+        table = allocateTable(rowCapacity, colCapacity, &mappedTable);
+    }
+    else
     {
-        unsigned long long t = x % y;
-        x = y;
-        y = t;
+        for (int i = 0; i < numRows; i++)
+        {
+            memset(table[i], 0, numCols * sizeof(double));
+        }
     }
 
-    return x;
+    int leqRow = 0;
+    int eqRow = numLeqConstraints;
+    for (int r = 0; r < lp->getNumRows(); r++)
+    {
+        int i = (lp->getRowType(r) == SparseLP::EQ) ? eqRow++ : leqRow++;
+        for (int k = lp->getRowStart(r); k < lp->getRowEnd(r); k++)
+        {
+            table[i][lp->getColIndex(k)] = lp->getValue(k);
+        }
+        table[i][numDecisionVars + i] = 1;
+        table[i][numDecisionVars + numConstraints] = lp->getRhs(r);
+    }
+    for (int j = 0; j < numDecisionVars; j++)
+    {
+        table[numConstraints][j] = lp->getObjective(j);
+    }
+    initState();
 }
 
-
 /**
- * Calculates the combination (n choose k), which is used as
- * an upper limit on the number of iterations the solver is 
- * allowed to complete. These numbers get large quicly, and 
- * so we are using unsigned long longs as potential return values.
- *
- * Param: n - the set
- * Param: k - how many to choose from n
+ * Debug function for displaying a matrix. It only prints in SERVER_DEBUG
+ * builds, but is always defined since it is the first virtual function of
+ * the class and so determines where the vtable is emitted.
  *
- * Return: n choose k
+ * Param: matrix - the matrix to print.
+ * Param: x - the length of the matrix.
+ * Param: y - the width of the matrix.
  */
-unsigned long long Simplex::choose(int n, int k)
+void Simplex::displayMatrix(double** matrix, int x, int y)
 {
-    static const unsigned long long MAX_LONG =
-        std::numeric_limits<unsigned long long>::max();
-    unsigned long long r = 1;
-
-    // check for invalid parameters
-    if (k <= n)
+#ifdef SERVER_DEBUG
+    for (int i = 0; i < x; i++)
     {
-        bool overflow = false;
-
-        for (int d = 1; d <= k && !overflow; ++d, --n)
+        for (int j = 0; j < y; j++)
         {
-            unsigned long long g = gcd(r, (unsigned long long) d);
-            r /= g;
-            unsigned long long t = n / (d / g);
-
-            if (r > MAX_LONG / t)
-                // overflow error
-            {
-                overflow = true;
-            }
-            else
-            {
-                r *= t;
-            }
+            fprintf(stderr, "%7.2f", matrix[i][j]);
         }
+
+        fprintf(stderr, "\n");
     }
 
-    return r;
+    fprintf(stderr, "\n");
+#endif
 }
 
 /**
@@ -172,7 +260,7 @@ void Simplex::lpToTable(LinearProgram* lp)
 void Simplex::tokenizeToMatrix(LinkedList<std::string>* list, int start)
 {
     LinkedList<std::string>::ListIterator iterator = list->iterator();
-    for (int i = start; i < list->getSize(); i++)
+    for (int i = start; i < start + list->getSize(); i++)
     {
         int j = 0;
         std::istringstream split(iterator.next());
@@ -200,6 +288,13 @@ void Simplex::tokenizeToMatrix(LinkedList<std::string>* list, int start)
  * and subtracting from every other row a multiple of this new pivot row, 
  * such that they have the value 0 in the pivot column.
  *
+ * A table mapped from a file (see setMappedStorage()) is worked through a
+ * panel of rows at a time, in the same order, so it gives the same result.
+ *
+ * Builds with PIVOT_HOOKS call the PivotHook of setPivotHook() around 
+ * every pivot, which the benchmark counts pivots through; other builds 
+ * have no call at all.
+ *
  * Param: table - the table to perform a pivot operation on.
  * Param: pivotRow - the number of rows that are permitted to be the pivot
  *                   row
@@ -210,9 +305,13 @@ void Simplex::tokenizeToMatrix(LinkedList<std::string>* list, int start)
 void Simplex::pivot(double** table, int pivotRow, int pivotCol, 
                                     int numRows, int numCols)
 {   
-    #ifdef SERVER_DEBUG
-        std::cerr << "pivoting on row " << pivotRow << " col " << pivotCol << std::endl;
-    #endif
+    TRACE_SCOPE("pivot", "row", pivotRow, "col", pivotCol);
+#ifdef PIVOT_HOOKS
+    if (pivotHook)
+    {
+        pivotHook->beforePivot();
+    }
+#endif
     double pivotNumber = table[pivotRow][pivotCol];
 
     for (int col = 0; col < numCols; col++)
@@ -223,21 +322,49 @@ void Simplex::pivot(double** table, int pivotRow, int pivotCol,
         }
     }
 
-    for (int row = 0; row < numRows; row++)
+    // A table mapped from a file is updated a panel of rows at a time, 
+    // asking for the next panel before starting on this one so the disk
+    // reads it while the rows here are worked on. A table on the heap is 
+    // a single panel.
+    MappedTable* mapped = 0;
+    if (table == this->table)
+    {
+        mapped = mappedTable;
+    }
+    else if (table == relatedTable)
+    {
+        mapped = mappedRelatedTable;
+    }
+    int panelRows = mapped ? mapped->getPanelRows() : numRows;
+    for (int first = 0; first < numRows; first += panelRows)
     {
-        if (std::abs(table[row][pivotCol]) > ZERO_TOLERANCE &&
-            row != pivotRow)
+        int last = std::min(first + panelRows, numRows);
+        if (mapped && last < numRows)
         {
-            double multiple = table[row][pivotCol] /
-                              table[pivotRow][pivotCol];
-
-            for (int col = 0; col < numCols; col++)
+            mapped->willNeed(last, panelRows);
+        }
+        for (int row = first; row < last; row++)
+        {
+            if (std::abs(table[row][pivotCol]) > ZERO_TOLERANCE &&
+                row != pivotRow)
             {
-                table[row][col] = table[row][col] -
-                                    (multiple * table[pivotRow][col]);
+                double multiple = table[row][pivotCol] /
+                                  table[pivotRow][pivotCol];
+
+                for (int col = 0; col < numCols; col++)
+                {
+                    table[row][col] = table[row][col] -
+                                        (multiple * table[pivotRow][col]);
+                }
             }
         }
     }
+#ifdef PIVOT_HOOKS
+    if (pivotHook)
+    {
+        pivotHook->afterPivot();
+    }
+#endif
 }
 
 /**
@@ -290,15 +417,62 @@ bool Simplex::isTwoPhase()
 LPSolution* Simplex::solve()
 {
     LPSolution* sol = new LPSolution();
+    solveInto(sol);
+    return sol;
+}
+
+/**
+ * Solves the problem like solve(), but into a solution the caller owns, 
+ * whose array of optimal values is reused when it has the right size. 
+ * With load() and setKeepWorkspace(), this lets a server solve problems of
+ * the same shape over and over without allocating: after the first solve,
+ * a solve with the default settings that ends SOLVED allocates nothing.
+ * Only the result of the solution is replaced; its sensitivity analysis is
+ * left alone.
+ *
+ * Param: sol - the solution to store the result in.
+ */
+void Simplex::solveInto(LPSolution* sol)
+{
+    sol->setErrorCode(LPSolution::DEFAULT);
+    sol->setZValue(0);
+    sol->setGap(0);
+    iterations = 0;
+    degeneratePivots = 0;
+    timedOut = false;
+    phaseOneIterations = 0;
+    phaseOneTime = 0;
+    phaseTwoTime = 0;
+    AllocationCounter counter;
+    allocations[SolveStats::PHASE_ONE] = 0;
+    allocatedBytes[SolveStats::PHASE_ONE] = 0;
+    std::chrono::steady_clock::time_point start = 
+        std::chrono::steady_clock::now();
+    if (gapTolerance > 0)
+    {
+        computeUpperBounds();
+    }
     if (isTwoPhase())
     {
-        if (checkFeasibility())
+        bool feasible = checkFeasibility();
+        phaseOneIterations = iterations;
+        phaseOneTime = secondsSince(start);
+        countAllocations(SolveStats::PHASE_ONE, counter);
+        if (feasible)
         {
             #ifdef SERVER_DEBUG
                 std::cerr << "new matrix" << std::endl;
                 displayMatrix(table, numRows, numCols);
             #endif
-            optimize(table, sol, numRows, numCols, numRows - 1);
+            start = std::chrono::steady_clock::now();
+            optimizePerturbed(sol);
+            phaseTwoTime = secondsSince(start);
+        }
+        else if (timedOut || relatedSol.getErrorCode() ==
+                             LPSolution::EXCEEDED_MAX_ITERATIONS)
+        {
+            sol->setErrorCode(timedOut ? LPSolution::TIMED_OUT :
+                              LPSolution::EXCEEDED_MAX_ITERATIONS);
         }
         else
         {
@@ -307,289 +481,1703 @@ LPSolution* Simplex::solve()
     }
     else
     {
-        optimize(table, sol, numRows, numCols, numRows - 1);
+        optimizePerturbed(sol);
+        phaseTwoTime = secondsSince(start);
     }
+    countAllocations(SolveStats::PHASE_TWO, counter);
+    recordStats(sol);
+}
 
-    arrayDel2d(table, numConstraints + 1);
-
+/**
+ * Solves the problem like solve(), but first crashes a starting basis from
+ * a feasible point, such as one found by a heuristic (see crash()), so 
+ * Phase II starts near the optimum rather than at the origin. The answer is
+ * exact either way. Problems that need Phase I have no slack basis to 
+ * crash from and are solved as by solve().
+ *
+ * Param: point - a feasible value of every decision variable.
+ * Return: The solution.
+ */
+LPSolution* Simplex::solveFrom(const double* point)
+{
+    if (isTwoPhase())
+    {
+        return solve();
+    }
+    LPSolution* sol = new LPSolution();
+    iterations = 0;
+    degeneratePivots = 0;
+    timedOut = false;
+    AllocationCounter counter;
+    std::chrono::steady_clock::time_point start = 
+        std::chrono::steady_clock::now();
+    if (gapTolerance > 0)
+    {
+        computeUpperBounds();
+    }
+    crash(point);
+    phaseOneIterations = iterations;
+    phaseOneTime = secondsSince(start);
+    countAllocations(SolveStats::PHASE_ONE, counter);
+    start = std::chrono::steady_clock::now();
+    optimizePerturbed(sol);
+    phaseTwoTime = secondsSince(start);
+    countAllocations(SolveStats::PHASE_TWO, counter);
+    recordStats(sol);
     return sol;
 }
 
 /**
- * CheckFeasiblity() is Phase I of the Two-Phase Simplex Method. It forms
- * an auxiliary problem to the original by adding "artificial" extra slack
- * variables that ensure it has a Basic Feasible Solution even if the original
- * doesn't. This auxilary problem, which trys to minimize all the artificial
- * variables to zero, is solved using the optimize() method. If the optimal 
- * value is 0, it means the original problem can be solved using the BFS 
- * indicated by the final table. In that case, the appropriate rows and 
- * columns are copied over to the original table. Otherwise, 
- * false is returned.
+ * Pivots the decision variables that are positive at a feasible point into
+ * the slack basis, each in place of the slack of a row the point holds 
+ * tight. Every column left out of the basis is then 0 at the point, so if
+ * every candidate finds a row the basic solution is the point itself. A 
+ * candidate may only take a row that the ratio test allows, so the basis
+ * stays feasible throughout; one that cannot enter yet is tried again on 
+ * the next pass, once the others have moved the rows that block it. 
+ * Candidates are taken from the sparsest column up and each picks the 
+ * sparsest row it can, which keeps the basis close to triangular: for 
+ * HetNet scenes a rate at r_ua,max takes its own bound row, and z, which 
+ * appears in every fairness row, comes last. The passes stop when one 
+ * pivots nothing or the budget runs out.
  *
- * return: True if Feasible.
- *
- * TODO: refactor this endless function
+ * Param: point - a feasible value of every decision variable.
+ * Return: The number of pivots made.
  */
-bool Simplex::checkFeasibility()
+int Simplex::crash(const double* point)
 {
-    // Instantiate a table for the related (auxilary) problem.
-    int curRows = numConstraints + numEqConstraints + 2;
-    int curColumns = numDecisionVars + (2 * numConstraints) +
-                     (2 * numEqConstraints) + 1;
-    double** relatedTable = arrayInit2d(curRows, curColumns);
-
-    // Copy the  constraints from the original problem into the 
-    // first m rows and n+m columns of relatedTable.
+    TRACE_SCOPE("crash", "rows", numConstraints, "cols", numCols);
+    int rhsCol = numCols - 1;
+    std::vector<bool> tight(numConstraints);
+    std::vector<int> rowCount(numConstraints, 0);
+    std::vector<int> colCount(numDecisionVars, 0);
     for (int i = 0; i < numConstraints; i++)
     {
-        for (int j = 0; j < numDecisionVars + numConstraints; j++)
+        double activity = 0;
+        for (int j = 0; j < numDecisionVars; j++)
         {
-            relatedTable[i][j] = table[i][j];
+            if (table[i][j] != 0)
+            {
+                activity += table[i][j] * point[j];
+                rowCount[i]++;
+                colCount[j]++;
+            }
         }
+        tight[i] = table[i][rhsCol] - activity <=
+                   FEASIBILITY_TOLERANCE * std::max(1.0,
+                                                    std::abs(table[i][rhsCol]));
+    }
 
-        relatedTable[i][curColumns - 1] = table[i][numDecisionVars + numConstraints];
+    std::vector<std::pair<int, int> > candidates;
+    for (int j = 0; j < numDecisionVars; j++)
+    {
+        if (point[j] > ZERO_TOLERANCE)
+        {
+            candidates.push_back(std::make_pair(colCount[j], j));
+        }
     }
+    std::sort(candidates.begin(), candidates.end());
 
-    // Copy the objective equation over. 
-    for (int i = 0; i < numConstraints + numDecisionVars; i++)
+    int pivots = 0;
+    bool progress = true;
+    while (progress)
     {
-        relatedTable[numConstraints + numEqConstraints][i] =
-            table[numConstraints][i];
+        progress = false;
+        for (size_t k = 0; k < candidates.size() && !budgetExhausted(); k++)
+        {
+            int col = candidates[k].second;
+            if (col < 0)
+            {
+                continue;
+            }
+            double minRatio = DBL_MAX;
+            for (int row = 0; row < numConstraints; row++)
+            {
+                if (table[row][col] > ZERO_TOLERANCE)
+                {
+                    minRatio = std::min(minRatio,
+                                        table[row][rhsCol] / table[row][col]);
+                }
+            }
+            int pivotRow = -1;
+            for (int row = 0; row < numConstraints; row++)
+            {
+                if (tight[row] && basis[row] >= numDecisionVars &&
+                    table[row][col] > ZERO_TOLERANCE &&
+                    table[row][rhsCol] / table[row][col] <=
+                        minRatio + FEASIBILITY_TOLERANCE &&
+                    (pivotRow == -1 || rowCount[row] < rowCount[pivotRow]))
+                {
+                    pivotRow = row;
+                }
+            }
+            if (pivotRow != -1)
+            {
+                pivot(table, pivotRow, col, numRows, numCols);
+                basis[pivotRow] = col;
+                if (table[pivotRow][rhsCol] < 0)
+                {
+                    table[pivotRow][rhsCol] = 0;
+                }
+                candidates[k].second = -1;
+                iterations++;
+                pivots++;
+                progress = true;
+            }
+        }
     }
+    return pivots;
+}
 
-    // Used to keep track of which column needs the next artifical variable.
-    int colCounter = numDecisionVars + numConstraints + numEqConstraints;
+/**
+ * Phase II of solve(). When perturbation is on, a small, different amount 
+ * is first added to the right hand side of every <= row, so that no two 
+ * rows block an entering column at the same step and no pivot is a step of
+ * length 0. Degenerate problems such as HetNet scenes, where many rates 
+ * start at 0 and many bounds tie, can otherwise spend most of their pivots
+ * standing still. Once the perturbed problem is optimal the original right
+ * hand sides are put back, which leaves the basis at most slightly 
+ * infeasible, and the last few pivots (dual simplex, then primal) solve the
+ * original problem exactly. The implied bounds only hold for the original
+ * problem, so a gap tolerance only applies to those last pivots. A solve 
+ * that runs out of budget only returns a point that is feasible for the 
+ * original right hand sides.
+ *
+ * Param: sol - the solution we are storing results in.
+ */
+void Simplex::optimizePerturbed(LPSolution* sol)
+{
+    if (!perturb)
+    {
+        optimize(table, basis.data(), sol, numRows, numCols, numRows - 1);
+        return;
+    }
 
-    // Add an artificial slack variable for each inequality constraint,
-    // -1 when b is negative, 1 otherwise.
+    // The amounts are scaled by the largest right hand side, so rows with
+    // a right hand side of 0 are moved as far as the others, and come from
+    // a fixed linear congruential sequence, so repeated solves of a problem
+    // take the same pivots.
+    std::vector<double> original(rowRhs.begin(),
+                                 rowRhs.begin() + numLeqConstraints);
+    std::vector<double> originalBounds(upperBound);
+    double scale = 1;
     for (int i = 0; i < numLeqConstraints; i++)
     {
-        if (table[i][numDecisionVars + numConstraints] < 0)
-        {
-            relatedTable[i][colCounter++] = -1;
-        }
-        else
-        {
-            relatedTable[i][colCounter++] = 1;
-        }
+        scale = std::max(scale, std::abs(original[i]));
+    }
+    unsigned int seed = 12345;
+    for (int i = 0; i < numLeqConstraints; i++)
+    {
+        seed = seed * 1103515245 + 12345;
+        double fraction = 0.5 + 0.5 * ((seed >> 16) & 0x7fff) / 32767.0;
+        changeRhs(i, original[i] + PERTURBATION * scale * fraction);
     }
 
-    int rowCounter = 0;
-    // Add artificial variables for each equality constraint, and make a second
-    // copy of each with an opposite-valued artificial variable. 
-    for (int i = numLeqConstraints; i < numConstraints; i++)
+    optimize(table, basis.data(), sol, numRows, numCols, numRows - 1);
+    for (int i = 0; i < numLeqConstraints; i++)
     {
-        if (table[i][numDecisionVars + numConstraints] < 0)
-        {
-            relatedTable[i][colCounter++] = -1;
-        }
-        else
-        {
-            relatedTable[i][colCounter++] = 1;
-        }
+        changeRhs(i, original[i]);
+    }
+    upperBound.swap(originalBounds);
+    if (sol->getErrorCode() != LPSolution::SOLVED &&
+        sol->getErrorCode() != LPSolution::TIMED_OUT)
+    {
+        return;
+    }
 
-        for (int j = 0; j < curColumns; j++)
-        {
-            relatedTable[numConstraints + rowCounter][j] = relatedTable[i][j];
-        }
+    // A timed out point was only feasible for the perturbed right hand 
+    // sides. The budget is spent, so it is kept only if it is feasible 
+    // without them, and optimize() reads it off the table again; otherwise
+    // there is nothing left to repair it with and no values are returned.
+    int errorCode = restoreFeasibility();
+    if (errorCode == LPSolution::SOLVED)
+    {
+        optimize(table, basis.data(), sol, numRows, numCols, numRows - 1);
+    }
+    else
+    {
+        delete [] sol->getOptimalValues();
+        sol->setOptimalValues(0);
+        sol->setNumOptimalValues(0);
+        sol->setErrorCode(errorCode);
+    }
+}
 
-        relatedTable[numConstraints + rowCounter]
-        [numDecisionVars + numLeqConstraints + rowCounter] = 0;
+/**
+ * Enables or disables the Harris ratio test (see ratioTest()). It is on by
+ * default; turning it off is mostly useful for comparisons.
+ */
+void Simplex::setHarrisRatioTest(bool inHarris)
+{
+    harris = inHarris;
+}
 
-        relatedTable[numConstraints + rowCounter]
-        [numDecisionVars + numConstraints + rowCounter] = -1;
+/**
+ * Enables or disables perturbing the right hand sides in solve() (see 
+ * optimizePerturbed()). It is off by default.
+ */
+void Simplex::setPerturbation(bool inPerturb)
+{
+    perturb = inPerturb;
+}
 
-        relatedTable[numConstraints + rowCounter][colCounter + rowCounter] =
-        relatedTable[numConstraints + rowCounter][colCounter + rowCounter - 1];
+/**
+ * Returns the number of pivots of the last solve() or reoptimize() that 
+ * left every variable where it was, because the leaving row's right hand
+ * side was 0. Many such pivots in a row mean the method is stalling.
+ */
+unsigned long long Simplex::getDegeneratePivots()
+{
+    return degeneratePivots;
+}
 
-        relatedTable[numConstraints + rowCounter]
-                    [colCounter + rowCounter - 1] = 0;
+/**
+ * Lets solve() stop as soon as the current point is provably within a 
+ * relative gap of the optimum, instead of pivoting until it is optimal.
+ * The proof needs an upper bound on every variable, which solve() derives
+ * from the rows (see computeUpperBounds()); problems where some improving
+ * variable has no implied bound are always solved exactly. The gap the
+ * solution reached is reported by LPSolution::getGap().
+ *
+ * Param: inGapTolerance - the relative gap, such as 0.01 for a solution
+ *                         within 1% of the optimum, or 0 to solve exactly.
+ */
+void Simplex::setGapTolerance(double inGapTolerance)
+{
+    gapTolerance = inGapTolerance;
+}
 
-        rowCounter++;
-        colCounter++;
-    }
-    
-    // Set the objective equation of the auxiliary problem to have a 1 in 
-    // each artificial variable column. We're trying to minimize their sum.
-    for (int i = numDecisionVars + numConstraints + numEqConstraints;
-             i < curColumns - 1; i++)
-    {
-        relatedTable[numConstraints + numEqConstraints + 1][i] = 1;
-    }
-    
-    // Multiply rows with negative b-values by -1 to simplify the solving.
-    for (int i = 0; i < curRows - 1; i++)
+/**
+ * Derives an upper bound on every column from the rows of the table, 
+ * which must still hold the original problem. Since every variable is at
+ * least 0, a row sum_k(a_k * x_k) <= b bounds each x_j with a_j > 0 by
+ * (b - sum(a_k * u_k over a_k < 0)) / a_j, where u_k are bounds already 
+ * found, and bounds its slack by the numerator. Bounds found from one row
+ * can bound variables of another, so the rows are passed over 
+ * BOUND_PASSES times; for HetNet scenes the first pass bounds every rate
+ * and the fairness rows then bound z. Columns without a bound get DBL_MAX.
+ */
+void Simplex::computeUpperBounds()
+{
+    // Gather the nonzero entries once; the table is mostly zeros.
+    std::vector<int> rowStart(numConstraints + 1, 0);
+    std::vector<int> cols;
+    std::vector<double> values;
+    for (int i = 0; i < numConstraints; i++)
     {
-        if (relatedTable[i][curColumns - 1] < 0)
+        for (int j = 0; j < numDecisionVars; j++)
         {
-            for (int j = 0; j < curColumns; j++)
+            if (table[i][j] != 0)
             {
-                if (relatedTable[i][j] != 0)
-                    relatedTable[i][j] *= -1;
+                cols.push_back(j);
+                values.push_back(table[i][j]);
             }
         }
+        rowStart[i + 1] = cols.size();
     }
-    
-    // Sum each column and subtract that from the entry in the last row, 
-    // the objective equation.
-    for (int i = 0; i < curColumns; i++)
-    {
-        double columnSum = 0;
 
-        for (int j = 0; j < curRows - 2; j++)
+    upperBound.assign(numDecisionVars + numConstraints, DBL_MAX);
+    for (int pass = 0; pass < BOUND_PASSES; pass++)
+    {
+        for (int i = 0; i < numConstraints; i++)
         {
-            columnSum += relatedTable[j][i];
+            double rest = table[i][numCols - 1];
+            bool bounded = true;
+            for (int k = rowStart[i]; k < rowStart[i + 1] && bounded; k++)
+            {
+                if (values[k] < 0)
+                {
+                    bounded = upperBound[cols[k]] != DBL_MAX;
+                    rest -= values[k] * upperBound[cols[k]];
+                }
+            }
+            if (!bounded)
+            {
+                continue;
+            }
+            rest = std::max(rest, 0.0);
+            upperBound[numDecisionVars + i] = rest;
+            for (int k = rowStart[i]; k < rowStart[i + 1]; k++)
+            {
+                if (values[k] > ZERO_TOLERANCE)
+                {
+                    upperBound[cols[k]] = std::min(upperBound[cols[k]], 
+                                                   rest / values[k]);
+                }
+            }
         }
-
-        relatedTable[curRows - 1][i] -= columnSum;
-    }
-
-    #ifdef SERVER_DEBUG
-        std::cerr << "related matrix" << std::endl;
-        displayMatrix(relatedTable, curRows, curColumns);
-    #endif
-    // Multiply the objective equation row by -1 so it can be solved as a 
-    // maximization.
-    for (int i = 0; i < curColumns; i++)
-    {
-        if (!(std::abs(relatedTable[curRows - 1][i]) < ZERO_TOLERANCE))
-            relatedTable[curRows - 1][i] *= -1;
     }
+}
 
-    // Attempt to solve the related problem to find a BFS for the original.
-    LPSolution relatedSol;
-    optimize(relatedTable, &relatedSol, curRows, curColumns, curRows - 2);
-    
-    // Multiply the original problem's objective equation by -1. 
-    for (int i = 0; i < curColumns - 1; i++)
+/**
+ * Returns the relative gap between the current point of Phase II and a 
+ * bound on the optimum. Every feasible point x has objective value
+ * z + sum_j(d_j * x_j), where z is the current value and d_j the objective
+ * row entries of the nonbasic columns, so with each x_j at most its upper
+ * bound u_j the optimum is at most z + sum(d_j * u_j over d_j > 0): a 
+ * Lagrangian bound with the current duals.
+ *
+ * Return: (bound - z) / |bound|, or DBL_MAX if there is no bound.
+ */
+double Simplex::computeGap()
+{
+    if (upperBound.empty())
     {
-        if (!(std::abs(relatedTable[curRows - 2][i]) < ZERO_TOLERANCE))
-            relatedTable[curRows - 2][i] *= -1;
+        return DBL_MAX;
     }
-
-    // Check if the auxiliary problem's optimal value is 0, which means we
-    // found a BFS for the original.
-    bool solvable;
-    if ((solvable = (relatedSol.getErrorCode() == 0 &&
-        std::abs(relatedSol.getZValue()) < ZERO_TOLERANCE)))
+    double* objective = table[numRows - 1];
+    double value = -objective[numCols - 1];
+    double bound = value;
+    for (int j = 0; j < numCols - 1; j++)
     {
-        // Transfer the BFS we found to the original table for solving later.
-        for (int i = 0; i < numConstraints; i++)
+        if (objective[j] > 0)
         {
-            for (int j = 0; j < numConstraints + numDecisionVars; j++)
+            if (upperBound[j] == DBL_MAX)
             {
-                table[i][j] = relatedTable[i][j];
+                return DBL_MAX;
             }
-
-            table[i][numConstraints + numDecisionVars] =
-                relatedTable[i][curColumns - 1];
+            bound += objective[j] * upperBound[j];
         }
-        for (int i = 0; i < numConstraints + numDecisionVars; i++)
-        {
-            table[numConstraints][i] =
-                relatedTable[numConstraints + numEqConstraints][i];
-        }
-
-        table[numConstraints][numConstraints + numDecisionVars] =
-            relatedTable[numConstraints + numEqConstraints][curColumns - 1];
-
     }
-    arrayDel2d(relatedTable, curRows);
-    return solvable;
+    return (bound - value) / std::max(std::abs(bound), ZERO_TOLERANCE);
 }
 
 /**
- * The core of the Simplex method. This takes in a table, solution object,
- * the size of the table, and how many of the rows are for constraints
- * (rather than objective equations). It then tries to pivot the table
- * as many times as necessary (under a limit) to increase the z-value (the
- * value of the objective equation). See the documentation for details on 
- * the algorithm used.
- *
- * Param: table - the table we are currently optimizing.
- * Param: sol - the solution we are storing results in.
- * Param: curRows - the current number of rows in the table.
- * Param: curCols - the current number of columns in the table.
- * Param: constraintRows - the number of rows containing constraints.
+ * Sets the limits on every later solve(), reoptimize() and Phase I. A solve
+ * that runs out of budget returns LPSolution::TIMED_OUT. If it was in 
+ * Phase II, every basis it visited was feasible and the objective only 
+ * grew, so the solution holds the point it stopped at, the best feasible 
+ * point found; if it was still looking for a feasible point (Phase I, or 
+ * the dual simplex method in reoptimize()) the solution has no values.
  *
- * TODO: should probably be refactored to return the error code rather than
- *       take in the solution and set it.
+ * Param: inBudget - the limits, or 0 for none. It must outlive the solves.
  */
-void Simplex::optimize(double** table, LPSolution* sol, int curRows, 
-                      int curCols, int constraintRows)
+void Simplex::setBudget(SolveBudget* inBudget)
 {
-    double* optimalValues = new double[numDecisionVars]();
-    sol->setNumOptimalValues(numDecisionVars);
-    unsigned long long maxIter = choose(curCols, curRows);
+    budget = inBudget;
+}
+
+/**
+ * Copies the statistics of the solve that just ended into its solution 
+ * (see SolveStats). Callers that parse or build the problem themselves 
+ * add those times on top.
+ *
+ * Param: sol - the solution.
+ */
+void Simplex::recordStats(LPSolution* sol)
+{
+    SolveStats& stats = sol->getStats();
+    stats.setEngine("simplex");
+    stats.setPricing("dantzig");
+    stats.setRatioTest(harris ? "harris" : "textbook");
+    stats.setShape(numConstraints, numCols - 1);
+    stats.setBuildTime(buildTime);
+    stats.setPhaseOneIterations(phaseOneIterations);
+    stats.setPhaseOneTime(phaseOneTime);
+    stats.setPhaseTwoIterations(iterations - phaseOneIterations);
+    stats.setPhaseTwoTime(phaseTwoTime);
+    stats.setDegeneratePivots(degeneratePivots);
+    stats.setPeakTableBytes(peakTableBytes);
+    for (int stage = SolveStats::BUILD; stage <= SolveStats::PHASE_TWO; 
+         stage++)
+    {
+        stats.setAllocations(stage, allocations[stage], allocatedBytes[stage]);
+    }
+}
+
+/**
+ * Returns the most bytes the tables of a solve() will hold at once, from 
+ * the size of the problem alone, so that a caller can tell whether it fits
+ * in memory before anything is allocated. The prediction is exact for a 
+ * fresh Simplex: it is the peak getStats() reports afterwards.
+ *
+ * Param: numConstraints - the <= and = rows.
+ * Param: numDecisionVars - the variables.
+ * Param: numArtificial - the rows that need an artificial variable in 
+ *                        Phase I (see checkFeasibility()), or 0 if there
+ *                        is no Phase I.
+ */
+unsigned long long Simplex::predictPeakBytes(int numConstraints,
+                                             int numDecisionVars,
+                                             int numArtificial)
+{
+    unsigned long long cols = numDecisionVars + numConstraints + 1;
+    unsigned long long bytes = arrayBytes2d(numConstraints + 1, cols);
+    if (numArtificial > 0)
+    {
+        bytes += arrayBytes2d(numConstraints + 2, cols + numArtificial);
+    }
+    return bytes;
+}
+
+/**
+ * Returns predictPeakBytes() of a Linear Program. Only the right hand 
+ * sides of its rows are read, to count the rows needing Phase I.
+ *
+ * Param: lp - the Linear Program.
+ */
+unsigned long long Simplex::predictPeakBytes(LinearProgram* lp)
+{
+    int numEq = lp->getEqConstraints()->getSize();
+    int numArtificial = numEq;
+    LinkedList<std::string>::ListIterator it =
+        lp->getLeqConstraints()->iterator();
+    while (it.hasNext())
+    {
+        std::string row = it.next();
+        size_t last = row.find_last_not_of(' ');
+        size_t start = row.find_last_of(' ', last);
+        start = (start == std::string::npos) ? 0 : start + 1;
+        if (strtod(row.c_str() + start, 0) < 0)
+        {
+            numArtificial++;
+        }
+    }
+
+    std::istringstream countVars(lp->getEquation());
+    std::string token;
+    int numDecisionVars = 0;
+    while (std::getline(countVars, token, ' '))
+    {
+        numDecisionVars++;
+    }
+    return predictPeakBytes(lp->getLeqConstraints()->getSize() + numEq,
+                            numDecisionVars, numArtificial);
+}
+
+/**
+ * Returns predictPeakBytes() of a sparse Linear Program.
+ *
+ * Param: lp - the Linear Program.
+ */
+unsigned long long Simplex::predictPeakBytes(SparseLP* lp)
+{
+    int numArtificial = lp->getNumEqRows();
+    for (int i = 0; i < lp->getNumRows(); i++)
+    {
+        if (lp->getRowType(i) == SparseLP::LEQ && lp->getRhs(i) < 0)
+        {
+            numArtificial++;
+        }
+    }
+    return predictPeakBytes(lp->getNumRows(), lp->getNumVars(),
+                            numArtificial);
+}
+
+/**
+ * Keeps the tables of the Simplex objects made from now on in memory-mapped
+ * temporary files instead of on the heap, when they are large, so problems
+ * whose tables do not fit in memory can still be solved, if slowly (see 
+ * MappedTable). Pivots then update the table a panel of rows at a time, 
+ * reading the next panel from disk while working on the current one. A 
+ * table whose file cannot be made is put on the heap as usual.
+ *
+ * It is meant for offline studies and is set for the whole process, so 
+ * set it before solving. Mapped tables still count towards 
+ * Solver::setMemoryLimit(), which is per web server worker.
+ *
+ * Param: directory - where to make the files, or "" to stop mapping.
+ * Param: minBytes - the smallest table to map, in arrayBytes2d() bytes.
+ * Param: panelBytes - about how many bytes of rows a pivot works on at a
+ *                     time.
+ */
+void Simplex::setMappedStorage(std::string directory,
+                               unsigned long long minBytes,
+                               unsigned long long panelBytes)
+{
+    mapDirectory = directory;
+    mapMinBytes = minBytes;
+    mapPanelBytes = panelBytes;
+}
+
+/**
+ * Returns true if the table is held in a memory-mapped file (see 
+ * setMappedStorage()).
+ */
+bool Simplex::isTableMapped()
+{
+    return mappedTable != 0;
+}
+
+#ifdef PIVOT_HOOKS
+/**
+ * Sets the hook called around every pivot (see PivotHook).
+ *
+ * Param: hook - the hook, or 0 for none. It must outlive the solve.
+ */
+void Simplex::setPivotHook(PivotHook* hook)
+{
+    pivotHook = hook;
+}
+#endif
+
+/**
+ * Records the allocations counted since the counter was last started as
+ * those of a stage, and starts it again for the next stage.
+ *
+ * Param: stage - a stage of SolveStats.
+ * Param: counter - the counter.
+ */
+void Simplex::countAllocations(int stage, AllocationCounter& counter)
+{
+    allocations[stage] = counter.getAllocations();
+    allocatedBytes[stage] = counter.getBytes();
+    counter.restart();
+}
+
+/**
+ * Keeps Phase I's table after each solve, so the next solve of a problem
+ * no larger can reuse it instead of allocating another (see solveInto()).
+ * It is off by default, since the kept table costs as much memory as the 
+ * table itself for as long as the Simplex lives.
+ *
+ * Param: keep - true to keep the table.
+ */
+void Simplex::setKeepWorkspace(bool keep)
+{
+    keepWorkspace = keep;
+    if (!keep && relatedTable)
+    {
+        freeTable(relatedTable, relatedRowCapacity, &mappedRelatedTable);
+        relatedTable = 0;
+        relatedRowCapacity = 0;
+        relatedColCapacity = 0;
+    }
+}
+
+/**
+ * Returns the number of pivots taken by the last solve() or reoptimize().
+ */
+unsigned long long Simplex::getIterations()
+{
+    return iterations;
+}
+
+/**
+ * Checks the budget before a pivot and records whether it ran out.
+ *
+ * Return: True if the solve must stop.
+ */
+bool Simplex::budgetExhausted()
+{
+    timedOut = budget && budget->isExhausted(iterations);
+    return timedOut;
+}
+
+/**
+ * Destructor for Simplex objects. The table is kept after solve() so the
+ * problem can be modified and reoptimized, and is freed here.
+ */
+Simplex::~Simplex()
+{
+    freeTable(table, rowCapacity, &mappedTable);
+    if (relatedTable)
+    {
+        freeTable(relatedTable, relatedRowCapacity, &mappedRelatedTable);
+    }
+}
+
+/**
+ * Sets up the slack basis the table starts in, where the slack variable of
+ * each row is basic in that row, and records the original right hand sides
+ * and objective coefficients for changeRhs() and changeObjective().
+ */
+void Simplex::initState()
+{
+    basis.resize(numConstraints);
+    rowRhs.resize(numConstraints);
+    for (int i = 0; i < numConstraints; i++)
+    {
+        basis[i] = numDecisionVars + i;
+        rowRhs[i] = table[i][numCols - 1];
+    }
+    varCost.resize(numDecisionVars);
+    for (int j = 0; j < numDecisionVars; j++)
+    {
+        varCost[j] = table[numConstraints][j];
+    }
+}
+
+/**
+ * Returns the basic column of every constraint row of the table: decision
+ * variables are numbered from 0, and the slack variable of row i is column
+ * getNumDecisionVars() + i. Rows whose basic variable is not a column of the
+ * table are -1.
+ */
+std::vector<int> Simplex::getBasis()
+{
+    return basis;
+}
+
+/**
+ * Returns the number of decision variables, including added ones.
+ */
+int Simplex::getNumDecisionVars()
+{
+    return numDecisionVars;
+}
+
+/**
+ * Returns the number of constraint rows, including added ones.
+ */
+int Simplex::getNumConstraints()
+{
+    return numConstraints;
+}
+
+/**
+ * Returns the dual value (shadow price) of a constraint row in the current
+ * table: the rate at which the objective grows as the row's right hand side
+ * grows. It is read from the objective row entry of the row's slack column.
+ *
+ * Param: row - the row.
+ * Return: Its dual value, which is nonnegative once the table is optimal.
+ */
+double Simplex::getDual(int row)
+{
+    return -table[numRows - 1][numDecisionVars + row];
+}
+
+/**
+ * Returns the reduced cost of a decision variable in the current table: 
+ * its objective row entry, the rate at which the objective would change if
+ * the variable were increased from its current value.
+ *
+ * Param: var - the decision variable.
+ * Return: Its reduced cost, which is at most 0 once the table is optimal.
+ */
+double Simplex::getReducedCost(int var)
+{
+    return table[numRows - 1][var];
+}
+
+/**
+ * Reads a sensitivity analysis off the optimal table into a solution, so
+ * questions such as which access point's capacity is worth raising are 
+ * answered without solving again.
+ *
+ * Right hand side ranging: raising row i's right hand side by t moves the
+ * basic values along row i's slack column, which holds column i of the 
+ * inverse basis. The basis stays feasible, and the dual value valid, while
+ * every basic value stays nonnegative.
+ *
+ * Objective ranging: raising the cost of a nonbasic variable by t raises 
+ * its own objective row entry by t, so the basis stays optimal until the
+ * entry reaches 0. Raising the cost of the variable basic in row r by t 
+ * lowers the objective row by t times row r, which stays optimal while 
+ * every nonbasic entry stays at most 0.
+ *
+ * Param: sol - the solution of the last solve() or reoptimize(), which must
+ *              be SOLVED.
+ */
+void Simplex::computeSensitivity(LPSolution* sol)
+{
+    double* objective = table[numRows - 1];
+    std::vector<int> basicRow(numCols - 1, -1);
+    for (int i = 0; i < numConstraints; i++)
+    {
+        if (basis[i] >= 0)
+        {
+            basicRow[basis[i]] = i;
+        }
+    }
+
+    std::vector<double>& duals = sol->getDuals();
+    std::vector<double>& rhsLower = sol->getRhsLower();
+    std::vector<double>& rhsUpper = sol->getRhsUpper();
+    duals.resize(numConstraints);
+    rhsLower.resize(numConstraints);
+    rhsUpper.resize(numConstraints);
+    for (int row = 0; row < numConstraints; row++)
+    {
+        int slackCol = numDecisionVars + row;
+        double down = DBL_MAX;
+        double up = DBL_MAX;
+        for (int i = 0; i < numConstraints; i++)
+        {
+            double entry = table[i][slackCol];
+            double value = std::max(table[i][numCols - 1], 0.0);
+            if (entry > ZERO_TOLERANCE)
+            {
+                down = std::min(down, value / entry);
+            }
+            else if (entry < -ZERO_TOLERANCE)
+            {
+                up = std::min(up, -value / entry);
+            }
+        }
+        duals[row] = getDual(row) + 0.0; // no -0 in printed output
+        rhsLower[row] = (down == DBL_MAX) ? -DBL_MAX : rowRhs[row] - down;
+        rhsUpper[row] = (up == DBL_MAX) ? DBL_MAX : rowRhs[row] + up;
+    }
+
+    std::vector<double>& reducedCosts = sol->getReducedCosts();
+    std::vector<double>& costLower = sol->getCostLower();
+    std::vector<double>& costUpper = sol->getCostUpper();
+    reducedCosts.resize(numDecisionVars);
+    costLower.resize(numDecisionVars);
+    costUpper.resize(numDecisionVars);
+    for (int var = 0; var < numDecisionVars; var++)
+    {
+        reducedCosts[var] = getReducedCost(var);
+        int row = basicRow[var];
+        if (row == -1)
+        {
+            costLower[var] = -DBL_MAX;
+            costUpper[var] = varCost[var] - std::min(objective[var], 0.0);
+            continue;
+        }
+
+        double down = DBL_MAX;
+        double up = DBL_MAX;
+        for (int col = 0; col < numCols - 1; col++)
+        {
+            double entry = table[row][col];
+            if (basicRow[col] != -1 || std::abs(entry) <= ZERO_TOLERANCE)
+            {
+                continue;
+            }
+            double slack = -std::min(objective[col], 0.0);
+            if (entry > 0)
+            {
+                down = std::min(down, slack / entry);
+            }
+            else
+            {
+                up = std::min(up, -slack / entry);
+            }
+        }
+        reducedCosts[var] = 0;
+        costLower[var] = (down == DBL_MAX) ? -DBL_MAX : varCost[var] - down;
+        costUpper[var] = (up == DBL_MAX) ? DBL_MAX : varCost[var] + up;
+    }
+}
+
+/*
+ * The functions below modify a problem that has already been solved, so it 
+ * can be reoptimized starting from its current basis rather than from 
+ * scratch. They rely on the slack columns of the table holding the inverse
+ * of the current basis, which holds because every row starts out with its
+ * own slack variable. Rows are numbered as in the table: the <= rows first,
+ * then the = rows, then any added rows.
+ */
+
+/**
+ * Makes sure the table can hold the given number of rows and columns,
+ * reallocating it with room to spare if it cannot.
+ *
+ * Param: rows - the number of rows needed.
+ * Param: cols - the number of columns needed.
+ */
+void Simplex::reserveTable(int rows, int cols)
+{
+    if (rows <= rowCapacity && cols <= colCapacity)
+    {
+        return;
+    }
+    int newRowCapacity = std::max(rows, rowCapacity + rowCapacity / 2);
+    int newColCapacity = std::max(cols, colCapacity + colCapacity / 2);
+    MappedTable* newMapped = 0;
+    double** newTable = allocateTable(newRowCapacity, newColCapacity,
+                                      &newMapped);
+    peakTableBytes = std::max(peakTableBytes, 
+                              arrayBytes2d(rowCapacity, colCapacity) +
+                              arrayBytes2d(newRowCapacity, newColCapacity));
+    for (int i = 0; i < numRows; i++)
+    {
+        memcpy(newTable[i], table[i], numCols * sizeof(double));
+    }
+    freeTable(table, rowCapacity, &mappedTable);
+    table = newTable;
+    mappedTable = newMapped;
+    rowCapacity = newRowCapacity;
+    colCapacity = newColCapacity;
+}
+
+/**
+ * Changes the right hand side of a row. The basis stays the same; the 
+ * values of the basic variables and of the objective move by the change 
+ * times the row's slack column, which may make the table infeasible until
+ * reoptimize() is called.
+ *
+ * Param: row - the row to change.
+ * Param: rhs - its new right hand side.
+ */
+void Simplex::changeRhs(int row, double rhs)
+{
+    upperBound.clear();
+    double delta = rhs - rowRhs[row];
+    int slackCol = numDecisionVars + row;
+    if (delta == 0)
+    {
+        return;
+    }
+    for (int i = 0; i < numRows; i++)
+    {
+        if (table[i][slackCol] != 0)
+        {
+            table[i][numCols - 1] += delta * table[i][slackCol];
+        }
+    }
+    rowRhs[row] = rhs;
+}
+
+/**
+ * Adds delta to the objective coefficient of a column and updates the
+ * objective row to match. If the column is basic in row r, the objective
+ * row changes by -delta times row r, which keeps the column's own entry at
+ * 0; otherwise only its own entry changes.
+ *
+ * Param: col - the column.
+ * Param: delta - the change in its objective coefficient.
+ */
+void Simplex::shiftColumnCost(int col, double delta)
+{
+    double* objective = table[numRows - 1];
+    int basicRow = -1;
+    for (int i = 0; i < numConstraints && basicRow == -1; i++)
+    {
+        if (basis[i] == col)
+        {
+            basicRow = i;
+        }
+    }
+
+    if (basicRow == -1)
+    {
+        objective[col] += delta;
+    }
+    else
+    {
+        for (int j = 0; j < numCols; j++)
+        {
+            if (table[basicRow][j] != 0)
+            {
+                objective[j] -= delta * table[basicRow][j];
+            }
+        }
+        objective[col] = 0;
+    }
+}
+
+/**
+ * Changes the objective coefficient of a decision variable. This may make
+ * the current basis non-optimal until reoptimize() is called.
+ *
+ * Param: var - the decision variable.
+ * Param: cost - its new coefficient.
+ */
+void Simplex::changeObjective(int var, double cost)
+{
+    if (cost != varCost[var])
+    {
+        shiftColumnCost(var, cost - varCost[var]);
+        varCost[var] = cost;
+    }
+}
+
+/**
+ * Adds decision variables. The new columns are placed after the existing
+ * decision variables, so the slack columns move right, and are expressed in
+ * terms of the current basis. They start out nonbasic at 0, so the table 
+ * stays feasible, but may be attractive enough to make it non-optimal.
+ *
+ * The columns are given in compressed sparse column form over the original
+ * rows: the entries of new column k are rowIndex[i] and values[i] for i in
+ * [colStart[k], colStart[k + 1]).
+ *
+ * Param: count - the number of columns to add.
+ * Param: costs - their objective coefficients.
+ * Param: colStart - the first entry of each column; has count + 1 entries.
+ * Param: rowIndex - the row of each entry.
+ * Param: values - the value of each entry.
+ * Return: The index of the first new decision variable.
+ */
+int Simplex::addColumns(int count, const double* costs, const int* colStart,
+                        const int* rowIndex, const double* values)
+{
+    upperBound.clear();
+    int first = numDecisionVars;
+    reserveTable(numRows, numCols + count);
+
+    // Shift the slack and right hand side columns of every row.
+    for (int i = 0; i < numRows; i++)
+    {
+        memmove(table[i] + first + count, table[i] + first,
+                (numCols - first) * sizeof(double));
+        for (int k = 0; k < count; k++)
+        {
+            table[i][first + k] = 0;
+        }
+    }
+    numDecisionVars += count;
+    numCols += count;
+    for (int i = 0; i < numConstraints; i++)
+    {
+        if (basis[i] >= first)
+        {
+            basis[i] += count;
+        }
+    }
+
+    // The column of B^-1 * a is the sum of the slack columns of a's rows, 
+    // weighted by a. The objective row entry works the same way, plus the
+    // variable's own coefficient.
+    for (int k = 0; k < count; k++)
+    {
+        int col = first + k;
+        for (int e = colStart[k]; e < colStart[k + 1]; e++)
+        {
+            int slackCol = numDecisionVars + rowIndex[e];
+            for (int i = 0; i < numRows; i++)
+            {
+                if (table[i][slackCol] != 0)
+                {
+                    table[i][col] += values[e] * table[i][slackCol];
+                }
+            }
+        }
+        table[numRows - 1][col] += costs[k];
+        varCost.push_back(costs[k]);
+    }
+    return first;
+}
+
+/**
+ * Adds a <= row over the decision variables. The row gets its own slack 
+ * variable, which becomes basic in it, and the basic variables are 
+ * eliminated from it so the table stays in canonical form. Its right hand 
+ * side may end up negative, in which case the current solution violates the
+ * new row until reoptimize() is called.
+ *
+ * Param: count - the number of nonzero coefficients.
+ * Param: vars - the decision variable of each coefficient.
+ * Param: values - the coefficients.
+ * Param: rhs - the right hand side.
+ * Return: The index of the new row.
+ */
+int Simplex::addRow(int count, const int* vars, const double* values,
+                    double rhs)
+{
+    upperBound.clear();
+    int row = numConstraints;
+    int slackCol = numCols - 1;
+    reserveTable(numRows + 1, numCols + 1);
+
+    // Make room for the new slack column in front of the right hand sides.
+    for (int i = 0; i < numRows; i++)
+    {
+        table[i][numCols] = table[i][numCols - 1];
+        table[i][slackCol] = 0;
+    }
+    numCols++;
+
+    // The objective row moves down to make room for the new row.
+    double* newRow = table[numRows];
+    table[numRows] = table[numRows - 1];
+    table[numRows - 1] = newRow;
+    numRows++;
+    for (int j = 0; j < numCols; j++)
+    {
+        newRow[j] = 0;
+    }
+    for (int k = 0; k < count; k++)
+    {
+        newRow[vars[k]] += values[k];
+    }
+    newRow[slackCol] = 1;
+    newRow[numCols - 1] = rhs;
+
+    for (int i = 0; i < numConstraints; i++)
+    {
+        int col = basis[i];
+        if (col >= 0 && newRow[col] != 0)
+        {
+            double multiple = newRow[col];
+            for (int j = 0; j < numCols; j++)
+            {
+                if (table[i][j] != 0)
+                {
+                    newRow[j] -= multiple * table[i][j];
+                }
+            }
+            newRow[col] = 0;
+        }
+    }
+
+    basis.push_back(slackCol);
+    rowRhs.push_back(rhs);
+    numConstraints++;
+    numLeqConstraints++;
+    return row;
+}
+
+/**
+ * Dual simplex method. Starting from a table whose objective row is 
+ * optimal (no positive entries) but whose basic variables may be negative,
+ * repeatedly removes the most negative basic variable from the basis, 
+ * bringing in the column that keeps the objective row optimal, until every
+ * basic variable is nonnegative.
+ *
+ * Return: LPSolution::SOLVED, INFEASIBLE if some row cannot be made 
+ *         feasible, TIMED_OUT if the budget ran out, or 
+ *         EXCEEDED_MAX_ITERATIONS.
+ */
+int Simplex::dualSimplex()
+{
+    TRACE_SCOPE("dualSimplex", "rows", numConstraints, "cols", numCols);
+    unsigned long long maxIter =
+        (unsigned long long) PIVOTS_PER_LINE * (numRows + numCols);
+    double* objective = table[numRows - 1];
+
+    for (unsigned long long numIter = 0; numIter < maxIter; numIter++)
+    {
+        int pivotRow = -1;
+        double minRhs = -ZERO_TOLERANCE;
+        for (int row = 0; row < numConstraints; row++)
+        {
+            if (table[row][numCols - 1] < minRhs)
+            {
+                minRhs = table[row][numCols - 1];
+                pivotRow = row;
+            }
+        }
+        if (pivotRow == -1)
+        {
+            return LPSolution::SOLVED;
+        }
+        if (budgetExhausted())
+        {
+            return LPSolution::TIMED_OUT;
+        }
+
+        int pivotCol = -1;
+        double minRatio = DBL_MAX;
+        for (int col = 0; col < numCols - 1; col++)
+        {
+            if (table[pivotRow][col] < -ZERO_TOLERANCE &&
+                !isEqualitySlack(col))
+            {
+                double ratio = objective[col] / table[pivotRow][col];
+                if (ratio < minRatio)
+                {
+                    minRatio = ratio;
+                    pivotCol = col;
+                }
+            }
+        }
+        if (pivotCol == -1)
+        {
+            return LPSolution::INFEASIBLE;
+        }
+
+        pivot(table, pivotRow, pivotCol, numRows, numCols);
+        basis[pivotRow] = pivotCol;
+        iterations++;
+    }
+    return LPSolution::EXCEEDED_MAX_ITERATIONS;
+}
+
+/**
+ * Brings a modified table back to a basic feasible solution. If the table
+ * is already feasible nothing happens. Otherwise the objective row is made
+ * optimal by temporarily lowering the coefficient of every column that 
+ * would enter the basis, the dual simplex method removes the 
+ * infeasibilities, and the original coefficients are put back.
+ *
+ * Return: LPSolution::SOLVED, or the error code of dualSimplex().
+ */
+int Simplex::restoreFeasibility()
+{
+    bool feasible = true;
+    for (int row = 0; row < numConstraints && feasible; row++)
+    {
+        feasible = table[row][numCols - 1] >= -ZERO_TOLERANCE;
+    }
+    if (feasible)
+    {
+        return LPSolution::SOLVED;
+    }
+
+    std::vector<int> shiftedCols;
+    std::vector<double> shifts;
+    for (int col = 0; col < numCols - 1; col++)
+    {
+        if (table[numRows - 1][col] > 0)
+        {
+            shiftedCols.push_back(col);
+            shifts.push_back(table[numRows - 1][col]);
+            table[numRows - 1][col] = 0;
+        }
+    }
+
+    int errorCode = dualSimplex();
+
+    for (size_t k = 0; k < shiftedCols.size(); k++)
+    {
+        shiftColumnCost(shiftedCols[k], shifts[k]);
+    }
+    return errorCode;
+}
+
+/**
+ * Solves the problem again after it was modified, starting from the basis 
+ * of the previous solution. This usually takes far fewer pivots than 
+ * solving the modified problem from scratch.
+ *
+ * Return: The LPSolution containing the result.
+ */
+LPSolution* Simplex::reoptimize()
+{
+    LPSolution* sol = new LPSolution();
+    iterations = 0;
+    degeneratePivots = 0;
+    timedOut = false;
+    phaseTwoTime = 0;
+    AllocationCounter counter;
+    std::chrono::steady_clock::time_point start = 
+        std::chrono::steady_clock::now();
+    int errorCode = restoreFeasibility();
+    phaseOneIterations = iterations;
+    phaseOneTime = secondsSince(start);
+    countAllocations(SolveStats::PHASE_ONE, counter);
+    if (errorCode == LPSolution::SOLVED)
+    {
+        start = std::chrono::steady_clock::now();
+        optimize(table, basis.data(), sol, numRows, numCols, numRows - 1);
+        phaseTwoTime = secondsSince(start);
+    }
+    else
+    {
+        sol->setErrorCode(errorCode);
+    }
+    countAllocations(SolveStats::PHASE_TWO, counter);
+    recordStats(sol);
+    return sol;
+}
+
+/**
+ * Computes how the objective row would change if the objective moved 
+ * along a direction: entry j of the result is the rate of change of the 
+ * objective row entry of column j, which is the direction's own entry for
+ * column j minus the direction's entries for the basic columns weighted by
+ * column j's entries in their rows.
+ *
+ * Param: direction - the change in each decision variable's coefficient.
+ * Param: costs - receives the rate of change of each column's entry.
+ */
+void Simplex::directionalCosts(const double* direction,
+                               std::vector<double>& costs)
+{
+    costs.assign(numCols - 1, 0);
+    for (int j = 0; j < numDecisionVars; j++)
+    {
+        costs[j] = direction[j];
+    }
+    for (int i = 0; i < numConstraints; i++)
+    {
+        int col = basis[i];
+        if (col >= 0 && col < numDecisionVars && direction[col] != 0)
+        {
+            for (int j = 0; j < numCols - 1; j++)
+            {
+                if (table[i][j] != 0)
+                {
+                    costs[j] -= direction[col] * table[i][j];
+                }
+            }
+        }
+    }
+    for (int i = 0; i < numConstraints; i++)
+    {
+        if (basis[i] >= 0)
+        {
+            costs[basis[i]] = 0;
+        }
+    }
+}
+
+/**
+ * Returns how far the objective can move along a direction before the 
+ * current basis stops being optimal: the largest t such that the basis is
+ * optimal for the objective c + t * direction, where c is the current 
+ * objective. The table must be optimal.
+ *
+ * Param: direction - the change in each decision variable's coefficient.
+ * Return: The largest such t, 0 if the basis is only optimal at c, or 
+ *         DBL_MAX if it stays optimal however far the objective moves.
+ */
+double Simplex::getObjectiveRange(const double* direction)
+{
+    std::vector<double> costs;
+    directionalCosts(direction, costs);
+    double* objective = table[numRows - 1];
+    double range = DBL_MAX;
+    for (int j = 0; j < numCols - 1; j++)
+    {
+        if (costs[j] > ZERO_TOLERANCE)
+        {
+            range = std::min(range, std::max(-objective[j] / costs[j], 0.0));
+        }
+    }
+    return range;
+}
+
+/**
+ * Moves to an adjacent basis that stays optimal a little further along a
+ * direction, when getObjectiveRange() is 0. The column that ties with the
+ * current basis (its objective row entry is 0) and gains the most along 
+ * the direction enters, and the usual ratio test picks the row it leaves.
+ *
+ * Param: direction - the change in each decision variable's coefficient.
+ * Return: False if no column ties and gains, or the entering column is
+ *         unbounded.
+ */
+bool Simplex::pivotTowards(const double* direction)
+{
+    std::vector<double> costs;
+    directionalCosts(direction, costs);
+    double* objective = table[numRows - 1];
+    int pivotCol = -1;
+    for (int j = 0; j < numCols - 1; j++)
+    {
+        if (objective[j] >= -ZERO_TOLERANCE && costs[j] > ZERO_TOLERANCE &&
+            (pivotCol == -1 || costs[j] > costs[pivotCol]))
+        {
+            pivotCol = j;
+        }
+    }
+    if (pivotCol == -1)
+    {
+        return false;
+    }
+
+    int pivotRow = -1;
+    double minRatio = DBL_MAX;
+    for (int row = 0; row < numConstraints; row++)
+    {
+        if (table[row][pivotCol] > ZERO_TOLERANCE &&
+            table[row][numCols - 1] / table[row][pivotCol] < minRatio)
+        {
+            minRatio = table[row][numCols - 1] / table[row][pivotCol];
+            pivotRow = row;
+        }
+    }
+    if (pivotRow == -1)
+    {
+        return false;
+    }
+    pivot(table, pivotRow, pivotCol, numRows, numCols);
+    basis[pivotRow] = pivotCol;
+    return true;
+}
+
+/**
+ * CheckFeasiblity() is Phase I of the Two-Phase Simplex Method. It forms
+ * an auxiliary problem to the original by adding "artificial" extra slack
+ * variables that ensure it has a Basic Feasible Solution even if the original
+ * doesn't. Rows with a negative right hand side are negated first; only
+ * they and the = rows get an artificial variable, the other rows start 
+ * with their slack in the basis. This auxilary problem, which trys to 
+ * minimize all the artificial variables to zero, is solved using the 
+ * optimize() method, carrying the original objective row along. If the 
+ * optimal value is 0, it means the original problem can be solved using the
+ * BFS indicated by the final table. In that case, any artificial variable
+ * left in the basis at 0 is pivoted out and the appropriate rows and 
+ * columns are copied over to the original table. Otherwise, false is 
+ * returned.
+ *
+ * The slacks of the = rows never enter the basis (see isEqualitySlack()),
+ * so they stay at 0; their columns are kept only to be read by getDual().
+ *
+ * return: True if Feasible.
+ */
+bool Simplex::checkFeasibility()
+{
+    TRACE_SCOPE("checkFeasibility", "rows", numConstraints,
+                "cols", numCols);
+    int rhsCol = numDecisionVars + numConstraints;
+    artificialRows.clear();
+    for (int i = 0; i < numConstraints; i++)
+    {
+        if (i >= numLeqConstraints || table[i][rhsCol] < 0)
+        {
+            artificialRows.push_back(i);
+        }
+    }
+
+    // Instantiate a table for the related (auxilary) problem: the 
+    // constraints, the original objective and the auxiliary objective.
+    int numArtificial = artificialRows.size();
+    int curRows = numConstraints + 2;
+    int curColumns = rhsCol + numArtificial + 1;
+    reserveRelatedTable(curRows, curColumns);
+    peakTableBytes = std::max(peakTableBytes,
+                              arrayBytes2d(rowCapacity, colCapacity) +
+                              arrayBytes2d(curRows, curColumns));
+    relatedBasis.resize(numConstraints);
+    for (int i = 0; i < numConstraints; i++)
+    {
+        double sign = (table[i][rhsCol] < 0) ? -1 : 1;
+        for (int j = 0; j < rhsCol; j++)
+        {
+            relatedTable[i][j] = sign * table[i][j];
+        }
+        relatedTable[i][curColumns - 1] = sign * table[i][rhsCol];
+        relatedBasis[i] = numDecisionVars + i;
+    }
+    for (int j = 0; j < rhsCol; j++)
+    {
+        relatedTable[numConstraints][j] = table[numConstraints][j];
+    }
+    relatedTable[numConstraints][curColumns - 1] = table[numConstraints][rhsCol];
+
+    // Maximizing minus the sum of the artificial variables, with the 
+    // objective row written in terms of the nonbasic columns: the sum of 
+    // the artificial rows.
+    double* auxObjective = relatedTable[curRows - 1];
+    for (int k = 0; k < numArtificial; k++)
+    {
+        int i = artificialRows[k];
+        relatedTable[i][rhsCol + k] = 1;
+        relatedBasis[i] = rhsCol + k;
+        for (int j = 0; j < rhsCol; j++)
+        {
+            if (!isEqualitySlack(j))
+            {
+                auxObjective[j] += relatedTable[i][j];
+            }
+        }
+        auxObjective[curColumns - 1] += relatedTable[i][curColumns - 1];
+    }
+
+    #ifdef SERVER_DEBUG
+        std::cerr << "related matrix" << std::endl;
+        displayMatrix(relatedTable, curRows, curColumns);
+    #endif
+
+    // Attempt to solve the related problem to find a BFS for the original.
+    relatedSol.setErrorCode(LPSolution::DEFAULT);
+    optimize(relatedTable, relatedBasis.data(), &relatedSol, curRows,
+             curColumns, numConstraints);
+
+    // Check if the auxiliary problem's optimal value is 0, which means we
+    // found a BFS for the original.
+    bool solvable;
+    if ((solvable = (relatedSol.getErrorCode() == 0 &&
+        std::abs(relatedSol.getZValue()) < ZERO_TOLERANCE)))
+    {
+        // An artificial variable may still be basic, at 0, in a degenerate
+        // row. Its row would have no basic column in the original table, so
+        // pivot it out on the row's largest entry among the original 
+        // columns. The right hand side is 0, so no other row moves. Rows 
+        // without such an entry are redundant and are left alone.
+        for (int row = 0; row < numConstraints; row++)
+        {
+            if (relatedBasis[row] < rhsCol)
+            {
+                continue;
+            }
+            int pivotCol = -1;
+            double largest = ZERO_TOLERANCE;
+            for (int j = 0; j < rhsCol; j++)
+            {
+                if (!isEqualitySlack(j) &&
+                    std::abs(relatedTable[row][j]) > largest)
+                {
+                    largest = std::abs(relatedTable[row][j]);
+                    pivotCol = j;
+                }
+            }
+            if (pivotCol >= 0)
+            {
+                pivot(relatedTable, row, pivotCol, curRows, curColumns);
+                relatedBasis[row] = pivotCol;
+                iterations++;
+            }
+        }
+
+        // Transfer the BFS we found to the original table for solving later.
+        for (int i = 0; i <= numConstraints; i++)
+        {
+            for (int j = 0; j < rhsCol; j++)
+            {
+                table[i][j] = relatedTable[i][j];
+            }
+            table[i][rhsCol] = relatedTable[i][curColumns - 1];
+        }
+        for (int i = 0; i < numConstraints; i++)
+        {
+            basis[i] = (relatedBasis[i] < rhsCol) ? relatedBasis[i] : -1;
+        }
+    }
+    if (!keepWorkspace)
+    {
+        freeTable(relatedTable, relatedRowCapacity, &mappedRelatedTable);
+        relatedTable = 0;
+        relatedRowCapacity = 0;
+        relatedColCapacity = 0;
+    }
+    return solvable;
+}
+
+/**
+ * Makes relatedTable a zeroed table for Phase I's related problem, reusing
+ * the kept one when it is large enough (see setKeepWorkspace()).
+ *
+ * Param: rows - the number of rows needed.
+ * Param: cols - the number of columns needed.
+ */
+void Simplex::reserveRelatedTable(int rows, int cols)
+{
+    if (rows > relatedRowCapacity || cols > relatedColCapacity)
+    {
+        if (relatedTable)
+        {
+            freeTable(relatedTable, relatedRowCapacity, &mappedRelatedTable);
+        }
+        relatedRowCapacity = std::max(rows, relatedRowCapacity);
+        relatedColCapacity = std::max(cols, relatedColCapacity);
+        relatedTable = allocateTable(relatedRowCapacity, relatedColCapacity,
+                                     &mappedRelatedTable);
+    }
+    else
+    {
+        for (int i = 0; i < rows; i++)
+        {
+            memset(relatedTable[i], 0, cols * sizeof(double));
+        }
+    }
+}
+
+/**
+ * Allocates a zeroed table, in a memory-mapped file if it is large enough
+ * (see setMappedStorage()) and on the heap otherwise.
+ *
+ * Param: rows - the number of rows.
+ * Param: cols - the number of columns.
+ * Param: mapped - set to the file the table is mapped from, or to 0.
+ * Return: The table; free it with freeTable().
+ */
+double** Simplex::allocateTable(int rows, int cols, MappedTable** mapped)
+{
+    *mapped = 0;
+    if (!mapDirectory.empty() && arrayBytes2d(rows, cols) >= mapMinBytes)
+    {
+        MappedTable* file = new MappedTable(mapDirectory, rows, cols,
+                                            mapPanelBytes);
+        if (file->isOpen())
+        {
+            *mapped = file;
+            return file->getRows();
+        }
+        #ifdef SERVER_DEBUG
+            std::cerr << "table kept on the heap: " << file->getError()
+                      << std::endl;
+        #endif
+        delete file;
+    }
+    return arrayInit2d(rows, cols);
+}
+
+/**
+ * Frees a table from allocateTable().
+ *
+ * Param: rows - the table.
+ * Param: numRows - the number of rows it was allocated with.
+ * Param: mapped - the file it is mapped from, or 0; set to 0.
+ */
+void Simplex::freeTable(double** rows, int numRows, MappedTable** mapped)
+{
+    if (*mapped)
+    {
+        delete *mapped;
+        *mapped = 0;
+    }
+    else
+    {
+        arrayDel2d(rows, numRows);
+    }
+}
+
+/**
+ * Returns true if a column is the slack of an = row. Such a slack must 
+ * stay at 0, so it may never enter the basis; its column is kept only
+ * because it holds a column of the inverse basis, which getDual() reads.
+ * The = rows are the ones after the <= rows of the original problem.
+ *
+ * Param: col - a column of the table.
+ */
+bool Simplex::isEqualitySlack(int col)
+{
+    return col >= numDecisionVars + numLeqConstraints &&
+           col < numDecisionVars + numConstraints;
+}
+
+/**
+ * Chooses the row that leaves the basis when a column enters it. 
+ *
+ * The textbook test takes the row with the smallest ratio of right hand 
+ * side to pivot column entry. Ties, which are common in degenerate 
+ * problems, go to the first row, whatever the size of its entry.
+ *
+ * The Harris test makes two passes instead. The first finds the largest 
+ * step that keeps every basic variable above -FEASIBILITY_TOLERANCE; the
+ * second picks, among the rows that block at or before that step, the one
+ * with the largest pivot column entry. Large pivots keep the table 
+ * accurate, and choosing by size breaks ties between degenerate rows. The
+ * chosen row's right hand side may be slightly negative, within the 
+ * tolerance; it is set to 0 so the step never moves backwards.
+ *
+ * Param: table - the table being optimized.
+ * Param: pivotCol - the entering column.
+ * Param: curCols - the number of columns in the table.
+ * Param: constraintRows - the number of rows containing constraints.
+ * Return: The leaving row. The column must have a positive entry.
+ */
+int Simplex::ratioTest(double** table, int pivotCol, int curCols,
+                       int constraintRows)
+{
+    int pivotRow = 0;
+    if (!harris)
+    {
+        double minRatio = DBL_MAX;
+        for (int row = 0; row < constraintRows; row++)
+        {
+            if (table[row][pivotCol] > ZERO_TOLERANCE &&
+                table[row][curCols - 1] / table[row][pivotCol] < minRatio)
+            {
+                minRatio = table[row][curCols - 1] / table[row][pivotCol];
+                pivotRow = row;
+            }
+        }
+        return pivotRow;
+    }
+
+    double maxStep = DBL_MAX;
+    for (int row = 0; row < constraintRows; row++)
+    {
+        if (table[row][pivotCol] > ZERO_TOLERANCE)
+        {
+            maxStep = std::min(maxStep, (table[row][curCols - 1] +
+                                         FEASIBILITY_TOLERANCE) /
+                                        table[row][pivotCol]);
+        }
+    }
+    double maxPivot = 0;
+    for (int row = 0; row < constraintRows; row++)
+    {
+        if (table[row][pivotCol] > std::max(maxPivot, ZERO_TOLERANCE) &&
+            table[row][curCols - 1] / table[row][pivotCol] <= maxStep)
+        {
+            maxPivot = table[row][pivotCol];
+            pivotRow = row;
+        }
+    }
+    if (table[pivotRow][curCols - 1] < 0)
+    {
+        table[pivotRow][curCols - 1] = 0;
+    }
+    return pivotRow;
+}
+
+/**
+ * The core of the Simplex method. This takes in a table, solution object,
+ * the size of the table, and how many of the rows are for constraints
+ * (rather than objective equations). It then tries to pivot the table
+ * as many times as necessary (under a limit) to increase the z-value (the
+ * value of the objective equation). See the documentation for details on 
+ * the algorithm used.
+ *
+ * Param: table - the table we are currently optimizing.
+ * Param: basis - the basic column of each constraint row, kept up to date
+ *                as the table is pivoted.
+ * Param: sol - the solution we are storing results in.
+ * Param: curRows - the current number of rows in the table.
+ * Param: curCols - the current number of columns in the table.
+ * Param: constraintRows - the number of rows containing constraints.
+ *
+ * TODO: should probably be refactored to return the error code rather than
+ *       take in the solution and set it.
+ */
+void Simplex::optimize(double** table, int* basis, LPSolution* sol,
+                       int curRows, int curCols, int constraintRows)
+{
+    TRACE_SCOPE("optimize", "rows", curRows, "cols", curCols);
+    // Reuse the solution's array when it has the right size.
+    double* optimalValues = sol->getOptimalValues();
+    if (!optimalValues || sol->getNumOptimalValues() != numDecisionVars)
+    {
+        delete [] optimalValues;
+        optimalValues = new double[numDecisionVars];
+    }
+    std::fill(optimalValues, optimalValues + numDecisionVars, 0.0);
+    sol->setOptimalValues(optimalValues);
+    sol->setNumOptimalValues(numDecisionVars);
+    unsigned long long maxIter =
+        (unsigned long long) PIVOTS_PER_LINE * (curRows + curCols);
     unsigned long long numIter = 0; // number of iterations completed.
     bool stay = true;
 
     while (numIter < maxIter && stay)
     {
-        int pivotCol;
+        int pivotCol = -1;
         double maxCoeff = ZERO_TOLERANCE;
 		// Determine if the solution is optimal or a pivot is needed.
 		for (int col = 0; col < curCols - 1; col++)
 		{
-			if (table[curRows - 1][col] > maxCoeff)
+			if (table[curRows - 1][col] > maxCoeff && !isEqualitySlack(col))
 			{
 				maxCoeff = table[curRows - 1][col];
 				pivotCol = col;
 			}
 		}
-        if (maxCoeff == ZERO_TOLERANCE)
+        bool optimal = (maxCoeff == ZERO_TOLERANCE);
+        bool phaseTwo = (table == this->table);
+        double gap = optimal ? 0 : DBL_MAX;
+        if (!optimal && phaseTwo && gapTolerance > 0)
+        {
+            gap = computeGap();
+        }
+        bool closeEnough = gap <= gapTolerance;
+        if (optimal || closeEnough || budgetExhausted())
         {
-            sol->setErrorCode(LPSolution::SOLVED);
+            sol->setErrorCode((optimal || closeEnough) ? LPSolution::SOLVED :
+                                                         LPSolution::TIMED_OUT);
+            sol->setGap(gap);
 
             #ifdef SERVER_DEBUG
-                std::cerr << "solved" << std::endl;
+                std::cerr << (optimal ? "solved" : "timed out") << std::endl;
                 displayMatrix(table, curRows, curCols);
             #endif
-            // evaluate the final matrix for the values of each decision variable
-            double bvals[curRows];
-            for (int i = 0; i < curRows; i++)
-            {
-                bvals[i] = table[i][curCols - 1];
-            }
-            for (int col = 0; col < numDecisionVars; col++)
+            // Out of budget in Phase I there is no feasible point to report;
+            // in Phase II the current basis is the best one found so far.
+            if (optimal || phaseTwo)
             {
-                bool foundOne = false; // found a 1 in this column
-                bool foundNonZero = false; // found a nonzero number (except 1st 1)
-                int solutionRow;
-
+                // read the value of each basic decision variable off the 
+                // final matrix; nonbasic variables are 0
                 for (int row = 0; row < constraintRows; row++)
                 {
-                    if (std::abs(table[row][col]) > ZERO_TOLERANCE)
+                    if (basis[row] >= 0 && basis[row] < numDecisionVars)
                     {
-                        if (table[row][col] != 1 || foundOne)
-                        {
-                            foundNonZero = true;
-                        }
-                        else if (table[row][col] == 1)
-                        {
-                            foundOne = true;
-                            solutionRow = row;
-                        }
+                        optimalValues[basis[row]] = table[row][curCols - 1];
                     }
                 }
 
-                if (foundOne && !foundNonZero)
+                if (std::abs(table[curRows - 1][curCols - 1]) < ZERO_TOLERANCE)
                 {
-                    optimalValues[col] = bvals[solutionRow];  // table[solutionRow][curCols - 1];
-                    //fixes reusing B-values... maybe
-                    bvals[solutionRow] = 0; 
+                    sol->setZValue(0);
+                }
+                else
+                {
+                    sol->setZValue(-1 * table[curRows - 1][curCols - 1]);
                 }
-            }
-
-            sol->setOptimalValues(optimalValues);
-
-            if (std::abs(table[curRows - 1][curCols - 1]) < ZERO_TOLERANCE)
-            {
-                sol->setZValue(0);
             }
             else
             {
-                sol->setZValue(-1 * table[curRows - 1][curCols - 1]);
+                delete [] optimalValues;
+                sol->setOptimalValues(0);
+                sol->setNumOptimalValues(0);
             }
 
             stay = false; // break out of the loop to return
@@ -610,40 +2198,29 @@ void Simplex::optimize(double** table, LPSolution* sol, int curRows,
             if (maxVar == ZERO_TOLERANCE)
             {
                 sol->setErrorCode(LPSolution::UNBOUNDED);
+                delete [] optimalValues;
+                sol->setOptimalValues(0);
                 stay = false; // break out of the loop to return
             }
             else
             {
-                // Determine pivot row.
-                int pivotRow;
-                double minRatio = DBL_MAX;
-
-                for (int row = 0; row < constraintRows; row++)
+                int pivotRow = ratioTest(table, pivotCol, curCols,
+                                         constraintRows);
+                if (table[pivotRow][curCols - 1] <= FEASIBILITY_TOLERANCE)
                 {
-                    if (table[row][pivotCol] > ZERO_TOLERANCE)
-                    {
-                        if ((table[row][curCols - 1] /
-                             table[row][pivotCol]) < minRatio)
-                        {
-                            minRatio = table[row][curCols - 1] /
-                                       table[row][pivotCol];
-                            pivotRow = row;
-                        }
-                    }
+                    degeneratePivots++;
                 }
 
                 // pivot the table to (hopefully) increase z.
                 pivot(table, pivotRow, pivotCol, curRows, curCols);
+                basis[pivotRow] = pivotCol;
                 numIter++;
-                #ifdef SERVER_DEBUG
-                    std::cerr << "iter " << numIter << std::endl;
-                    displayMatrix(table, curRows, curCols);
-                #endif 
+                iterations++;
             }
         }
     } // end while loop
 
-    if (maxIter - numIter < 2)
+    if (stay)
     {
         sol->setErrorCode(LPSolution::EXCEEDED_MAX_ITERATIONS);
     }
@@ -0,0 +1,79 @@
+/**
+ * Implementation of the SolveBudget class.
+ */
+
+#include "SolveBudget.h"
+
+/**
+ * Constructor for an unlimited budget.
+ */
+SolveBudget::SolveBudget() : hasDeadline(false), maxIterations(0),
+                             cancelled(false)
+{
+}
+
+/**
+ * Sets the deadline to a number of seconds from now.
+ *
+ * Param: seconds - the time allowed; 0 or less removes the deadline.
+ */
+void SolveBudget::setTimeLimit(double seconds)
+{
+    hasDeadline = seconds > 0;
+    if (hasDeadline)
+    {
+        deadline = std::chrono::steady_clock::now() +
+                   std::chrono::duration_cast<
+                       std::chrono::steady_clock::duration>(
+                           std::chrono::duration<double>(seconds));
+    }
+}
+
+/**
+ * Sets the time by which solves must stop.
+ */
+void SolveBudget::setDeadline(std::chrono::steady_clock::time_point inDeadline)
+{
+    deadline = inDeadline;
+    hasDeadline = true;
+}
+
+/**
+ * Sets the most pivots a single solve may take, counting both phases.
+ *
+ * Param: inMaxIterations - the cap, or 0 for no limit.
+ */
+void SolveBudget::setMaxIterations(unsigned long long inMaxIterations)
+{
+    maxIterations = inMaxIterations;
+}
+
+/**
+ * Asks every solve using this budget to stop at its next pivot. It is safe
+ * to call from any thread.
+ */
+void SolveBudget::cancel()
+{
+    cancelled.store(true, std::memory_order_relaxed);
+}
+
+/**
+ * Returns true once cancel() has been called.
+ */
+bool SolveBudget::isCancelled()
+{
+    return cancelled.load(std::memory_order_relaxed);
+}
+
+/**
+ * Returns true if a solve that has taken the given number of pivots must
+ * stop.
+ *
+ * Param: iterations - pivots taken so far.
+ */
+bool SolveBudget::isExhausted(unsigned long long iterations)
+{
+    return cancelled.load(std::memory_order_relaxed) ||
+           (maxIterations > 0 && iterations >= maxIterations) ||
+           (hasDeadline && std::chrono::steady_clock::now() >= deadline);
+}
@@ -0,0 +1,375 @@
+/**
+ * Implementation of the SolveStats class.
+ */
+
+#include "SolveStats.h"
+#include "AllocationCounter.h"
+#include <sstream>
+
+/**
+ * Constructor for statistics of a solve that has not run.
+ */
+SolveStats::SolveStats() : parseTime(0), buildTime(0), phaseOneIterations(0),
+                           phaseOneTime(0), phaseTwoIterations(0),
+                           phaseTwoTime(0), degeneratePivots(0),
+                           peakTableBytes(0), predictedTableBytes(0),
+                           numRows(0), numColumns(0), status(0), gap(0)
+{
+    for (int stage = 0; stage < NUM_STAGES; stage++)
+    {
+        allocations[stage] = 0;
+        allocatedBytes[stage] = 0;
+    }
+}
+
+/**
+ * Returns the seconds spent turning the request into a problem.
+ */
+double SolveStats::getParseTime()
+{
+    return parseTime;
+}
+
+/**
+ * Sets the seconds spent turning the request into a problem.
+ */
+void SolveStats::setParseTime(double inParseTime)
+{
+    parseTime = inParseTime;
+}
+
+/**
+ * Returns the seconds spent building the linear program and its table.
+ */
+double SolveStats::getBuildTime()
+{
+    return buildTime;
+}
+
+/**
+ * Sets the seconds spent building the linear program and its table.
+ */
+void SolveStats::setBuildTime(double inBuildTime)
+{
+    buildTime = inBuildTime;
+}
+
+/**
+ * Returns the pivots made finding a feasible basis.
+ */
+unsigned long long SolveStats::getPhaseOneIterations()
+{
+    return phaseOneIterations;
+}
+
+/**
+ * Sets the pivots made finding a feasible basis.
+ */
+void SolveStats::setPhaseOneIterations(unsigned long long iterations)
+{
+    phaseOneIterations = iterations;
+}
+
+/**
+ * Returns the seconds spent finding a feasible basis.
+ */
+double SolveStats::getPhaseOneTime()
+{
+    return phaseOneTime;
+}
+
+/**
+ * Sets the seconds spent finding a feasible basis.
+ */
+void SolveStats::setPhaseOneTime(double inPhaseOneTime)
+{
+    phaseOneTime = inPhaseOneTime;
+}
+
+/**
+ * Returns the pivots made optimizing from a feasible basis.
+ */
+unsigned long long SolveStats::getPhaseTwoIterations()
+{
+    return phaseTwoIterations;
+}
+
+/**
+ * Sets the pivots made optimizing from a feasible basis.
+ */
+void SolveStats::setPhaseTwoIterations(unsigned long long iterations)
+{
+    phaseTwoIterations = iterations;
+}
+
+/**
+ * Returns the seconds spent optimizing from a feasible basis.
+ */
+double SolveStats::getPhaseTwoTime()
+{
+    return phaseTwoTime;
+}
+
+/**
+ * Sets the seconds spent optimizing from a feasible basis.
+ */
+void SolveStats::setPhaseTwoTime(double inPhaseTwoTime)
+{
+    phaseTwoTime = inPhaseTwoTime;
+}
+
+/**
+ * Returns the pivots, of either phase, that did not move the solution.
+ */
+unsigned long long SolveStats::getDegeneratePivots()
+{
+    return degeneratePivots;
+}
+
+/**
+ * Sets the pivots that did not move the solution.
+ */
+void SolveStats::setDegeneratePivots(unsigned long long inDegeneratePivots)
+{
+    degeneratePivots = inDegeneratePivots;
+}
+
+/**
+ * Returns the most bytes the simplex tables held at once.
+ */
+unsigned long long SolveStats::getPeakTableBytes()
+{
+    return peakTableBytes;
+}
+
+/**
+ * Sets the most bytes the simplex tables held at once.
+ */
+void SolveStats::setPeakTableBytes(unsigned long long inPeakTableBytes)
+{
+    peakTableBytes = inPeakTableBytes;
+}
+
+/**
+ * Returns the peak bytes of the tables that the Solver predicted before
+ * admitting the solve (see Solver::setMemoryLimit()), or 0.
+ */
+unsigned long long SolveStats::getPredictedTableBytes()
+{
+    return predictedTableBytes;
+}
+
+/**
+ * Sets the peak bytes of the tables predicted before the solve.
+ */
+void SolveStats::setPredictedTableBytes(unsigned long long inPredicted)
+{
+    predictedTableBytes = inPredicted;
+}
+
+/**
+ * Returns the number of constraint rows of the problem.
+ */
+int SolveStats::getNumRows()
+{
+    return numRows;
+}
+
+/**
+ * Returns the number of columns of the problem, slacks included.
+ */
+int SolveStats::getNumColumns()
+{
+    return numColumns;
+}
+
+/**
+ * Sets the shape of the problem: its constraint rows, and its columns,
+ * decision variables and slacks together.
+ */
+void SolveStats::setShape(int inNumRows, int inNumColumns)
+{
+    numRows = inNumRows;
+    numColumns = inNumColumns;
+}
+
+/**
+ * Returns the heap allocations made in a stage.
+ *
+ * Param: stage - PARSE, BUILD, PHASE_ONE or PHASE_TWO.
+ */
+unsigned long long SolveStats::getAllocations(int stage)
+{
+    return allocations[stage];
+}
+
+/**
+ * Returns the bytes allocated in a stage.
+ *
+ * Param: stage - PARSE, BUILD, PHASE_ONE or PHASE_TWO.
+ */
+unsigned long long SolveStats::getAllocatedBytes(int stage)
+{
+    return allocatedBytes[stage];
+}
+
+/**
+ * Sets the heap allocations made in a stage and the bytes they asked for.
+ *
+ * Param: stage - PARSE, BUILD, PHASE_ONE or PHASE_TWO.
+ * Param: inAllocations - the number of allocations.
+ * Param: bytes - the bytes allocated.
+ */
+void SolveStats::setAllocations(int stage, unsigned long long inAllocations,
+                                unsigned long long bytes)
+{
+    allocations[stage] = inAllocations;
+    allocatedBytes[stage] = bytes;
+}
+
+/**
+ * Adds to the heap allocations made in a stage, for callers that do part
+ * of the stage themselves.
+ *
+ * Param: stage - PARSE, BUILD, PHASE_ONE or PHASE_TWO.
+ * Param: inAllocations - the number of allocations.
+ * Param: bytes - the bytes allocated.
+ */
+void SolveStats::addAllocations(int stage, unsigned long long inAllocations,
+                                unsigned long long bytes)
+{
+    allocations[stage] += inAllocations;
+    allocatedBytes[stage] += bytes;
+}
+
+/**
+ * Returns the method that found the solution, such as "simplex" or "flow".
+ */
+std::string& SolveStats::getEngine()
+{
+    return engine;
+}
+
+/**
+ * Sets the method that found the solution.
+ */
+void SolveStats::setEngine(std::string inEngine)
+{
+    engine = inEngine;
+}
+
+/**
+ * Returns the rule that chose the entering columns, or "" if no pivots
+ * were made.
+ */
+std::string& SolveStats::getPricing()
+{
+    return pricing;
+}
+
+/**
+ * Sets the rule that chose the entering columns.
+ */
+void SolveStats::setPricing(std::string inPricing)
+{
+    pricing = inPricing;
+}
+
+/**
+ * Returns the rule that chose the leaving rows, "harris" or "textbook", or
+ * "" if no pivots were made.
+ */
+std::string& SolveStats::getRatioTest()
+{
+    return ratioTest;
+}
+
+/**
+ * Sets the rule that chose the leaving rows.
+ */
+void SolveStats::setRatioTest(std::string inRatioTest)
+{
+    ratioTest = inRatioTest;
+}
+
+/**
+ * Returns the error code of the solution, as set by setResult().
+ */
+int SolveStats::getStatus()
+{
+    return status;
+}
+
+/**
+ * Returns the relative optimality gap of the solution, as set by 
+ * setResult().
+ */
+double SolveStats::getGap()
+{
+    return gap;
+}
+
+/**
+ * Sets the outcome of the solve, so a client reading only the statistics
+ * knows whether the answer is optimal, within a gap, or timed out.
+ *
+ * Param: inStatus - the solution's error code.
+ * Param: inGap - the solution's relative optimality gap.
+ */
+void SolveStats::setResult(int inStatus, double inGap)
+{
+    status = inStatus;
+    gap = inGap;
+}
+
+/**
+ * Returns the seconds spent in every stage together.
+ */
+double SolveStats::getTotalTime()
+{
+    return parseTime + buildTime + phaseOneTime + phaseTwoTime;
+}
+
+/**
+ * Writes the statistics as a single line JSON object, with times in
+ * seconds, ready to be appended to a log. The allocations of each stage 
+ * are only written by builds that count them.
+ */
+std::string SolveStats::toJson()
+{
+    std::ostringstream s;
+    s.precision(6);
+    s << "{\"status\": " << status << ", \"gap\": " << gap
+      << ", \"engine\": \"" << engine << "\", \"pricing\": \"" << pricing
+      << "\", \"ratioTest\": \"" << ratioTest << "\", \"rows\": " << numRows
+      << ", \"columns\": " << numColumns << ", \"parseTime\": " << parseTime
+      << ", \"buildTime\": " << buildTime
+      << ", \"phaseOneIterations\": " << phaseOneIterations
+      << ", \"phaseOneTime\": " << phaseOneTime
+      << ", \"phaseTwoIterations\": " << phaseTwoIterations
+      << ", \"phaseTwoTime\": " << phaseTwoTime
+      << ", \"degeneratePivots\": " << degeneratePivots
+      << ", \"peakTableBytes\": " << peakTableBytes
+      << ", \"predictedTableBytes\": " << predictedTableBytes
+      << ", \"totalTime\": " << getTotalTime();
+    if (AllocationCounter::isCounting())
+    {
+        const char* names[NUM_STAGES] = {"parse", "build", "phaseOne",
+                                         "phaseTwo"};
+        s << ", \"allocations\": {";
+        for (int stage = 0; stage < NUM_STAGES; stage++)
+        {
+            s << (stage ? ", \"" : "\"") << names[stage] << "\": "
+              << allocations[stage];
+        }
+        s << "}, \"allocatedBytes\": {";
+        for (int stage = 0; stage < NUM_STAGES; stage++)
+        {
+            s << (stage ? ", \"" : "\"") << names[stage] << "\": "
+              << allocatedBytes[stage];
+        }
+        s << "}";
+    }
+    s << "}";
+    return s.str();
+}
@@ -9,7 +9,411 @@
  */
 
 #include "Solver.h"
+#include "BasicSimplex.h"
 #include "Simplex.h"
+#include "ClusterDecomposition.h"
+#include "ColumnGeneration.h"
+#include "HetNetFlow.h"
+#include "RowGeneration.h"
+#include "WaterFilling.h"
+#include "Trace.h"
+#include <algorithm>
+
+/**
+ * Replaces the statistics of a solution found by an engine that solves 
+ * many linear programs, or none, with its name and the time it took, 
+ * reported as Phase II, since the statistics of its last inner solve 
+ * would be misleading.
+ *
+ * Param: sol - the solution.
+ * Param: engine - the name of the engine.
+ * Param: start - when the engine was started.
+ * Return: The solution.
+ */
+static LPSolution* stamp(LPSolution* sol, const char* engine,
+                         std::chrono::steady_clock::time_point start)
+{
+    SolveStats& stats = sol->getStats();
+    stats = SolveStats();
+    stats.setEngine(engine);
+    stats.setPhaseTwoTime(secondsSince(start));
+    return sol;
+}
+
+/**
+ * Returns the most bytes the simplex tables of a scene's whole problem 
+ * hold at once (see HetNetModel::buildLP()): a row per access point, pair 
+ * and device, and a column per pair and for z, with no Phase I. Engines 
+ * that grow their table towards the whole problem, split it into parts or
+ * walk it over beta are admitted by it.
+ *
+ * Param: model - the scene.
+ */
+static unsigned long long predictSceneBytes(HetNetModel* model)
+{
+    int numPairs = model->getNumPairs();
+    return Simplex::predictPeakBytes(model->getNumAccessPoints() + numPairs +
+                                     model->getNumDevices(), numPairs + 1, 0);
+}
+
+/**
+ * Returns the numbers of a row of a problem string, split at spaces as
+ * Simplex splits them.
+ */
+static std::vector<double> splitValues(const std::string& row)
+{
+    std::vector<double> values;
+    std::istringstream split(row);
+    std::string token;
+    while (std::getline(split, token, ' '))
+    {
+        double value = 0;
+        std::istringstream(token) >> value;
+        values.push_back(value);
+    }
+    return values;
+}
+
+/**
+ * Appends the rows of a list of constraints, each with its right hand side
+ * last, to a sparse Linear Program.
+ */
+static void addRows(LinkedList<std::string>* list, int type, SparseLP* sparse)
+{
+    LinkedList<std::string>::ListIterator iterator = list->iterator();
+    while (iterator.hasNext())
+    {
+        std::vector<double> row = splitValues(iterator.next());
+        sparse->addRow(type, row.empty() ? 0 : row.back());
+        for (int j = 0; j + 1 < (int) row.size() && j < sparse->getNumVars();
+             j++)
+        {
+            if (row[j] != 0)
+            {
+                sparse->addCoefficient(j, row[j]);
+            }
+        }
+    }
+}
+
+/**
+ * Fills a sparse Linear Program from a parsed one, for BasicSimplex, which
+ * only reads the sparse form. The <= rows come before the = rows, as in the
+ * table Simplex builds from the strings.
+ */
+static void toSparseLP(LinearProgram* lp, SparseLP* sparse)
+{
+    std::vector<double> objective = splitValues(lp->getEquation());
+    sparse->clear(objective.size());
+    for (size_t j = 0; j < objective.size(); j++)
+    {
+        sparse->setObjective(j, objective[j]);
+    }
+    addRows(lp->getLeqConstraints(), SparseLP::LEQ, sparse);
+    addRows(lp->getEqConstraints(), SparseLP::EQ, sparse);
+}
+
+/**
+ * Sets the wall clock time allowed for each later solve(). A solve that 
+ * takes longer stops with LPSolution::TIMED_OUT and the best feasible point
+ * it found (see SolveBudget), so a hard problem cannot hold a web server
+ * worker indefinitely.
+ *
+ * Param: seconds - the time allowed, or 0 for no limit.
+ */
+void Solver::setTimeLimit(double seconds)
+{
+    timeLimit = seconds;
+}
+
+/**
+ * Sets the number of pivots allowed for each later solve(), as 
+ * setTimeLimit() does for time.
+ *
+ * Param: inMaxIterations - the pivots allowed, or 0 for no limit.
+ */
+void Solver::setMaxIterations(unsigned long long inMaxIterations)
+{
+    maxIterations = inMaxIterations;
+}
+
+/**
+ * Sets the relative optimality gap each later solve() may stop at, so an 
+ * interactive user gets a provably near-optimal answer sooner than the 
+ * exact one (see Simplex::setGapTolerance()). The gap reached is reported
+ * by LPSolution::getGap().
+ *
+ * A BasicSimplex cannot stop at a gap, so a nonzero gap is refused while
+ * setScalar() has chosen one.
+ *
+ * Param: inGapTolerance - the gap, such as 0.01 for 1%, or 0 to solve 
+ *                         exactly.
+ * Return: False if the gap was refused, leaving the old one.
+ */
+bool Solver::setGapTolerance(double inGapTolerance)
+{
+    if (inGapTolerance > 0 && scalar >= 0)
+    {
+        return false;
+    }
+    gapTolerance = inGapTolerance;
+    return true;
+}
+
+/**
+ * Sets the log every later problem is recorded into, for replaying the
+ * real workload against another build (see CaptureLog). The log still 
+ * belongs to the caller, and must outlive its use here.
+ *
+ * Param: log - the log, or 0 to stop recording.
+ */
+void Solver::setCaptureLog(CaptureLog* log)
+{
+    captureLog = log;
+}
+
+/**
+ * Limits the memory the tables of the solves running at once may hold 
+ * between them, by their size predicted from the problem before anything
+ * is allocated (see Simplex::predictPeakBytes()). A solve that does not 
+ * fit beside the others waits for them up to a timeout. One that does not
+ * fit even alone is handed to a leaner engine if there is one, and 
+ * otherwise comes back as LPSolution::REJECTED, instead of the process 
+ * running out of memory halfway through it.
+ *
+ * The limit holds between the threads of this process only; web server
+ * workers that are separate processes each have their own.
+ *
+ * Param: bytes - the memory allowed, or 0 for no limit.
+ * Param: queueSeconds - the most time a solve may wait for memory.
+ */
+void Solver::setMemoryLimit(unsigned long long bytes, double queueSeconds)
+{
+    queueTimeout = queueSeconds;
+    gate.setCapacity(bytes);
+}
+
+/**
+ * Sets whether solve() starts the simplex method on a scene from a basis
+ * crashed from the WaterFilling allocation (see Simplex::solveFrom()) 
+ * rather than from the slack basis. Every crash step is a pivot of the
+ * whole table, one per rate the allocation makes positive, and on most 
+ * scenes they outnumber the pivots the crashed basis saves, so it is off
+ * unless asked for. A BasicSimplex always starts from the slack basis, so
+ * a crash start is refused while setScalar() has chosen one.
+ *
+ * Param: crash - true to crash a starting basis.
+ * Return: False if the crash start was refused, leaving it off.
+ */
+bool Solver::setCrashStart(bool crash)
+{
+    if (crash && scalar >= 0)
+    {
+        return false;
+    }
+    crashStart = crash;
+    return true;
+}
+
+/**
+ * Sets the simplex method that solve() runs on problems and scenes. By 
+ * default it is Simplex; a BasicSimplex compiled for another scalar type
+ * or other rules may be chosen instead, such as float for huge runs where 
+ * an approximate answer will do. The other engines always use Simplex.
+ *
+ * A BasicSimplex only solves exactly from the slack basis, so it is 
+ * refused while a gap tolerance or crash start is set, rather than have 
+ * them silently ignored; set them back to 0 and false first.
+ *
+ * Param: scalar - SimplexVariant::FLOAT, DOUBLE or LONG_DOUBLE, or -1 for
+ *                 Simplex.
+ * Param: pricing - SimplexVariant::DANTZIG or BLAND.
+ * Param: ratioTest - SimplexVariant::TEXTBOOK or HARRIS.
+ * Return: False if the BasicSimplex was refused, leaving the old engine.
+ */
+bool Solver::setScalar(int inScalar, int inPricing, int inRatioTest)
+{
+    if (inScalar >= 0 && (gapTolerance > 0 || crashStart))
+    {
+        return false;
+    }
+    scalar = inScalar;
+    pricing = inPricing;
+    ratioTest = inRatioTest;
+    return true;
+}
+
+/**
+ * Stops every solve running in this process, on any thread: each one 
+ * returns LPSolution::TIMED_OUT, with the best feasible point it reached 
+ * if it has one, as if its time limit had run out. Solves that start 
+ * afterwards are not affected.
+ */
+void Solver::cancel()
+{
+    std::lock_guard<std::mutex> lock(runningMutex);
+    for (size_t i = 0; i < running.size(); i++)
+    {
+        running[i]->cancel();
+    }
+}
+
+/**
+ * Gives a budget the time limit and pivot limit that were set and records
+ * it as running, so cancel() can reach it.
+ *
+ * Param: budget - the budget of a solve that is about to start.
+ */
+void Solver::startBudget(SolveBudget* budget)
+{
+    budget->setTimeLimit(timeLimit);
+    budget->setMaxIterations(maxIterations);
+    std::lock_guard<std::mutex> lock(runningMutex);
+    running.push_back(budget);
+}
+
+/**
+ * Forgets a budget recorded by startBudget(), once its solve has ended.
+ *
+ * Param: budget - the budget.
+ */
+void Solver::finishBudget(SolveBudget* budget)
+{
+    std::lock_guard<std::mutex> lock(runningMutex);
+    running.erase(std::find(running.begin(), running.end(), budget));
+}
+
+/**
+ * Admits a table built outside the solve methods, such as the one a 
+ * DynamicSimulation keeps between ticks, through the memory limit of
+ * setMemoryLimit(). The caller must releaseMemory() the same bytes once 
+ * the table is freed.
+ *
+ * Param: bytes - the bytes the table is predicted to need.
+ * Return: False if it was not admitted within the queue timeout.
+ */
+bool Solver::acquireMemory(unsigned long long bytes)
+{
+    return gate.acquire(bytes, queueTimeout);
+}
+
+/**
+ * Gives back memory admitted by acquireMemory().
+ *
+ * Param: bytes - the bytes that were admitted.
+ */
+void Solver::releaseMemory(unsigned long long bytes)
+{
+    gate.release(bytes);
+}
+
+/**
+ * Returns the answer to a solve that was not admitted.
+ *
+ * Param: predicted - the bytes the solve was predicted to need.
+ * Return: A solution with LPSolution::REJECTED and no values.
+ */
+LPSolution* Solver::reject(unsigned long long predicted)
+{
+    LPSolution* sol = new LPSolution();
+    sol->setErrorCode(LPSolution::REJECTED);
+    sol->getStats().setEngine("rejected");
+    sol->getStats().setPredictedTableBytes(predicted);
+    return sol;
+}
+
+/**
+ * Records a solved problem into the capture log, if there is one and the
+ * problem is sampled, along with the settings it was solved under and the
+ * engine that answered.
+ *
+ * Param: kind - CaptureLog::PROBLEM or CaptureLog::SCENE.
+ * Param: problem - the request string.
+ * Param: sol - the answer.
+ * Param: arrival - CaptureLog::now() when the request arrived.
+ * Param: seconds - the time the request took.
+ */
+void Solver::capture(int kind, std::string& problem, LPSolution* sol,
+                     unsigned long long arrival, double seconds)
+{
+    if (!captureLog || !captureLog->sample())
+    {
+        return;
+    }
+    CaptureRecord record;
+    record.timestamp = arrival;
+    record.kind = kind;
+    record.problem = problem;
+    record.errorCode = sol->getErrorCode();
+    record.resultHash = CaptureLog::hashSolution(sol);
+    record.engine = sol->getStats().getEngine();
+    record.seconds = seconds;
+    writeCapture(record);
+}
+
+/**
+ * Records a scene solved over beta into the capture log, as capture()
+ * records an answer.
+ *
+ * Param: kind - CaptureLog::PATH.
+ * Param: problem - the scene string.
+ * Param: path - the computed path.
+ * Param: arrival - CaptureLog::now() when the request arrived.
+ * Param: seconds - the time the request took.
+ */
+void Solver::capture(int kind, std::string& problem, BetaPath* path,
+                     unsigned long long arrival, double seconds)
+{
+    if (!captureLog || !captureLog->sample())
+    {
+        return;
+    }
+    CaptureRecord record;
+    record.timestamp = arrival;
+    record.kind = kind;
+    record.problem = problem;
+    record.errorCode = path->getErrorCode();
+    record.resultHash = CaptureLog::hashPath(path);
+    record.engine = path->getStats().getEngine();
+    record.seconds = seconds;
+    writeCapture(record);
+}
+
+/**
+ * Adds the current settings to a sampled record and writes it to the 
+ * capture log.
+ */
+void Solver::writeCapture(CaptureRecord& record)
+{
+    record.timeLimit = timeLimit;
+    record.maxIterations = maxIterations;
+    record.gapTolerance = gapTolerance;
+    record.memoryLimit = gate.getCapacity();
+    record.queueTimeout = queueTimeout;
+    record.crashStart = crashStart;
+    record.scalar = scalar;
+    record.pricing = pricing;
+    record.ratioTest = ratioTest;
+    captureLog->write(record);
+}
+
+/**
+ * Restores the settings a request was recorded under (see capture()), so 
+ * that solving it again gives the recorded answer.
+ *
+ * Param: record - the recorded request.
+ */
+void Solver::applySettings(CaptureRecord& record)
+{
+    timeLimit = record.timeLimit;
+    maxIterations = record.maxIterations;
+    gapTolerance = record.gapTolerance;
+    setMemoryLimit(record.memoryLimit, record.queueTimeout);
+    crashStart = record.crashStart;
+    scalar = record.scalar;
+    pricing = record.pricing;
+    ratioTest = record.ratioTest;
+}
 
 /**
  * This function parses out the Linear Program from a string into a 
@@ -17,14 +421,12 @@
  * happen if the correct format is not followed! Please error check
  * beforehand until this function is improved!
  *
- * Afterwards, the program is sent off to be solved by the appropriate Solver
- * (currently only the simplex method is supported.)
- *
  * Param: problem - The Linear Program in string form.
- * Return: The final solution.
+ * Return: The Linear Program, which the caller must delete.
  */
-LPSolution* Solver::solve(std::string& problem)
+LinearProgram* Solver::parse(std::string& problem)
 {
+    TRACE_SCOPE("Solver::parse", "bytes", problem.size());
     size_t firstsemicolon = problem.find(";", 0);
     size_t secondsemicolon = problem.find(";", firstsemicolon + 1);
     size_t thirdsemicolon = problem.find(";", secondsemicolon + 1);
@@ -56,14 +458,405 @@ LPSolution* Solver::solve(std::string& problem)
         std::string token;
         while (std::getline(split, token, ','))
         {
-            lp->addLeqConstraint(token);
+            lp->addEqConstraint(token);
             #ifdef SERVER_DEBUG
-                std::cerr << "ineq: " << token << std::endl;
+                std::cerr << "eq: " << token << std::endl;
             #endif
         }
     }
-    LPSolution* sol = Simplex(lp).solve();
+    return lp;
+}
+
+/**
+ * Parses a Linear Program from a string (see parse()) and sends it off to 
+ * be solved by the appropriate Solver. The problem is recorded into the
+ * capture log, if one is set (see setCaptureLog()).
+ *
+ * Param: problem - The Linear Program in string form.
+ * Return: The final solution.
+ */
+LPSolution* Solver::solve(std::string& problem)
+{
+    unsigned long long arrival = CaptureLog::now();
+    AllocationCounter counter;
+    std::chrono::steady_clock::time_point start =
+        std::chrono::steady_clock::now();
+    LinearProgram* lp = parse(problem);
+    double parseTime = secondsSince(start);
+    unsigned long long parseAllocations = counter.getAllocations();
+    unsigned long long parseBytes = counter.getBytes();
+    LPSolution* sol = solve(lp);
+    sol->getStats().setParseTime(parseTime);
+    sol->getStats().setAllocations(SolveStats::PARSE, parseAllocations,
+                                   parseBytes);
     delete lp;
+    capture(CaptureLog::PROBLEM, problem, sol, arrival, secondsSince(start));
+    return sol;
+}
+
+/**
+ * Solves a Linear Program (currently only the simplex method is supported)
+ * within the time limit, pivot limit and gap tolerance that were set, with
+ * Simplex or the BasicSimplex chosen by setScalar().
+ *
+ * Param: lp - The Linear Program. It is not modified, and still belongs to
+ *             the caller.
+ * Return: The final solution.
+ */
+LPSolution* Solver::solve(LinearProgram* lp)
+{
+    TRACE_SCOPE("Solver::solve");
+    SparseLP sparse;
+    if (scalar >= 0)
+    {
+        toSparseLP(lp, &sparse);
+    }
+    unsigned long long predicted = scalar >= 0 ?
+        SimplexVariant::predictPeakBytes(&sparse, scalar) :
+        Simplex::predictPeakBytes(lp);
+    if (!gate.acquire(predicted, queueTimeout))
+    {
+        return reject(predicted);
+    }
+    LPSolution* sol;
+    {
+        SolveBudget budget;
+        startBudget(&budget);
+        if (scalar >= 0)
+        {
+            Solve* variant = SimplexVariant::create(&sparse, scalar, pricing,
+                                                    ratioTest, &budget);
+            sol = variant->solve();
+            delete variant;
+        }
+        else
+        {
+            Simplex simplex(lp);
+            simplex.setBudget(&budget);
+            simplex.setGapTolerance(gapTolerance);
+            sol = simplex.solve();
+        }
+        finishBudget(&budget);
+    }
+    gate.release(predicted);
+    sol->getStats().setPredictedTableBytes(predicted);
     return sol;
 }
 
+
+/**
+ * Solves a Heterogeneous Network scene. The linear program is assembled
+ * numerically by the model and handed straight to the simplex method, so 
+ * no problem string is ever built or parsed. The simplex method starts 
+ * from the slack basis, or from a basis crashed from the WaterFilling 
+ * allocation if setCrashStart() asked for it. If setScalar() chose a 
+ * BasicSimplex, it solves instead, always from the slack basis.
+ *
+ * The optimal values are ordered as the model's columns: one r_ua per pair
+ * that is in range, followed by z. See HetNetModel::expandSolution().
+ *
+ * Param: model - The scene to optimize.
+ * Return: The final solution.
+ */
+LPSolution* Solver::solve(HetNetModel* model)
+{
+    TRACE_SCOPE("Solver::solve", "devices", model->getNumDevices(),
+                "accessPoints", model->getNumAccessPoints());
+    AllocationCounter counter;
+    std::chrono::steady_clock::time_point begin =
+        std::chrono::steady_clock::now();
+    SparseLP lp;
+    model->buildLP(&lp);
+    double buildTime = secondsSince(begin);
+    unsigned long long buildAllocations = counter.getAllocations();
+    unsigned long long buildBytes = counter.getBytes();
+
+    // A scene needs no Phase I table. If even the Phase II table 
+    // would not fit, the flow engine finds the same objective in far less
+    // memory, when the weights allow it.
+    unsigned long long predicted = scalar >= 0 ?
+        SimplexVariant::predictPeakBytes(&lp, scalar) :
+        Simplex::predictPeakBytes(lp.getNumRows(), lp.getNumVars(), 0);
+    if (!gate.fits(predicted) && model->getAlpha() >= 0 &&
+        model->getBeta() >= 0)
+    {
+        LPSolution* sol = solveFlow(model);
+        sol->getStats().setPredictedTableBytes(predicted);
+        return sol;
+    }
+    if (!gate.acquire(predicted, queueTimeout))
+    {
+        return reject(predicted);
+    }
+    LPSolution* sol;
+    double fillTime = 0;
+    unsigned long long fillAllocations = 0;
+    unsigned long long fillBytes = 0;
+    {
+        SolveBudget budget;
+        startBudget(&budget);
+        if (scalar >= 0)
+        {
+            Solve* variant = SimplexVariant::create(&lp, scalar, pricing,
+                                                    ratioTest, &budget);
+            sol = variant->solve();
+            delete variant;
+        }
+        else
+        {
+            Simplex simplex(&lp);
+            simplex.setBudget(&budget);
+            simplex.setGapTolerance(gapTolerance);
+            if (crashStart)
+            {
+                begin = std::chrono::steady_clock::now();
+                counter.restart();
+                WaterFilling filling(model);
+                LPSolution* start = filling.solve();
+                fillTime = secondsSince(begin);
+                fillAllocations = counter.getAllocations();
+                fillBytes = counter.getBytes();
+                sol = simplex.solveFrom(start->getOptimalValues());
+                delete start;
+            }
+            else
+            {
+                sol = simplex.solve();
+            }
+        }
+        finishBudget(&budget);
+    }
+    gate.release(predicted);
+
+    // The model's LP is part of the build, and the water filling is part 
+    // of finding the starting basis.
+    SolveStats& stats = sol->getStats();
+    if (crashStart && scalar < 0)
+    {
+        stats.setEngine("crashed simplex");
+    }
+    stats.setPredictedTableBytes(predicted);
+    stats.setBuildTime(stats.getBuildTime() + buildTime);
+    stats.setPhaseOneTime(stats.getPhaseOneTime() + fillTime);
+    stats.addAllocations(SolveStats::BUILD, buildAllocations, buildBytes);
+    stats.addAllocations(SolveStats::PHASE_ONE, fillAllocations, fillBytes);
+    return sol;
+}
+
+/**
+ * Solves a Heterogeneous Network scene exactly and adds a sensitivity 
+ * analysis to the solution (see Simplex::computeSensitivity()). The rows
+ * are ordered as HetNetModel::buildLP() adds them, so the dual value of 
+ * the capacity row of access point a, getDuals()[a], is how much the 
+ * objective grows per unit of extra r_a,max: the access points with the 
+ * largest duals are the bottlenecks most worth upgrading, up to 
+ * getRhsUpper()[a].
+ *
+ * Param: model - The scene to optimize.
+ * Return: The final solution, with sensitivity if it is SOLVED.
+ */
+LPSolution* Solver::solveSensitivity(HetNetModel* model)
+{
+    TRACE_SCOPE("Solver::solveSensitivity", "devices", model->getNumDevices(),
+                "accessPoints", model->getNumAccessPoints());
+    AllocationCounter counter;
+    std::chrono::steady_clock::time_point start =
+        std::chrono::steady_clock::now();
+    SparseLP lp;
+    model->buildLP(&lp);
+    double buildTime = secondsSince(start);
+    unsigned long long buildAllocations = counter.getAllocations();
+    unsigned long long buildBytes = counter.getBytes();
+
+    // The sensitivity analysis needs the final table, so there is no 
+    // leaner engine to fall back on.
+    unsigned long long predicted = Simplex::predictPeakBytes(&lp);
+    if (!gate.acquire(predicted, queueTimeout))
+    {
+        return reject(predicted);
+    }
+    LPSolution* sol;
+    {
+        SolveBudget budget;
+        startBudget(&budget);
+        Simplex simplex(&lp);
+        simplex.setBudget(&budget);
+        sol = simplex.solve();
+        if (sol->getErrorCode() == LPSolution::SOLVED)
+        {
+            simplex.computeSensitivity(sol);
+        }
+        finishBudget(&budget);
+    }
+    gate.release(predicted);
+    sol->getStats().setPredictedTableBytes(predicted);
+    sol->getStats().setBuildTime(sol->getStats().getBuildTime() + buildTime);
+    sol->getStats().addAllocations(SolveStats::BUILD, buildAllocations,
+                                   buildBytes);
+    return sol;
+}
+
+/**
+ * Solves a Heterogeneous Network scene by column generation, which only 
+ * brings the pairs that can improve the solution into the problem. This is
+ * much faster than solve() for scenes where devices are in range of many
+ * networks. See ColumnGeneration. The time limit covers the whole solve,
+ * and the pivot limit each of its linear programs.
+ *
+ * Param: model - The scene to optimize.
+ * Return: The final solution, ordered as the model's columns.
+ */
+LPSolution* Solver::solveColumnGeneration(HetNetModel* model)
+{
+    TRACE_SCOPE("Solver::solveColumnGeneration",
+                "devices", model->getNumDevices(),
+                "accessPoints", model->getNumAccessPoints());
+    unsigned long long predicted = predictSceneBytes(model);
+    if (!gate.acquire(predicted, queueTimeout))
+    {
+        return reject(predicted);
+    }
+    std::chrono::steady_clock::time_point start =
+        std::chrono::steady_clock::now();
+    LPSolution* sol;
+    {
+        SolveBudget budget;
+        startBudget(&budget);
+        ColumnGeneration generation(model);
+        generation.setBudget(&budget);
+        sol = stamp(generation.solve(), "column generation", start);
+        finishBudget(&budget);
+    }
+    gate.release(predicted);
+    sol->getStats().setPredictedTableBytes(predicted);
+    return sol;
+}
+
+/**
+ * Solves a Heterogeneous Network scene as a sequence of maximum flows 
+ * instead of a linear program. This is much faster than solve() and gives
+ * the same objective value, though possibly other optimal rates. See 
+ * HetNetFlow. Scenes with a negative weight are handed to solve().
+ *
+ * Param: model - The scene to optimize.
+ * Return: The final solution, ordered as the model's columns.
+ */
+LPSolution* Solver::solveFlow(HetNetModel* model)
+{
+    if (model->getAlpha() < 0 || model->getBeta() < 0)
+    {
+        return solve(model);
+    }
+    TRACE_SCOPE("Solver::solveFlow", "devices", model->getNumDevices(),
+                "accessPoints", model->getNumAccessPoints());
+    std::chrono::steady_clock::time_point start =
+        std::chrono::steady_clock::now();
+    HetNetFlow flow(model);
+    return stamp(flow.solve(), "flow", start);
+}
+
+/**
+ * Solves a Heterogeneous Network scene with only the fairness rows that 
+ * hold z down, adding the others as they turn out to be violated. This is
+ * much faster than solve() for scenes with many devices. See 
+ * RowGeneration. The limits apply as in solveColumnGeneration().
+ *
+ * Param: model - The scene to optimize.
+ * Return: The final solution, ordered as the model's columns.
+ */
+LPSolution* Solver::solveRowGeneration(HetNetModel* model)
+{
+    TRACE_SCOPE("Solver::solveRowGeneration", "devices", model->getNumDevices(),
+                "accessPoints", model->getNumAccessPoints());
+    unsigned long long predicted = predictSceneBytes(model);
+    if (!gate.acquire(predicted, queueTimeout))
+    {
+        return reject(predicted);
+    }
+    std::chrono::steady_clock::time_point start =
+        std::chrono::steady_clock::now();
+    LPSolution* sol;
+    {
+        SolveBudget budget;
+        startBudget(&budget);
+        RowGeneration generation(model);
+        generation.setBudget(&budget);
+        sol = stamp(generation.solve(), "row generation", start);
+        finishBudget(&budget);
+    }
+    gate.release(predicted);
+    sol->getStats().setPredictedTableBytes(predicted);
+    return sol;
+}
+
+/**
+ * Solves a Heterogeneous Network scene by splitting it into clusters of 
+ * devices and access points that share no pairs, solving the clusters 
+ * concurrently and combining their solutions. See ClusterDecomposition.
+ * The limits apply as in solveColumnGeneration().
+ *
+ * Param: model - The scene to optimize.
+ * Param: mode - ClusterDecomposition::EXACT or 
+ *               ClusterDecomposition::APPROXIMATE.
+ * Param: numThreads - The number of threads, or 0 for one per core.
+ * Return: The final solution, ordered as the model's columns.
+ */
+LPSolution* Solver::solveClusters(HetNetModel* model, int mode, int numThreads)
+{
+    TRACE_SCOPE("Solver::solveClusters", "devices", model->getNumDevices(),
+                "accessPoints", model->getNumAccessPoints());
+    // The clusters' tables together are smaller than the whole problem's.
+    unsigned long long predicted = predictSceneBytes(model);
+    if (!gate.acquire(predicted, queueTimeout))
+    {
+        return reject(predicted);
+    }
+    std::chrono::steady_clock::time_point start =
+        std::chrono::steady_clock::now();
+    LPSolution* sol;
+    {
+        SolveBudget budget;
+        startBudget(&budget);
+        ClusterDecomposition decomposition(model);
+        decomposition.setBudget(&budget);
+        sol = stamp(decomposition.solve(mode, numThreads), "clusters", start);
+        finishBudget(&budget);
+    }
+    gate.release(predicted);
+    sol->getStats().setPredictedTableBytes(predicted);
+    return sol;
+}
+
+/**
+ * Computes the solution of a Heterogeneous Network scene for every 
+ * fairness weight beta, with alpha = 1 - beta (see BetaPath), within the
+ * time limit and pivot limit that were set.
+ *
+ * Param: model - The scene to optimize. Its weights are ignored.
+ * Return: The computed path, which the caller must delete. Its error code
+ *         is LPSolution::TIMED_OUT if the limits ran out before beta = 1,
+ *         or LPSolution::REJECTED if its table did not fit in the memory
+ *         limit (see setMemoryLimit()).
+ */
+BetaPath* Solver::solvePath(HetNetModel* model)
+{
+    TRACE_SCOPE("Solver::solvePath", "devices", model->getNumDevices(),
+                "accessPoints", model->getNumAccessPoints());
+    BetaPath* path = new BetaPath(model);
+    unsigned long long predicted = predictSceneBytes(model);
+    if (!gate.acquire(predicted, queueTimeout))
+    {
+        path->reject();
+        path->getStats().setPredictedTableBytes(predicted);
+        return path;
+    }
+    SolveBudget budget;
+    startBudget(&budget);
+    path->setBudget(&budget);
+    path->compute();
+    path->setBudget(0);
+    finishBudget(&budget);
+    gate.release(predicted);
+    path->getStats().setPredictedTableBytes(predicted);
+    return path;
+}
@@ -0,0 +1,185 @@
+/**
+ * Concrete implementation of methods for a sparse Linear Program.
+ */
+
+#include "SparseLP.h"
+
+/**
+ * Constructor for an empty sparse linear program.
+ */
+SparseLP::SparseLP() : numVars(0), numLeqRows(0), numEqRows(0)
+{
+    rowStart.push_back(0);
+}
+
+/**
+ * Removes every row and resets the objective to numVars zeros. The storage
+ * already reserved by the vectors is kept so a SparseLP can be rebuilt
+ * repeatedly without reallocating.
+ *
+ * Param: inNumVars - the number of decision variables of the new program.
+ */
+void SparseLP::clear(int inNumVars)
+{
+    numVars = inNumVars;
+    objective.assign(numVars, 0);
+    rowStart.clear();
+    rowStart.push_back(0);
+    colIndex.clear();
+    values.clear();
+    rhs.clear();
+    rowType.clear();
+    numLeqRows = 0;
+    numEqRows = 0;
+}
+
+/**
+ * Sets the objective coefficient of a decision variable.
+ *
+ * Param: col - the decision variable.
+ * Param: value - its coefficient in the (maximized) objective equation.
+ */
+void SparseLP::setObjective(int col, double value)
+{
+    objective[col] = value;
+}
+
+/**
+ * Starts a new row. Coefficients added with addCoefficient() afterwards
+ * belong to this row until the next call to addRow().
+ *
+ * Param: type - LEQ or EQ.
+ * Param: inRhs - the right hand side of the constraint.
+ * Return: The index of the new row.
+ */
+int SparseLP::addRow(int type, double inRhs)
+{
+    if (!rhs.empty())
+    {
+        rowStart.push_back(colIndex.size());
+    }
+    rhs.push_back(inRhs);
+    rowType.push_back(type);
+    if (type == EQ)
+    {
+        numEqRows++;
+    }
+    else
+    {
+        numLeqRows++;
+    }
+    return rhs.size() - 1;
+}
+
+/**
+ * Adds a nonzero coefficient to the most recently added row. Zero
+ * coefficients are not stored.
+ *
+ * Param: col - the decision variable.
+ * Param: value - the coefficient.
+ */
+void SparseLP::addCoefficient(int col, double value)
+{
+    if (value != 0)
+    {
+        colIndex.push_back(col);
+        values.push_back(value);
+    }
+}
+
+/**
+ * Returns the number of decision variables.
+ */
+int SparseLP::getNumVars()
+{
+    return numVars;
+}
+
+/**
+ * Returns the total number of rows.
+ */
+int SparseLP::getNumRows()
+{
+    return rhs.size();
+}
+
+/**
+ * Returns the number of <= rows.
+ */
+int SparseLP::getNumLeqRows()
+{
+    return numLeqRows;
+}
+
+/**
+ * Returns the number of = rows.
+ */
+int SparseLP::getNumEqRows()
+{
+    return numEqRows;
+}
+
+/**
+ * Returns the number of stored coefficients over all rows.
+ */
+int SparseLP::getNumNonZeros()
+{
+    return colIndex.size();
+}
+
+/**
+ * Returns the objective coefficient of a decision variable.
+ */
+double SparseLP::getObjective(int col)
+{
+    return objective[col];
+}
+
+/**
+ * Returns LEQ or EQ for the given row.
+ */
+int SparseLP::getRowType(int row)
+{
+    return rowType[row];
+}
+
+/**
+ * Returns the right hand side of the given row.
+ */
+double SparseLP::getRhs(int row)
+{
+    return rhs[row];
+}
+
+/**
+ * Returns the index of the first coefficient of the given row.
+ */
+int SparseLP::getRowStart(int row)
+{
+    return rowStart[row];
+}
+
+/**
+ * Returns one past the index of the last coefficient of the given row.
+ */
+int SparseLP::getRowEnd(int row)
+{
+    return (row + 1 < (int) rowStart.size()) ? rowStart[row + 1]
+                                             : (int) colIndex.size();
+}
+
+/**
+ * Returns the column of a stored coefficient.
+ */
+int SparseLP::getColIndex(int entry)
+{
+    return colIndex[entry];
+}
+
+/**
+ * Returns the value of a stored coefficient.
+ */
+double SparseLP::getValue(int entry)
+{
+    return values[entry];
+}
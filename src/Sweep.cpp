@@ -0,0 +1,442 @@
+/**
+ * Implementation of the Sweep class.
+ */
+
+#include "Sweep.h"
+#include "DynamicSimulation.h"
+#include "LPSolution.h"
+#include "Simplex.h"
+#include "Solver.h"
+#include "SparseLP.h"
+#include <cmath>
+#include <thread>
+
+const char* const Sweep::COLUMN_NAMES[Sweep::NUM_COLUMNS] = {
+    "point", "density", "scale", "alpha", "beta", "devices", "status",
+    "objective", "throughput", "fairness", "warm"
+};
+
+/**
+ * Constructor for a sweep of a single point: density 1, scale 1 and the
+ * scene's own weights. Every access point is scaled.
+ *
+ * Param: inScene - the scene. It is not modified.
+ */
+Sweep::Sweep(HetNetModel* inScene) : scene(inScene), budget(0)
+{
+    densities.assign(1, 1);
+    scales.assign(1, 1);
+    alphas.assign(1, scene->getAlpha());
+    betas.assign(1, scene->getBeta());
+    scaledAps.assign(scene->getNumAccessPoints(), true);
+}
+
+/**
+ * Fills values with steps evenly spaced values from "from" to "to". A
+ * single step gives just "from".
+ */
+void Sweep::setRange(std::vector<double>& values, double from, double to,
+                     int steps)
+{
+    if (steps < 1)
+    {
+        steps = 1;
+    }
+    values.resize(steps);
+    for (int i = 0; i < steps; i++)
+    {
+        values[i] = (steps == 1) ? from : from + (to - from) * i / (steps - 1);
+    }
+}
+
+/**
+ * Sets the device densities: the fraction of the scene's devices present,
+ * from 0 to 1. The devices kept are spread evenly through the scene's list.
+ */
+void Sweep::setDensities(double from, double to, int steps)
+{
+    setRange(densities, from, to, steps);
+}
+
+/**
+ * Sets the factors applied to r_a,max of the scaled access points, which
+ * also scales r_ua,max of their pairs. Factors should be positive; a factor
+ * of 0 takes the access points' pairs out of the problem.
+ */
+void Sweep::setScales(double from, double to, int steps)
+{
+    setRange(scales, from, to, steps);
+}
+
+/**
+ * Sets the throughput weights.
+ */
+void Sweep::setAlphas(double from, double to, int steps)
+{
+    setRange(alphas, from, to, steps);
+}
+
+/**
+ * Sets the fairness weights.
+ */
+void Sweep::setBetas(double from, double to, int steps)
+{
+    setRange(betas, from, to, steps);
+}
+
+/**
+ * Sets the access points whose rate is scaled, such as only the macro cells.
+ *
+ * Param: aps - the access points to scale; the others keep their rate.
+ */
+void Sweep::setScaledAccessPoints(const std::vector<int>& aps)
+{
+    scaledAps.assign(scene->getNumAccessPoints(), false);
+    for (size_t i = 0; i < aps.size(); i++)
+    {
+        scaledAps[aps[i]] = true;
+    }
+}
+
+/**
+ * Sets the limits of each point's solve (see Simplex::setBudget()), which
+ * the chains share. A point that runs out of budget gets a row with 
+ * LPSolution::TIMED_OUT as its status, and the chain goes on to the next
+ * point, which a cancelled or expired budget stops at once.
+ *
+ * Param: inBudget - the limits, or 0 for none. It must outlive the sweep.
+ */
+void Sweep::setBudget(SolveBudget* inBudget)
+{
+    budget = inBudget;
+}
+
+/**
+ * Returns the number of grid points.
+ */
+int Sweep::getNumPoints()
+{
+    return densities.size() * scales.size() * alphas.size() * betas.size();
+}
+
+/**
+ * Finds the grid point at a position of the snake order. The order counts
+ * through the grid like an odometer, density first and beta last, except
+ * that each parameter runs backwards whenever the count of the parameters
+ * before it is odd. Consecutive points then differ in one parameter by a
+ * single step, so neighbouring solves stay close.
+ *
+ * Param: order - the position, from 0 to getNumPoints() - 1.
+ * Param: density - receives the index of the point's density.
+ * Param: scale - receives the index of the point's scale.
+ * Param: alpha - receives the index of the point's alpha.
+ * Param: beta - receives the index of the point's beta.
+ * Return: The index of the point in the grid, density-major.
+ */
+int Sweep::getPoint(int order, int& density, int& scale, int& alpha, int& beta)
+{
+    int sizes[4] = {(int) densities.size(), (int) scales.size(),
+                    (int) alphas.size(), (int) betas.size()};
+    int digits[4];
+    int stride = getNumPoints();
+    int point = 0;
+    for (int i = 0; i < 4; i++)
+    {
+        int outer = order / stride;
+        stride /= sizes[i];
+        int digit = (order / stride) % sizes[i];
+        digits[i] = (outer % 2 == 0) ? digit : sizes[i] - 1 - digit;
+        point = point * sizes[i] + digits[i];
+    }
+    density = digits[0];
+    scale = digits[1];
+    alpha = digits[2];
+    beta = digits[3];
+    return point;
+}
+
+/**
+ * Returns the density of the given index.
+ */
+double Sweep::getDensity(int density)
+{
+    return densities[density];
+}
+
+/**
+ * Returns the scale of the given index.
+ */
+double Sweep::getScale(int scale)
+{
+    return scales[scale];
+}
+
+/**
+ * Returns the alpha of the given index.
+ */
+double Sweep::getAlpha(int alpha)
+{
+    return alphas[alpha];
+}
+
+/**
+ * Returns the beta of the given index.
+ */
+double Sweep::getBeta(int beta)
+{
+    return betas[beta];
+}
+
+/**
+ * Builds the scene at a density and scale, with the scene's weights.
+ * Device u is kept when floor((u + 1) * density) > floor(u * density),
+ * which keeps floor(numDevices * density) devices spread evenly through
+ * the list.
+ *
+ * Param: density - fraction of the devices to keep.
+ * Param: scale - the factor for the scaled access points' rates.
+ * Param: out - an empty scene to fill.
+ */
+void Sweep::buildScene(double density, double scale, HetNetModel* out)
+{
+    for (int a = 0; a < scene->getNumAccessPoints(); a++)
+    {
+        out->addAccessPoint(scene->getAccessPointX(a),
+                            scene->getAccessPointY(a),
+                            scene->getAccessPointRadius(a),
+                            scene->getAccessPointRate(a) *
+                                (scaledAps[a] ? scale : 1));
+    }
+    for (int u = 0; u < scene->getNumDevices(); u++)
+    {
+        if (std::floor((u + 1) * density) > std::floor(u * density))
+        {
+            out->addDevice(scene->getDeviceX(u), scene->getDeviceY(u));
+        }
+    }
+    out->setAlpha(scene->getAlpha());
+    out->setBeta(scene->getBeta());
+}
+
+/**
+ * Solves the points at positions [begin, end) of the snake order, each one
+ * from the table of the one before it where possible, and writes a row for
+ * each. Each new table is admitted by the Solver's memory limit, as in 
+ * DynamicSimulation::rebuild(); a point whose table does not fit gets a
+ * row with LPSolution::REJECTED as its status.
+ *
+ * Param: begin - the first position.
+ * Param: end - one past the last position.
+ * Param: writer - receives the rows.
+ * Param: solved - receives the number of points solved.
+ */
+void Sweep::runChain(int begin, int end, SweepWriter* writer, int* solved)
+{
+    HetNetModel* base = 0;
+    SparseLP lp;
+    Simplex* simplex = 0;
+    // The bytes the table was admitted with (see Solver::acquireMemory()).
+    unsigned long long heldBytes = 0;
+    Solver& solver = Solver::getInstance();
+    int numAps = scene->getNumAccessPoints();
+    int numPairs = 0;
+    int builtDensity = -1;
+    double builtScale = 0, builtAlpha = 0;
+    *solved = 0;
+
+    for (int order = begin; order < end; order++)
+    {
+        int d, s, a, b;
+        int point = getPoint(order, d, s, a, b);
+        double scale = scales[s];
+        double alpha = alphas[a];
+        double beta = betas[b];
+
+        // Weights and positive scales keep the shape of the problem.
+        bool warm = simplex && d == builtDensity && scale > 0 &&
+                    builtScale > 0;
+        LPSolution* sol = 0;
+        int solPairs = numPairs;
+        if (warm)
+        {
+            double sumRuaMax = 0;
+            for (int p = 0; p < numPairs; p++)
+            {
+                int ap = base->getPairAccessPoint(p);
+                double rate = base->getPairRate(p) *
+                              (scaledAps[ap] ? scale : 1);
+                if (scale != builtScale && scaledAps[ap])
+                {
+                    simplex->changeRhs(numAps + p, rate);
+                }
+                if (alpha != builtAlpha)
+                {
+                    simplex->changeObjective(p, alpha);
+                }
+                sumRuaMax += rate;
+            }
+            for (int ap = 0; ap < numAps && scale != builtScale; ap++)
+            {
+                if (scaledAps[ap])
+                {
+                    simplex->changeRhs(ap, base->getAccessPointRate(ap) *
+                                           scale);
+                }
+            }
+            simplex->changeObjective(numPairs, beta * sumRuaMax);
+            sol = simplex->reoptimize();
+            if (sol->getErrorCode() != LPSolution::SOLVED &&
+                sol->getErrorCode() != LPSolution::TIMED_OUT)
+            {
+                delete sol;
+                sol = 0;
+                warm = false;
+            }
+        }
+
+        if (!sol)
+        {
+            if (d != builtDensity)
+            {
+                delete base;
+                base = new HetNetModel();
+                buildScene(densities[d], 1, base);
+                numPairs = base->getNumPairs();
+                builtDensity = d;
+            }
+            HetNetModel model;
+            buildScene(densities[d], scale, &model);
+            model.setAlpha(alpha);
+            model.setBeta(beta);
+            model.buildLP(&lp);
+            delete simplex;
+            simplex = 0;
+            solver.releaseMemory(heldBytes);
+            heldBytes = Simplex::predictPeakBytes(&lp);
+            if (solver.acquireMemory(heldBytes))
+            {
+                simplex = new Simplex(&lp);
+                simplex->setBudget(budget);
+                sol = simplex->solve();
+            }
+            else
+            {
+                sol = new LPSolution();
+                sol->setErrorCode(LPSolution::REJECTED);
+                sol->getStats().setEngine("rejected");
+                sol->getStats().setPredictedTableBytes(heldBytes);
+                heldBytes = 0;
+            }
+            solPairs = model.getNumPairs();
+            if (solPairs != numPairs)
+            {
+                // A scale of 0 took pairs out, so the table cannot be
+                // reused at another scale.
+                delete simplex;
+                simplex = 0;
+                solver.releaseMemory(heldBytes);
+                heldBytes = 0;
+            }
+        }
+        builtScale = scale;
+        builtAlpha = alpha;
+
+        double row[NUM_COLUMNS] = {(double) point, densities[d], scale, alpha,
+                                   beta, (double) base->getNumDevices(),
+                                   (double) sol->getErrorCode(), 0, 0, 0,
+                                   (double) warm};
+        double* values = sol->getOptimalValues();
+        if (sol->getErrorCode() == LPSolution::SOLVED && values &&
+            sol->getNumOptimalValues() > solPairs)
+        {
+            row[7] = sol->getZValue();
+            for (int p = 0; p < solPairs; p++)
+            {
+                row[8] += values[p];
+            }
+            row[9] = values[solPairs];
+        }
+        writer->addRow(row);
+        delete sol;
+        (*solved)++;
+    }
+    delete simplex;
+    solver.releaseMemory(heldBytes);
+    delete base;
+}
+
+/**
+ * Thread entry point for runChain().
+ */
+void Sweep::runChainThread(Sweep* sweep, int begin, int end,
+                           SweepWriter* writer, int* solved)
+{
+    sweep->runChain(begin, end, writer, solved);
+}
+
+/**
+ * Solves every grid point. The snake order is split into numThreads
+ * contiguous chains that are solved concurrently. Rows are written as they
+ * are found, so they are not in any particular order; the "point" column
+ * gives each row's place in the grid.
+ *
+ * Param: writer - an open writer with NUM_COLUMNS columns.
+ * Param: numThreads - number of threads to use, or 0 for one per core.
+ * Return: The number of points solved.
+ */
+int Sweep::run(SweepWriter* writer, int numThreads)
+{
+    int numPoints = getNumPoints();
+    if (numThreads <= 0)
+    {
+        numThreads = DynamicSimulation::defaultThreads();
+    }
+    if (numThreads > numPoints)
+    {
+        numThreads = numPoints;
+    }
+
+    std::vector<int> solved(numThreads, 0);
+    std::vector<std::thread> threads;
+    for (int t = 1; t < numThreads; t++)
+    {
+        int begin = (long long) numPoints * t / numThreads;
+        int end = (long long) numPoints * (t + 1) / numThreads;
+        threads.push_back(std::thread(runChainThread, this, begin, end,
+                                      writer, &solved[t]));
+    }
+    if (numThreads > 0)
+    {
+        runChain(0, numPoints / numThreads, writer, &solved[0]);
+    }
+    int total = 0;
+    for (size_t t = 0; t < threads.size(); t++)
+    {
+        threads[t].join();
+    }
+    for (int t = 0; t < numThreads; t++)
+    {
+        total += solved[t];
+    }
+    return total;
+}
+
+/**
+ * Solves every grid point into a new sweep file.
+ *
+ * Param: path - the file to write.
+ * Param: numThreads - number of threads to use, or 0 for one per core.
+ * Return: The number of points solved, or -1 if the file could not be
+ *         written.
+ */
+int Sweep::run(std::string path, int numThreads)
+{
+    SweepWriter writer;
+    std::vector<std::string> names(COLUMN_NAMES, COLUMN_NAMES + NUM_COLUMNS);
+    if (!writer.open(path, names))
+    {
+        return -1;
+    }
+    int solved = run(&writer, numThreads);
+    return writer.close() ? solved : -1;
+}
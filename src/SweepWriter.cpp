@@ -0,0 +1,190 @@
+/**
+ * Implementation of the SweepWriter class.
+ */
+
+#include "SweepWriter.h"
+#include <cstring>
+#include <stdint.h>
+
+const char SweepWriter::MAGIC[8] = {'H', 'N', 'S', 'W', 'E', 'E', 'P', '1'};
+
+/**
+ * Constructor for a writer with no open file.
+ */
+SweepWriter::SweepWriter() : file(0), numColumns(0), blockRows(0),
+                             numRows(0), error(false)
+{
+}
+
+/**
+ * Destructor; writes the last block and closes the file if it is open.
+ */
+SweepWriter::~SweepWriter()
+{
+    close();
+}
+
+/**
+ * Creates a sweep file and writes its header.
+ *
+ * Param: path - the file to write.
+ * Param: names - the name of every column. Longer names are cut to
+ *                COLUMN_NAME_SIZE - 1 characters.
+ * Return: False if the file could not be created.
+ */
+bool SweepWriter::open(std::string path, const std::vector<std::string>& names)
+{
+    close();
+    file = fopen(path.c_str(), "wb");
+    error = (file == 0);
+    if (error)
+    {
+        return false;
+    }
+
+    numColumns = names.size();
+    block.assign(numColumns, std::vector<double>(BLOCK_ROWS));
+    blockRows = 0;
+    numRows = 0;
+
+    int32_t count = numColumns;
+    error = fwrite(MAGIC, 1, sizeof(MAGIC), file) != sizeof(MAGIC) ||
+            fwrite(&count, 4, 1, file) != 1;
+    for (int c = 0; c < numColumns && !error; c++)
+    {
+        char name[COLUMN_NAME_SIZE];
+        memset(name, 0, sizeof(name));
+        strncpy(name, names[c].c_str(), COLUMN_NAME_SIZE - 1);
+        error = fwrite(name, 1, COLUMN_NAME_SIZE, file) != COLUMN_NAME_SIZE;
+    }
+    return !error;
+}
+
+/**
+ * Adds a row, writing the current block first if it is full.
+ *
+ * Param: row - one value for every column.
+ */
+void SweepWriter::addRow(const double* row)
+{
+    std::lock_guard<std::mutex> guard(lock);
+    if (!file)
+    {
+        return;
+    }
+    for (int c = 0; c < numColumns; c++)
+    {
+        block[c][blockRows] = row[c];
+    }
+    blockRows++;
+    numRows++;
+    if (blockRows == BLOCK_ROWS)
+    {
+        flush();
+    }
+}
+
+/**
+ * Writes the rows of the current block, column by column. The caller holds
+ * the lock.
+ */
+void SweepWriter::flush()
+{
+    if (blockRows == 0 || error)
+    {
+        blockRows = 0;
+        return;
+    }
+    int32_t count = blockRows;
+    error = fwrite(&count, 4, 1, file) != 1;
+    for (int c = 0; c < numColumns && !error; c++)
+    {
+        error = fwrite(&block[c][0], sizeof(double), blockRows, file) !=
+                (size_t) blockRows;
+    }
+    blockRows = 0;
+}
+
+/**
+ * Writes the last block and closes the file.
+ *
+ * Return: False if any write failed.
+ */
+bool SweepWriter::close()
+{
+    std::lock_guard<std::mutex> guard(lock);
+    if (!file)
+    {
+        return !error;
+    }
+    flush();
+    error = (fclose(file) != 0) || error;
+    file = 0;
+    return !error;
+}
+
+/**
+ * Returns the number of rows added since the file was opened.
+ */
+long long SweepWriter::getNumRows()
+{
+    return numRows;
+}
+
+/**
+ * Returns true if a write failed.
+ */
+bool SweepWriter::hasError()
+{
+    return error;
+}
+
+/**
+ * Reads a whole sweep file into memory. This is meant for tests and small
+ * sweeps; large ones should be read a block at a time.
+ *
+ * Param: path - the file to read.
+ * Param: names - receives the name of every column.
+ * Param: columns - receives the values of every column.
+ * Return: False if the file could not be opened or is not a sweep file.
+ */
+bool SweepWriter::read(std::string path, std::vector<std::string>& names,
+                       std::vector<std::vector<double> >& columns)
+{
+    names.clear();
+    columns.clear();
+    FILE* in = fopen(path.c_str(), "rb");
+    if (!in)
+    {
+        return false;
+    }
+
+    char magic[sizeof(MAGIC)];
+    int32_t count = 0;
+    bool ok = fread(magic, 1, sizeof(magic), in) == sizeof(magic) &&
+              memcmp(magic, MAGIC, sizeof(MAGIC)) == 0 &&
+              fread(&count, 4, 1, in) == 1 && count >= 0;
+    for (int c = 0; c < count && ok; c++)
+    {
+        char name[COLUMN_NAME_SIZE + 1];
+        name[COLUMN_NAME_SIZE] = '\0';
+        ok = fread(name, 1, COLUMN_NAME_SIZE, in) == COLUMN_NAME_SIZE;
+        names.push_back(name);
+    }
+    columns.assign(names.size(), std::vector<double>());
+
+    int32_t rows;
+    while (ok && fread(&rows, 4, 1, in) == 1)
+    {
+        ok = rows > 0 && rows <= BLOCK_ROWS;
+        for (int c = 0; c < count && ok; c++)
+        {
+            size_t first = columns[c].size();
+            columns[c].resize(first + rows);
+            ok = fread(&columns[c][first], sizeof(double), rows, in) ==
+                 (size_t) rows;
+        }
+    }
+    fclose(in);
+    return ok;
+}
@@ -0,0 +1,53 @@
+/**
+ * Concrete implementation of methods for a simulation time step.
+ */
+
+#include "Tick.h"
+
+/**
+ * Constructor for an empty step at time 0.
+ */
+Tick::Tick() : time(0)
+{
+}
+
+/**
+ * Constructor for an empty step.
+ *
+ * Param: inTime - the time of the step.
+ */
+Tick::Tick(double inTime) : time(inTime)
+{
+}
+
+/**
+ * Records that a device moved during this step.
+ *
+ * Param: device - the device that moved.
+ * Param: newX - its new x coordinate.
+ * Param: newY - its new y coordinate.
+ */
+void Tick::addMove(int device, double newX, double newY)
+{
+    devices.push_back(device);
+    x.push_back(newX);
+    y.push_back(newY);
+}
+
+/**
+ * Returns the number of devices that moved during this step.
+ */
+int Tick::getNumMoves()
+{
+    return devices.size();
+}
+
+/**
+ * Removes every move so the step can be reused. The storage is kept.
+ */
+void Tick::clear()
+{
+    devices.clear();
+    x.clear();
+    y.clear();
+}
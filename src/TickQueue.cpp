@@ -0,0 +1,72 @@
+/**
+ * Implementation of the TickQueue class.
+ */
+
+#include "TickQueue.h"
+
+/**
+ * Constructor for an empty queue.
+ *
+ * Param: inCapacity - the largest number of ticks to hold at once.
+ */
+TickQueue::TickQueue(int inCapacity) : capacity(inCapacity > 0 ? inCapacity : 1),
+                                       closed(false)
+{
+}
+
+/**
+ * Adds a tick to the back of the queue, waiting for room if it is full. The
+ * tick's moves are moved into the queue, leaving it empty.
+ *
+ * Param: tick - the tick to add.
+ */
+void TickQueue::push(Tick& tick)
+{
+    std::unique_lock<std::mutex> guard(lock);
+    while (ticks.size() >= capacity)
+    {
+        notFull.wait(guard);
+    }
+    ticks.push_back(Tick(tick.time));
+    ticks.back().devices.swap(tick.devices);
+    ticks.back().x.swap(tick.x);
+    ticks.back().y.swap(tick.y);
+    notEmpty.notify_one();
+}
+
+/**
+ * Removes the tick at the front of the queue, waiting for one if the queue
+ * is empty.
+ *
+ * Param: tick - receives the tick.
+ * Return: False if the queue is empty and closed, so no tick will come.
+ */
+bool TickQueue::pop(Tick& tick)
+{
+    std::unique_lock<std::mutex> guard(lock);
+    while (ticks.empty() && !closed)
+    {
+        notEmpty.wait(guard);
+    }
+    if (ticks.empty())
+    {
+        return false;
+    }
+    tick.time = ticks.front().time;
+    tick.devices.swap(ticks.front().devices);
+    tick.x.swap(ticks.front().x);
+    tick.y.swap(ticks.front().y);
+    ticks.pop_front();
+    notFull.notify_one();
+    return true;
+}
+
+/**
+ * Marks the end of the ticks. Consumers waiting on an empty queue return.
+ */
+void TickQueue::close()
+{
+    std::lock_guard<std::mutex> guard(lock);
+    closed = true;
+    notEmpty.notify_all();
+}
@@ -0,0 +1,318 @@
+/**
+ * Implementation of the trace buffers and their Chrome trace export.
+ */
+
+#include "Trace.h"
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <iomanip>
+#include <mutex>
+#include <set>
+#include <sstream>
+#include <unistd.h>
+
+// Definition for the constant that is passed by reference.
+constexpr unsigned long long TraceBuffer::CAPACITY;
+
+/**
+ * Owns every buffer ever handed to a thread. A thread's buffer outlives
+ * the thread, since its events are usually exported after it has been
+ * joined, and is handed to the next new thread instead of a fresh one.
+ * The lock is only taken when a thread records its first event, when the
+ * buffers are read and when they are cleared.
+ */
+class TraceRegistry {
+    public:
+        std::mutex lock;
+        std::vector<TraceBuffer*> buffers;
+        std::vector<TraceBuffer*> idle;
+        int nextThread;
+
+        TraceRegistry() : nextThread(0)
+        {
+        }
+
+        ~TraceRegistry()
+        {
+            for (size_t i = 0; i < buffers.size(); i++)
+            {
+                delete buffers[i];
+            }
+        }
+};
+
+static TraceRegistry registry;
+
+/**
+ * Gives a thread's buffer back to the registry when the thread exits.
+ */
+class ThreadBuffer {
+    public:
+        TraceBuffer* buffer;
+
+        ThreadBuffer() : buffer(0)
+        {
+        }
+
+        ~ThreadBuffer()
+        {
+            if (buffer)
+            {
+                std::lock_guard<std::mutex> guard(registry.lock);
+                buffer->setThread(-1);
+                registry.idle.push_back(buffer);
+            }
+        }
+};
+
+static thread_local ThreadBuffer threadBuffer;
+
+/**
+ * Constructor for an empty buffer that no thread records into yet.
+ */
+TraceBuffer::TraceBuffer() : count(0), reserved(0), cleared(0), thread(-1)
+{
+    events = new TraceEvent[CAPACITY];
+}
+
+/**
+ * Destructor for buffers.
+ */
+TraceBuffer::~TraceBuffer()
+{
+    delete [] events;
+}
+
+/**
+ * Returns the number that identifies the recording thread in the trace.
+ */
+int TraceBuffer::getThread()
+{
+    return thread;
+}
+
+/**
+ * Sets the number that identifies the recording thread in the trace.
+ */
+void TraceBuffer::setThread(int inThread)
+{
+    thread = inThread;
+}
+
+/**
+ * Records an event, overwriting the oldest one if the buffer is full. Only
+ * the buffer's own thread may call it.
+ *
+ * Param: event - the event; its thread is filled in.
+ */
+void TraceBuffer::record(const TraceEvent& event)
+{
+    unsigned long long n = count.load(std::memory_order_relaxed);
+    reserved.store(n + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    TraceEvent& slot = events[n % CAPACITY];
+    slot = event;
+    slot.thread = thread;
+    count.store(n + 1, std::memory_order_release);
+}
+
+/**
+ * Appends the events recorded since the last clear(), oldest first. It may
+ * be called while the buffer's thread keeps recording: events that were
+ * overwritten while they were being copied are left out.
+ *
+ * Param: out - the list to append to.
+ */
+void TraceBuffer::copyEvents(std::vector<TraceEvent>& out)
+{
+    unsigned long long end = count.load(std::memory_order_acquire);
+    unsigned long long begin = std::max(cleared.load(),
+                                        end > CAPACITY ? end - CAPACITY : 0);
+    size_t first = out.size();
+    for (unsigned long long i = begin; i < end; i++)
+    {
+        out.push_back(events[i % CAPACITY]);
+    }
+
+    // The slot of event i is reused by event i + CAPACITY, which may have
+    // been written, or be half written, by now.
+    std::atomic_thread_fence(std::memory_order_acquire);
+    unsigned long long now = reserved.load(std::memory_order_relaxed);
+    if (now > CAPACITY && now - CAPACITY > begin)
+    {
+        unsigned long long lost = std::min(now - CAPACITY, end) - begin;
+        out.erase(out.begin() + first, out.begin() + first + lost);
+    }
+}
+
+/**
+ * Forgets the events recorded so far. It may be called from any thread.
+ */
+void TraceBuffer::clear()
+{
+    cleared.store(count.load(std::memory_order_acquire));
+}
+
+/**
+ * Returns the current time in nanoseconds of the steady clock, the time
+ * base of every event.
+ */
+unsigned long long Trace::now()
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+/**
+ * Returns the buffer of the calling thread, taking one from the registry
+ * on its first call.
+ */
+TraceBuffer* Trace::getBuffer()
+{
+    if (!threadBuffer.buffer)
+    {
+        std::lock_guard<std::mutex> guard(registry.lock);
+        if (registry.idle.empty())
+        {
+            registry.buffers.push_back(new TraceBuffer());
+            threadBuffer.buffer = registry.buffers.back();
+        }
+        else
+        {
+            threadBuffer.buffer = registry.idle.back();
+            registry.idle.pop_back();
+        }
+        threadBuffer.buffer->setThread(registry.nextThread++);
+    }
+    return threadBuffer.buffer;
+}
+
+/**
+ * Returns the events of every thread since the last clear(), in the order
+ * they began.
+ */
+std::vector<TraceEvent> Trace::getEvents()
+{
+    std::vector<TraceEvent> events;
+    {
+        std::lock_guard<std::mutex> guard(registry.lock);
+        for (size_t i = 0; i < registry.buffers.size(); i++)
+        {
+            registry.buffers[i]->copyEvents(events);
+        }
+    }
+    std::stable_sort(events.begin(), events.end(),
+                     [](const TraceEvent& a, const TraceEvent& b)
+                     {
+                         return a.begin < b.begin;
+                     });
+    return events;
+}
+
+/**
+ * Writes nanoseconds as the microseconds the trace format counts in.
+ */
+static void writeMicroseconds(std::ostream& s, unsigned long long ns)
+{
+    s << ns / 1000 << '.' << std::setw(3) << std::setfill('0') << ns % 1000;
+}
+
+/**
+ * Returns the events of every thread since the last clear() in the Chrome
+ * trace event format: one complete ("X") event per traced block, with its
+ * arguments, and a name for each thread. Load the file in chrome://tracing
+ * or ui.perfetto.dev.
+ */
+std::string Trace::toJson()
+{
+    std::vector<TraceEvent> events = getEvents();
+    int pid = getpid();
+    std::ostringstream s;
+    s << "{\"displayTimeUnit\": \"ms\", \"traceEvents\": [";
+    std::set<int> threads;
+    for (size_t i = 0; i < events.size(); i++)
+    {
+        TraceEvent& event = events[i];
+        s << (i == 0 ? "\n" : ",\n") << "{\"name\": \"" << event.name
+          << "\", \"cat\": \"solver\", \"ph\": \"X\", \"pid\": " << pid
+          << ", \"tid\": " << event.thread << ", \"ts\": ";
+        writeMicroseconds(s, event.begin);
+        s << ", \"dur\": ";
+        writeMicroseconds(s, event.duration);
+        s << ", \"args\": {";
+        for (int a = 0; a < 2 && event.argNames[a]; a++)
+        {
+            s << (a == 0 ? "" : ", ") << "\"" << event.argNames[a] << "\": "
+              << event.args[a];
+        }
+        s << "}}";
+        threads.insert(event.thread);
+    }
+    for (std::set<int>::iterator it = threads.begin(); it != threads.end();
+         ++it)
+    {
+        s << ",\n{\"name\": \"thread_name\", \"ph\": \"M\", \"pid\": " << pid
+          << ", \"tid\": " << *it << ", \"args\": {\"name\": \"solver "
+          << *it << "\"}}";
+    }
+    s << "\n]}\n";
+    return s.str();
+}
+
+/**
+ * Writes toJson() to a file.
+ *
+ * Param: path - the file to write.
+ * Return: True if the file was written.
+ */
+bool Trace::writeJson(std::string path)
+{
+    std::ofstream out(path.c_str());
+    out << toJson();
+    out.close();
+    return !out.fail();
+}
+
+/**
+ * Forgets the events of every thread, so the next export only shows what
+ * happens from now on, such as a single solve.
+ */
+void Trace::clear()
+{
+    std::lock_guard<std::mutex> guard(registry.lock);
+    for (size_t i = 0; i < registry.buffers.size(); i++)
+    {
+        registry.buffers[i]->clear();
+    }
+}
+
+/**
+ * Starts timing a block.
+ *
+ * Param: name - the name of the event, a string literal.
+ * Param: argName0 - the name of the first argument, or 0 for none.
+ * Param: arg0 - the first argument.
+ * Param: argName1 - the name of the second argument, or 0 for none.
+ * Param: arg1 - the second argument.
+ */
+TraceScope::TraceScope(const char* name, const char* argName0, long long arg0,
+                       const char* argName1, long long arg1)
+{
+    event.name = name;
+    event.argNames[0] = argName0;
+    event.argNames[1] = argName0 ? argName1 : 0;
+    event.args[0] = arg0;
+    event.args[1] = arg1;
+    event.thread = -1;
+    event.begin = Trace::now();
+}
+
+/**
+ * Records the block into the buffer of the calling thread.
+ */
+TraceScope::~TraceScope()
+{
+    event.duration = Trace::now() - event.begin;
+    Trace::getBuffer()->record(event);
+}
@@ -0,0 +1,415 @@
+/**
+ * Implementation of the TraceReader class.
+ */
+
+#include "TraceReader.h"
+#include <cctype>
+#include <climits>
+#include <cstdlib>
+#include <cstring>
+#include <stdint.h>
+
+const char TraceReader::BINARY_MAGIC[8] = {'H', 'N', 'T', 'R', 'A', 'C', 
+                                           'E', '1'};
+
+/**
+ * Constructor for a reader with the default buffer size.
+ */
+TraceReader::TraceReader() : file(0), binary(false),
+                             buffer(DEFAULT_BUFFER_SIZE + 1), pos(0), end(0),
+                             endOfFile(true), error(false), lineNumber(0),
+                             numDevices(0), havePending(false)
+{
+}
+
+/**
+ * Constructor for a reader with the given buffer size. CSV lines must fit
+ * in the buffer.
+ *
+ * Param: bufferSize - the size of the read buffer in bytes.
+ */
+TraceReader::TraceReader(int bufferSize) : file(0), binary(false), pos(0),
+                                           end(0), endOfFile(true),
+                                           error(false), lineNumber(0),
+                                           numDevices(0), havePending(false)
+{
+    if (bufferSize < BINARY_RECORD_SIZE)
+    {
+        bufferSize = BINARY_RECORD_SIZE;
+    }
+    // One extra byte so a CSV line at the end of the buffer can always be
+    // terminated.
+    buffer.resize(bufferSize + 1);
+}
+
+/**
+ * Destructor; closes the trace.
+ */
+TraceReader::~TraceReader()
+{
+    close();
+}
+
+/**
+ * Opens a trace and detects its format.
+ *
+ * Param: path - the file to read.
+ * Return: False if the file could not be opened.
+ */
+bool TraceReader::open(std::string path)
+{
+    close();
+    file = fopen(path.c_str(), "rb");
+    if (!file)
+    {
+        return false;
+    }
+    pos = end = 0;
+    endOfFile = false;
+    error = false;
+    lineNumber = 0;
+    havePending = false;
+
+    fill(sizeof(BINARY_MAGIC));
+    binary = end >= sizeof(BINARY_MAGIC) &&
+             memcmp(&buffer[0], BINARY_MAGIC, sizeof(BINARY_MAGIC)) == 0;
+    if (binary)
+    {
+        pos = sizeof(BINARY_MAGIC);
+    }
+    else
+    {
+        // Skip a header line.
+        char first = (end > 0) ? buffer[0] : '0';
+        if (!(isdigit(first) || first == '-' || first == '+' || first == '.'))
+        {
+            double time, x, y;
+            int device;
+            readCsvRecord(time, device, x, y);
+            error = false;
+        }
+    }
+    return true;
+}
+
+/**
+ * Closes the trace, if one is open.
+ */
+void TraceReader::close()
+{
+    if (file)
+    {
+        fclose(file);
+        file = 0;
+    }
+    endOfFile = true;
+    pos = end = 0;
+}
+
+/**
+ * Returns true if the open trace is in the binary format.
+ */
+bool TraceReader::isBinary()
+{
+    return binary;
+}
+
+/**
+ * Returns true if reading stopped at a malformed record.
+ */
+bool TraceReader::hasError()
+{
+    return error;
+}
+
+/**
+ * Returns the number of the last CSV line read, counting from 1.
+ */
+int TraceReader::getLineNumber()
+{
+    return lineNumber;
+}
+
+/**
+ * Sets the number of devices of the scene the trace moves, so that a 
+ * record for any other device is taken as malformed.
+ *
+ * Param: inNumDevices - the number of devices, or 0 for no limit.
+ */
+void TraceReader::setNumDevices(int inNumDevices)
+{
+    numDevices = inNumDevices;
+}
+
+/**
+ * Makes sure at least the given number of unparsed bytes are in the 
+ * buffer, moving the unparsed bytes to its start and reading more of the
+ * file after them if needed.
+ *
+ * Param: needed - the number of bytes wanted.
+ * Return: False if the file ends first.
+ */
+bool TraceReader::fill(size_t needed)
+{
+    if (end - pos >= needed)
+    {
+        return true;
+    }
+    if (pos > 0)
+    {
+        memmove(&buffer[0], &buffer[pos], end - pos);
+        end -= pos;
+        pos = 0;
+    }
+    while (!endOfFile && end < needed)
+    {
+        size_t count = fread(&buffer[end], 1, buffer.size() - 1 - end, file);
+        end += count;
+        if (count == 0)
+        {
+            endOfFile = true;
+        }
+    }
+    return end - pos >= needed;
+}
+
+/**
+ * Reads the next record in either format.
+ *
+ * Return: False at the end of the trace or at a malformed record.
+ */
+bool TraceReader::readRecord(double& time, int& device, double& x, double& y)
+{
+    if (!file || error)
+    {
+        return false;
+    }
+    bool read = binary ? readBinaryRecord(time, device, x, y) 
+                       : readCsvRecord(time, device, x, y);
+    if (read && (device < 0 || (numDevices > 0 && device >= numDevices)))
+    {
+        error = true;
+        return false;
+    }
+    return read;
+}
+
+/**
+ * Reads the next CSV record, skipping blank lines.
+ *
+ * Return: False at the end of the trace or at a malformed line.
+ */
+bool TraceReader::readCsvRecord(double& time, int& device, double& x,
+                                double& y)
+{
+    while (true)
+    {
+        // Find the end of the line, reading more of the file if the line
+        // continues past the buffer.
+        char* lineEnd = 0;
+        size_t scanned = 0;
+        while (!lineEnd)
+        {
+            lineEnd = (char*) memchr(&buffer[pos + scanned], '\n',
+                                     end - pos - scanned);
+            if (lineEnd)
+            {
+                break;
+            }
+            scanned = end - pos;
+            if (scanned == buffer.size() - 1)
+            {
+                // The line does not fit in the buffer.
+                error = true;
+                return false;
+            }
+            if (!fill(scanned + 1))
+            {
+                if (scanned == 0)
+                {
+                    return false;
+                }
+                // The last line has no line break; there is always room
+                // for its terminator.
+                lineEnd = &buffer[end];
+            }
+        }
+
+        *lineEnd = '\0';
+        char* line = &buffer[pos];
+        pos = lineEnd - &buffer[0] + 1;
+        if (pos > end)
+        {
+            pos = end;
+        }
+        lineNumber++;
+
+        char* cursor = line;
+        while (isspace(*cursor))
+        {
+            cursor++;
+        }
+        if (*cursor == '\0')
+        {
+            continue;
+        }
+
+        char* next;
+        time = strtod(cursor, &next);
+        bool valid = next != cursor && *next == ',';
+        cursor = next + 1;
+        long id = strtol(cursor, &next, 10);
+        device = (id >= 0 && id <= INT_MAX) ? id : -1;
+        valid = valid && next != cursor && *next == ',';
+        cursor = next + 1;
+        x = strtod(cursor, &next);
+        valid = valid && next != cursor && *next == ',';
+        cursor = next + 1;
+        y = strtod(cursor, &next);
+        valid = valid && next != cursor;
+        while (valid && *next != '\0')
+        {
+            valid = isspace(*next);
+            next++;
+        }
+        if (!valid)
+        {
+            error = true;
+        }
+        return valid;
+    }
+}
+
+/**
+ * Reads the next binary record.
+ *
+ * Return: False at the end of the trace or at a truncated record.
+ */
+bool TraceReader::readBinaryRecord(double& time, int& device, double& x,
+                                   double& y)
+{
+    if (!fill(BINARY_RECORD_SIZE))
+    {
+        error = end != pos;
+        return false;
+    }
+    const char* record = &buffer[pos];
+    int32_t id;
+    memcpy(&time, record, 8);
+    memcpy(&id, record + 8, 4);
+    memcpy(&x, record + 12, 8);
+    memcpy(&y, record + 20, 8);
+    device = id;
+    pos += BINARY_RECORD_SIZE;
+    return true;
+}
+
+/**
+ * Reads the next tick: every consecutive record with the same time as the
+ * first one.
+ *
+ * Param: tick - receives the tick. Its previous moves are cleared.
+ * Return: False if there are no more ticks, or a malformed record was 
+ *         found; hasError() tells the two apart.
+ */
+bool TraceReader::readTick(Tick& tick)
+{
+    tick.clear();
+    double time, x, y;
+    int device;
+    if (havePending)
+    {
+        time = pendingTime;
+        device = pendingDevice;
+        x = pendingX;
+        y = pendingY;
+        havePending = false;
+    }
+    else if (!readRecord(time, device, x, y))
+    {
+        return false;
+    }
+
+    tick.time = time;
+    tick.addMove(device, x, y);
+    while (readRecord(time, device, x, y))
+    {
+        if (time != tick.time)
+        {
+            havePending = true;
+            pendingTime = time;
+            pendingDevice = device;
+            pendingX = x;
+            pendingY = y;
+            break;
+        }
+        tick.addMove(device, x, y);
+    }
+    return !error;
+}
+
+/**
+ * Writes the magic number that starts a binary trace.
+ *
+ * Param: out - the file to write.
+ * Return: False if the write failed.
+ */
+bool TraceReader::writeBinaryHeader(FILE* out)
+{
+    return fwrite(BINARY_MAGIC, 1, sizeof(BINARY_MAGIC), out) ==
+           sizeof(BINARY_MAGIC);
+}
+
+/**
+ * Writes one record of a binary trace.
+ *
+ * Param: out - the file to write.
+ * Return: False if the write failed.
+ */
+bool TraceReader::writeBinaryRecord(FILE* out, double time, int device,
+                                    double x, double y)
+{
+    char record[BINARY_RECORD_SIZE];
+    int32_t id = device;
+    memcpy(record, &time, 8);
+    memcpy(record + 8, &id, 4);
+    memcpy(record + 12, &x, 8);
+    memcpy(record + 20, &y, 8);
+    return fwrite(record, 1, BINARY_RECORD_SIZE, out) == BINARY_RECORD_SIZE;
+}
+
+/**
+ * Converts a CSV trace to the binary format, which is smaller and much 
+ * faster to read. The conversion streams, like reading does.
+ *
+ * Param: csvPath - the trace to convert.
+ * Param: binaryPath - the file to write.
+ * Return: False if either file could not be opened or the CSV trace is
+ *         malformed.
+ */
+bool TraceReader::convertToBinary(std::string csvPath, std::string binaryPath)
+{
+    TraceReader reader;
+    if (!reader.open(csvPath))
+    {
+        return false;
+    }
+    FILE* out = fopen(binaryPath.c_str(), "wb");
+    if (!out)
+    {
+        return false;
+    }
+
+    bool ok = writeBinaryHeader(out);
+    Tick tick;
+    while (ok && reader.readTick(tick))
+    {
+        for (int i = 0; i < tick.getNumMoves() && ok; i++)
+        {
+            ok = writeBinaryRecord(out, tick.time, tick.devices[i], tick.x[i],
+                                   tick.y[i]);
+        }
+    }
+    ok = ok && !reader.hasError();
+    return fclose(out) == 0 && ok;
+}
@@ -0,0 +1,442 @@
+/**
+ * Implementation of the WaterFilling class.
+ */
+
+#include "WaterFilling.h"
+#include "Trace.h"
+#include <algorithm>
+#include <cmath>
+
+/**
+ * Constructor.
+ *
+ * Param: inModel - the scene to solve. It is not modified.
+ */
+WaterFilling::WaterFilling(HetNetModel* inModel) : model(inModel)
+{
+}
+
+/**
+ * Clears the state of the last filling and orders each device's pairs from
+ * the highest r_ua,max down.
+ */
+void WaterFilling::reset()
+{
+    int numDevices = model->getNumDevices();
+    int numAps = model->getNumAccessPoints();
+    int numPairs = model->getNumPairs();
+
+    devicePairs.assign(numDevices, std::vector<int>());
+    for (int p = 0; p < numPairs; p++)
+    {
+        devicePairs[model->getPairDevice(p)].push_back(p);
+    }
+    std::vector<std::pair<double, int> > byRate;
+    for (int u = 0; u < numDevices; u++)
+    {
+        std::vector<int>& pairs = devicePairs[u];
+        byRate.clear();
+        for (size_t i = 0; i < pairs.size(); i++)
+        {
+            byRate.push_back(std::make_pair(-model->getPairRate(pairs[i]),
+                                            pairs[i]));
+        }
+        std::sort(byRate.begin(), byRate.end());
+        for (size_t i = 0; i < pairs.size(); i++)
+        {
+            pairs[i] = byRate[i].second;
+        }
+    }
+    nextPair.assign(numDevices, 0);
+    currentPair.assign(numDevices, -1);
+    attachLevel.assign(numDevices, 0);
+    deviceVersion.assign(numDevices, 0);
+    apDrawing.assign(numAps, 0);
+    apRoom.resize(numAps);
+    for (int a = 0; a < numAps; a++)
+    {
+        apRoom[a] = model->getAccessPointRate(a);
+    }
+    apLevel.assign(numAps, 0);
+    apFull.assign(numAps, false);
+    apVersion.assign(numAps, 0);
+    apPairs.assign(numAps, std::vector<int>());
+    rates.assign(numPairs, 0);
+    events = std::priority_queue<Event, std::vector<Event>,
+                                 std::greater<Event> >();
+}
+
+/**
+ * Brings an access point's room up to a level and changes the number of
+ * devices drawing from it, scheduling when it will fill up.
+ */
+void WaterFilling::updateAccessPoint(int ap, double level, int change)
+{
+    apRoom[ap] -= apDrawing[ap] * (level - apLevel[ap]);
+    apLevel[ap] = level;
+    apDrawing[ap] += change;
+    apVersion[ap]++;
+    if (!apFull[ap] && apDrawing[ap] > 0)
+    {
+        Event event = {level + std::max(apRoom[ap], 0.0) / apDrawing[ap],
+                       true, ap, apVersion[ap]};
+        events.push(event);
+    }
+}
+
+/**
+ * Moves a device onto the pair it has not used yet that offers the most: 
+ * r_ua,max, or the room left on the access point shared with the devices 
+ * already drawing from it, whichever is less. A device with no pair left 
+ * on an access point with room stops rising.
+ */
+void WaterFilling::attach(int device, double level)
+{
+    currentPair[device] = -1;
+    std::vector<int>& pairs = devicePairs[device];
+    int best = -1;
+    double bestOffer = 0;
+    for (int i = nextPair[device]; i < (int) pairs.size(); i++)
+    {
+        int ap = model->getPairAccessPoint(pairs[i]);
+        if (apFull[ap])
+        {
+            continue;
+        }
+        double room = apRoom[ap] - apDrawing[ap] * (level - apLevel[ap]);
+        double offer = std::min(model->getPairRate(pairs[i]),
+                                room / (apDrawing[ap] + 1));
+        if (best == -1 || offer > bestOffer)
+        {
+            best = i;
+            bestOffer = offer;
+        }
+    }
+    if (best == -1)
+    {
+        return;
+    }
+
+    // Keep the unused pairs after nextPair.
+    std::swap(pairs[best], pairs[nextPair[device]]);
+    int pair = pairs[nextPair[device]++];
+    int ap = model->getPairAccessPoint(pair);
+    currentPair[device] = pair;
+    attachLevel[device] = level;
+    deviceVersion[device]++;
+    Event event = {level + model->getPairRate(pair), false, device,
+                   deviceVersion[device]};
+    events.push(event);
+    apPairs[ap].push_back(pair);
+    updateAccessPoint(ap, level, 1);
+}
+
+/**
+ * Takes a device off the pair it draws from, which keeps the rate it
+ * reached.
+ */
+void WaterFilling::detach(int device, double level)
+{
+    int pair = currentPair[device];
+    rates[pair] = std::min(level - attachLevel[device],
+                           model->getPairRate(pair));
+    currentPair[device] = -1;
+    updateAccessPoint(model->getPairAccessPoint(pair), level, -1);
+}
+
+/**
+ * Moves flow once along a cycle or path of the pairs whose rate is strictly
+ * between 0 and r_ua,max. Walking from a device to an access point adds to
+ * a pair and walking back takes away, so flow around a cycle changes no
+ * device's or access point's total, and flow along a path from one device
+ * above z to another moves rate from the second to the first. Either way
+ * the throughput and z stay the same, and the amount is as large as it 
+ * can be, so a pair reaches 0 or r_ua,max or the second device comes down
+ * to z. Once no cycle and no such path is left, the point is a vertex of
+ * the problem, which a crash basis can represent exactly.
+ *
+ * Param: z - the rate of the worst served device.
+ * Param: received - the total rate of each device, kept up to date.
+ * Return: False if there was nothing to move.
+ */
+bool WaterFilling::pushAround(double z, std::vector<double>& received)
+{
+    int numDevices = model->getNumDevices();
+    int numNodes = numDevices + model->getNumAccessPoints();
+
+    // Drop the pairs that reached 0 or r_ua,max, which never move again.
+    // Devices are nodes 0 to numDevices - 1, then the access points.
+    size_t kept = 0;
+    freePairs.resize(numNodes);
+    for (int node = 0; node < numNodes; node++)
+    {
+        freePairs[node].clear();
+    }
+    for (size_t i = 0; i < freeList.size(); i++)
+    {
+        int p = freeList[i];
+        double margin = RATE_TOLERANCE * model->getPairRate(p);
+        if (rates[p] > margin && rates[p] < model->getPairRate(p) - margin)
+        {
+            freeList[kept++] = p;
+            freePairs[model->getPairDevice(p)].push_back(p);
+            freePairs[numDevices + model->getPairAccessPoint(p)].push_back(p);
+        }
+    }
+    freeList.resize(kept);
+
+    // Grow a spanning forest until some pair closes a cycle.
+    std::vector<int> parentPair(numNodes, -1);
+    std::vector<int> parent(numNodes, -1);
+    std::vector<int> depth(numNodes, -1);
+    std::vector<int> root(numNodes, -1);
+    int from = -1, to = -1, closing = -1;
+    for (int start = 0; start < numNodes && closing == -1; start++)
+    {
+        if (depth[start] != -1 || freePairs[start].empty())
+        {
+            continue;
+        }
+        depth[start] = 0;
+        root[start] = start;
+        std::vector<int> queue(1, start);
+        for (size_t q = 0; q < queue.size() && closing == -1; q++)
+        {
+            int node = queue[q];
+            for (size_t i = 0; i < freePairs[node].size(); i++)
+            {
+                int pair = freePairs[node][i];
+                int device = model->getPairDevice(pair);
+                int other = (node == device) ?
+                            numDevices + model->getPairAccessPoint(pair) :
+                            device;
+                if (pair == parentPair[node])
+                {
+                    continue;
+                }
+                if (depth[other] == -1)
+                {
+                    depth[other] = depth[node] + 1;
+                    parent[other] = node;
+                    parentPair[other] = pair;
+                    root[other] = start;
+                    queue.push_back(other);
+                }
+                else
+                {
+                    from = node;
+                    to = other;
+                    closing = pair;
+                    break;
+                }
+            }
+        }
+    }
+
+    if (closing == -1)
+    {
+        // No cycle: look for two devices above z in the same tree.
+        std::vector<int> above(numNodes, -1);
+        for (int u = 0; u < numDevices && closing == -1; u++)
+        {
+            if (depth[u] == -1 ||
+                received[u] <= z + RATE_TOLERANCE * (1 + z))
+            {
+                continue;
+            }
+            if (above[root[u]] == -1)
+            {
+                above[root[u]] = u;
+            }
+            else
+            {
+                from = above[root[u]];
+                to = u;
+                closing = -2;
+            }
+        }
+        if (closing == -1)
+        {
+            return false;
+        }
+    }
+
+    // Walk from "from" up to the common ancestor and down to "to".
+    std::vector<int> up, down;
+    int a = from, b = to;
+    while (a != b)
+    {
+        if (depth[a] >= depth[b])
+        {
+            up.push_back(a);
+            a = parent[a];
+        }
+        else
+        {
+            down.push_back(b);
+            b = parent[b];
+        }
+    }
+    std::vector<int> walk(up);
+    walk.push_back(a);
+    walk.insert(walk.end(), down.rbegin(), down.rend());
+    std::vector<int> pairs;
+    std::vector<bool> adds;
+    for (size_t i = 0; i + 1 < walk.size(); i++)
+    {
+        int child = (parent[walk[i]] == walk[i + 1]) ? walk[i] : walk[i + 1];
+        pairs.push_back(parentPair[child]);
+        adds.push_back(walk[i] < numDevices);
+    }
+    if (closing >= 0)
+    {
+        pairs.push_back(closing);
+        adds.push_back(to < numDevices);
+    }
+
+    double amount = (closing >= 0) ? HUGE_VAL : received[to] - z;
+    for (size_t i = 0; i < pairs.size(); i++)
+    {
+        amount = std::min(amount, adds[i] ?
+                          model->getPairRate(pairs[i]) - rates[pairs[i]] :
+                          rates[pairs[i]]);
+    }
+    for (size_t i = 0; i < pairs.size(); i++)
+    {
+        int pair = pairs[i];
+        rates[pair] += adds[i] ? amount : -amount;
+        double margin = RATE_TOLERANCE * model->getPairRate(pair);
+        if (rates[pair] <= margin)
+        {
+            rates[pair] = 0;
+        }
+        else if (rates[pair] >= model->getPairRate(pair) - margin)
+        {
+            rates[pair] = model->getPairRate(pair);
+        }
+    }
+    if (closing < 0)
+    {
+        received[from] += amount;
+        received[to] -= amount;
+    }
+    return true;
+}
+
+/**
+ * Fills the scene.
+ *
+ * Return: A feasible solution, ordered as the model's columns.
+ */
+LPSolution* WaterFilling::solve()
+{
+    TRACE_SCOPE("WaterFilling::solve");
+    int numDevices = model->getNumDevices();
+    int numAps = model->getNumAccessPoints();
+    int numPairs = model->getNumPairs();
+
+    reset();
+    for (int u = 0; u < numDevices; u++)
+    {
+        attach(u, 0);
+    }
+    while (!events.empty())
+    {
+        Event event = events.top();
+        events.pop();
+        if (event.accessPoint)
+        {
+            int ap = event.index;
+            if (event.version != apVersion[ap])
+            {
+                continue;
+            }
+            apFull[ap] = true;
+            std::vector<int> pairs;
+            pairs.swap(apPairs[ap]);
+            for (size_t i = 0; i < pairs.size(); i++)
+            {
+                int device = model->getPairDevice(pairs[i]);
+                if (currentPair[device] == pairs[i])
+                {
+                    detach(device, event.level);
+                    attach(device, event.level);
+                }
+            }
+        }
+        else if (event.version == deviceVersion[event.index] &&
+                 currentPair[event.index] != -1)
+        {
+            detach(event.index, event.level);
+            attach(event.index, event.level);
+        }
+    }
+
+    // Undo any rounding past r_a,max, then hand out the room that is left.
+    std::vector<double> apLoad(numAps, 0);
+    for (int p = 0; p < numPairs; p++)
+    {
+        apLoad[model->getPairAccessPoint(p)] += rates[p];
+    }
+    for (int p = 0; p < numPairs; p++)
+    {
+        int ap = model->getPairAccessPoint(p);
+        if (apLoad[ap] > model->getAccessPointRate(ap))
+        {
+            rates[p] *= model->getAccessPointRate(ap) / apLoad[ap];
+        }
+    }
+    for (int a = 0; a < numAps; a++)
+    {
+        apLoad[a] = std::min(apLoad[a], model->getAccessPointRate(a));
+    }
+    for (int u = 0; u < numDevices; u++)
+    {
+        for (size_t i = 0; i < devicePairs[u].size(); i++)
+        {
+            int pair = devicePairs[u][i];
+            int ap = model->getPairAccessPoint(pair);
+            double extra = std::min(model->getPairRate(pair) - rates[pair],
+                                    model->getAccessPointRate(ap) -
+                                        apLoad[ap]);
+            if (extra > 0)
+            {
+                rates[pair] += extra;
+                apLoad[ap] += extra;
+            }
+        }
+    }
+
+    std::vector<double> received(numDevices, 0);
+    for (int p = 0; p < numPairs; p++)
+    {
+        received[model->getPairDevice(p)] += rates[p];
+    }
+    double z = numDevices > 0 ?
+               *std::min_element(received.begin(), received.end()) : 0;
+    freeList.resize(numPairs);
+    for (int p = 0; p < numPairs; p++)
+    {
+        freeList[p] = p;
+    }
+    while (pushAround(z, received))
+    {
+    }
+
+    double* values = new double[numPairs + 1]();
+    double total = 0;
+    for (int p = 0; p < numPairs; p++)
+    {
+        values[p] = rates[p];
+        total += rates[p];
+    }
+    values[numPairs] = z;
+
+    LPSolution* sol = new LPSolution();
+    sol->setErrorCode(LPSolution::SOLVED);
+    sol->setOptimalValues(values);
+    sol->setNumOptimalValues(numPairs + 1);
+    sol->setZValue(model->getAlpha() * total + model->getBeta() *
+                   model->getSumRuaMax() * values[numPairs]);
+    return sol;
+}
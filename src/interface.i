@@ -8,7 +8,9 @@
  * Takes in a string that is the problem in the format:
  * "objeqn;ineq,ineq,;eq,eq,;"
  * and returns the solution, a string with the z value and optimal
- * values for the decision variables.
+ * values for the decision variables, followed by a line 
+ * "stats: {...}" with the statistics of the solve (see SolveStats),
+ * including its error code ("status") and optimality gap ("gap").
  *
  * Authors: Tyler Allen, Matthew Leeds
  * Version - 07/24/14
@@ -18,9 +20,24 @@
 #include "LinearProgram.h"
 #include "LPSolution.h"
 #include "Solver.h"
+#include "HetNetModel.h"
+#include "BetaPath.h"
+#include "BasicSimplex.h"
+#include "Trace.h"
+#include "AllocationCounter.h"
+#include "utils.h"
+#include <cfloat>
+#include <cstdlib>
 #include <sstream>
 #include <iostream>
 
+/** The statistics of the last solve, as JSON (see cppLastSolveStats). */
+static std::string lastStats;
+/** The log problems are being recorded into, or 0, and the arguments of
+ * the cppStartCapture that opened it. */
+static CaptureLog* captureLog = 0;
+static std::string captureArguments;
+
 std::string cppMain(std::string problem)
 {
     #ifdef SERVER_DEBUG
@@ -34,7 +51,9 @@ std::string cppMain(std::string problem)
         std::cerr << "answer error code = " << answer->getErrorCode() << std::endl;
     #endif
     std::ostringstream s;
-    if (answer->getErrorCode() == 0) {
+    if (answer->getErrorCode() == 0 ||
+        (answer->getErrorCode() == LPSolution::TIMED_OUT &&
+         answer->getOptimalValues())) {
         double* answervals = answer->getOptimalValues();
         s << "z value: " << answer->getZValue() << " <br /> " << "answer values: ";
         for (int i = 0; i < answer->getNumOptimalValues(); i++)
@@ -43,10 +62,381 @@ std::string cppMain(std::string problem)
         }
         s << "\n";
     }
+    else if (answer->getErrorCode() == LPSolution::REJECTED) {
+        s << "rejected: the problem needs more memory than the server "
+          << "allows\n";
+    }
+    answer->getStats().setResult(answer->getErrorCode(), answer->getGap());
+    lastStats = answer->getStats().toJson();
+    s << "stats: " << lastStats << "\n";
+    delete answer;
+
+    return s.str();
+}
+
+/**
+ * Solves a Heterogeneous Network scene sent in the compact form
+ * "alpha beta;x y radius maxRate,...,;x y,...,;" (see HetNetModel). The
+ * linear program is generated on the server, so the request only grows
+ * linearly with the number of devices and networks. The answer has the same
+ * format as cppMain: one value per device and network (device-major),
+ * followed by z.
+ */
+std::string cppSolveScene(std::string scene)
+{
+    #ifdef SERVER_DEBUG
+        std::cerr << "Scene: " << scene << std::endl;
+    #endif
+
+    unsigned long long arrival = CaptureLog::now();
+    AllocationCounter counter;
+    std::chrono::steady_clock::time_point start =
+        std::chrono::steady_clock::now();
+    HetNetModel model(scene);
+    double parseTime = secondsSince(start);
+    unsigned long long parseAllocations = counter.getAllocations();
+    unsigned long long parseBytes = counter.getBytes();
+    LPSolution* answer = Solver::getInstance().solve(&model);
+    answer->getStats().setParseTime(parseTime);
+    answer->getStats().setAllocations(SolveStats::PARSE, parseAllocations,
+                                      parseBytes);
+    answer->getStats().setResult(answer->getErrorCode(), answer->getGap());
+    lastStats = answer->getStats().toJson();
+    Solver::getInstance().capture(CaptureLog::SCENE, scene, answer, arrival,
+                                  secondsSince(start));
+
+    #ifdef SERVER_DEBUG
+        std::cerr << "answer error code = " << answer->getErrorCode() << std::endl;
+    #endif
+    std::ostringstream s;
+    if (answer->getErrorCode() == 0 ||
+        (answer->getErrorCode() == LPSolution::TIMED_OUT &&
+         answer->getOptimalValues())) {
+        std::vector<double> answervals = model.expandSolution(answer);
+        s << "z value: " << answer->getZValue() << " <br /> " << "answer values: ";
+        for (size_t i = 0; i < answervals.size(); i++)
+        {
+            s << answervals[i] << " ";
+        }
+        s << "\n";
+    }
+    else if (answer->getErrorCode() == LPSolution::REJECTED) {
+        s << "rejected: the problem needs more memory than the server "
+          << "allows\n";
+    }
     delete answer;
 
     return s.str();
 }
+
+/**
+ * Solves a Heterogeneous Network scene for every fairness weight beta in 
+ * [0, 1], with alpha = 1 - beta, so the web front-end can move its slider 
+ * without asking again (see BetaPath). The weights in the scene string are
+ * ignored. The answer has one line per interval of beta over which the 
+ * solution does not change: "start end;objStart objEnd;values", where the
+ * objective values are at the two ends (it is linear in between) and the
+ * values are as in cppSolveScene. If the time limit runs out first, the 
+ * intervals found so far are followed by a "timed out:" line, and if the
+ * path does not fit in the memory limit the answer is a "rejected:" line.
+ * The gap tolerance of cppSetGapTolerance does not apply: every interval 
+ * is solved exactly, since its ends are found from the optimal basis.
+ */
+std::string cppSolveScenePath(std::string scene)
+{
+    #ifdef SERVER_DEBUG
+        std::cerr << "Scene path: " << scene << std::endl;
+    #endif
+
+    unsigned long long arrival = CaptureLog::now();
+    std::chrono::steady_clock::time_point start =
+        std::chrono::steady_clock::now();
+    HetNetModel model(scene);
+    double parseTime = secondsSince(start);
+    BetaPath* path = Solver::getInstance().solvePath(&model);
+    int errorCode = path->getErrorCode();
+    path->getStats().setParseTime(parseTime);
+    path->getStats().setResult(errorCode, 0);
+    lastStats = path->getStats().toJson();
+    Solver::getInstance().capture(CaptureLog::PATH, scene, path, arrival,
+                                  secondsSince(start));
+
+    #ifdef SERVER_DEBUG
+        std::cerr << "path error code = " << errorCode << std::endl;
+    #endif
+    std::ostringstream s;
+    if (errorCode == 0 || errorCode == LPSolution::TIMED_OUT) {
+        for (int i = 0; i < path->getNumIntervals(); i++)
+        {
+            LPSolution* answer = path->getSolution(path->getStart(i));
+            std::vector<double> answervals = model.expandSolution(answer);
+            s << path->getStart(i) << " " << path->getEnd(i) << ";"
+              << path->getObjectiveValue(i, path->getStart(i)) << " "
+              << path->getObjectiveValue(i, path->getEnd(i)) << ";";
+            for (size_t j = 0; j < answervals.size(); j++)
+            {
+                s << answervals[j] << " ";
+            }
+            s << "\n";
+            delete answer;
+        }
+    }
+    if (errorCode == LPSolution::TIMED_OUT) {
+        s << "timed out: the path only covers beta up to "
+          << (path->getNumIntervals() ? 
+              path->getEnd(path->getNumIntervals() - 1) : 0) << "\n";
+    }
+    else if (errorCode == LPSolution::REJECTED) {
+        s << "rejected: the problem needs more memory than the server "
+          << "allows\n";
+    }
+    delete path;
+
+    return s.str();
+}
+
+/**
+ * Sets the number of seconds each later solve may take (see 
+ * Solver::setTimeLimit()); "0" removes the limit. A solve that runs out of
+ * time answers with the best feasible point it found, in the usual format,
+ * or with nothing if it had not found one yet. Returns an empty string.
+ */
+std::string cppSetTimeLimit(std::string seconds)
+{
+    Solver::getInstance().setTimeLimit(strtod(seconds.c_str(), 0));
+    return "";
+}
+
+/**
+ * Sets the relative optimality gap each later solve may stop at (see 
+ * Solver::setGapTolerance()), such as "0.01" for an answer within 1% of the
+ * optimum; "0" solves exactly. Returns an empty string, or an 
+ * "unsupported:" line if cppSetScalar chose a simplex method that cannot 
+ * stop at a gap.
+ */
+std::string cppSetGapTolerance(std::string gap)
+{
+    if (!Solver::getInstance().setGapTolerance(strtod(gap.c_str(), 0)))
+    {
+        return "unsupported: gap tolerance " + gap + " with scalar type\n";
+    }
+    return "";
+}
+
+/**
+ * Sets whether later scenes start the simplex method from a basis crashed
+ * from the water-filling allocation (see Solver::setCrashStart()): "1" for
+ * yes, "0", the default, for the slack basis. Returns an empty string, or
+ * an "unsupported:" line if cppSetScalar chose a simplex method that 
+ * cannot crash a basis.
+ */
+std::string cppSetCrashStart(std::string crash)
+{
+    if (!Solver::getInstance().setCrashStart(atoi(crash.c_str()) != 0))
+    {
+        return "unsupported: crash start with scalar type\n";
+    }
+    return "";
+}
+
+/**
+ * Sets the simplex method later problems and scenes are solved with (see
+ * Solver::setScalar()): scalar is "float", "double" or "long double" for a
+ * BasicSimplex of that type, with pricing "dantzig" or "bland" and 
+ * ratioTest "textbook" or "harris", or "" for Simplex, the default, when
+ * the other two are ignored. Returns an empty string, an "unknown:" line
+ * if a name is not one of these, or an "unsupported:" line if a gap 
+ * tolerance or crash start is set, which a BasicSimplex cannot honour; 
+ * the engine is then left as it was.
+ */
+std::string cppSetScalar(std::string scalar, std::string pricing,
+                         std::string ratioTest)
+{
+    if (scalar.empty())
+    {
+        Solver::getInstance().setScalar(-1, 0, 0);
+        return "";
+    }
+    int type = scalar == "float" ? SimplexVariant::FLOAT :
+               (scalar == "double" ? SimplexVariant::DOUBLE :
+               (scalar == "long double" ? SimplexVariant::LONG_DOUBLE : -1));
+    if (type == -1 || (pricing != "dantzig" && pricing != "bland") ||
+        (ratioTest != "textbook" && ratioTest != "harris"))
+    {
+        return "unknown: " + scalar + " " + pricing + " " + ratioTest + "\n";
+    }
+    if (!Solver::getInstance().setScalar(type,
+            pricing == "bland" ? SimplexVariant::BLAND :
+                                 SimplexVariant::DANTZIG,
+            ratioTest == "harris" ? SimplexVariant::HARRIS :
+                                    SimplexVariant::TEXTBOOK))
+    {
+        return "unsupported: " + scalar + " with a gap tolerance or crash "
+               "start\n";
+    }
+    return "";
+}
+
+/**
+ * Sets the memory, in megabytes, that the tables of the solves running at
+ * once in this process may hold (see Solver::setMemoryLimit()); "0" 
+ * removes the limit. A solve that does not fit waits up to queueSeconds 
+ * for others to finish. One that could never fit is solved by a leaner 
+ * engine when there is one, and otherwise answers with a "rejected:" line.
+ * Returns an empty string.
+ */
+std::string cppSetMemoryLimit(std::string megabytes, std::string queueSeconds)
+{
+    Solver::getInstance().setMemoryLimit(
+        (unsigned long long) (strtod(megabytes.c_str(), 0) * 1024 * 1024),
+        strtod(queueSeconds.c_str(), 0));
+    return "";
+}
+
+/**
+ * Solves a scene like cppSolveScene and reports how much each access 
+ * point's capacity is worth (see Solver::solveSensitivity()). After the
+ * usual first line, the answer has one line per access point: 
+ * "dual lower upper", where dual is the growth of the objective per unit 
+ * of extra r_a,max and [lower, upper] is the range of r_a,max over which 
+ * that holds ("inf" when unlimited).
+ */
+std::string cppSolveSceneSensitivity(std::string scene)
+{
+    #ifdef SERVER_DEBUG
+        std::cerr << "Scene sensitivity: " << scene << std::endl;
+    #endif
+
+    AllocationCounter counter;
+    std::chrono::steady_clock::time_point start =
+        std::chrono::steady_clock::now();
+    HetNetModel model(scene);
+    double parseTime = secondsSince(start);
+    unsigned long long parseAllocations = counter.getAllocations();
+    unsigned long long parseBytes = counter.getBytes();
+    LPSolution* answer = Solver::getInstance().solveSensitivity(&model);
+    answer->getStats().setParseTime(parseTime);
+    answer->getStats().setAllocations(SolveStats::PARSE, parseAllocations,
+                                      parseBytes);
+    answer->getStats().setResult(answer->getErrorCode(), answer->getGap());
+    lastStats = answer->getStats().toJson();
+
+    std::ostringstream s;
+    if (answer->getErrorCode() == 0) {
+        std::vector<double> answervals = model.expandSolution(answer);
+        s << "z value: " << answer->getZValue() << " <br /> " << "answer values: ";
+        for (size_t i = 0; i < answervals.size(); i++)
+        {
+            s << answervals[i] << " ";
+        }
+        s << "\n";
+        for (int a = 0; a < model.getNumAccessPoints(); a++)
+        {
+            s << answer->getDuals()[a] << " ";
+            if (answer->getRhsLower()[a] == -DBL_MAX)
+            {
+                s << "-inf ";
+            }
+            else
+            {
+                s << answer->getRhsLower()[a] << " ";
+            }
+            if (answer->getRhsUpper()[a] == DBL_MAX)
+            {
+                s << "inf\n";
+            }
+            else
+            {
+                s << answer->getRhsUpper()[a] << "\n";
+            }
+        }
+    }
+    else if (answer->getErrorCode() == LPSolution::REJECTED) {
+        s << "rejected: the problem needs more memory than the server "
+          << "allows\n";
+    }
+    delete answer;
+
+    return s.str();
+}
+
+/**
+ * Returns the statistics of the last cppMain, cppSolveScene, 
+ * cppSolveScenePath or cppSolveSceneSensitivity call of this process as a
+ * single line of JSON (see SolveStats::toJson()), so the web server can 
+ * log the time each stage took next to the shape of the problem, and tell
+ * the client whether the answer is optimal ("status" 0 and "gap" 0), 
+ * within the gap tolerance, or timed out ("status" 500). Returns an empty
+ * string before the first solve.
+ */
+std::string cppLastSolveStats()
+{
+    return lastStats;
+}
+
+/**
+ * Forgets the trace events recorded so far (see Trace.h), so that a later
+ * cppWriteTrace only shows the solves made after it. Returns an empty 
+ * string.
+ */
+std::string cppClearTrace()
+{
+    Trace::clear();
+    return "";
+}
+
+/**
+ * Writes the trace events recorded since the last cppClearTrace to a file
+ * in the Chrome trace event format, to be opened in chrome://tracing or 
+ * ui.perfetto.dev. Events are only recorded by a library built with 
+ * TRACE= -DSOLVER_TRACE; otherwise the trace is empty. Returns an empty
+ * string, or an error message if the file could not be written.
+ */
+std::string cppWriteTrace(std::string path)
+{
+    return Trace::writeJson(path) ? "" : "could not write " + path;
+}
+
+/**
+ * Starts recording the problems of cppMain and cppSolveScene into a log
+ * appended to the file at path (see CaptureLog), replacing any log being
+ * recorded; sampleEvery is "1" to record every problem, or "n" to record
+ * one in n. Calling it again with the same arguments keeps the open log,
+ * so a web server worker may call it on every request. The log can be 
+ * replayed against another build with bin/replay. Returns an empty string,
+ * or an error message if the file could not be opened.
+ */
+std::string cppStartCapture(std::string path, std::string sampleEvery)
+{
+    if (captureLog && captureArguments == path + ";" + sampleEvery)
+    {
+        return "";
+    }
+    cppStopCapture();
+    CaptureLog* log = new CaptureLog(path,
+                                     strtoul(sampleEvery.c_str(), 0, 10));
+    if (!log->isOpen())
+    {
+        std::string error = log->getError();
+        delete log;
+        return error;
+    }
+    captureLog = log;
+    captureArguments = path + ";" + sampleEvery;
+    Solver::getInstance().setCaptureLog(captureLog);
+    return "";
+}
+
+/**
+ * Stops recording problems, closing the log. Returns an empty string.
+ */
+std::string cppStopCapture()
+{
+    Solver::getInstance().setCaptureLog(0);
+    delete captureLog;
+    captureLog = 0;
+    return "";
+}
 %}
 %include "std_string.i"
 %include "interface.h"
@@ -45,3 +45,24 @@ void arrayDel2d(double** array, unsigned long long x)
     }
     delete [] array;
 }
+
+/**
+ * Returns the number of bytes held by a two-dimensional array from 
+ * arrayInit2d(), row pointers included.
+ *
+ * Param: x - the length of the array.
+ * Param: y - the width of the array.
+ */
+unsigned long long arrayBytes2d(unsigned long long x, unsigned long long y)
+{
+    return x * (sizeof(double*) + y * sizeof(double));
+}
+
+/**
+ * Returns the seconds of wall clock time elapsed since a point in time.
+ */
+double secondsSince(std::chrono::steady_clock::time_point start)
+{
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() -
+                                         start).count();
+}
@@ -0,0 +1,136 @@
+// Checks that the predicted table memory of a problem is what the simplex
+// method actually allocates, with and without Phase I, that the Solver
+// rejects a problem over its memory limit and hands a scene over it to the
+// flow engine, that the other engines on a scene are rejected over it too,
+// sweeps included, and that a MemoryGate makes solves wait for each other.
+
+#include "ClusterDecomposition.h"
+#include "DynamicSimulation.h"
+#include "MemoryGate.h"
+#include "Solver.h"
+#include "Sweep.h"
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+static const int NUM_PROBLEMS = 2;
+// The first needs Phase I, the second starts from the slack basis.
+static const char* PROBLEMS[NUM_PROBLEMS] = {"1 1;1 1 1,-1 0 -0.1,;;",
+                                             "3 1;1 0 2,0 1 3,;;"};
+
+int main(void)
+{
+    bool passed = true;
+    Solver& solver = Solver::getInstance();
+
+    for (int i = 0; i < NUM_PROBLEMS; i++)
+    {
+        std::string problem = PROBLEMS[i];
+        LPSolution* sol = solver.solve(problem);
+        SolveStats& stats = sol->getStats();
+        bool exact = sol->getErrorCode() == LPSolution::SOLVED &&
+                     stats.getPredictedTableBytes() > 0 &&
+                     stats.getPredictedTableBytes() ==
+                     stats.getPeakTableBytes();
+        std::cout << "predicted " << i << ": "
+                  << stats.getPredictedTableBytes() << " bytes, used "
+                  << stats.getPeakTableBytes() << (exact ? "" : " (wrong)")
+                  << std::endl;
+        passed = passed && exact;
+        delete sol;
+    }
+
+    solver.setMemoryLimit(16, 0);
+    std::string problem = PROBLEMS[0];
+    LPSolution* sol = solver.solve(problem);
+    bool rejected = sol->getErrorCode() == LPSolution::REJECTED &&
+                    sol->getStats().getEngine() == "rejected" &&
+                    sol->getOptimalValues() == 0 &&
+                    sol->getStats().getPredictedTableBytes() > 16;
+    std::cout << "rejected: " << sol->getErrorCode()
+              << (rejected ? "" : " (wrong)") << std::endl;
+    passed = passed && rejected;
+    delete sol;
+
+    std::string scene = "0.5 0.5;100 100 80 1000,160 100 80 500,;"
+                        "90 110,150 95,130 130,400 400,;";
+    HetNetModel model(scene);
+    sol = solver.solve(&model);
+    solver.setMemoryLimit(0, 0);
+    LPSolution* exactSol = solver.solve(&model);
+    bool fellBack = sol->getErrorCode() == LPSolution::SOLVED &&
+                    sol->getStats().getEngine() == "flow" &&
+                    exactSol->getStats().getEngine() == "simplex" &&
+                    std::abs(sol->getZValue() - exactSol->getZValue()) <=
+                    1e-6 * (1 + std::abs(exactSol->getZValue()));
+    std::cout << "fell back: " << sol->getStats().getEngine() << " z = "
+              << sol->getZValue() << (fellBack ? "" : " (wrong)")
+              << std::endl;
+    passed = passed && fellBack;
+    delete sol;
+    delete exactSol;
+
+    solver.setMemoryLimit(16, 0);
+    std::vector<LPSolution*> engines;
+    engines.push_back(solver.solveRowGeneration(&model));
+    engines.push_back(solver.solveColumnGeneration(&model));
+    engines.push_back(solver.solveClusters(&model,
+                                           ClusterDecomposition::EXACT, 1));
+    {
+        DynamicSimulation simulation(&model);
+        engines.push_back(simulation.solve());
+    }
+    BetaPath* path = solver.solvePath(&model);
+    bool allRejected = path->getErrorCode() == LPSolution::REJECTED &&
+                       path->getNumIntervals() == 0 &&
+                       path->getStats().getPredictedTableBytes() > 16;
+    for (size_t i = 0; i < engines.size(); i++)
+    {
+        allRejected = allRejected &&
+                      engines[i]->getErrorCode() == LPSolution::REJECTED &&
+                      engines[i]->getStats().getEngine() == "rejected" &&
+                      engines[i]->getStats().getPredictedTableBytes() > 16;
+        delete engines[i];
+    }
+    delete path;
+    Sweep sweep(&model);
+    sweep.setBetas(0, 1, 3);
+    std::string sweepPath = "/tmp/hetnet_admission_sweep.bin";
+    std::vector<std::string> names;
+    std::vector<std::vector<double> > rows;
+    allRejected = allRejected && sweep.run(sweepPath, 2) == 3 &&
+                  SweepWriter::read(sweepPath, names, rows);
+    for (size_t r = 0; allRejected && r < rows[6].size(); r++)
+    {
+        allRejected = rows[6][r] == LPSolution::REJECTED;
+    }
+    remove(sweepPath.c_str());
+    solver.setMemoryLimit(0, 0);
+    std::cout << "other engines rejected: " << (allRejected ? "" : "wrong")
+              << std::endl;
+    passed = passed && allRejected;
+
+    MemoryGate gate;
+    gate.setCapacity(100);
+    bool never = !gate.acquire(200, 10) && gate.getUsed() == 0;
+    bool first = gate.acquire(60, 0);
+    bool timedOut = !gate.acquire(60, 0.05);
+    std::thread releaser([&gate]()
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+        gate.release(60);
+    });
+    bool waited = gate.acquire(60, 10);
+    releaser.join();
+    bool queued = never && first && timedOut && waited &&
+                  gate.getUsed() == 60;
+    std::cout << "queued: " << gate.getUsed() << " bytes in use"
+              << (queued ? "" : " (wrong)") << std::endl;
+    passed = passed && queued;
+
+    std::cout << (passed ? "PASSED" : "FAILED") << std::endl;
+    return passed ? 0 : 1;
+}
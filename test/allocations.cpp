@@ -0,0 +1,121 @@
+// Solves a stream of problems of the same shape, some needing Phase I, with
+// one Simplex that is loaded and solved into the same solution each time,
+// and checks every answer against a fresh Simplex. Built with
+// ALLOCS= -DCOUNT_ALLOCATIONS it also checks that once warmed up, the
+// stream allocates nothing and the statistics report each stage:
+//
+// make test TESTFILE=test/allocations.cpp ALLOCS=-DCOUNT_ALLOCATIONS
+
+#include "Simplex.h"
+#include "AllocationCounter.h"
+#include <cmath>
+#include <iostream>
+#include <vector>
+
+/**
+ * Builds the i-th problem of the stream: three variables, a <= row, a <=
+ * row with a negative right hand side when i is odd, and an = row.
+ */
+static SparseLP* makeProblem(int i)
+{
+    SparseLP* lp = new SparseLP();
+    lp->clear(3);
+    lp->setObjective(0, 1 + i % 3);
+    lp->setObjective(1, 2);
+    lp->setObjective(2, 1 + i % 2);
+    lp->addRow(SparseLP::LEQ, 10 + i);
+    lp->addCoefficient(0, 1);
+    lp->addCoefficient(1, 1);
+    lp->addCoefficient(2, 1);
+    lp->addRow(SparseLP::LEQ, (i % 2) ? -1 - i % 4 : 4);
+    lp->addCoefficient(0, -1);
+    lp->addCoefficient(1, (i % 2) ? -1 : 1);
+    lp->addRow(SparseLP::EQ, i % 5);
+    lp->addCoefficient(0, 1);
+    lp->addCoefficient(2, -1);
+    return lp;
+}
+
+int main(void)
+{
+    bool passed = true;
+    const int NUM_PROBLEMS = 20;
+    std::vector<SparseLP*> problems;
+    std::vector<double> expected;
+    for (int i = 0; i < NUM_PROBLEMS; i++)
+    {
+        problems.push_back(makeProblem(i));
+        Simplex fresh(problems.back());
+        LPSolution* sol = fresh.solve();
+        expected.push_back(sol->getZValue());
+        passed = passed && sol->getErrorCode() == LPSolution::SOLVED;
+        delete sol;
+    }
+
+    // Warm up on the first problems: the table, Phase I's table and the
+    // solution's values are allocated once, at their full size.
+    Simplex simplex(problems[0]);
+    simplex.setKeepWorkspace(true);
+    LPSolution sol;
+    for (int i = 0; i < 2; i++)
+    {
+        simplex.load(problems[i]);
+        simplex.solveInto(&sol);
+    }
+
+    AllocationCounter counter;
+    bool answers = true;
+    for (int i = 0; i < NUM_PROBLEMS; i++)
+    {
+        simplex.load(problems[i]);
+        simplex.solveInto(&sol);
+        answers = answers && sol.getErrorCode() == LPSolution::SOLVED &&
+                  std::abs(sol.getZValue() - expected[i]) < 1e-6;
+    }
+    unsigned long long allocations = counter.getAllocations();
+    unsigned long long bytes = counter.getBytes();
+    std::cout << "answers: " << NUM_PROBLEMS << " problems "
+              << (answers ? "" : "(wrong)") << std::endl;
+    passed = passed && answers;
+
+    SolveStats& stats = sol.getStats();
+    if (AllocationCounter::isCounting())
+    {
+        bool steady = allocations == 0 && bytes == 0 &&
+                      stats.getAllocations(SolveStats::BUILD) == 0 &&
+                      stats.getAllocations(SolveStats::PHASE_ONE) == 0 &&
+                      stats.getAllocations(SolveStats::PHASE_TWO) == 0;
+        std::cout << "steady state: " << allocations << " allocations of "
+                  << bytes << " bytes " << (steady ? "" : "(wrong)")
+                  << std::endl;
+        passed = passed && steady;
+
+        // A fresh Simplex allocates its table, Phase I's table and the
+        // solution's values, and reports them.
+        Simplex fresh(problems[1]);
+        LPSolution* first = fresh.solve();
+        SolveStats& firstStats = first->getStats();
+        bool reported = firstStats.getAllocations(SolveStats::BUILD) > 0 &&
+                        firstStats.getAllocations(SolveStats::PHASE_ONE) > 0 &&
+                        firstStats.getAllocatedBytes(SolveStats::BUILD) > 0 &&
+                        firstStats.toJson().find("\"allocations\": {") !=
+                            std::string::npos;
+        std::cout << firstStats.toJson() << std::endl;
+        std::cout << "reported: " << (reported ? "" : "(wrong)") << std::endl;
+        passed = passed && reported;
+        delete first;
+    }
+    else
+    {
+        std::cout << "allocations are not counted in this build" << std::endl;
+        passed = passed && allocations == 0 &&
+                 stats.toJson().find("\"allocations\"") == std::string::npos;
+    }
+
+    for (int i = 0; i < NUM_PROBLEMS; i++)
+    {
+        delete problems[i];
+    }
+    std::cout << (passed ? "PASSED" : "FAILED") << std::endl;
+    return passed ? 0 : 1;
+}
@@ -0,0 +1,111 @@
+// Computes the solution paths of many small scenes over beta and checks 
+// that the objective value each gives at a range of betas matches solving
+// the scene from scratch at each of them, that a path's statistics add up
+// over all its solves, and that the Solver's pivot limit stops a path 
+// partway with TIMED_OUT.
+
+#include "Solver.h"
+#include "BetaPath.h"
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+
+int main(void)
+{
+    bool passed = true;
+    int multipleIntervals = 0;
+    HetNetModel* several = 0;
+    for (int seed = 0; seed < 300; seed++)
+    {
+        srand(seed);
+        HetNetModel model;
+        int numAps = 2 + rand() % 4;
+        int numDevices = 2 + rand() % 6;
+        for (int a = 0; a < numAps; a++)
+        {
+            model.addAccessPoint(rand() % 200, rand() % 200, 60 + rand() % 120,
+                                 100 + rand() % 1000);
+        }
+        for (int u = 0; u < numDevices; u++)
+        {
+            model.addDevice(rand() % 200, rand() % 200);
+        }
+
+        BetaPath path(&model);
+        passed = passed && path.compute() == LPSolution::SOLVED &&
+                 path.getStart(0) == 0 &&
+                 path.getEnd(path.getNumIntervals() - 1) == 1;
+        for (int i = 1; i < path.getNumIntervals(); i++)
+        {
+            passed = passed && path.getStart(i) == path.getEnd(i - 1);
+        }
+        multipleIntervals += (path.getNumIntervals() > 1);
+        if (path.getNumIntervals() > 1 && !several)
+        {
+            several = new HetNetModel(model);
+        }
+
+        for (int step = 0; step <= 20; step++)
+        {
+            double beta = step / 20.0;
+            model.setAlpha(1 - beta);
+            model.setBeta(beta);
+            LPSolution* direct = Solver::getInstance().solve(&model);
+            LPSolution* fromPath = path.getSolution(beta);
+            if (direct->getErrorCode() != LPSolution::SOLVED ||
+                fromPath->getErrorCode() != LPSolution::SOLVED ||
+                std::abs(direct->getZValue() - fromPath->getZValue()) > 
+                    0.001 * (1 + std::abs(direct->getZValue())))
+            {
+                std::cout << "scene " << seed << ", beta " << beta 
+                          << ": direct " << direct->getZValue() << " path "
+                          << fromPath->getZValue() << std::endl;
+                passed = false;
+            }
+            delete direct;
+            delete fromPath;
+        }
+    }
+    std::cout << "paths with more than one interval: " << multipleIntervals
+              << std::endl;
+    passed = passed && multipleIntervals > 0;
+    if (several)
+    {
+        // One pivot short of the whole path stops it before its last
+        // interval.
+        Solver& solver = Solver::getInstance();
+        BetaPath* whole = solver.solvePath(several);
+        solver.setMaxIterations(whole->getIterations() - 1);
+        BetaPath* cut = solver.solvePath(several);
+        solver.setMaxIterations(0);
+        SolveStats& stats = whole->getStats();
+        bool counted = stats.getEngine() == "beta path" &&
+                       stats.getPhaseOneIterations() + 
+                       stats.getPhaseTwoIterations() ==
+                           whole->getIterations() &&
+                       stats.getNumRows() > 0 && stats.getNumColumns() > 0 &&
+                       stats.getPeakTableBytes() > 0;
+        std::cout << stats.toJson() << (counted ? "" : " (wrong)")
+                  << std::endl;
+        passed = passed && counted;
+
+        bool stopped = whole->getErrorCode() == LPSolution::SOLVED &&
+                       cut->getErrorCode() == LPSolution::TIMED_OUT &&
+                       cut->getNumIntervals() < whole->getNumIntervals();
+        for (int i = 0; stopped && i < cut->getNumIntervals(); i++)
+        {
+            stopped = cut->getEnd(i) == whole->getEnd(i);
+        }
+        std::cout << "limited path: " << cut->getNumIntervals() << " of "
+                  << whole->getNumIntervals() << " intervals in "
+                  << cut->getIterations() << " of " << whole->getIterations()
+                  << " pivots" << (stopped ? "" : " (wrong)") << std::endl;
+        passed = passed && stopped;
+        delete whole;
+        delete cut;
+        delete several;
+    }
+
+    std::cout << (passed ? "PASSED" : "FAILED") << std::endl;
+    return passed ? 0 : 1;
+}
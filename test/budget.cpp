@@ -0,0 +1,231 @@
+// Solves a scene under iteration, time and cancellation budgets and checks
+// that each stops with TIMED_OUT and a feasible point, even with perturbed
+// right hand sides, and that a generous budget does not change the answer.
+// Then checks that the engines that build their own tables pass a budget 
+// on to them, and that Solver::cancel() stops a solve running on another
+// thread.
+
+#include "Simplex.h"
+#include "ClusterDecomposition.h"
+#include "ColumnGeneration.h"
+#include "DynamicSimulation.h"
+#include "HetNetModel.h"
+#include "RowGeneration.h"
+#include "SolveBudget.h"
+#include "Solver.h"
+#include "Sweep.h"
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <thread>
+
+// Returns true if the values satisfy every row of the problem.
+bool feasible(SparseLP& lp, LPSolution* sol)
+{
+    double* values = sol->getOptimalValues();
+    if (!values || sol->getNumOptimalValues() != lp.getNumVars())
+    {
+        return false;
+    }
+    for (int r = 0; r < lp.getNumRows(); r++)
+    {
+        double sum = 0;
+        for (int k = lp.getRowStart(r); k < lp.getRowEnd(r); k++)
+        {
+            sum += lp.getValue(k) * values[lp.getColIndex(k)];
+        }
+        if (sum > lp.getRhs(r) + 0.001)
+        {
+            return false;
+        }
+    }
+    for (int j = 0; j < lp.getNumVars(); j++)
+    {
+        if (values[j] < -0.001)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+// Solves a scene through the Solver and raises done when it returns.
+void solveScene(HetNetModel* model, LPSolution** sol, std::atomic<bool>* done)
+{
+    *sol = Solver::getInstance().solve(model);
+    *done = true;
+}
+
+int main(void)
+{
+    srand(11);
+    HetNetModel model;
+    for (int a = 0; a < 30; a++)
+    {
+        model.addAccessPoint(rand() % 1000, rand() % 1000, 100 + rand() % 200,
+                             100 + rand() % 1000);
+    }
+    for (int u = 0; u < 200; u++)
+    {
+        model.addDevice(rand() % 1000, rand() % 1000);
+    }
+    model.setAlpha(0.5);
+    model.setBeta(0.5);
+    SparseLP lp;
+    model.buildLP(&lp);
+
+    Simplex full(&lp);
+    LPSolution* optimal = full.solve();
+    std::cout << "unlimited: " << optimal->getZValue() << " in "
+              << full.getIterations() << " pivots" << std::endl;
+    bool passed = optimal->getErrorCode() == LPSolution::SOLVED;
+
+    // An iteration cap stops Phase II at a feasible, worse point.
+    SolveBudget capped;
+    capped.setMaxIterations(full.getIterations() / 2);
+    Simplex partial(&lp);
+    partial.setBudget(&capped);
+    LPSolution* sol = partial.solve();
+    std::cout << "capped: " << sol->getZValue() << " in "
+              << partial.getIterations() << " pivots" << std::endl;
+    passed = passed && sol->getErrorCode() == LPSolution::TIMED_OUT &&
+             partial.getIterations() == full.getIterations() / 2 &&
+             feasible(lp, sol) &&
+             sol->getZValue() <= optimal->getZValue() + 0.001;
+    delete sol;
+
+    // A perturbed solve that runs out only returns points that are 
+    // feasible without the perturbation.
+    int kept = 0;
+    for (unsigned long long cap = 1; cap < full.getIterations(); cap += 7)
+    {
+        SolveBudget perturbedCap;
+        perturbedCap.setMaxIterations(cap);
+        Simplex perturbed(&lp);
+        perturbed.setPerturbation(true);
+        perturbed.setBudget(&perturbedCap);
+        sol = perturbed.solve();
+        kept += sol->getOptimalValues() != 0;
+        passed = passed && (sol->getErrorCode() == LPSolution::TIMED_OUT ||
+                            sol->getErrorCode() == LPSolution::SOLVED) &&
+                 (!sol->getOptimalValues() || feasible(lp, sol));
+        delete sol;
+    }
+    std::cout << "perturbed: kept " << kept << " points" << std::endl;
+
+    // A cancelled budget stops before the first pivot.
+    SolveBudget cancelled;
+    cancelled.cancel();
+    Simplex stopped(&lp);
+    stopped.setBudget(&cancelled);
+    sol = stopped.solve();
+    passed = passed && sol->getErrorCode() == LPSolution::TIMED_OUT &&
+             stopped.getIterations() == 0 && feasible(lp, sol);
+    delete sol;
+
+    // A short deadline returns long before the problem would be solved.
+    SolveBudget deadline;
+    std::chrono::steady_clock::time_point start =
+        std::chrono::steady_clock::now();
+    deadline.setTimeLimit(0.001);
+    Simplex timed(&lp);
+    timed.setBudget(&deadline);
+    sol = timed.solve();
+    double seconds = std::chrono::duration<double>(
+        std::chrono::steady_clock::now() - start).count();
+    std::cout << "deadline: stopped after " << timed.getIterations()
+              << " pivots in " << seconds << " s" << std::endl;
+    passed = passed && sol->getErrorCode() == LPSolution::TIMED_OUT &&
+             timed.getIterations() < full.getIterations() &&
+             feasible(lp, sol);
+    delete sol;
+
+    // A generous budget gives the same answer as none.
+    SolveBudget generous;
+    generous.setTimeLimit(60);
+    generous.setMaxIterations(1000000);
+    Simplex unhurried(&lp);
+    unhurried.setBudget(&generous);
+    sol = unhurried.solve();
+    passed = passed && sol->getErrorCode() == LPSolution::SOLVED &&
+             std::abs(sol->getZValue() - optimal->getZValue()) < 0.001;
+    delete sol;
+
+    // Running out during the dual simplex method leaves no feasible point.
+    full.changeRhs(0, 0);
+    full.changeRhs(1, 0);
+    full.setBudget(&cancelled);
+    sol = full.reoptimize();
+    passed = passed && sol->getErrorCode() == LPSolution::TIMED_OUT &&
+             sol->getOptimalValues() == 0;
+    delete sol;
+
+    // The generation engines return a point of the whole scene, in the 
+    // model's column order, when their budget runs out.
+    ColumnGeneration columns(&model);
+    columns.setBudget(&capped);
+    sol = columns.solve();
+    std::cout << "column generation capped: " << sol->getZValue()
+              << std::endl;
+    passed = passed && sol->getErrorCode() == LPSolution::TIMED_OUT &&
+             feasible(lp, sol) &&
+             sol->getZValue() <= optimal->getZValue() + 0.001;
+    delete sol;
+    SolveBudget few;
+    few.setMaxIterations(20);
+    RowGeneration rows(&model);
+    rows.setBudget(&few);
+    sol = rows.solve();
+    std::cout << "row generation capped: " << sol->getZValue() << std::endl;
+    passed = passed && sol->getErrorCode() == LPSolution::TIMED_OUT &&
+             feasible(lp, sol) &&
+             sol->getZValue() <= optimal->getZValue() + 0.001;
+    delete sol;
+
+    // The other engines stop at once on a cancelled budget.
+    ClusterDecomposition clusters(&model);
+    clusters.setBudget(&cancelled);
+    sol = clusters.solve(ClusterDecomposition::EXACT, 2);
+    passed = passed && sol->getErrorCode() == LPSolution::TIMED_OUT;
+    delete sol;
+    HetNetModel moving(model);
+    DynamicSimulation simulation(&moving);
+    simulation.setBudget(&cancelled);
+    sol = simulation.solve();
+    passed = passed && sol->getErrorCode() == LPSolution::TIMED_OUT;
+    delete sol;
+    Sweep sweep(&model);
+    sweep.setBetas(0, 1, 4);
+    sweep.setBudget(&cancelled);
+    std::string path = "/tmp/hetnet_budget_sweep.bin";
+    std::vector<std::string> names;
+    std::vector<std::vector<double> > results;
+    passed = passed && sweep.run(path, 2) == 4 &&
+             SweepWriter::read(path, names, results);
+    for (size_t r = 0; passed && r < results[6].size(); r++)
+    {
+        passed = results[6][r] == LPSolution::TIMED_OUT;
+    }
+    remove(path.c_str());
+    std::cout << "engines " << (passed ? "stopped" : "did not stop")
+              << std::endl;
+
+    // Solver::cancel() reaches a solve running on another thread.
+    std::atomic<bool> done(false);
+    LPSolution* cancelledSol = 0;
+    std::thread solving(solveScene, &model, &cancelledSol, &done);
+    while (!done)
+    {
+        Solver::getInstance().cancel();
+    }
+    solving.join();
+    passed = passed && cancelledSol->getErrorCode() == LPSolution::TIMED_OUT;
+    delete cancelledSol;
+    delete optimal;
+
+    std::cout << (passed ? "PASSED" : "FAILED") << std::endl;
+    return passed ? 0 : 1;
+}
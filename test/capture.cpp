@@ -0,0 +1,195 @@
+// Records problems, a scene and a scene's path over beta into a capture log
+// through the Solver, and checks that the log reads back the same requests,
+// settings and answers, that solving them again gives the recorded hashes,
+// that sampling keeps one problem in n, that a log cut short keeps its
+// whole records, and that the memory limit and simplex variant a problem
+// was solved under are recorded with the engine, and restored to solve it
+// again.
+
+#include "BasicSimplex.h"
+#include "CaptureLog.h"
+#include "Solver.h"
+#include <cstdio>
+#include <iostream>
+#include <unistd.h>
+
+static const int NUM_PROBLEMS = 3;
+static const char* PROBLEMS[NUM_PROBLEMS] = {"1 1;1 1 1,-1 0 -0.1,;;",
+                                             "3 1;1 0 2,0 1 3,-1 -1 -1,;;",
+                                             "1 1;1 1 1,-1 -1 -2,;;"};
+
+/**
+ * Returns a fresh, empty file to write a log into.
+ */
+static std::string tempFile()
+{
+    char path[] = "/tmp/captureXXXXXX";
+    close(mkstemp(path));
+    remove(path);
+    return path;
+}
+
+int main(void)
+{
+    bool passed = true;
+    Solver& solver = Solver::getInstance();
+    std::string path = tempFile();
+    CaptureLog* log = new CaptureLog(path, 1);
+    passed = passed && log->isOpen();
+    solver.setCaptureLog(log);
+
+    std::vector<unsigned long long> hashes;
+    std::vector<int> errorCodes;
+    for (int i = 0; i < NUM_PROBLEMS; i++)
+    {
+        solver.setMaxIterations(i == 1 ? 1000 : 0);
+        std::string problem = PROBLEMS[i];
+        LPSolution* sol = solver.solve(problem);
+        hashes.push_back(CaptureLog::hashSolution(sol));
+        errorCodes.push_back(sol->getErrorCode());
+        delete sol;
+    }
+    solver.setMaxIterations(0);
+    // As cppSolveScene records a scene.
+    std::string scene = "0.5 0.5;100 100 80 1000,160 100 80 500,;"
+                        "90 110,150 95,130 130,400 400,;";
+    unsigned long long arrival = CaptureLog::now();
+    HetNetModel model(scene);
+    LPSolution* sol = solver.solve(&model);
+    solver.capture(CaptureLog::SCENE, scene, sol, arrival, 0.001);
+    hashes.push_back(CaptureLog::hashSolution(sol));
+    errorCodes.push_back(sol->getErrorCode());
+    delete sol;
+    // As cppSolveScenePath records it.
+    arrival = CaptureLog::now();
+    BetaPath* scenePath = solver.solvePath(&model);
+    solver.capture(CaptureLog::PATH, scene, scenePath, arrival, 0.001);
+    hashes.push_back(CaptureLog::hashPath(scenePath));
+    errorCodes.push_back(scenePath->getErrorCode());
+    delete scenePath;
+    solver.setCaptureLog(0);
+    delete log;
+
+    std::vector<CaptureRecord> records;
+    std::string error;
+    bool read = CaptureLog::read(path, records, error) &&
+                records.size() == NUM_PROBLEMS + 2;
+    for (size_t i = 0; read && i < records.size(); i++)
+    {
+        CaptureRecord& record = records[i];
+        bool isScene = i >= NUM_PROBLEMS;
+        int kind = i == NUM_PROBLEMS ? CaptureLog::SCENE :
+                   (isScene ? CaptureLog::PATH : CaptureLog::PROBLEM);
+        read = read && record.kind == kind &&
+               record.problem == (isScene ? scene : PROBLEMS[i]) &&
+               record.maxIterations == (i == 1 ? 1000u : 0u) &&
+               record.timeLimit == 0 && record.gapTolerance == 0 &&
+               record.errorCode == errorCodes[i] &&
+               record.resultHash == hashes[i] && record.seconds > 0 &&
+               (i == 0 || record.timestamp >= records[i - 1].timestamp);
+    }
+    std::cout << "read: " << records.size() << " records " << error
+              << (read ? "" : " (wrong)") << std::endl;
+    passed = passed && read;
+
+    // Solving the problems again gives the same answers; an infeasible
+    // problem hashes differently from a solved one, and a path differently
+    // from the scene's answer.
+    bool replayed = hashes[0] != hashes[2] &&
+                    hashes[NUM_PROBLEMS] != hashes[NUM_PROBLEMS + 1];
+    for (int i = 0; read && i < NUM_PROBLEMS; i++)
+    {
+        LPSolution* again = solver.solve(records[i].problem);
+        replayed = replayed &&
+                   CaptureLog::hashSolution(again) == records[i].resultHash;
+        delete again;
+    }
+    if (read)
+    {
+        HetNetModel again(records[NUM_PROBLEMS + 1].problem);
+        BetaPath* pathAgain = solver.solvePath(&again);
+        replayed = replayed && CaptureLog::hashPath(pathAgain) ==
+                               records[NUM_PROBLEMS + 1].resultHash;
+        delete pathAgain;
+    }
+    std::cout << "replayed: " << (replayed ? "" : "(wrong)") << std::endl;
+    passed = passed && replayed;
+
+    // A crash in the middle of a write leaves part of a frame behind.
+    FILE* file = fopen(path.c_str(), "r+");
+    fseek(file, 0, SEEK_END);
+    long size = ftell(file);
+    fclose(file);
+    passed = passed && truncate(path.c_str(), size - 3) == 0;
+    records.clear();
+    bool cut = !CaptureLog::read(path, records, error) &&
+               records.size() == NUM_PROBLEMS + 1 &&
+               error.find("cut short") != std::string::npos;
+    std::cout << "cut short: " << records.size() << " records, " << error
+              << (cut ? "" : " (wrong)") << std::endl;
+    passed = passed && cut;
+    remove(path.c_str());
+
+    std::string sampledPath = tempFile();
+    log = new CaptureLog(sampledPath, 2);
+    solver.setCaptureLog(log);
+    for (int i = 0; i < 5; i++)
+    {
+        std::string problem = PROBLEMS[i % NUM_PROBLEMS];
+        delete solver.solve(problem);
+    }
+    solver.setCaptureLog(0);
+    delete log;
+    records.clear();
+    bool sampled = CaptureLog::read(sampledPath, records, error) &&
+                   records.size() == 3 && records[1].problem == PROBLEMS[2];
+    std::cout << "sampled: " << records.size() << " of 5 "
+              << (sampled ? "" : "(wrong)") << std::endl;
+    passed = passed && sampled;
+    remove(sampledPath.c_str());
+
+    std::string settingsPath = tempFile();
+    log = new CaptureLog(settingsPath, 1);
+    solver.setCaptureLog(log);
+    std::string problem = PROBLEMS[0];
+    solver.setMemoryLimit(16, 0.5);
+    delete solver.solve(problem);
+    solver.setMemoryLimit(0, 0);
+    solver.setScalar(SimplexVariant::FLOAT, SimplexVariant::BLAND,
+                     SimplexVariant::HARRIS);
+    delete solver.solve(problem);
+    solver.setScalar(-1, 0, 0);
+    solver.setCaptureLog(0);
+    delete log;
+    records.clear();
+    bool restored = CaptureLog::read(settingsPath, records, error) &&
+                    records.size() == 2 &&
+                    records[0].memoryLimit == 16 &&
+                    records[0].queueTimeout == 0.5 &&
+                    records[0].scalar == -1 &&
+                    records[0].engine == "rejected" &&
+                    records[1].memoryLimit == 0 &&
+                    records[1].scalar == SimplexVariant::FLOAT &&
+                    records[1].pricing == SimplexVariant::BLAND &&
+                    records[1].ratioTest == SimplexVariant::HARRIS &&
+                    !records[1].crashStart &&
+                    records[1].engine == "simplex float";
+    for (size_t i = 0; restored && i < records.size(); i++)
+    {
+        solver.applySettings(records[i]);
+        LPSolution* again = solver.solve(records[i].problem);
+        restored = restored &&
+                   CaptureLog::hashSolution(again) == records[i].resultHash &&
+                   again->getStats().getEngine() == records[i].engine;
+        delete again;
+    }
+    solver.setMemoryLimit(0, 0);
+    solver.setScalar(-1, 0, 0);
+    std::cout << "settings: " << records.size() << " records "
+              << (restored ? "" : "(wrong)") << std::endl;
+    passed = passed && restored;
+    remove(settingsPath.c_str());
+
+    std::cout << (passed ? "PASSED" : "FAILED") << std::endl;
+    return passed ? 0 : 1;
+}
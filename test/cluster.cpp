@@ -0,0 +1,77 @@
+// Builds a scene of several separate neighborhoods and checks that solving
+// it cluster by cluster gives the same objective value as solving it whole,
+// and that the approximate mode gives a feasible solution no better than it.
+
+#include "Solver.h"
+#include "ClusterDecomposition.h"
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+
+// Checks every row of the scene's problem against a solution.
+static bool feasible(HetNetModel& model, LPSolution* sol)
+{
+    SparseLP lp;
+    model.buildLP(&lp);
+    double* values = sol->getOptimalValues();
+    for (int row = 0; row < lp.getNumRows(); row++)
+    {
+        double sum = 0;
+        for (int i = lp.getRowStart(row); i < lp.getRowEnd(row); i++)
+        {
+            sum += lp.getValue(i) * values[lp.getColIndex(i)];
+        }
+        if (sum > lp.getRhs(row) + 0.01)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+int main(void)
+{
+    srand(5);
+    bool passed = true;
+    for (int trial = 0; trial < 4; trial++)
+    {
+        HetNetModel model;
+        model.setAlpha(0.2 + 0.2 * trial);
+        model.setBeta(0.8 - 0.2 * trial);
+        for (int n = 0; n < 6; n++)
+        {
+            double cx = 1000 * n, cy = 500 * (n % 2);
+            for (int a = 0; a < 3; a++)
+            {
+                model.addAccessPoint(cx + rand() % 150, cy + rand() % 150, 
+                                     120 + rand() % 60, 300 + rand() % 900);
+            }
+            for (int u = 0; u < 10; u++)
+            {
+                model.addDevice(cx + rand() % 150, cy + rand() % 150);
+            }
+        }
+
+        LPSolution* whole = Solver::getInstance().solve(&model);
+        ClusterDecomposition decomposition(&model);
+        LPSolution* exact = decomposition.solve(ClusterDecomposition::EXACT, 3);
+        LPSolution* approximate = Solver::getInstance().solveClusters(
+                &model, ClusterDecomposition::APPROXIMATE, 3);
+        std::cout << decomposition.getNumClusters() << " clusters: whole "
+                  << whole->getZValue() << " exact " << exact->getZValue()
+                  << " approximate " << approximate->getZValue() << std::endl;
+
+        passed = passed && decomposition.getNumClusters() >= 6 &&
+                 whole->getErrorCode() == LPSolution::SOLVED &&
+                 exact->getErrorCode() == LPSolution::SOLVED &&
+                 approximate->getErrorCode() == LPSolution::SOLVED &&
+                 std::abs(whole->getZValue() - exact->getZValue()) < 0.01 &&
+                 approximate->getZValue() <= exact->getZValue() + 0.01 &&
+                 feasible(model, exact) && feasible(model, approximate);
+        delete whole;
+        delete exact;
+        delete approximate;
+    }
+    std::cout << (passed ? "PASSED" : "FAILED") << std::endl;
+    return passed ? 0 : 1;
+}
@@ -0,0 +1,109 @@
+// Solves crowded scenes, where every device is in range of many networks,
+// by column generation and checks that the objective value matches solving
+// the whole problem while using only part of the pairs, and that the 
+// solution comes back in the model's column order satisfying every row.
+
+#include "Solver.h"
+#include "ColumnGeneration.h"
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <vector>
+
+// Checks every row of the scene's problem against a solution whose values
+// are ordered as the model's columns.
+static bool feasible(HetNetModel& model, LPSolution* sol)
+{
+    SparseLP lp;
+    model.buildLP(&lp);
+    double* values = sol->getOptimalValues();
+    if (!values || sol->getNumOptimalValues() != lp.getNumVars())
+    {
+        return false;
+    }
+    for (int row = 0; row < lp.getNumRows(); row++)
+    {
+        double sum = 0;
+        for (int i = lp.getRowStart(row); i < lp.getRowEnd(row); i++)
+        {
+            sum += lp.getValue(i) * values[lp.getColIndex(i)];
+        }
+        if (sum > lp.getRhs(row) + 0.01)
+        {
+            return false;
+        }
+    }
+    for (int j = 0; j < lp.getNumVars(); j++)
+    {
+        if (values[j] < -0.01)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+// Checks that expanding a solution puts each pair's share of its access
+// point's time at that device and access point, and z last.
+static bool expands(HetNetModel& model, LPSolution* sol)
+{
+    int numAps = model.getNumAccessPoints();
+    int numPairs = model.getNumPairs();
+    double* values = sol->getOptimalValues();
+    std::vector<double> dense = model.expandSolution(sol);
+    if (!values || std::abs(dense.back() - values[numPairs]) > 0.01)
+    {
+        return false;
+    }
+    for (int p = 0; p < numPairs; p++)
+    {
+        double share = dense[model.getPairDevice(p) * numAps +
+                             model.getPairAccessPoint(p)];
+        if (std::abs(share * model.getPairRate(p) - values[p]) > 0.01 ||
+            share > 1.01)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+int main(void)
+{
+    srand(9);
+    bool passed = true;
+    for (int trial = 0; trial < 5; trial++)
+    {
+        HetNetModel model;
+        model.setAlpha(0.25 * trial);
+        model.setBeta(1 - 0.25 * trial);
+        for (int a = 0; a < 12; a++)
+        {
+            model.addAccessPoint(rand() % 300, rand() % 300, 250 + rand() % 100,
+                                 300 + rand() % 1200);
+        }
+        for (int u = 0; u < 40; u++)
+        {
+            model.addDevice(rand() % 300, rand() % 300);
+        }
+
+        LPSolution* whole = Solver::getInstance().solve(&model);
+        ColumnGeneration generation(&model);
+        LPSolution* generated = generation.solve();
+        std::cout << "whole " << whole->getZValue() << " generated "
+                  << generated->getZValue() << " using "
+                  << generation.getNumColumns() << " of "
+                  << model.getNumPairs() << " pairs in "
+                  << generation.getNumRounds() << " rounds" << std::endl;
+
+        passed = passed && whole->getErrorCode() == LPSolution::SOLVED &&
+                 generated->getErrorCode() == LPSolution::SOLVED &&
+                 std::abs(whole->getZValue() - generated->getZValue()) < 0.01 &&
+                 generation.getNumColumns() < model.getNumPairs() &&
+                 feasible(model, generated) && expands(model, generated);
+        delete whole;
+        delete generated;
+    }
+    std::cout << (passed ? "PASSED" : "FAILED") << std::endl;
+    return passed ? 0 : 1;
+}
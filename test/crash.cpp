@@ -0,0 +1,110 @@
+// Fills random scenes with the water-filling heuristic, checks that every
+// allocation is feasible and no better than the optimum, and that solving
+// from the basis crashed from it finds the same optimum with fewer Phase II
+// pivots on every scene. The crash pivots themselves are reported but not
+// held to anything: they often outnumber those saved, which is why Solver
+// only crashes when asked to.
+
+#include "Simplex.h"
+#include "WaterFilling.h"
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+
+/**
+ * Returns true if the rates and z of a solution obey every row of the
+ * scene's problem.
+ */
+static bool feasible(HetNetModel& model, LPSolution* sol)
+{
+    int numPairs = model.getNumPairs();
+    double* values = sol->getOptimalValues();
+    double slack = 1e-6 * (1 + model.getSumRuaMax());
+    std::vector<double> apLoad(model.getNumAccessPoints(), 0);
+    std::vector<double> deviceRate(model.getNumDevices(), 0);
+    for (int p = 0; p < numPairs; p++)
+    {
+        if (values[p] < -slack || values[p] > model.getPairRate(p) + slack)
+        {
+            return false;
+        }
+        apLoad[model.getPairAccessPoint(p)] += values[p];
+        deviceRate[model.getPairDevice(p)] += values[p];
+    }
+    for (int a = 0; a < model.getNumAccessPoints(); a++)
+    {
+        if (apLoad[a] > model.getAccessPointRate(a) + slack)
+        {
+            return false;
+        }
+    }
+    for (int u = 0; u < model.getNumDevices(); u++)
+    {
+        if (values[numPairs] > deviceRate[u] + slack)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+int main(void)
+{
+    srand(40);
+    bool passed = true;
+    unsigned long long slackPivots = 0, crashPivots = 0, phaseTwoPivots = 0;
+    for (int trial = 0; trial < 8; trial++)
+    {
+        HetNetModel model;
+        model.setAlpha((trial % 4) / 3.0);
+        model.setBeta(1 - (trial % 4) / 3.0);
+        for (int a = 0; a < 12; a++)
+        {
+            model.addAccessPoint(rand() % 400, rand() % 400, 80 + rand() % 160,
+                                 400 + rand() % 1600);
+        }
+        for (int u = 0; u < 100; u++)
+        {
+            model.addDevice(rand() % 400, rand() % 400);
+        }
+        SparseLP lp;
+        model.buildLP(&lp);
+
+        Simplex plain(&lp);
+        LPSolution* exact = plain.solve();
+        WaterFilling filling(&model);
+        LPSolution* heuristic = filling.solve();
+        Simplex crashed(&lp);
+        LPSolution* found = crashed.solveFrom(heuristic->getOptimalValues());
+
+        double optimum = exact->getZValue();
+        double tolerance = 1e-4 * (1 + std::abs(optimum));
+        unsigned long long crashSteps = found->getStats()
+                                            .getPhaseOneIterations();
+        unsigned long long phaseTwo = found->getStats()
+                                          .getPhaseTwoIterations();
+        bool ok = exact->getErrorCode() == LPSolution::SOLVED &&
+                  found->getErrorCode() == LPSolution::SOLVED &&
+                  std::abs(found->getZValue() - optimum) <= tolerance &&
+                  feasible(model, heuristic) &&
+                  heuristic->getZValue() <= optimum + tolerance &&
+                  phaseTwo < plain.getIterations();
+        std::cout << "scene " << trial << ": optimum " << optimum
+                  << " heuristic " << heuristic->getZValue() << " pivots "
+                  << plain.getIterations() << " from slack, " << crashSteps
+                  << " crash and " << phaseTwo << " more crashed"
+                  << (ok ? "" : " (wrong)") << std::endl;
+        passed = passed && ok;
+        slackPivots += plain.getIterations();
+        crashPivots += crashSteps;
+        phaseTwoPivots += phaseTwo;
+        delete exact;
+        delete heuristic;
+        delete found;
+    }
+    std::cout << "total pivots " << slackPivots << " from slack, "
+              << crashPivots << " crash and " << phaseTwoPivots
+              << " more crashed" << std::endl;
+    std::cout << (passed ? "PASSED" : "FAILED") << std::endl;
+    return passed ? 0 : 1;
+}
@@ -0,0 +1,90 @@
+// Solves Beale's example, which makes the textbook simplex method cycle
+// forever, with each ratio test and with perturbation, and checks the 
+// degenerate pivot statistics on a HetNet scene.
+
+#include "Simplex.h"
+#include "HetNetModel.h"
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+
+int main(void)
+{
+    SparseLP beale;
+    beale.clear(4);
+    double costs[] = {0.75, -20, 0.5, -6};
+    for (int j = 0; j < 4; j++)
+    {
+        beale.setObjective(j, costs[j]);
+    }
+    double rows[3][4] = {{0.25, -8, -1, 9}, {0.5, -12, -0.5, 3}, {0, 0, 1, 0}};
+    double rhs[] = {0, 0, 1};
+    for (int r = 0; r < 3; r++)
+    {
+        beale.addRow(SparseLP::LEQ, rhs[r]);
+        for (int j = 0; j < 4; j++)
+        {
+            if (rows[r][j] != 0)
+            {
+                beale.addCoefficient(j, rows[r][j]);
+            }
+        }
+    }
+
+    bool passed = true;
+    const char* names[] = {"textbook", "Harris", "Harris, perturbed"};
+    for (int mode = 0; mode < 3; mode++)
+    {
+        Simplex simplex(&beale);
+        simplex.setHarrisRatioTest(mode > 0);
+        simplex.setPerturbation(mode == 2);
+        LPSolution* sol = simplex.solve();
+        std::cout << names[mode] << ": error code " << sol->getErrorCode()
+                  << ", z " << sol->getZValue() << ", " 
+                  << simplex.getIterations() << " pivots, "
+                  << simplex.getDegeneratePivots() << " degenerate"
+                  << std::endl;
+        if (mode > 0)
+        {
+            passed = passed && sol->getErrorCode() == LPSolution::SOLVED &&
+                     std::abs(sol->getZValue() - 1.25) < 0.001;
+        }
+        delete sol;
+    }
+
+    srand(5);
+    HetNetModel model;
+    for (int a = 0; a < 20; a++)
+    {
+        model.addAccessPoint(rand() % 1000, rand() % 1000, 100 + rand() % 200,
+                             100 + rand() % 1000);
+    }
+    for (int u = 0; u < 150; u++)
+    {
+        model.addDevice(rand() % 1000, rand() % 1000);
+    }
+    model.setAlpha(0.5);
+    model.setBeta(0.5);
+    SparseLP lp;
+    model.buildLP(&lp);
+    double objective[3];
+    for (int mode = 0; mode < 3; mode++)
+    {
+        Simplex simplex(&lp);
+        simplex.setHarrisRatioTest(mode > 0);
+        simplex.setPerturbation(mode == 2);
+        LPSolution* sol = simplex.solve();
+        objective[mode] = sol->getZValue();
+        std::cout << "scene, " << names[mode] << ": z " << objective[mode]
+                  << ", " << simplex.getIterations() << " pivots, "
+                  << simplex.getDegeneratePivots() << " degenerate"
+                  << std::endl;
+        passed = passed && sol->getErrorCode() == LPSolution::SOLVED &&
+                 simplex.getDegeneratePivots() <= simplex.getIterations();
+        delete sol;
+    }
+    passed = passed && std::abs(objective[1] - objective[0]) < 0.001 &&
+             std::abs(objective[2] - objective[0]) < 0.001;
+    std::cout << (passed ? "PASSED" : "FAILED") << std::endl;
+    return passed ? 0 : 1;
+}
@@ -0,0 +1,86 @@
+// Moves devices around a scene for a number of ticks and checks that the
+// warm started, cold and multithreaded runs all find the same z values, 
+// and that the warm run reoptimizes its table on most ticks. The pivots of
+// both are printed; with half the devices moving every tick, reoptimizing
+// is not always cheaper in pivots than starting over.
+
+#include "DynamicSimulation.h"
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+
+int main(void)
+{
+    srand(7);
+    HetNetModel model;
+    model.setAlpha(0.6);
+    model.setBeta(0.4);
+    for (int a = 0; a < 6; a++)
+    {
+        model.addAccessPoint(rand() % 400, rand() % 400, 100 + rand() % 100,
+                             500 + rand() % 1000);
+    }
+    for (int u = 0; u < 25; u++)
+    {
+        model.addDevice(rand() % 400, rand() % 400);
+    }
+
+    std::vector<Tick> ticks;
+    for (int t = 0; t < 40; t++)
+    {
+        Tick tick(t);
+        for (int u = 0; u < 25; u += 1 + rand() % 3)
+        {
+            tick.addMove(u, rand() % 400, rand() % 400);
+        }
+        ticks.push_back(tick);
+    }
+
+    HetNetModel coldModel(model);
+    DynamicSimulation cold(&coldModel);
+    cold.setWarmStart(false);
+    HetNetModel steppedModel(model);
+    DynamicSimulation stepped(&steppedModel);
+    std::vector<LPSolution*> warm = DynamicSimulation::run(&model, ticks, 1);
+    std::vector<LPSolution*> parallel = DynamicSimulation::run(&model, ticks, 4);
+
+    bool passed = true;
+    unsigned long long coldPivots = 0, warmPivots = 0;
+    for (size_t t = 0; t < ticks.size(); t++)
+    {
+        LPSolution* coldSol = cold.step(ticks[t]);
+        LPSolution* steppedSol = stepped.step(ticks[t]);
+        coldPivots += coldSol->getStats().getPhaseOneIterations() +
+                      coldSol->getStats().getPhaseTwoIterations();
+        warmPivots += steppedSol->getStats().getPhaseOneIterations() +
+                      steppedSol->getStats().getPhaseTwoIterations();
+        passed = passed && std::abs(coldSol->getZValue() -
+                                    steppedSol->getZValue()) <= 0.01;
+        delete steppedSol;
+        if (coldSol->getErrorCode() != LPSolution::SOLVED ||
+            warm[t]->getErrorCode() != LPSolution::SOLVED ||
+            std::abs(coldSol->getZValue() - warm[t]->getZValue()) > 0.01 ||
+            std::abs(coldSol->getZValue() - parallel[t]->getZValue()) > 0.01)
+        {
+            std::cout << "tick " << t << ": cold " << coldSol->getZValue()
+                      << " warm " << warm[t]->getZValue() << " parallel "
+                      << parallel[t]->getZValue() << std::endl;
+            passed = false;
+        }
+        delete coldSol;
+        delete warm[t];
+        delete parallel[t];
+    }
+
+    // Only the first tick, and a tick that collected too many stale slots,
+    // should need a new table.
+    int numTicks = ticks.size();
+    std::cout << "rebuilds: warm " << stepped.getNumRebuilds() << ", cold "
+              << cold.getNumRebuilds() << " of " << numTicks << std::endl;
+    std::cout << "pivots: warm " << warmPivots << ", cold " << coldPivots
+              << std::endl;
+    passed = passed && cold.getNumRebuilds() == numTicks &&
+             stepped.getNumRebuilds() <= numTicks / 4;
+    std::cout << (passed ? "PASSED" : "FAILED") << std::endl;
+    return passed ? 0 : 1;
+}
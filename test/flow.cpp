@@ -0,0 +1,109 @@
+// Solves random scenes with the maximum flow solver and checks that every
+// answer is feasible and has the objective value the simplex method finds.
+
+#include "Solver.h"
+#include "HetNetFlow.h"
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+
+/**
+ * Returns true if the rates and z of a solution obey every row of the
+ * scene's problem, and its objective value is what they add up to.
+ */
+static bool feasible(HetNetModel& model, LPSolution* sol)
+{
+    int numPairs = model.getNumPairs();
+    double* values = sol->getOptimalValues();
+    if (!values || sol->getNumOptimalValues() != numPairs + 1)
+    {
+        return false;
+    }
+    double slack = 1e-6 * (1 + model.getSumRuaMax());
+    std::vector<double> apLoad(model.getNumAccessPoints(), 0);
+    std::vector<double> deviceRate(model.getNumDevices(), 0);
+    double total = 0;
+    for (int p = 0; p < numPairs; p++)
+    {
+        if (values[p] < -slack || values[p] > model.getPairRate(p) + slack)
+        {
+            return false;
+        }
+        apLoad[model.getPairAccessPoint(p)] += values[p];
+        deviceRate[model.getPairDevice(p)] += values[p];
+        total += values[p];
+    }
+    for (int a = 0; a < model.getNumAccessPoints(); a++)
+    {
+        if (apLoad[a] > model.getAccessPointRate(a) + slack)
+        {
+            return false;
+        }
+    }
+    for (int u = 0; u < model.getNumDevices(); u++)
+    {
+        if (values[numPairs] > deviceRate[u] + slack)
+        {
+            return false;
+        }
+    }
+    double objective = model.getAlpha() * total +
+                       model.getBeta() * model.getSumRuaMax() *
+                       values[numPairs];
+    return std::abs(objective - sol->getZValue()) <=
+           1e-6 * (1 + std::abs(objective));
+}
+
+int main(void)
+{
+    srand(39);
+    bool passed = true;
+    double simplexTime = 0, flowTime = 0;
+    for (int trial = 0; trial < 12; trial++)
+    {
+        HetNetModel model;
+        model.setAlpha((trial % 4) / 3.0);
+        model.setBeta(1 - (trial % 4) / 3.0);
+        int numAps = 4 + rand() % 12;
+        int numDevices = 10 + rand() % 90;
+        for (int a = 0; a < numAps; a++)
+        {
+            model.addAccessPoint(rand() % 400, rand() % 400, 60 + rand() % 200,
+                                 200 + rand() % 1500);
+        }
+        for (int u = 0; u < numDevices; u++)
+        {
+            model.addDevice(rand() % 400, rand() % 400);
+        }
+
+        std::chrono::steady_clock::time_point start =
+            std::chrono::steady_clock::now();
+        LPSolution* exact = Solver::getInstance().solve(&model);
+        std::chrono::steady_clock::time_point middle =
+            std::chrono::steady_clock::now();
+        HetNetFlow flow(&model);
+        LPSolution* found = flow.solve();
+        std::chrono::steady_clock::time_point end =
+            std::chrono::steady_clock::now();
+        simplexTime += std::chrono::duration<double>(middle - start).count();
+        flowTime += std::chrono::duration<double>(end - middle).count();
+
+        bool same = exact->getErrorCode() == LPSolution::SOLVED &&
+                    found->getErrorCode() == LPSolution::SOLVED &&
+                    std::abs(exact->getZValue() - found->getZValue()) <=
+                        1e-4 * (1 + std::abs(exact->getZValue()));
+        bool valid = feasible(model, found);
+        std::cout << "scene " << trial << ": " << model.getNumPairs()
+                  << " pairs, simplex " << exact->getZValue() << " flow "
+                  << found->getZValue() << " in " << flow.getNumFlows()
+                  << " flows" << (valid ? "" : " (infeasible)") << std::endl;
+        passed = passed && same && valid;
+        delete exact;
+        delete found;
+    }
+    std::cout << "simplex " << simplexTime << " s, flow " << flowTime << " s"
+              << std::endl;
+    std::cout << (passed ? "PASSED" : "FAILED") << std::endl;
+    return passed ? 0 : 1;
+}
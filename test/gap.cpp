@@ -0,0 +1,79 @@
+// Solves random scenes with a relative gap tolerance and checks that each
+// answer is feasible, certifies a gap within the tolerance, and is really
+// that close to the exact optimum.
+
+#include "Simplex.h"
+#include "HetNetModel.h"
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+
+int main(void)
+{
+    bool passed = true;
+    int stoppedEarly = 0;
+    double tolerances[] = {0.1, 0.02};
+    for (int seed = 0; seed < 20; seed++)
+    {
+        srand(seed);
+        HetNetModel model;
+        for (int a = 0; a < 10; a++)
+        {
+            model.addAccessPoint(rand() % 600, rand() % 600, 100 + rand() % 200,
+                                 100 + rand() % 1000);
+        }
+        for (int u = 0; u < 60; u++)
+        {
+            model.addDevice(rand() % 600, rand() % 600);
+        }
+        model.setAlpha(0.5);
+        model.setBeta(0.5);
+        SparseLP lp;
+        model.buildLP(&lp);
+
+        Simplex exact(&lp);
+        LPSolution* optimal = exact.solve();
+        passed = passed && optimal->getErrorCode() == LPSolution::SOLVED &&
+                 optimal->getGap() == 0;
+
+        for (int t = 0; t < 2; t++)
+        {
+            Simplex simplex(&lp);
+            simplex.setGapTolerance(tolerances[t]);
+            LPSolution* sol = simplex.solve();
+            double z = sol->getZValue();
+            double gap = sol->getGap();
+            // The optimum is at most z + gap * |bound|, and bound = z / (1 - gap).
+            double bound = z / (1 - gap);
+            bool ok = sol->getErrorCode() == LPSolution::SOLVED &&
+                      gap <= tolerances[t] &&
+                      z <= optimal->getZValue() + 0.001 &&
+                      optimal->getZValue() <= bound + 0.001;
+
+            double* values = sol->getOptimalValues();
+            for (int r = 0; r < lp.getNumRows() && ok; r++)
+            {
+                double sum = 0;
+                for (int k = lp.getRowStart(r); k < lp.getRowEnd(r); k++)
+                {
+                    sum += lp.getValue(k) * values[lp.getColIndex(k)];
+                }
+                ok = sum <= lp.getRhs(r) + 0.001;
+            }
+            if (!ok)
+            {
+                std::cout << "scene " << seed << ", tolerance " 
+                          << tolerances[t] << ": z " << z << ", gap " << gap
+                          << ", optimum " << optimal->getZValue() << std::endl;
+                passed = false;
+            }
+            stoppedEarly += simplex.getIterations() < exact.getIterations();
+            delete sol;
+        }
+        delete optimal;
+    }
+    std::cout << "solves that stopped early: " << stoppedEarly << std::endl;
+    passed = passed && stoppedEarly > 0;
+    std::cout << (passed ? "PASSED" : "FAILED") << std::endl;
+    return passed ? 0 : 1;
+}
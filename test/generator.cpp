@@ -0,0 +1,74 @@
+// Checks that generated scenes have the requested size, depend only on the
+// seed, and put every device in range of a network.
+
+#include "HetNetModel.h"
+#include "SceneGenerator.h"
+#include <iostream>
+
+int main(void)
+{
+    bool passed = true;
+    int sizes[3][2] = {{10, 2}, {120, 12}, {400, 30}};
+    for (int s = 0; s < 3; s++)
+    {
+        SceneGenerator first(7);
+        SceneGenerator second(7);
+        SceneGenerator other(8);
+        first.setNumDevices(sizes[s][0]);
+        first.setNumAccessPoints(sizes[s][1]);
+        first.setOverlap(3);
+        second.setNumDevices(sizes[s][0]);
+        second.setNumAccessPoints(sizes[s][1]);
+        second.setOverlap(3);
+        other.setNumDevices(sizes[s][0]);
+        other.setNumAccessPoints(sizes[s][1]);
+        other.setOverlap(3);
+        std::string scene = first.generate();
+        bool repeatable = scene == second.generate() &&
+                          scene != other.generate() &&
+                          scene != first.generate();
+
+        HetNetModel model(scene);
+        std::vector<bool> covered(model.getNumDevices(), false);
+        for (int p = 0; p < model.getNumPairs(); p++)
+        {
+            covered[model.getPairDevice(p)] = true;
+        }
+        bool allCovered = true;
+        for (int u = 0; u < model.getNumDevices(); u++)
+        {
+            allCovered = allCovered && covered[u];
+        }
+        bool sized = model.getNumDevices() == sizes[s][0] &&
+                     model.getNumAccessPoints() == sizes[s][1] &&
+                     model.getAlpha() == 0.5 && model.getBeta() == 0.5;
+
+        std::cout << "scene " << s << ": " << model.getNumDevices()
+                  << " devices, " << model.getNumAccessPoints()
+                  << " access points, " << model.getNumPairs() << " pairs, "
+                  << "side " << first.getSide()
+                  << (repeatable ? "" : " (not repeatable)")
+                  << (allCovered ? "" : " (device out of range)")
+                  << (sized ? "" : " (wrong size)") << std::endl;
+        passed = passed && repeatable && allCovered && sized;
+    }
+
+    // Denser scenes give every device more networks to choose from.
+    int pairs[2];
+    for (int d = 0; d < 2; d++)
+    {
+        SceneGenerator generator(3);
+        generator.setNumDevices(300);
+        generator.setNumAccessPoints(20);
+        generator.setOverlap(d ? 6 : 1);
+        std::string scene = generator.generate();
+        HetNetModel model(scene);
+        pairs[d] = model.getNumPairs();
+    }
+    std::cout << "pairs at overlap 1: " << pairs[0] << ", at overlap 6: "
+              << pairs[1] << std::endl;
+    passed = passed && pairs[1] > 2 * pairs[0];
+
+    std::cout << (passed ? "PASSED" : "FAILED") << std::endl;
+    return passed ? 0 : 1;
+}
@@ -0,0 +1,72 @@
+// Checks that a scene solved through HetNetModel gives the same z value as
+// the dense problem string the web front-end used to build.
+
+#include "Solver.h"
+#include "HetNetModel.h"
+#include <cmath>
+#include <iostream>
+#include <sstream>
+
+int main(void)
+{
+    std::string scene = "0.5 0.5;100 100 80 1000,160 100 80 500,;"
+                        "90 110,150 95,130 130,400 400,;";
+    HetNetModel model(scene);
+    LPSolution* answer = Solver::getInstance().solve(&model);
+    std::cout << "pairs in range = " << model.getNumPairs() << std::endl;
+    std::cout << "answer error code = " << answer->getErrorCode() << std::endl;
+    std::cout << "z value: " << answer->getZValue() << std::endl;
+
+    // The same problem written out densely, as simulation.js used to.
+    int numDevices = model.getNumDevices();
+    int numAps = model.getNumAccessPoints();
+    std::vector<double> rates(numDevices * numAps, 0);
+    for (int p = 0; p < model.getNumPairs(); p++)
+    {
+        rates[model.getPairDevice(p) * numAps + model.getPairAccessPoint(p)] =
+            model.getPairRate(p);
+    }
+    std::ostringstream problem;
+    for (int i = 0; i < numDevices * numAps; i++)
+    {
+        problem << 0.5 * rates[i] << " ";
+    }
+    problem << 0.5 * model.getSumRuaMax() << ";";
+    double maxRates[] = {1000, 500};
+    for (int a = 0; a < numAps; a++)
+    {
+        for (int i = 0; i < numDevices * numAps; i++)
+        {
+            problem << ((i % numAps == a) ? rates[i] : 0) << " ";
+        }
+        problem << "0 " << maxRates[a] << ",";
+    }
+    for (int k = 0; k < numDevices * numAps; k++)
+    {
+        for (int i = 0; i < numDevices * numAps; i++)
+        {
+            problem << ((i == k) ? 1 : 0) << " ";
+        }
+        problem << "0 1,";
+    }
+    for (int u = 0; u < numDevices; u++)
+    {
+        for (int i = 0; i < numDevices * numAps; i++)
+        {
+            problem << ((i / numAps == u) ? -rates[i] : 0) << " ";
+        }
+        problem << "1 0,";
+    }
+    problem << ";;";
+    std::string problemString = problem.str();
+    LPSolution* dense = Solver::getInstance().solve(problemString);
+    std::cout << "dense z value: " << dense->getZValue() << std::endl;
+
+    bool passed = answer->getErrorCode() == LPSolution::SOLVED &&
+                  dense->getErrorCode() == LPSolution::SOLVED &&
+                  std::abs(answer->getZValue() - dense->getZValue()) < 0.001;
+    std::cout << (passed ? "PASSED" : "FAILED") << std::endl;
+    delete answer;
+    delete dense;
+    return passed ? 0 : 1;
+}
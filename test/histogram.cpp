@@ -0,0 +1,129 @@
+// Records known distributions in the load test's HdrHistogram and checks 
+// that every percentile it reports is within 3 significant digits of the
+// exact one, never below it, and that single values anywhere in the range
+// land in a sub-bucket that is within that precision of them.
+
+#include "HdrHistogram.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <vector>
+
+static const unsigned long long HIGHEST = 3600ULL * 1000 * 1000 * 1000;
+static const int DIGITS = 3;
+static const int NUM_PERCENTILES = 7;
+static const double PERCENTILES[NUM_PERCENTILES] = {0, 10, 50, 90, 99, 99.9,
+                                                    100};
+
+/**
+ * Returns true if a reported value is at or above the exact one and within
+ * one unit of its third significant digit.
+ */
+static bool close(unsigned long long reported, unsigned long long exact)
+{
+    return reported >= exact && reported - exact <= exact * 1e-3;
+}
+
+/**
+ * Records the values and checks each percentile against the value of the
+ * sorted values it names.
+ */
+static bool check(std::vector<unsigned long long>& values, const char* name)
+{
+    HdrHistogram histogram(HIGHEST, DIGITS);
+    double sum = 0;
+    for (size_t i = 0; i < values.size(); i++)
+    {
+        histogram.record(values[i]);
+        sum += values[i];
+    }
+    std::sort(values.begin(), values.end());
+
+    bool passed = histogram.getCount() == values.size() &&
+                  histogram.getMin() == values.front() &&
+                  histogram.getMax() == values.back() &&
+                  std::abs(histogram.getMean() - sum / values.size()) < 1e-6;
+    std::cout << name << ":";
+    for (int i = 0; i < NUM_PERCENTILES; i++)
+    {
+        double rank = std::ceil(PERCENTILES[i] / 100 * values.size());
+        unsigned long long exact = values[std::max(rank, 1.0) - 1];
+        unsigned long long reported =
+            histogram.valueAtPercentile(PERCENTILES[i]);
+        bool ok = close(reported, exact);
+        std::cout << " p" << PERCENTILES[i] << " " << reported
+                  << (ok ? "" : " (wrong)");
+        passed = passed && ok;
+    }
+    std::cout << std::endl;
+    return passed;
+}
+
+int main(void)
+{
+    bool passed = true;
+    srand(5);
+
+    std::vector<unsigned long long> uniform;
+    for (unsigned long long v = 1; v <= 100000; v++)
+    {
+        uniform.push_back(v);
+    }
+    passed = check(uniform, "uniform") && passed;
+
+    // Latencies in nanoseconds from 10us to about 10s, with a long tail.
+    std::vector<unsigned long long> exponential;
+    for (int i = 0; i < 200000; i++)
+    {
+        double u = (rand() + 1.0) / (RAND_MAX + 2.0);
+        exponential.push_back(10000 + (unsigned long long) 
+                              (-2e6 * std::log(u) * (1 + i % 50)));
+    }
+    passed = check(exponential, "exponential") && passed;
+
+    std::vector<unsigned long long> constant(1000, 123456789);
+    passed = check(constant, "constant") && passed;
+
+    // Each value with the highest one after it, so the median is the 
+    // value's sub-bucket rather than the exact maximum.
+    bool buckets = true;
+    for (unsigned long long v = 1; v < HIGHEST; v = v * 3 / 2 + 1)
+    {
+        HdrHistogram histogram(HIGHEST, DIGITS);
+        histogram.record(v);
+        histogram.record(HIGHEST);
+        unsigned long long reported = histogram.valueAtPercentile(50);
+        if (!close(reported, v))
+        {
+            std::cout << v << " reported as " << reported << std::endl;
+            buckets = false;
+        }
+    }
+    std::cout << "single values: " << (buckets ? "" : "wrong") << std::endl;
+    passed = passed && buckets;
+
+    // Two halves added together report as the whole.
+    HdrHistogram whole(HIGHEST, DIGITS);
+    HdrHistogram half(HIGHEST, DIGITS);
+    HdrHistogram other(HIGHEST, DIGITS);
+    for (size_t i = 0; i < exponential.size(); i++)
+    {
+        whole.record(exponential[i]);
+        (i % 2 ? half : other).record(exponential[i]);
+    }
+    half.add(other);
+    bool added = half.getCount() == whole.getCount() &&
+                 half.getMin() == whole.getMin() &&
+                 half.getMax() == whole.getMax();
+    for (int i = 0; i < NUM_PERCENTILES; i++)
+    {
+        added = added && half.valueAtPercentile(PERCENTILES[i]) ==
+                         whole.valueAtPercentile(PERCENTILES[i]);
+    }
+    std::cout << "added: " << (added ? "" : "wrong") << std::endl;
+    passed = passed && added;
+
+    std::cout << (passed ? "PASSED" : "FAILED") << std::endl;
+    return passed ? 0 : 1;
+}
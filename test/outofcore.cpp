@@ -0,0 +1,125 @@
+// Solves problems and generated scenes with every table on the heap, then
+// again with every table in a memory-mapped file split into small panels,
+// and checks that the answers are identical, that growing a mapped table
+// (as row generation does) keeps its rows, and that a table whose file
+// cannot be made falls back to the heap.
+
+#include "MappedTable.h"
+#include "SceneGenerator.h"
+#include "Simplex.h"
+#include "Solver.h"
+#include <iostream>
+
+static const int NUM_PROBLEMS = 3;
+static const char* PROBLEMS[NUM_PROBLEMS] = {"1 1;1 1 1,-1 0 -0.1,;;",
+                                             "3 1;1 0 2,0 1 3,-1 -1 -1,;;",
+                                             "2 3;1 1 4,1 3 6,;1 1 2,;"};
+static const int NUM_SCENES = 3;
+
+/**
+ * Returns true if two solutions have the same error code, z and values,
+ * bit for bit.
+ */
+static bool same(LPSolution* a, LPSolution* b)
+{
+    if (a->getErrorCode() != b->getErrorCode() ||
+        a->getZValue() != b->getZValue() ||
+        a->getNumOptimalValues() != b->getNumOptimalValues())
+    {
+        return false;
+    }
+    for (int i = 0; i < a->getNumOptimalValues(); i++)
+    {
+        if (a->getOptimalValues()[i] != b->getOptimalValues()[i])
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * Solves every problem and scene, the scenes both whole and by row
+ * generation, and appends the solutions.
+ */
+static void solveAll(std::vector<LPSolution*>& solutions)
+{
+    Solver& solver = Solver::getInstance();
+    for (int i = 0; i < NUM_PROBLEMS; i++)
+    {
+        std::string problem = PROBLEMS[i];
+        solutions.push_back(solver.solve(problem));
+    }
+    for (int i = 0; i < NUM_SCENES; i++)
+    {
+        SceneGenerator generator(i + 1);
+        generator.setNumDevices(40);
+        generator.setNumAccessPoints(5);
+        std::string scene = generator.generate();
+        HetNetModel model(scene);
+        solutions.push_back(solver.solve(&model));
+        solutions.push_back(solver.solveRowGeneration(&model));
+    }
+}
+
+int main(void)
+{
+    bool passed = true;
+
+    MappedTable file("/tmp", 10, 100, 1600);
+    bool opened = file.isOpen() && file.getPanelRows() == 2;
+    for (int i = 0; opened && i < 10; i++)
+    {
+        for (int j = 0; j < 100; j++)
+        {
+            opened = opened && file.getRows()[i][j] == 0;
+            file.getRows()[i][j] = i * 100 + j;
+        }
+    }
+    file.willNeed(8, 4);
+    opened = opened && file.getRows()[9][99] == 999;
+    MappedTable missing("/nonexistent", 10, 100, 1600);
+    bool failed = !missing.isOpen() && !missing.getError().empty();
+    std::cout << "mapped table: " << (opened ? "" : "wrong ")
+              << (failed ? "" : "opened a missing directory") << std::endl;
+    passed = passed && opened && failed;
+
+    std::vector<LPSolution*> heap;
+    solveAll(heap);
+    // Panels of a single row of most tables.
+    Simplex::setMappedStorage("/tmp", 0, 64);
+    std::vector<LPSolution*> mapped;
+    solveAll(mapped);
+    bool identical = heap.size() == mapped.size();
+    for (size_t i = 0; i < heap.size(); i++)
+    {
+        if (!same(heap[i], mapped[i]))
+        {
+            std::cout << "solution " << i << ": heap " << heap[i]->getZValue()
+                      << " mapped " << mapped[i]->getZValue() << std::endl;
+            identical = false;
+        }
+        delete heap[i];
+        delete mapped[i];
+    }
+    std::cout << "identical: " << heap.size() << " solutions"
+              << (identical ? "" : " (wrong)") << std::endl;
+    passed = passed && identical;
+
+    std::string problem = PROBLEMS[0];
+    LinearProgram* lp = Solver::getInstance().parse(problem);
+    Simplex inFile(lp);
+    Simplex::setMappedStorage("/nonexistent", 0, 64);
+    Simplex onHeap(lp);
+    LPSolution* sol = onHeap.solve();
+    bool fellBack = inFile.isTableMapped() && !onHeap.isTableMapped() &&
+                    sol->getErrorCode() == LPSolution::SOLVED;
+    std::cout << "fell back: " << (fellBack ? "" : "wrong") << std::endl;
+    passed = passed && fellBack;
+    delete sol;
+    delete lp;
+    Simplex::setMappedStorage("", 0, MappedTable::DEFAULT_PANEL_BYTES);
+
+    std::cout << (passed ? "PASSED" : "FAILED") << std::endl;
+    return passed ? 0 : 1;
+}
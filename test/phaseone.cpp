@@ -0,0 +1,103 @@
+// Solves small problems that need Phase I, with <= rows that have negative
+// right hand sides and with = rows, both built directly and parsed from the
+// string format, and compares them with answers worked out by hand.
+
+#include "Solver.h"
+#include <cmath>
+#include <iostream>
+
+/**
+ * Solves a problem and returns true if it has the expected error code and,
+ * when solved, the expected objective value and a point that satisfies
+ * every row.
+ */
+static bool check(const char* objective, const char** leq, int numLeq,
+                  const char** eq, int numEq, int errorCode, double z)
+{
+    LinearProgram lp(objective);
+    for (int i = 0; i < numLeq; i++)
+    {
+        lp.addLeqConstraint(leq[i]);
+    }
+    for (int i = 0; i < numEq; i++)
+    {
+        lp.addEqConstraint(eq[i]);
+    }
+    LPSolution* sol = Solver::getInstance().solve(&lp);
+    bool ok = sol->getErrorCode() == errorCode;
+    if (ok && errorCode == LPSolution::SOLVED)
+    {
+        ok = std::abs(sol->getZValue() - z) < 1e-6;
+        double* values = sol->getOptimalValues();
+        int numVars = sol->getNumOptimalValues();
+        for (int i = 0; i < numLeq + numEq; i++)
+        {
+            std::istringstream row(i < numLeq ? leq[i] : eq[i - numLeq]);
+            double lhs = 0, coefficient;
+            for (int j = 0; j < numVars && row >> coefficient; j++)
+            {
+                lhs += coefficient * values[j];
+            }
+            double rhs;
+            row >> rhs;
+            ok = ok && lhs <= rhs + 1e-6 && (i < numLeq || lhs >= rhs - 1e-6);
+        }
+    }
+    std::cout << objective << ": error " << sol->getErrorCode() << " z "
+              << sol->getZValue() << (ok ? "" : " (wrong)") << std::endl;
+    delete sol;
+    return ok;
+}
+
+int main(void)
+{
+    bool passed = true;
+    const char* floor[] = {"1 1 1", "-1 0 -0.1"};
+    passed = check("1 1", floor, 2, 0, 0, LPSolution::SOLVED, 1) && passed;
+    passed = check("1 2", floor, 2, 0, 0, LPSolution::SOLVED, 1.9) && passed;
+    const char* box[] = {"1 0 2", "0 1 3", "-1 -1 -1"};
+    passed = check("3 1", box, 3, 0, 0, LPSolution::SOLVED, 9) && passed;
+    const char* cover[] = {"-1 -1 -2"};
+    passed = check("-1 -1", cover, 1, 0, 0, LPSolution::SOLVED, -2) && passed;
+    // The point of the two rows is degenerate, leaving an artificial
+    // variable in the basis at the end of Phase I.
+    const char* pinned[] = {"5 10 10", "-3 -10 -10"};
+    passed = check("3 -7", pinned, 2, 0, 0, LPSolution::SOLVED, -7) && passed;
+    const char* empty[] = {"1 1 1", "-1 -1 -2"};
+    passed = check("1 1", empty, 2, 0, 0, LPSolution::INFEASIBLE, 0) &&
+             passed;
+
+    const char* bound[] = {"5 10 10", "-8 -7 6"};
+    const char* line[] = {"-3 -10 -10"};
+    passed = check("3 -7", bound, 2, line, 1, LPSolution::SOLVED, -7) &&
+             passed;
+    const char* total[] = {"1 1 1 10"};
+    const char* chain[] = {"1 -1 0 1", "0 1 -1 1"};
+    passed = check("1 1 1", total, 1, chain, 2, LPSolution::SOLVED, 10) &&
+             passed;
+    const char* sum[] = {"1 1 3", "1 -1 1"};
+    passed = check("1 0", 0, 0, sum, 2, LPSolution::SOLVED, 2) && passed;
+    const char* low[] = {"1 0 1", "0 1 1"};
+    const char* high[] = {"1 1 3"};
+    passed = check("1 2", low, 2, high, 1, LPSolution::INFEASIBLE, 0) &&
+             passed;
+
+    // The same problems in the string format: = rows follow the second ;.
+    // Relaxed to <=, the first would reach z = 0 and the second be feasible.
+    std::string strings[] = {"-1 -1;;1 1 3,;", "1 2;1 0 1,0 1 1,;1 1 3,;"};
+    int codes[] = {LPSolution::SOLVED, LPSolution::INFEASIBLE};
+    double values[] = {-3, 0};
+    for (int i = 0; i < 2; i++)
+    {
+        LPSolution* sol = Solver::getInstance().solve(strings[i]);
+        bool ok = sol->getErrorCode() == codes[i] &&
+                  std::abs(sol->getZValue() - values[i]) < 1e-6;
+        std::cout << strings[i] << ": error " << sol->getErrorCode() << " z "
+                  << sol->getZValue() << (ok ? "" : " (wrong)") << std::endl;
+        passed = passed && ok;
+        delete sol;
+    }
+
+    std::cout << (passed ? "PASSED" : "FAILED") << std::endl;
+    return passed ? 0 : 1;
+}
@@ -0,0 +1,118 @@
+// Solves scenes with lazily generated fairness rows and checks that the
+// solution satisfies every row of the whole problem with the same 
+// objective value, while carrying only the fairness rows that bind at the
+// optimum, and only a fraction of them in spread out scenes.
+
+#include "Solver.h"
+#include "RowGeneration.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <vector>
+
+// Checks every row of the scene's problem against a solution, the 
+// fairness rows z <= sum_a(r_ua) included.
+static bool feasible(HetNetModel& model, LPSolution* sol)
+{
+    SparseLP lp;
+    model.buildLP(&lp);
+    double* values = sol->getOptimalValues();
+    if (!values || sol->getNumOptimalValues() != lp.getNumVars())
+    {
+        return false;
+    }
+    for (int row = 0; row < lp.getNumRows(); row++)
+    {
+        double sum = 0;
+        for (int i = lp.getRowStart(row); i < lp.getRowEnd(row); i++)
+        {
+            sum += lp.getValue(i) * values[lp.getColIndex(i)];
+        }
+        if (sum > lp.getRhs(row) + 0.01)
+        {
+            return false;
+        }
+    }
+    for (int j = 0; j < lp.getNumVars(); j++)
+    {
+        if (values[j] < -0.01)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+// Counts the devices whose rate is at z in a solution of the whole 
+// problem, whose fairness rows bind.
+static int countBinding(HetNetModel& model, LPSolution* sol)
+{
+    int numPairs = model.getNumPairs();
+    double* values = sol->getOptimalValues();
+    std::vector<double> rate(model.getNumDevices(), 0);
+    for (int p = 0; p < numPairs; p++)
+    {
+        rate[model.getPairDevice(p)] += values[p];
+    }
+    int binding = 0;
+    for (size_t u = 0; u < rate.size(); u++)
+    {
+        binding += rate[u] - values[numPairs] <= 0.01;
+    }
+    return binding;
+}
+
+int main(void)
+{
+    srand(13);
+    bool passed = true;
+    for (int trial = 0; trial < 5; trial++)
+    {
+        HetNetModel model;
+        model.setAlpha(0.25 * trial);
+        model.setBeta(1 - 0.25 * trial);
+        // Crowd the scene in odd trials, so more fairness rows bind.
+        int area = (trial % 2) ? 300 : 800;
+        for (int a = 0; a < 50; a++)
+        {
+            model.addAccessPoint(rand() % area, rand() % area, 100 + rand() % 50,
+                                 300 + rand() % 1200);
+        }
+        for (int u = 0; u < 80; u++)
+        {
+            model.addDevice(rand() % area, rand() % area);
+        }
+
+        LPSolution* whole = Solver::getInstance().solve(&model);
+
+        // The whole problem has a fairness row per device. Generation 
+        // should carry no row that is slack at the optimum besides the one
+        // it starts with, and few bind in the spread out scenes, so there 
+        // it must carry only a fraction.
+        int maxRows = std::max(countBinding(model, whole), 1);
+        if (trial % 2 == 0)
+        {
+            maxRows = std::min(maxRows, model.getNumDevices() / 4);
+        }
+
+        RowGeneration generation(&model);
+        LPSolution* generated = generation.solve();
+        std::cout << "whole " << whole->getZValue() << " generated "
+                  << generated->getZValue() << " using "
+                  << generation.getNumActiveRows() << " fairness rows of "
+                  << model.getNumDevices() << " (at most " << maxRows 
+                  << ") in " << generation.getNumRounds() << " rounds"
+                  << std::endl;
+
+        passed = passed && whole->getErrorCode() == LPSolution::SOLVED &&
+                 generated->getErrorCode() == LPSolution::SOLVED &&
+                 std::abs(whole->getZValue() - generated->getZValue()) < 0.01 &&
+                 feasible(model, generated) &&
+                 generation.getNumActiveRows() <= maxRows;
+        delete whole;
+        delete generated;
+    }
+    std::cout << (passed ? "PASSED" : "FAILED") << std::endl;
+    return passed ? 0 : 1;
+}
@@ -0,0 +1,192 @@
+// Solves generated scenes, with and without a floor on z that needs Phase I,
+// and small problems with = rows, with every instantiation of BasicSimplex,
+// and checks that each finds the objective value Simplex finds, to the
+// precision of its scalar type, and tells infeasible and unbounded problems
+// apart. Also checks that the Solver runs the instantiation setScalar()
+// chooses, on scenes and problem strings, with its table size predicted, 
+// and refuses to pair one with a gap tolerance or crash start.
+
+#include "BasicSimplex.h"
+#include "SceneGenerator.h"
+#include "Simplex.h"
+#include "Solver.h"
+#include <cmath>
+#include <iostream>
+
+static const int NUM_SCENES = 4;
+static const int NUM_SCALARS = 3;
+static const char* SCALARS[NUM_SCALARS] = {"float", "double", "long double"};
+/** The relative error allowed for each scalar type. */
+static const double TOLERANCE[NUM_SCALARS] = {1e-3, 1e-7, 1e-7};
+
+/**
+ * Solves a problem with every instantiation and returns true if each one
+ * ends with the same error code as Simplex and, if SOLVED, the same z to
+ * within its tolerance.
+ */
+static bool compare(SparseLP& lp, const char* name)
+{
+    Simplex simplex(&lp);
+    LPSolution* expected = simplex.solve();
+    bool passed = true;
+    for (int scalar = 0; scalar < NUM_SCALARS; scalar++)
+    {
+        for (int pricing = 0; pricing < 2; pricing++)
+        {
+            for (int ratioTest = 0; ratioTest < 2; ratioTest++)
+            {
+                Solve* solve = SimplexVariant::create(&lp, scalar, pricing,
+                                                      ratioTest, 0);
+                LPSolution* sol = solve->solve();
+                double z = expected->getZValue();
+                bool same = sol->getErrorCode() == expected->getErrorCode() &&
+                            (sol->getErrorCode() != LPSolution::SOLVED ||
+                             std::abs(sol->getZValue() - z) <=
+                             TOLERANCE[scalar] * (1 + std::abs(z)));
+                if (!same)
+                {
+                    std::cout << name << " " << SCALARS[scalar] << " "
+                              << sol->getStats().getPricing() << " "
+                              << sol->getStats().getRatioTest() << ": "
+                              << sol->getErrorCode() << " z = "
+                              << sol->getZValue() << ", expected "
+                              << expected->getErrorCode() << " z = " << z
+                              << std::endl;
+                }
+                passed = passed && same;
+                delete sol;
+                delete solve;
+            }
+        }
+    }
+    std::cout << name << ": z = " << expected->getZValue()
+              << (passed ? "" : " (wrong)") << std::endl;
+    delete expected;
+    return passed;
+}
+
+int main(void)
+{
+    bool passed = true;
+    for (int i = 0; i < NUM_SCENES; i++)
+    {
+        SceneGenerator generator(i + 11);
+        generator.setNumDevices(30 + 10 * i);
+        generator.setNumAccessPoints(4 + i);
+        std::string scene = generator.generate();
+        HetNetModel model(scene);
+        SparseLP lp;
+        model.buildLP(&lp);
+        passed = compare(lp, "scene") && passed;
+
+        // A floor on z, the last column, at half of its optimal value makes
+        // the slack basis infeasible.
+        Simplex simplex(&lp);
+        LPSolution* sol = simplex.solve();
+        int zCol = lp.getNumVars() - 1;
+        lp.addRow(SparseLP::LEQ, -sol->getOptimalValues()[zCol] / 2);
+        lp.addCoefficient(zCol, -1);
+        delete sol;
+        passed = compare(lp, "floored scene") && passed;
+    }
+
+    // max 2x + 3y with x + y = 2, x + 3y <= 6: x = y = 1.
+    SparseLP equality;
+    equality.clear(2);
+    equality.setObjective(0, 2);
+    equality.setObjective(1, 3);
+    equality.addRow(SparseLP::EQ, 2);
+    equality.addCoefficient(0, 1);
+    equality.addCoefficient(1, 1);
+    equality.addRow(SparseLP::LEQ, 6);
+    equality.addCoefficient(0, 1);
+    equality.addCoefficient(1, 3);
+    passed = compare(equality, "equality") && passed;
+
+    // x + y <= 1 with x + y >= 2.
+    SparseLP infeasible;
+    infeasible.clear(2);
+    infeasible.setObjective(0, 1);
+    infeasible.addRow(SparseLP::LEQ, 1);
+    infeasible.addCoefficient(0, 1);
+    infeasible.addCoefficient(1, 1);
+    infeasible.addRow(SparseLP::LEQ, -2);
+    infeasible.addCoefficient(0, -1);
+    infeasible.addCoefficient(1, -1);
+    passed = compare(infeasible, "infeasible") && passed;
+
+    // max x with x - y <= 1.
+    SparseLP unbounded;
+    unbounded.clear(2);
+    unbounded.setObjective(0, 1);
+    unbounded.addRow(SparseLP::LEQ, 1);
+    unbounded.addCoefficient(0, 1);
+    unbounded.addCoefficient(1, -1);
+    passed = compare(unbounded, "unbounded") && passed;
+
+    Solver& solver = Solver::getInstance();
+    SceneGenerator generator(7);
+    generator.setNumDevices(40);
+    generator.setNumAccessPoints(5);
+    std::string scene = generator.generate();
+    HetNetModel model(scene);
+    std::string problem = "2 3;1 3 6,;1 1 2,;";
+    LPSolution* expectedScene = solver.solve(&model);
+    LPSolution* expectedProblem = solver.solve(problem);
+    bool chosen = true;
+    for (int scalar = 0; scalar < NUM_SCALARS; scalar++)
+    {
+        solver.setScalar(scalar, SimplexVariant::BLAND,
+                         SimplexVariant::TEXTBOOK);
+        LPSolution* sols[2] = {solver.solve(&model), solver.solve(problem)};
+        LPSolution* expected[2] = {expectedScene, expectedProblem};
+        for (int i = 0; i < 2; i++)
+        {
+            SolveStats& stats = sols[i]->getStats();
+            double z = expected[i]->getZValue();
+            bool ran = sols[i]->getErrorCode() == LPSolution::SOLVED &&
+                       stats.getEngine() == std::string("simplex ") +
+                                            SCALARS[scalar] &&
+                       stats.getPricing() == "bland" &&
+                       stats.getRatioTest() == "textbook" &&
+                       stats.getPredictedTableBytes() ==
+                       stats.getPeakTableBytes() &&
+                       std::abs(sols[i]->getZValue() - z) <=
+                       TOLERANCE[scalar] * (1 + std::abs(z));
+            if (!ran)
+            {
+                std::cout << "solver " << SCALARS[scalar] << " "
+                          << (i ? "problem" : "scene") << ": "
+                          << stats.toJson() << std::endl;
+            }
+            chosen = chosen && ran;
+            delete sols[i];
+        }
+    }
+    // A BasicSimplex can neither stop at a gap nor crash a basis.
+    bool refused = !solver.setGapTolerance(0.01) &&
+                   !solver.setCrashStart(true) &&
+                   solver.setGapTolerance(0) && solver.setCrashStart(false);
+    solver.setScalar(-1, 0, 0);
+    refused = refused && solver.setGapTolerance(0.01) &&
+              !solver.setScalar(SimplexVariant::DOUBLE,
+                                SimplexVariant::DANTZIG,
+                                SimplexVariant::TEXTBOOK);
+    solver.setGapTolerance(0);
+    refused = refused && solver.setCrashStart(true) &&
+              !solver.setScalar(SimplexVariant::DOUBLE,
+                                SimplexVariant::DANTZIG,
+                                SimplexVariant::TEXTBOOK);
+    solver.setCrashStart(false);
+    chosen = chosen && refused;
+    LPSolution* reset = solver.solve(problem);
+    chosen = chosen && reset->getStats().getEngine() == "simplex";
+    delete reset;
+    delete expectedScene;
+    delete expectedProblem;
+    std::cout << "solver: " << (chosen ? "" : "(wrong)") << std::endl;
+    passed = passed && chosen;
+
+    std::cout << (passed ? "PASSED" : "FAILED") << std::endl;
+    return passed ? 0 : 1;
+}
@@ -0,0 +1,117 @@
+// Checks the sensitivity analysis of a scene against solving it again with
+// a changed capacity or cost: within its range, a dual value must predict
+// the change of the objective, and a cost change must leave the solution
+// where it was.
+
+#include "Solver.h"
+#include "Simplex.h"
+#include "HetNetModel.h"
+#include <cfloat>
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+
+// Solves lp with the right hand side of one row, or the cost of one
+// variable, replaced.
+LPSolution* resolve(SparseLP& lp, int row, double rhs, int var, double cost)
+{
+    Simplex simplex(&lp);
+    LPSolution* sol = simplex.solve();
+    delete sol;
+    if (row >= 0)
+    {
+        simplex.changeRhs(row, rhs);
+    }
+    if (var >= 0)
+    {
+        simplex.changeObjective(var, cost);
+    }
+    return simplex.reoptimize();
+}
+
+bool close(double a, double b)
+{
+    return std::abs(a - b) <= 0.001 * (1 + std::abs(a));
+}
+
+int main(void)
+{
+    srand(3);
+    HetNetModel model;
+    for (int a = 0; a < 8; a++)
+    {
+        model.addAccessPoint(rand() % 400, rand() % 400, 100 + rand() % 150,
+                             100 + rand() % 900);
+    }
+    for (int u = 0; u < 40; u++)
+    {
+        model.addDevice(rand() % 400, rand() % 400);
+    }
+    model.setAlpha(0.3);
+    model.setBeta(0.7);
+    SparseLP lp;
+    model.buildLP(&lp);
+
+    LPSolution* sol = Solver::getInstance().solveSensitivity(&model);
+    bool passed = sol->getErrorCode() == LPSolution::SOLVED &&
+                  sol->hasSensitivity() &&
+                  (int) sol->getDuals().size() == lp.getNumRows() &&
+                  (int) sol->getReducedCosts().size() == lp.getNumVars();
+    double z = sol->getZValue();
+
+    // Capacity rows: move each r_a,max halfway to each end of its range.
+    int bottleneck = 0;
+    for (int a = 0; a < model.getNumAccessPoints() && passed; a++)
+    {
+        double rhs = lp.getRhs(a);
+        double dual = sol->getDuals()[a];
+        double ends[] = {std::max(sol->getRhsLower()[a], 0.0),
+                         std::min(sol->getRhsUpper()[a], rhs + 1000)};
+        passed = passed && dual >= -0.001 && ends[0] <= rhs + 0.001 &&
+                 ends[1] >= rhs - 0.001;
+        for (int e = 0; e < 2; e++)
+        {
+            double moved = (rhs + ends[e]) / 2;
+            LPSolution* changed = resolve(lp, a, moved, -1, 0);
+            if (!close(changed->getZValue(), z + dual * (moved - rhs)))
+            {
+                std::cout << "ap " << a << ": dual " << dual << " predicts "
+                          << z + dual * (moved - rhs) << ", solved "
+                          << changed->getZValue() << std::endl;
+                passed = false;
+            }
+            delete changed;
+        }
+        if (dual > sol->getDuals()[bottleneck])
+        {
+            bottleneck = a;
+        }
+    }
+    std::cout << "most valuable capacity: access point " << bottleneck
+              << ", dual " << sol->getDuals()[bottleneck] << std::endl;
+
+    // Costs: inside its range a variable's cost can change without moving
+    // the solution.
+    for (int var = 0; var < lp.getNumVars() && passed; var += 7)
+    {
+        double cost = lp.getObjective(var);
+        double lower = std::max(sol->getCostLower()[var], cost - 100);
+        double upper = std::min(sol->getCostUpper()[var], cost + 100);
+        passed = passed && lower <= cost + 0.001 && upper >= cost - 0.001 &&
+                 sol->getReducedCosts()[var] <= 0.001;
+        double moved = (cost + (var % 2 ? lower : upper)) / 2;
+        LPSolution* changed = resolve(lp, -1, 0, var, moved);
+        double x = sol->getOptimalValues()[var];
+        if (!close(changed->getZValue(), z + (moved - cost) * x))
+        {
+            std::cout << "variable " << var << ": cost " << cost << " -> " 
+                      << moved << " gave " << changed->getZValue()
+                      << ", expected " << z + (moved - cost) * x << std::endl;
+            passed = false;
+        }
+        delete changed;
+    }
+    delete sol;
+    std::cout << (passed ? "PASSED" : "FAILED") << std::endl;
+    return passed ? 0 : 1;
+}
@@ -0,0 +1,87 @@
+// Checks the statistics each solve reports: pivots of each phase adding up
+// to the total, the shape of the table, its memory, the engine, and the 
+// status and gap the interface adds.
+
+#include "Simplex.h"
+#include "Solver.h"
+#include "SceneGenerator.h"
+#include <iostream>
+#include <sstream>
+
+int main(void)
+{
+    bool passed = true;
+
+    // Two rows and two variables that need Phase I.
+    std::string problem = "1 1;1 1 1,-1 0 -0.1,;;";
+    LPSolution* sol = Solver::getInstance().solve(problem);
+    SolveStats& stats = sol->getStats();
+    bool phases = stats.getEngine() == "simplex" &&
+                  stats.getPricing() == "dantzig" &&
+                  stats.getRatioTest() == "harris" &&
+                  stats.getNumRows() == 2 && stats.getNumColumns() == 4 &&
+                  stats.getPhaseOneIterations() > 0 &&
+                  stats.getPhaseTwoIterations() > 0 &&
+                  stats.getParseTime() > 0 && stats.getBuildTime() > 0 &&
+                  stats.getPeakTableBytes() > 3 * (5 * sizeof(double)) &&
+                  stats.toJson().find("\"phaseOneIterations\": ") !=
+                      std::string::npos;
+    std::cout << stats.toJson() << std::endl;
+    passed = passed && phases;
+    delete sol;
+
+    SceneGenerator generator(42);
+    generator.setNumDevices(60);
+    generator.setNumAccessPoints(6);
+    std::string scene = generator.generate();
+    HetNetModel model(scene);
+    SparseLP lp;
+    model.buildLP(&lp);
+
+    Simplex simplex(&lp);
+    sol = simplex.solve();
+    SolveStats& plain = sol->getStats();
+    bool counted = plain.getPhaseOneIterations() == 0 &&
+                   plain.getPhaseTwoIterations() == simplex.getIterations() &&
+                   plain.getDegeneratePivots() ==
+                       simplex.getDegeneratePivots() &&
+                   plain.getNumRows() == lp.getNumRows() &&
+                   plain.getNumColumns() == lp.getNumVars() + lp.getNumRows();
+    std::cout << plain.toJson() << std::endl;
+    passed = passed && counted;
+    delete sol;
+
+    const char* engines[4] = {"simplex", "crashed simplex", "flow",
+                              "row generation"};
+    for (int e = 0; e < 4; e++)
+    {
+        Solver::getInstance().setCrashStart(e == 1);
+        sol = e <= 1 ? Solver::getInstance().solve(&model) :
+              e == 2 ? Solver::getInstance().solveFlow(&model) :
+                       Solver::getInstance().solveRowGeneration(&model);
+        bool named = sol->getStats().getEngine() == engines[e] &&
+                     sol->getStats().getTotalTime() > 0;
+        std::cout << engines[e] << ": " << sol->getStats().getTotalTime()
+                  << " s" << (named ? "" : " (wrong)") << std::endl;
+        passed = passed && named;
+        delete sol;
+    }
+
+    // The interface copies the outcome in before writing the JSON.
+    Solver::getInstance().setGapTolerance(0.5);
+    sol = Solver::getInstance().solve(&model);
+    Solver::getInstance().setGapTolerance(0);
+    sol->getStats().setResult(sol->getErrorCode(), sol->getGap());
+    std::ostringstream expected;
+    expected << "{\"status\": 0, \"gap\": " << sol->getGap() << ", ";
+    bool outcome = sol->getErrorCode() == LPSolution::SOLVED &&
+                   sol->getGap() > 0 && sol->getGap() <= 0.5 &&
+                   sol->getStats().getGap() == sol->getGap() &&
+                   sol->getStats().toJson().find(expected.str()) == 0;
+    std::cout << sol->getStats().toJson() << std::endl;
+    passed = passed && outcome;
+    delete sol;
+
+    std::cout << (passed ? "PASSED" : "FAILED") << std::endl;
+    return passed ? 0 : 1;
+}
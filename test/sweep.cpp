@@ -0,0 +1,92 @@
+// Sweeps a random scene over density, scale, alpha and beta on several
+// threads, reads the sweep file back and checks every row against solving
+// the same point from scratch.
+
+#include "Solver.h"
+#include "Sweep.h"
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+
+int main(void)
+{
+    srand(7);
+    HetNetModel scene;
+    for (int a = 0; a < 6; a++)
+    {
+        scene.addAccessPoint(rand() % 300, rand() % 300, 80 + rand() % 120,
+                             200 + rand() % 1000);
+    }
+    for (int u = 0; u < 30; u++)
+    {
+        scene.addDevice(rand() % 300, rand() % 300);
+    }
+
+    Sweep sweep(&scene);
+    sweep.setDensities(0.5, 1, 2);
+    sweep.setScales(0.5, 2, 4);
+    sweep.setAlphas(0, 1, 3);
+    sweep.setBetas(0, 1, 5);
+    std::vector<int> scaled;
+    scaled.push_back(0);
+    scaled.push_back(3);
+    sweep.setScaledAccessPoints(scaled);
+
+    // Consecutive points of the snake order differ in one parameter.
+    bool passed = true;
+    std::vector<bool> seen(sweep.getNumPoints(), false);
+    int last[4] = {0, 0, 0, 0};
+    for (int order = 0; order < sweep.getNumPoints(); order++)
+    {
+        int point[4];
+        int index = sweep.getPoint(order, point[0], point[1], point[2],
+                                   point[3]);
+        int changed = 0;
+        for (int i = 0; i < 4; i++)
+        {
+            changed += std::abs(point[i] - last[i]);
+            last[i] = point[i];
+        }
+        passed = passed && !seen[index] && changed == (order > 0 ? 1 : 0);
+        seen[index] = true;
+    }
+    std::cout << "snake order " << (passed ? "ok" : "broken") << std::endl;
+
+    std::string path = "/tmp/hetnet_sweep.bin";
+    int solved = sweep.run(path, 4);
+    std::vector<std::string> names;
+    std::vector<std::vector<double> > columns;
+    passed = passed && solved == sweep.getNumPoints() &&
+             SweepWriter::read(path, names, columns) &&
+             (int) names.size() == Sweep::NUM_COLUMNS &&
+             (int) columns[0].size() == solved;
+    std::cout << "points solved = " << solved << std::endl;
+
+    int warm = 0;
+    for (size_t r = 0; passed && r < columns[0].size(); r++)
+    {
+        int point = columns[0][r];
+        int b = point % 5, a = (point / 5) % 3, s = (point / 15) % 4,
+            d = point / 60;
+        HetNetModel model;
+        sweep.buildScene(sweep.getDensity(d), sweep.getScale(s), &model);
+        model.setAlpha(sweep.getAlpha(a));
+        model.setBeta(sweep.getBeta(b));
+        LPSolution* direct = Solver::getInstance().solve(&model);
+        if (columns[6][r] != LPSolution::SOLVED ||
+            columns[5][r] != model.getNumDevices() ||
+            std::abs(columns[7][r] - direct->getZValue()) >
+                0.001 * (1 + std::abs(direct->getZValue())))
+        {
+            std::cout << "point " << point << ": sweep " << columns[7][r]
+                      << " direct " << direct->getZValue() << std::endl;
+            passed = false;
+        }
+        warm += (columns[10][r] != 0);
+        delete direct;
+    }
+    std::cout << "reoptimized points = " << warm << std::endl;
+    passed = passed && warm > solved / 2;
+    std::cout << (passed ? "PASSED" : "FAILED") << std::endl;
+    return passed ? 0 : 1;
+}
@@ -3,7 +3,6 @@
 
 int main(void)
 {
-    std::io
     LinearProgram* pTestProblem = new LinearProgram("5 4 3");
     pTestProblem->addLeqConstraint("2 3 1 5");
     pTestProblem->addLeqConstraint("4 1 2 11");
@@ -17,6 +16,7 @@ int main(void)
     std::cout << "answer values: " << answervals[1] << std::endl; 
     std::cout << "answer values: " << answervals[2] << std::endl; 
     }
+    delete answer;
     delete pTestProblem;
     return 0;
 }
@@ -0,0 +1,124 @@
+// Writes a mobility trace as CSV, converts it to the binary format, and 
+// checks that both read back as the ticks that were written, that 
+// solving the trace while reading it matches solving it from memory, and
+// that moves of devices the scene does not have are rejected.
+
+#include "DynamicSimulation.h"
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+
+static bool sameTicks(TraceReader& reader, std::vector<Tick>& ticks)
+{
+    Tick tick;
+    size_t count = 0;
+    while (reader.readTick(tick))
+    {
+        if (count == ticks.size())
+        {
+            return false;
+        }
+        Tick& expected = ticks[count++];
+        if (tick.time != expected.time ||
+            tick.devices != expected.devices || tick.x != expected.x ||
+            tick.y != expected.y)
+        {
+            return false;
+        }
+    }
+    return !reader.hasError() && count == ticks.size();
+}
+
+static void collectZ(Tick& tick, LPSolution* sol, void* data)
+{
+    ((std::vector<double>*) data)->push_back(sol->getZValue());
+}
+
+int main(void)
+{
+    srand(11);
+    HetNetModel model;
+    model.setAlpha(0.5);
+    model.setBeta(0.5);
+    for (int a = 0; a < 5; a++)
+    {
+        model.addAccessPoint(rand() % 300, rand() % 300, 100 + rand() % 60,
+                             500 + rand() % 500);
+    }
+    for (int u = 0; u < 20; u++)
+    {
+        model.addDevice(rand() % 300, rand() % 300);
+    }
+
+    // Positions are multiples of 1/4, which print exactly.
+    std::vector<Tick> ticks;
+    FILE* csv = fopen("trace_test.csv", "w");
+    fprintf(csv, "time,device,x,y\n");
+    for (int t = 0; t < 30; t++)
+    {
+        Tick tick(t * 0.5);
+        for (int u = rand() % 3; u < 20; u += 1 + rand() % 4)
+        {
+            tick.addMove(u, (rand() % 1200) / 4.0, (rand() % 1200) / 4.0);
+            fprintf(csv, "%g,%d,%g,%g\n", tick.time, u, tick.x.back(),
+                    tick.y.back());
+        }
+        ticks.push_back(tick);
+    }
+    fclose(csv);
+
+    // A small buffer makes lines and records straddle refills.
+    TraceReader csvReader(40);
+    bool passed = csvReader.open("trace_test.csv") && !csvReader.isBinary() &&
+                  sameTicks(csvReader, ticks);
+    std::cout << "CSV trace read back: " << passed << std::endl;
+
+    passed = passed && TraceReader::convertToBinary("trace_test.csv",
+                                                    "trace_test.bin");
+    TraceReader binaryReader(40);
+    passed = passed && binaryReader.open("trace_test.bin") &&
+             binaryReader.isBinary() && sameTicks(binaryReader, ticks);
+    std::cout << "binary trace read back: " << passed << std::endl;
+
+    std::vector<LPSolution*> expected = DynamicSimulation::run(&model, ticks, 1);
+    std::vector<double> streamed;
+    HetNetModel streamModel(model);
+    DynamicSimulation simulation(&streamModel);
+    binaryReader.open("trace_test.bin");
+    int numTicks = simulation.runTrace(&binaryReader, collectZ, &streamed, 2);
+    passed = passed && numTicks == (int) ticks.size();
+    for (size_t t = 0; t < expected.size(); t++)
+    {
+        passed = passed && t < streamed.size() &&
+                 std::abs(expected[t]->getZValue() - streamed[t]) < 0.01;
+        delete expected[t];
+    }
+    std::cout << "streamed ticks solved: " << numTicks << std::endl;
+
+    // Device 20 is one past the last; the trace stops at its record, which
+    // like any malformed record also drops the tick being read before it.
+    csv = fopen("trace_test.csv", "w");
+    fprintf(csv, "0,3,10,10\n1,20,10,10\n2,4,10,10\n");
+    fclose(csv);
+    TraceReader::convertToBinary("trace_test.csv", "trace_test.bin");
+    std::vector<double> rejected;
+    TraceReader badReader;
+    badReader.open("trace_test.bin");
+    numTicks = simulation.runTrace(&badReader, collectZ, &rejected, 2);
+    bool stopped = numTicks == 0 && badReader.hasError();
+    Tick bad(0);
+    bad.addMove(-1, 10, 10);
+    bad.addMove(20, 10, 10);
+    bad.addMove(5, 10, 10);
+    stopped = stopped && !simulation.applyTick(bad) &&
+              streamModel.getDeviceX(5) == 10 &&
+              !streamModel.moveDevice(1 << 30, 0, 0);
+    std::cout << "bad device ids rejected: " << stopped << std::endl;
+    passed = passed && stopped;
+
+    remove("trace_test.csv");
+    remove("trace_test.bin");
+    std::cout << (passed ? "PASSED" : "FAILED") << std::endl;
+    return passed ? 0 : 1;
+}
@@ -0,0 +1,136 @@
+// Checks the trace buffers: a full ring keeps only its newest events,
+// threads record apart, clear() forgets, and the export is a Chrome trace.
+// Built with TRACE= -DSOLVER_TRACE it also checks the events of solves:
+//
+// make test TESTFILE=test/tracepoints.cpp TRACE=-DSOLVER_TRACE
+
+#include "Trace.h"
+#include "Solver.h"
+#include "ClusterDecomposition.h"
+#include "SceneGenerator.h"
+#include <iostream>
+#include <set>
+#include <thread>
+
+/**
+ * Records one more event than a ring holds, each carrying its number.
+ */
+static void fill()
+{
+    for (unsigned long long i = 0; i <= TraceBuffer::CAPACITY; i++)
+    {
+        TraceScope scope("fill", "i", i);
+    }
+}
+
+/**
+ * Returns the number of events with a name.
+ */
+static int countEvents(std::vector<TraceEvent>& events, std::string name)
+{
+    int count = 0;
+    for (size_t i = 0; i < events.size(); i++)
+    {
+        count += (name == events[i].name);
+    }
+    return count;
+}
+
+int main(void)
+{
+    bool passed = true;
+
+    // The main thread takes over the buffer the filler left behind, so its
+    // event overwrites the oldest one still kept.
+    Trace::clear();
+    std::thread filler(fill);
+    filler.join();
+    {
+        TraceScope scope("main");
+    }
+    std::vector<TraceEvent> events = Trace::getEvents();
+    bool ring = countEvents(events, "fill") ==
+                    (int)TraceBuffer::CAPACITY - 1 &&
+                countEvents(events, "main") == 1 &&
+                events.front().args[0] == 2 &&
+                events.back().name == std::string("main") &&
+                events.front().thread != events.back().thread;
+    for (size_t i = 1; i < events.size(); i++)
+    {
+        ring = ring && events[i - 1].begin <= events[i].begin;
+    }
+    std::string json = Trace::toJson();
+    ring = ring && json.find("\"traceEvents\": [") != std::string::npos &&
+           json.find("\"ph\": \"X\"") != std::string::npos &&
+           json.find("\"args\": {\"i\": 2}") != std::string::npos &&
+           json.find("\"thread_name\"") != std::string::npos;
+    std::cout << "ring: " << events.size() << " events "
+              << (ring ? "" : "(wrong)") << std::endl;
+    passed = passed && ring;
+
+    // The main thread still holds that buffer, so a new one is made.
+    Trace::clear();
+    passed = passed && Trace::getEvents().empty();
+    std::thread refiller(fill);
+    refiller.join();
+    events = Trace::getEvents();
+    bool cleared = countEvents(events, "fill") ==
+                       (int)TraceBuffer::CAPACITY &&
+                   events.front().args[0] == 1;
+    std::cout << "cleared: " << (cleared ? "" : "(wrong)") << std::endl;
+    passed = passed && cleared;
+
+    SceneGenerator generator(7);
+    generator.setNumDevices(80);
+    generator.setNumAccessPoints(12);
+    generator.setOverlap(0.3);
+    std::string scene = generator.generate();
+    HetNetModel model(scene);
+    Trace::clear();
+    LPSolution* sol = Solver::getInstance().solve(&model);
+    events = Trace::getEvents();
+    unsigned long long pivots = sol->getStats().getPhaseOneIterations() +
+                                sol->getStats().getPhaseTwoIterations();
+    delete sol;
+#ifdef SOLVER_TRACE
+    // Every pivot of the solve is one event inside the solve's own.
+    bool solve = countEvents(events, "Solver::solve") == 1 &&
+                 countEvents(events, "optimize") >= 1 &&
+                 countEvents(events, "pivot") >= (int)pivots &&
+                 events.front().name == std::string("Solver::solve");
+    for (size_t i = 1; i < events.size(); i++)
+    {
+        solve = solve && events[i].begin + events[i].duration <=
+                         events[0].begin + events[0].duration;
+    }
+#else
+    bool solve = events.empty();
+#endif
+    std::cout << "solve: " << events.size() << " events, " << pivots
+              << " pivots " << (solve ? "" : "(wrong)") << std::endl;
+    passed = passed && solve;
+
+    ClusterDecomposition decomposition(&model);
+    Trace::clear();
+    sol = Solver::getInstance().solveClusters(&model,
+                                              ClusterDecomposition::EXACT, 4);
+    events = Trace::getEvents();
+    delete sol;
+    std::set<int> threads;
+    for (size_t i = 0; i < events.size(); i++)
+    {
+        threads.insert(events[i].thread);
+    }
+#ifdef SOLVER_TRACE
+    bool clusters = decomposition.getNumClusters() < 2 || threads.size() > 1;
+#else
+    bool clusters = events.empty();
+#endif
+    std::cout << "clusters: " << decomposition.getNumClusters()
+              << " clusters on " << threads.size() << " threads "
+              << (clusters ? "" : "(wrong)") << std::endl;
+    passed = passed && clusters;
+
+    std::cout << (passed ? "PASSED" : "FAILED") << std::endl;
+    return passed ? 0 : 1;
+}
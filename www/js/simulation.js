@@ -39,6 +39,7 @@ var sumRuaMax; // sum of the max achievable rates for every device-network pair
 var simData; // holds r_ua,max values for each device-network pair
 var numDevices; // these are useful when formulating the optimization problem,
 var numNetworks; // and making sense of the answer that's returned.
+var solutionPath; // the solution for every beta, once the scene is optimized
 
 // constants
 var TRANSITION_DURATION = 500; // # of ms elements take to fade in or out
@@ -357,6 +358,7 @@ function modeOptimize()
 {
     $('#optimization').show();
     gatherData();
+    solutionPath = null; // the scene may have changed since it was optimized
     updateParams();
 }
 
@@ -619,140 +621,126 @@ function updateParams()
    alpha = (1 - Number(beta)).toFixed(2);
    $('#fairnessVal').html("Fairness Weight: " + beta);
    $('#throughputVal').html("Throughput Weight: " + alpha);
+   if (solutionPath)
+   {
+       showPathSolution();
+   }
 }
 
 
 /*
- * optimize uses the values of alpha and beta, and the data in simData to 
- * form a linear programming problem to optimize the system. Then it calls 
- * the LPSolver written in C++ using a shared library available to PHP on
- * the server side. The format for the problem passed to the solver is: 
- * "objeqn;ineq,ineq,;eq,eq,;" where equations are numbers (coefficients) 
- * separated by spaces.
+ * showPathSolution looks up the solution for the current beta in the
+ * solution path returned by the server and displays it, so moving the
+ * slider after optimizing needs no further requests.
  */
-function optimize()
+function showPathSolution()
 {
-    var problemFormulation = "";
-    numDevices = Object.keys(simData).length; // not always equal to deviceID
-    if (numDevices == 0)
+    var b = Number(beta);
+    for (var i = 0; i < solutionPath.length; i++)
     {
-        alert("Please add networks and devices before attempting to optimize "
-            + "the system.");
-        return;
+        var interval = solutionPath[i];
+        if (b <= interval.end || i == solutionPath.length - 1)
+        {
+            // the objective value is linear over the interval
+            var t = (interval.end > interval.start) ?
+                    (b - interval.start) / (interval.end - interval.start) : 0;
+            var z = interval.objStart + t * (interval.objEnd - interval.objStart);
+            visualSolution("z value: " + z + " <br /> answer values: "
+                         + interval.values + "\n");
+            animateTextBoxes();
+            return;
+        }
     }
+}
+
 
-    // formulate the objective equation, alpha * sum(r_u) + beta * sum(r_ua,max) * z
-    var objEqn = "";
-    for (var device in simData)
+/*
+ * parsePath reads the solution path returned by the server: one line per 
+ * interval of beta, "start end;objStart objEnd;values".
+ */
+function parsePath(answer)
+{
+    var path = [];
+    var lines = answer.split("\n");
+    for (var i = 0; i < lines.length; i++)
     {
-        if (simData.hasOwnProperty(device))
+        var fields = lines[i].split(";");
+        if (fields.length == 3)
         {
-            for (var network in simData[device])
-            {
-                if (simData[device].hasOwnProperty(network))
-                {
-                    objEqn += String(alpha * simData[device][network]);
-                    objEqn += " ";
-                }
-            }
+            var range = fields[0].split(" ");
+            var objective = fields[1].split(" ");
+            path.push({start    : Number(range[0]),
+                       end      : Number(range[1]),
+                       objStart : Number(objective[0]),
+                       objEnd   : Number(objective[1]),
+                       values   : fields[2]});
         }
     }
-    if (objEqn == "") // there are no networks
+    return path;
+}
+
+
+/*
+ * optimize uses the values of alpha and beta and the positions of every
+ * network and device to describe the scene to the server, which builds and
+ * solves the linear programming problem using the C++ solver available to
+ * PHP as a shared library. The server solves it for every value of beta at
+ * once, so the fairness slider works without further requests. The format of the scene passed to the solver is:
+ * "alpha beta;x y radius maxRate,...,;x y,...,;" where the second field
+ * lists the networks and the third lists the devices. Its size only grows
+ * linearly with the number of networks and devices.
+ */
+function optimize()
+{
+    numDevices = Object.keys(simData).length; // not always equal to deviceID
+    if (numDevices == 0 ||
+        Object.keys(simData[Object.keys(simData)[0]]).length == 0)
     {
         alert("Please add networks and devices before attempting to optimize "
             + "the system.");
         return;
     }
-    objEqn += String(beta * sumRuaMax);
-    problemFormulation += objEqn + ";";
-
-    // formulate constraints to ensure networks don't exceed max bandwidth
-    var inequalities = "";
     numNetworks = Object.keys(simData[Object.keys(simData)[0]]).length;
-    for (var i = 0; i < numNetworks; i++)
-    {
-        for (var j = 0; j < numDevices; j++)
-        {
-            var currentDevice = simData[Object.keys(simData)[j]];
-            for (var k = 0; k < numNetworks; k++)
-            {
-                if (k == i)
-                    inequalities += String(currentDevice[Object.keys(currentDevice)[k]]) + " ";
-                else
-                    inequalities += "0 ";
-            }
-        }
-        inequalities += "0 "; // z's coefficient
-        var currentNetworkID = "#network" + String(i + 1);
-        inequalities += String(maxRates[currentNetworkID]) + ",";
-    }
-   
-    // formulate constraints to ensure each x_ua <= 1 so devices don't exceed
-    // their potential bandwidth
-    var equalities = "";
-    for (var i = 0; i < numDevices * numNetworks; i++)
+
+    var networks = "";
+    for (var i = 1; i <= networkID; i++)
     {
-        var assignmentConstraint = "";
-        for (var j = 0; j < numDevices; j++)
-        {
-            for (var k = 0; k < numNetworks; k++)
-            {
-                if ((numNetworks * j) + k == i)
-                    assignmentConstraint += "1 ";
-                else
-                    assignmentConstraint += "0 ";
-            }
-        }
-        var currentDeviceIndex = Math.floor(i / numNetworks);
-        var currentDevice = simData[Object.keys(simData)[currentDeviceIndex]];
-        var currentMax = currentDevice[Object.keys(currentDevice)[i % currentDeviceIndex]];
-        if (currentMax == 0)
-        {
-            assignmentConstraint += "0 0,";
-            equalities += assignmentConstraint; 
-        }
-        else
+        var currentNetworkID = "#network" + i;
+        if (!d3.select(currentNetworkID).empty()) // make sure it wasn't deleted
         {
-            assignmentConstraint += "0 1,";
-            inequalities += assignmentConstraint;
+            networks += $(currentNetworkID).prop("cx").baseVal.value + " "
+                      + $(currentNetworkID).prop("cy").baseVal.value + " "
+                      + $(currentNetworkID).prop("r").baseVal.value + " "
+                      + maxRates[currentNetworkID] + ",";
         }
     }
 
-    // formulate constraints to ensure z <= r_u for all devices
-    for (var i = 0; i < numDevices; i++)
+    var devices = "";
+    for (var i = 1; i <= deviceID; i++)
     {
-        var currentDevice = simData[Object.keys(simData)[i]];
-        for (var j = 0; j < numDevices; j++)
+        var currentDeviceID = "#device" + i;
+        if (!d3.select(currentDeviceID).empty()) // make sure it wasn't deleted
         {
-            for (var k = 0; k < numNetworks; k++)
-            {
-                if (j == i)
-                {
-                    inequalities += String(-1 * currentDevice[Object.keys(currentDevice)[k]]);
-                    inequalities += " ";
-                }
-                else
-                {
-                    inequalities += "0 ";
-                }
-            }
+            var xforms = $(currentDeviceID).parent().prop("transform").baseVal;
+            devices += xforms.getItem(0).matrix.e + " "
+                     + xforms.getItem(0).matrix.f + ",";
         }
-        inequalities += "1 0,"; // 1 is z's coefficient, eqn <= 0
     }
-    problemFormulation += inequalities + ";" + equalities + ";";
-    console.log(problemFormulation);
+
+    var scene = alpha + " " + beta + ";" + networks + ";" + devices + ";";
+    console.log(scene);
 
     // make an AJAX POST to the server with the problem information
     $.ajax({
         type     : 'POST',
         url      : 'process.php',
-        data     : {'problem' : problemFormulation},
+        data     : {'scenePath' : scene},
         dataType : 'json',
         success  : function(data) {
             if (data.success) {
                 console.log(data.answer);
-                visualSolution(data.answer);
-                animateTextBoxes();
+                solutionPath = parsePath(data.answer);
+                showPathSolution();
                 changeText("Hover over devices to see their assigned "
                          + "allocations for each network.");
             } else {
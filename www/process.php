@@ -3,13 +3,46 @@
 switch($_SERVER['REQUEST_METHOD'])
 {
     case 'POST':
-        $str = $_POST['problem'];
-        error_log($str, 0);
-        $a = cppMain($str);
+        // Answer with the best point found so far rather than hold the
+        // worker when a scene takes too long to solve.
+        cppSetTimeLimit("5");
+        // Interactive users are happy with an answer within 1% of the best.
+        // Scene paths are always solved exactly; only single solves use it.
+        cppSetGapTolerance("0.01");
+        // Turn away problems whose tables would go over 1 GB, rather than
+        // have the worker killed halfway. The tables are allocated by C++,
+        // so PHP's memory_limit neither counts nor stops them.
+        cppSetMemoryLimit("1024", "2");
+        // Record the requests, to replay them against a new build before
+        // deploying it, when the server sets SOLVER_CAPTURE to a file.
+        if (getenv('SOLVER_CAPTURE'))
+        {
+            $sample = getenv('SOLVER_CAPTURE_SAMPLE');
+            cppStartCapture(getenv('SOLVER_CAPTURE'), $sample ? $sample : "1");
+        }
+        if (isset($_POST['scenePath']))
+        {
+            $a = cppSolveScenePath($_POST['scenePath']);
+        }
+        else if (isset($_POST['scene']))
+        {
+            $a = cppSolveScene($_POST['scene']);
+        }
+        else
+        {
+            $str = $_POST['problem'];
+            error_log($str, 0);
+            $a = cppMain($str);
+        }
         #error_log($a, 0); 
+        // Time spent in each stage of the solve, and the problem's shape.
+        $stats = cppLastSolveStats();
+        error_log($stats, 0);
         $response = array();
         $response['success'] = true;
         $response['answer'] = $a;
+        // The status and gap tell the client how close to optimal it is.
+        $response['stats'] = json_decode($stats, true);
         echo json_encode($response);
         break;
 }